@@ -0,0 +1,73 @@
+#!/usr/bin/env python3
+"""Compare two tl_bench JSON runs and flag regressions.
+
+    python3 bench/compare.py base.json new.json [--threshold=0.10] [--filter=matmul]
+
+For every benchmark present in both runs, prints the baseline and contender time
+per iteration and their ratio.  A ratio above 1 + threshold is a REGRESSION and
+one below 1 / (1 + threshold) is IMPROVED.  Benchmarks present in only one run
+are listed separately.  Exits with status 1 when any regression is found.
+"""
+
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        doc = json.load(f)
+    return {b["name"]: b for b in doc.get("benchmarks", [])}, doc.get("context", {})
+
+
+def fmt_time(ns):
+    for unit, scale in (("s", 1e9), ("ms", 1e6), ("us", 1e3)):
+        if ns >= scale:
+            return "%.3f %s" % (ns / scale, unit)
+    return "%.1f ns" % ns
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("baseline")
+    ap.add_argument("contender")
+    ap.add_argument("--threshold", type=float, default=0.10,
+                    help="relative slowdown that counts as a regression (default 0.10)")
+    ap.add_argument("--filter", default="", help="only compare names containing this substring")
+    args = ap.parse_args()
+
+    base, base_ctx = load(args.baseline)
+    cont, cont_ctx = load(args.contender)
+    if base_ctx.get("num_cpus") != cont_ctx.get("num_cpus"):
+        print("warning: runs come from machines with %s and %s CPUs"
+              % (base_ctx.get("num_cpus"), cont_ctx.get("num_cpus")))
+
+    names = [n for n in base if n in cont and args.filter in n]
+    regressions = improvements = 0
+    width = max([len(n) for n in names] + [9])
+    print("%-*s %12s %12s %8s" % (width, "benchmark", "baseline", "contender", "ratio"))
+    for name in names:
+        b, c = base[name]["real_time_ns"], cont[name]["real_time_ns"]
+        ratio = c / b if b > 0 else float("inf")
+        tag = ""
+        if ratio > 1.0 + args.threshold:
+            tag, regressions = "REGRESSION", regressions + 1
+        elif ratio < 1.0 / (1.0 + args.threshold):
+            tag, improvements = "IMPROVED", improvements + 1
+        print("%-*s %12s %12s %7.3fx  %s" % (width, name, fmt_time(b), fmt_time(c), ratio, tag))
+
+    only_base = [n for n in base if n not in cont and args.filter in n]
+    only_cont = [n for n in cont if n not in base and args.filter in n]
+    for label, missing in (("only in baseline", only_base), ("only in contender", only_cont)):
+        if missing:
+            print("\n%s:" % label)
+            for n in missing:
+                print("  " + n)
+
+    print("\n%d compared, %d regressions, %d improvements (threshold %.0f%%)"
+          % (len(names), regressions, improvements, 100.0 * args.threshold))
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
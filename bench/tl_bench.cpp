@@ -0,0 +1,426 @@
+// bench/tl_bench.cpp — Throughput benchmarks for every tl kernel family
+//
+//   ./tl_bench                                   all benchmarks, 1 and max threads
+//   ./tl_bench --filter=matmul --threads=1,4     a subset
+//   ./tl_bench --json=base.json                  machine-readable results
+//   python3 bench/compare.py base.json new.json  flag regressions between two runs
+//
+// FLOP counts use the textbook operation count (2 M N K for a GEMM, one per
+// element for element-wise arithmetic).  Transcendental kernels report bandwidth
+// only.  Byte counts are the compulsory traffic: every input read once and every
+// output written once.
+
+#include "bench.hpp"
+#include "../tl/tl.hpp"
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using tl::bench::Case;
+using tl::bench::keep;
+
+template <typename T>
+tl::Tensor<T> filled(const std::vector<std::size_t>& shape, float lo = -1.0f, float hi = 1.0f, std::uint64_t seed = 1) {
+    tl::random::Generator gen(seed);
+    const auto f = tl::random::uniform<float>(shape, lo, hi, gen);
+    tl::Tensor<T> t(shape);
+    for (std::size_t i = 0; i < f.data.size(); ++i) t.data[i] = static_cast<T>(f.data[i]);
+    return t;
+}
+
+double volume(const std::vector<std::size_t>& shape) {
+    double n = 1.0;
+    for (auto d : shape) n *= static_cast<double>(d);
+    return n;
+}
+
+// --- Linear algebra ---
+
+template <typename T>
+void add_matmul(tl::bench::Registry& reg, const char* dtype, std::size_t n) {
+    reg.add("matmul", dtype, std::to_string(n), [n] {
+        const auto A = filled<T>({n, n}, -1.0f, 1.0f, 1), B = filled<T>({n, n}, -1.0f, 1.0f, 2);
+        const double d = static_cast<double>(n);
+        return Case{2.0 * d * d * d, 3.0 * d * d * sizeof(T), [=] { keep(tl::linalg::matmul(A, B)); }};
+    });
+}
+
+void add_linalg(tl::bench::Registry& reg) {
+    for (std::size_t n : {64, 256, 512}) add_matmul<float>(reg, "f32", n);
+    for (std::size_t n : {256}) add_matmul<double>(reg, "f64", n);
+    for (std::size_t n : {256, 512}) add_matmul<tl::float16>(reg, "f16", n);
+    add_matmul<tl::bfloat16>(reg, "bf16", 256);
+
+    reg.add("transpose", "f32", "2048", [] {
+        const auto A = filled<float>({2048, 2048});
+        return Case{0.0, 2.0 * 2048 * 2048 * sizeof(float), [=] { keep(tl::linalg::transpose(A)); }};
+    });
+
+    reg.add("einsum_bmm", "f32", "bij,bjk-32x128", [] {
+        const auto A = filled<float>({32, 128, 128}, -1.0f, 1.0f, 1), B = filled<float>({32, 128, 128}, -1.0f, 1.0f, 2);
+        return Case{2.0 * 32 * 128 * 128 * 128, 3.0 * 32 * 128 * 128 * sizeof(float), [=] { keep(tl::einsum("bij,bjk->bik", A, B)); }};
+    });
+    reg.add("einsum_attention", "f32", "bhqd,bhkd-8x8x128x64", [] {
+        const auto Q = filled<float>({8, 8, 128, 64}, -1.0f, 1.0f, 1), K = filled<float>({8, 8, 128, 64}, -1.0f, 1.0f, 2);
+        return Case{2.0 * 64 * 128 * 128 * 64, (2.0 * 64 * 128 * 64 + 64.0 * 128 * 128) * sizeof(float),
+                    [=] { keep(tl::einsum("bhqd,bhkd->bhqk", Q, K)); }};
+    });
+    reg.add("lu_solve", "f64", "256", [] {
+        auto A = filled<double>({256, 256});
+        for (std::size_t i = 0; i < 256; ++i) A.data[i * 256 + i] += 256.0;
+        const auto b = filled<double>({256});
+        const double n = 256.0;
+        return Case{2.0 / 3.0 * n * n * n + 2.0 * n * n, (n * n + 2.0 * n) * sizeof(double),
+                    [=] { keep(tl::linalg::solve(A, b)); }};
+    });
+
+    reg.add("spmv", "f64", "poisson-1024^2", [] {
+        const std::size_t g = 1024, n = g * g;
+        std::vector<std::tuple<std::size_t, std::size_t, double>> trip;
+        trip.reserve(5 * n);
+        for (std::size_t i = 0; i < g; ++i)
+            for (std::size_t j = 0; j < g; ++j) {
+                const std::size_t r = i * g + j;
+                trip.emplace_back(r, r, 4.0);
+                if (i > 0) trip.emplace_back(r, r - g, -1.0);
+                if (i + 1 < g) trip.emplace_back(r, r + g, -1.0);
+                if (j > 0) trip.emplace_back(r, r - 1, -1.0);
+                if (j + 1 < g) trip.emplace_back(r, r + 1, -1.0);
+            }
+        auto A = std::make_shared<tl::linalg::CSRMatrix<double>>(tl::linalg::CSRMatrix<double>::from_triplets(n, n, std::move(trip)));
+        auto x = std::make_shared<tl::Tensor<double>>(filled<double>({n}));
+        auto y = std::make_shared<tl::Tensor<double>>(tl::Tensor<double>({n}));
+        const double nnz = static_cast<double>(A->nnz());
+        return Case{2.0 * nnz, nnz * (sizeof(double) + sizeof(std::size_t)) + 2.0 * n * sizeof(double),
+                    [=] { A->matvec(*x, *y); keep(*y); }};
+    });
+}
+
+// --- Element-wise (broadcast_apply / scalar operators / mixed types) ---
+
+void add_elementwise(tl::bench::Registry& reg) {
+    const std::size_t n = std::size_t(1) << 22;
+    reg.add("add", "f32", "4M", [n] {
+        const auto a = filled<float>({n}), b = filled<float>({n});
+        return Case{double(n), 3.0 * n * sizeof(float), [=] { keep(a + b); }};
+    });
+    reg.add("add", "f64", "4M", [n] {
+        const auto a = filled<double>({n}), b = filled<double>({n});
+        return Case{double(n), 3.0 * n * sizeof(double), [=] { keep(a + b); }};
+    });
+    reg.add("add", "f16", "4M", [n] {
+        const auto a = filled<tl::float16>({n}), b = filled<tl::float16>({n});
+        return Case{double(n), 3.0 * n * sizeof(tl::float16), [=] { keep(a + b); }};
+    });
+    reg.add("add_broadcast_row", "f32", "2048x2048", [] {
+        const auto a = filled<float>({2048, 2048}), b = filled<float>({2048});
+        const double m = 2048.0 * 2048.0;
+        return Case{m, 2.0 * m * sizeof(float), [=] { keep(a + b); }};
+    });
+    reg.add("mul_mixed", "i32*f32", "4M", [n] {
+        const auto a = filled<std::int32_t>({n}, 0.0f, 2.0f);
+        const auto b = filled<float>({n});
+        return Case{double(n), 3.0 * n * 4.0, [=] { keep(a * b); }};
+    });
+    reg.add("scale_inplace", "f32", "4M", [n] {
+        auto a = std::make_shared<tl::Tensor<float>>(filled<float>({n}));
+        return Case{double(n), 2.0 * n * sizeof(float), [=] { *a *= 1.0000001f; keep(*a); }};
+    });
+}
+
+// --- Indexing and masks ---
+
+void add_indexing(tl::bench::Registry& reg) {
+    // Embedding lookup and its gradient: 64K token ids into a [32K, 256] table.
+    const std::size_t vocab = 32768, dim = 256, tokens = 65536;
+    reg.add("index_select", "f32", "64Kx256", [=] {
+        const auto table = filled<float>({vocab, dim});
+        tl::Tensor<std::int64_t> ids({tokens});
+        for (std::size_t i = 0; i < tokens; ++i) ids.data[i] = static_cast<std::int64_t>((i * 2654435761u) % vocab);
+        return Case{0.0, 2.0 * tokens * dim * sizeof(float), [=] { keep(tl::index_select(table, 0, ids)); }};
+    });
+    reg.add("scatter_add", "f32", "64Kx256", [=] {
+        const auto grads = filled<float>({tokens, dim});
+        tl::Tensor<std::int64_t> rows({tokens, dim});
+        for (std::size_t i = 0; i < tokens; ++i)
+            for (std::size_t d = 0; d < dim; ++d) rows.data[i * dim + d] = static_cast<std::int64_t>((i * 2654435761u) % 4096);
+        const auto acc = tl::zeros<float>({4096, dim});
+        return Case{double(tokens * dim), double(tokens * dim) * (2 * sizeof(float) + sizeof(std::int64_t)),
+                    [=] { keep(tl::scatter_add(acc, 0, rows, grads)); }};
+    });
+    reg.add("where", "f32", "4M", [] {
+        const std::size_t n = std::size_t(1) << 22;
+        const auto a = filled<float>({n}, -1.0f, 1.0f, 1), b = filled<float>({n}, -1.0f, 1.0f, 2);
+        tl::Tensor<std::uint8_t> c({n});
+        for (std::size_t i = 0; i < n; ++i) c.data[i] = a.data[i] > b.data[i];
+        return Case{0.0, n * (3.0 * sizeof(float) + 1.0), [=] { keep(tl::where(c, a, b)); }};
+    });
+    reg.add("masked_select", "f32", "4M", [] {
+        const std::size_t n = std::size_t(1) << 22;
+        const auto a = filled<float>({n});
+        tl::Tensor<std::uint8_t> c({n});
+        for (std::size_t i = 0; i < n; ++i) c.data[i] = a.data[i] > 0.0f;
+        return Case{0.0, n * (1.5 * sizeof(float) + 1.0), [=] { keep(tl::masked_select(a, c)); }};
+    });
+
+    // Byte mask vs packed bits for the same predicate.
+    reg.add("compare_gt", "f32", "4M", [] {
+        const std::size_t n = std::size_t(1) << 22;
+        const auto a = filled<float>({n});
+        return Case{double(n), n * (sizeof(float) + 1.0), [=] { keep(a > 0.0f); }};
+    });
+    reg.add("compare_bits_gt", "f32", "4M", [] {
+        const std::size_t n = std::size_t(1) << 22;
+        const auto a = filled<float>({n});
+        return Case{double(n), n * (sizeof(float) + 0.125), [=] { keep(tl::compare_bits(a, tl::Cmp::Gt, 0.0f)); }};
+    });
+    reg.add("count_nonzero", "u8", "4M", [] {
+        const std::size_t n = std::size_t(1) << 22;
+        const auto c = filled<float>({n}) > 0.0f;
+        return Case{double(n), double(n), [=] { keep(tl::count_nonzero(c)); }};
+    });
+    reg.add("masked_select_bits", "f32", "4M", [] {
+        const std::size_t n = std::size_t(1) << 22;
+        const auto a = filled<float>({n});
+        const auto c = tl::compare_bits(a, tl::Cmp::Gt, 0.0f);
+        return Case{0.0, n * (1.5 * sizeof(float) + 0.125), [=] { keep(tl::masked_select(a, c)); }};
+    });
+}
+
+// --- Joining, splitting and padding ---
+
+void add_concat(tl::bench::Registry& reg) {
+    // Mini-batch assembly: 64 images of [3, 224, 224].
+    reg.add("stack", "f32", "64x3x224x224", [] {
+        std::vector<tl::Tensor<float>> images;
+        for (std::uint64_t i = 0; i < 64; ++i) images.push_back(filled<float>({3, 224, 224}, -1.0f, 1.0f, i));
+        const double bytes = 2.0 * 64 * 3 * 224 * 224 * sizeof(float);
+        return Case{0.0, bytes, [=] { keep(tl::stack(images)); }};
+    });
+    // Feature concatenation along the last axis: one run per row and part.
+    reg.add("concatenate_last", "f32", "2x4096x512", [] {
+        const auto a = filled<float>({4096, 512}, -1.0f, 1.0f, 1), b = filled<float>({4096, 512}, -1.0f, 1.0f, 2);
+        return Case{0.0, 4.0 * 4096 * 512 * sizeof(float), [=] { keep(tl::concatenate<float>({a, b}, -1)); }};
+    });
+    reg.add("chunk_to_tensor", "f32", "4096x1024/4", [] {
+        const auto x = filled<float>({4096, 1024});
+        return Case{0.0, 2.0 * 4096 * 1024 * sizeof(float), [=] {
+            for (const auto& s : tl::chunk(x, 4, -1)) keep(s.to_tensor());
+        }};
+    });
+    reg.add("pad_spatial", "f32", "32x64x56x56", [] {
+        const auto x = filled<float>({32, 64, 56, 56});
+        return Case{0.0, (32.0 * 64 * 56 * 56 + 32.0 * 64 * 58 * 58) * sizeof(float),
+                    [=] { keep(tl::pad(x, {{0, 0}, {0, 0}, {1, 1}, {1, 1}})); }};
+    });
+}
+
+// --- functional:: (apply_unary) and reductions ---
+
+template <typename T>
+void add_unary(tl::bench::Registry& reg, const char* dtype) {
+    const std::size_t n = std::size_t(1) << 22;
+    reg.add("exp", dtype, "4M", [n] {
+        const auto a = filled<T>({n});
+        return Case{0.0, 2.0 * n * sizeof(T), [=] { keep(tl::functional::exp(a)); }};
+    });
+    reg.add("relu", dtype, "4M", [n] {
+        const auto a = filled<T>({n});
+        return Case{double(n), 2.0 * n * sizeof(T), [=] { keep(tl::functional::relu(a)); }};
+    });
+    reg.add("sigmoid", dtype, "4M", [n] {
+        const auto a = filled<T>({n});
+        return Case{0.0, 2.0 * n * sizeof(T), [=] { keep(tl::functional::sigmoid(a)); }};
+    });
+    reg.add("sum", dtype, "4M", [n] {
+        const auto a = filled<T>({n});
+        return Case{double(n), double(n) * sizeof(T), [=] { keep(tl::sum(a)); }};
+    });
+    reg.add("max", dtype, "4M", [n] {
+        const auto a = filled<T>({n});
+        return Case{double(n), double(n) * sizeof(T), [=] { keep(tl::max(a)); }};
+    });
+}
+
+void add_functional(tl::bench::Registry& reg) {
+    add_unary<float>(reg, "f32");
+    add_unary<double>(reg, "f64");
+    add_unary<tl::float16>(reg, "f16");
+
+    reg.add("softmax", "f32", "4096x1000", [] {
+        const auto x = filled<float>({4096, 1000}, -5.0f, 5.0f);
+        return Case{0.0, 2.0 * 4096 * 1000 * sizeof(float), [=] { keep(tl::functional::softmax(x)); }};
+    });
+    reg.add("softmax_axis0", "f32", "1000x4096", [] {
+        const auto x = filled<float>({1000, 4096}, -5.0f, 5.0f);
+        return Case{0.0, 2.0 * 4096 * 1000 * sizeof(float), [=] { keep(tl::functional::softmax(x, 0)); }};
+    });
+    reg.add("cross_entropy", "f32", "4096x1000", [] {
+        const auto x = filled<float>({4096, 1000}, -5.0f, 5.0f);
+        std::vector<std::size_t> labels(4096);
+        for (std::size_t i = 0; i < labels.size(); ++i) labels[i] = (i * 37) % 1000;
+        return Case{0.0, 2.0 * 4096 * 1000 * sizeof(float),
+                    [=] { keep(tl::functional::softmax_cross_entropy(x, labels)); }};
+    });
+}
+
+// --- nn:: ---
+
+void add_nn(tl::bench::Registry& reg) {
+    for (auto algo : {tl::nn::ConvAlgorithm::Im2col, tl::nn::ConvAlgorithm::Winograd}) {
+        const bool wino = algo == tl::nn::ConvAlgorithm::Winograd;
+        reg.add(wino ? "conv2d_winograd" : "conv2d_im2col", "f32", "8x64x56x56-k3", [algo] {
+            const auto x = filled<float>({8, 64, 56, 56}), w = filled<float>({64, 64, 3, 3}, -0.1f, 0.1f);
+            tl::nn::Conv2dOptions opts;
+            opts.padding = {1, 1};
+            opts.algorithm = algo;
+            const double out = 8.0 * 64 * 56 * 56;
+            return Case{2.0 * out * 64 * 9, (volume(x.shape) + volume(w.shape) + out) * sizeof(float),
+                        [=] { keep(tl::nn::conv2d(x, w, opts)); }};
+        });
+    }
+    for (auto layout : {tl::nn::Layout::NCHW, tl::nn::Layout::NHWC}) {
+        const bool nhwc = layout == tl::nn::Layout::NHWC;
+        reg.add("max_pool2d", nhwc ? "f32-nhwc" : "f32-nchw", "16x64x112x112-k2", [layout, nhwc] {
+            const auto x = nhwc ? filled<float>({16, 112, 112, 64}) : filled<float>({16, 64, 112, 112});
+            tl::nn::Pool2dOptions opts;
+            opts.layout = layout;
+            const double n = volume(x.shape);
+            return Case{0.75 * n, 1.25 * n * sizeof(float), [=] { keep(tl::nn::max_pool2d(x, opts)); }};
+        });
+    }
+    reg.add("layer_norm", "f32", "4096x1024", [] {
+        const auto x = filled<float>({4096, 1024}), g = filled<float>({1024}), b = filled<float>({1024});
+        const double n = 4096.0 * 1024;
+        return Case{8.0 * n, 2.0 * n * sizeof(float), [=] { keep(tl::nn::layer_norm(x, g, b)); }};
+    });
+    // Two-layer MLP forward pass, eager vs a compiled graph replay.
+    for (bool replay : {false, true}) {
+        reg.add(replay ? "mlp_graph" : "mlp_eager", "f32", "256x512x512x10", [replay] {
+            struct State {
+                tl::Tensor<float> x = filled<float>({256, 512}), W1 = filled<float>({512, 512}, -0.05f, 0.05f, 2),
+                                  b1 = filled<float>({512}), W2 = filled<float>({512, 10}, -0.05f, 0.05f, 3),
+                                  b2 = filled<float>({10});
+                std::unique_ptr<tl::graph::Plan<float>> plan;
+            };
+            auto st = std::make_shared<State>();
+            tl::graph::Graph<float> g;
+            auto h = tl::graph::relu(tl::graph::matmul(g.input({256, 512}), g.param(st->W1)) + g.param(st->b1));
+            g.output(tl::graph::softmax(tl::graph::matmul(h, g.param(st->W2)) + g.param(st->b2)));
+            st->plan = std::make_unique<tl::graph::Plan<float>>(tl::graph::compile(g));
+            const double flops = 2.0 * 256 * 512 * 522;
+            const double bytes = (256.0 * 512 + 512.0 * 522 + 256.0 * 10) * sizeof(float);
+            if (replay) return Case{flops, bytes, [=] { st->plan->run({st->x}); keep(st->plan->output()); }};
+            return Case{flops, bytes, [=] {
+                namespace F = tl::functional;
+                keep(F::softmax(tl::linalg::matmul(F::relu(tl::linalg::matmul(st->x, st->W1) + st->b1), st->W2) + st->b2));
+            }};
+        });
+    }
+    reg.add("dropout", "f32", "4M", [] {
+        const auto x = filled<float>({std::size_t(1) << 22});
+        auto gen = std::make_shared<tl::random::Generator>(7);
+        const double n = volume(x.shape);
+        return Case{n, 2.0 * n * sizeof(float), [=] { keep(tl::nn::dropout(x, 0.1, *gen)); }};
+    });
+}
+
+// --- fft:: ---
+
+void add_fft(tl::bench::Registry& reg) {
+    // 5 n log2 n per complex transform (the customary FFT "flop" count), half that for real input.
+    for (std::size_t n : {1024, 1000, 4093}) {
+        reg.add("fft", "c64", std::to_string(n) + "x256", [n] {
+            const auto x = tl::make_complex(filled<float>({256, n}, -1.0f, 1.0f, 1), filled<float>({256, n}, -1.0f, 1.0f, 2));
+            const double d = static_cast<double>(n);
+            return Case{256.0 * 5.0 * d * std::log2(d), 2.0 * 256 * d * sizeof(std::complex<float>), [=] { keep(tl::fft::fft(x)); }};
+        });
+    }
+    reg.add("rfft", "f32", "4096x256", [] {
+        const auto x = filled<float>({256, 4096});
+        return Case{256.0 * 2.5 * 4096 * 12, 256.0 * (4096 * sizeof(float) + 2049 * sizeof(std::complex<float>)), [=] { keep(tl::fft::rfft(x)); }};
+    });
+    reg.add("fft2", "c128", "512^2", [] {
+        const auto x = tl::make_complex(filled<double>({512, 512}, -1.0f, 1.0f, 1), filled<double>({512, 512}, -1.0f, 1.0f, 2));
+        return Case{2.0 * 512 * 5.0 * 512 * 9, 2.0 * 512 * 512 * sizeof(std::complex<double>), [=] { keep(tl::fft::fftn(x)); }};
+    });
+
+    // Direct multiply-add counts, whichever method runs, so the two paths compare on one scale.
+    for (std::size_t k : {31, 1023}) {
+        reg.add("convolve", "f32", "1M*" + std::to_string(k), [k] {
+            const auto x = filled<float>({1 << 20}, -1.0f, 1.0f, 1), h = filled<float>({k}, -1.0f, 1.0f, 2);
+            return Case{2.0 * (1 << 20) * k, 2.0 * (1 << 20) * sizeof(float), [=] { keep(tl::fft::convolve(x, h, tl::fft::ConvMode::Same)); }};
+        });
+    }
+    reg.add("convolve2d", "f32", "1024^2*31^2", [] {
+        const auto x = filled<float>({1024, 1024}, -1.0f, 1.0f, 1), h = filled<float>({31, 31}, -1.0f, 1.0f, 2);
+        return Case{2.0 * 1024 * 1024 * 31 * 31, 2.0 * 1024 * 1024 * sizeof(float), [=] { keep(tl::fft::convolve(x, h, tl::fft::ConvMode::Same)); }};
+    });
+}
+
+// --- optim::, random::, quant::, pde:: ---
+
+void add_misc(tl::bench::Registry& reg) {
+    reg.add("adam_step", "f32", "4M-params", [] {
+        struct State {
+            tl::autograd::Parameter<float> p{filled<float>({std::size_t(1) << 22})};
+            std::unique_ptr<tl::optim::Adam<float>> opt;
+        };
+        auto st = std::make_shared<State>();
+        st->p.grad = filled<float>({std::size_t(1) << 22}, -1e-3f, 1e-3f, 3);
+        st->opt = std::make_unique<tl::optim::Adam<float>>(std::vector<tl::autograd::Parameter<float>*>{&st->p});
+        const double n = double(std::size_t(1) << 22);
+        return Case{12.0 * n, 7.0 * n * sizeof(float), [=] { st->opt->step(); keep(st->p.value); }};
+    });
+    reg.add("normal", "f32", "4M", [] {
+        auto gen = std::make_shared<tl::random::Generator>(11);
+        const std::size_t n = std::size_t(1) << 22;
+        return Case{0.0, double(n) * sizeof(float), [=] { keep(tl::random::normal<float>({n}, 0.0f, 1.0f, *gen)); }};
+    });
+    reg.add("qgemm", "u8*i8", "256x1024x1024", [] {
+        const auto a = tl::random::randint<std::uint8_t>({256, 1024}, 0, 256);
+        tl::quant::QTensor<std::int8_t> w{tl::random::randint<std::int8_t>({1024, 1024}, -128, 128), tl::quant::QParams{{1.0f}, {0}, -1}};
+        const auto packed = std::make_shared<tl::quant::PackedWeights>(w);
+        return Case{2.0 * 256 * 1024 * 1024, 256.0 * 1024 + 1024.0 * 1024 + 4.0 * 256 * 1024,
+                    [=] { keep(tl::quant::qgemm(a, *packed)); }};
+    });
+    reg.add("qlinear_requant", "u8*i8", "256x1024x1024", [] {
+        const auto x = filled<float>({256, 1024}, 0.0f, 1.0f);
+        const auto wf = filled<float>({1024, 1024}, -0.05f, 0.05f);
+        const auto xq = tl::quant::quantize<std::uint8_t>(x);
+        const auto packed = std::make_shared<tl::quant::PackedWeights>(
+            tl::quant::quantize<std::int8_t>(wf, tl::quant::choose_qparams<std::int8_t>(wf, 1, true)));
+        const auto bias = filled<float>({1024});
+        const auto out = tl::quant::choose_qparams<std::uint8_t>(tl::quant::qlinear(xq, *packed, bias, true));
+        return Case{2.0 * 256 * 1024 * 1024, 256.0 * 1024 + 1024.0 * 1024 + 256.0 * 1024,
+                    [=] { keep(tl::quant::qlinear(xq, *packed, bias, out, true)); }};
+    });
+    reg.add("stencil_laplacian", "f32", "2048^2", [] {
+        const auto u = filled<float>({2048, 2048});
+        const auto op = std::make_shared<tl::pde::StencilOperator<float>>(
+            tl::pde::Stencil<float>::laplacian(2), u.shape, tl::pde::Boundaries<float>::dirichlet(2));
+        auto out = std::make_shared<tl::Tensor<float>>(u.shape);
+        const double n = volume(u.shape);
+        return Case{9.0 * n, 2.0 * n * sizeof(float), [=] { op->apply(u, *out); keep(*out); }};
+    });
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    tl::bench::Registry reg;
+    add_linalg(reg);
+    add_elementwise(reg);
+    add_indexing(reg);
+    add_concat(reg);
+    add_functional(reg);
+    add_nn(reg);
+    add_fft(reg);
+    add_misc(reg);
+    return reg.main(argc, argv);
+}
@@ -19,6 +19,29 @@ void run_functional_tests      (tl::TestContext& ctx);
 void run_dot_product_tests     (tl::TestContext& ctx);
 void run_elementary_tests      (tl::TestContext& ctx);
 void run_broadcasting_tests    (tl::TestContext& ctx);
+void run_iterative_tests       (tl::TestContext& ctx);
+void run_pde_tests             (tl::TestContext& ctx);
+void run_multigrid_tests       (tl::TestContext& ctx);
+void run_ode_tests             (tl::TestContext& ctx);
+void run_autograd_tests        (tl::TestContext& ctx);
+void run_conv_tests            (tl::TestContext& ctx);
+void run_pooling_tests         (tl::TestContext& ctx);
+void run_softmax_tests         (tl::TestContext& ctx);
+void run_norm_tests            (tl::TestContext& ctx);
+void run_optim_tests           (tl::TestContext& ctx);
+void run_random_tests          (tl::TestContext& ctx);
+void run_half_tests            (tl::TestContext& ctx);
+void run_quant_tests           (tl::TestContext& ctx);
+void run_promotion_tests       (tl::TestContext& ctx);
+void run_profile_tests         (tl::TestContext& ctx);
+void run_memory_tests          (tl::TestContext& ctx);
+void run_graph_tests           (tl::TestContext& ctx);
+void run_einsum_tests          (tl::TestContext& ctx);
+void run_fft_tests             (tl::TestContext& ctx);
+void run_convolve_tests        (tl::TestContext& ctx);
+void run_indexing_tests        (tl::TestContext& ctx);
+void run_compare_tests         (tl::TestContext& ctx);
+void run_concat_tests          (tl::TestContext& ctx);
 
 // ── Include test translation units ───────────────────────────────────────────
 // (Each file defines the function declared above.)
@@ -28,6 +51,29 @@ void run_broadcasting_tests    (tl::TestContext& ctx);
 #include "test_dot_product.cpp"
 #include "test_elementary_functions.cpp"
 #include "test_broadcasting.cpp"
+#include "test_iterative.cpp"
+#include "test_pde.cpp"
+#include "test_multigrid.cpp"
+#include "test_ode.cpp"
+#include "test_autograd.cpp"
+#include "test_conv.cpp"
+#include "test_pooling.cpp"
+#include "test_softmax.cpp"
+#include "test_norm.cpp"
+#include "test_optim.cpp"
+#include "test_random.cpp"
+#include "test_half.cpp"
+#include "test_quant.cpp"
+#include "test_promotion.cpp"
+#include "test_profile.cpp"
+#include "test_memory.cpp"
+#include "test_graph.cpp"
+#include "test_einsum.cpp"
+#include "test_fft.cpp"
+#include "test_convolve.cpp"
+#include "test_indexing.cpp"
+#include "test_compare.cpp"
+#include "test_concat.cpp"
 
 
 // ── Runner ────────────────────────────────────────────────────────────────────
@@ -48,6 +94,29 @@ int main() {
     run_dot_product_tests(ctx);
     run_elementary_tests(ctx);
     run_broadcasting_tests(ctx);
+    run_iterative_tests(ctx);
+    run_pde_tests(ctx);
+    run_multigrid_tests(ctx);
+    run_ode_tests(ctx);
+    run_autograd_tests(ctx);
+    run_conv_tests(ctx);
+    run_pooling_tests(ctx);
+    run_softmax_tests(ctx);
+    run_norm_tests(ctx);
+    run_optim_tests(ctx);
+    run_random_tests(ctx);
+    run_half_tests(ctx);
+    run_quant_tests(ctx);
+    run_promotion_tests(ctx);
+    run_profile_tests(ctx);
+    run_memory_tests(ctx);
+    run_graph_tests(ctx);
+    run_einsum_tests(ctx);
+    run_fft_tests(ctx);
+    run_convolve_tests(ctx);
+    run_indexing_tests(ctx);
+    run_compare_tests(ctx);
+    run_concat_tests(ctx);
 
     return ctx.summary();   // exits 0 if all pass, 1 if any failed
 }
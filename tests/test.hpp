@@ -11,6 +11,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cstddef>
 #include <iostream>
 #include <string>
 #include <cmath>
@@ -85,6 +87,19 @@ struct TestContext {
     }
 };
 
+// ─── Tensor comparison ────────────────────────────────────────────────────────
+
+// Largest |a[i] - b[i]| over two tensors (anything with .shape and .data); a shape
+// mismatch counts as a huge error so a tolerance check fails instead of reading past b.
+template <typename A, typename B>
+double max_abs_diff(const A& a, const B& b) {
+    if (a.shape != b.shape) return 1e30;
+    double m = 0.0;
+    for (std::size_t i = 0; i < a.data.size(); ++i)
+        m = std::max(m, static_cast<double>(std::abs(a.data[i] - b.data[i])));
+    return m;
+}
+
 } // namespace tl
 
 
@@ -0,0 +1,198 @@
+// tests/test_autograd.cpp — Tests for tl::autograd (tape, operators, gradient buffers)
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+namespace {
+
+using tl::autograd::Parameter;
+using tl::autograd::Tape;
+using tl::autograd::Var;
+
+// Largest |analytic - central difference| over every entry of p, for a scalar loss.
+double grad_check(Parameter<double>& p, const std::function<Var<double>(Tape<double>&)>& loss) {
+    Tape<double> tape;
+    p.zero_grad();
+    loss(tape).backward();
+    const auto analytic = p.grad;
+
+    double worst = 0.0;
+    const double h = 1e-6;
+    for (std::size_t i = 0; i < p.value.data.size(); ++i) {
+        const double x = p.value.data[i];
+        p.value.data[i] = x + h;
+        tape.clear();
+        const double up = loss(tape).value().data[0];
+        p.value.data[i] = x - h;
+        tape.clear();
+        const double down = loss(tape).value().data[0];
+        p.value.data[i] = x;
+        worst = std::max(worst, std::abs(analytic.data[i] - (up - down) / (2.0 * h)));
+    }
+    return worst;
+}
+
+tl::Tensor<double> ramp(std::vector<std::size_t> shape, double scale = 0.1, double offset = -0.3) {
+    tl::Tensor<double> t(shape);
+    for (std::size_t i = 0; i < t.data.size(); ++i)
+        t.data[i] = offset + scale * static_cast<double>((i * 7) % 11);
+    return t;
+}
+
+} // namespace
+
+void run_autograd_tests(tl::TestContext& ctx) {
+
+    namespace ag = tl::autograd;
+
+    // ── Arithmetic and broadcasting ───────────────────────────────────────────
+    SUITE(ctx, "Autograd — arithmetic and broadcasting");
+
+    {
+        // d/dx sum(x * x + 3x) = 2x + 3
+        Parameter<double> x(tl::Tensor<double>({3}, {1.0, -2.0, 0.5}));
+        Tape<double> tape;
+        auto v = tape.param(x);
+        auto loss = ag::sum(v * v + v * 3.0);
+        CHECK_NEAR(ctx, loss.value().data[0], 1.0 + 4.0 + 0.25 + 3.0 * (-0.5), 1e-12);
+        loss.backward();
+        CHECK_NEAR(ctx, x.grad.data[0], 5.0, 1e-12);
+        CHECK_NEAR(ctx, x.grad.data[1], -1.0, 1e-12);
+        CHECK_NEAR(ctx, x.grad.data[2], 4.0, 1e-12);
+    }
+
+    {
+        // Bias broadcast over rows receives the column sums of the upstream gradient.
+        Parameter<double> b(tl::Tensor<double>({3}, {0.1, 0.2, 0.3}));
+        tl::Tensor<double> X({4, 3});
+        for (std::size_t i = 0; i < 12; ++i) X.data[i] = static_cast<double>(i);
+        Tape<double> tape;
+        auto y = tape.input(X) + tape.param(b);
+        CHECK(ctx, (y.shape() == std::vector<std::size_t>{4, 3}));
+        ag::sum(y * tape.input(X)).backward();
+        CHECK_NEAR(ctx, b.grad.data[0], 0.0 + 3.0 + 6.0 + 9.0, 1e-12);
+        CHECK_NEAR(ctx, b.grad.data[2], 2.0 + 5.0 + 8.0 + 11.0, 1e-12);
+
+        // Column vector broadcast against a row vector reduces along the other axis.
+        Parameter<double> c(tl::Tensor<double>({2, 1}, {1.0, 2.0}));
+        Parameter<double> r(tl::Tensor<double>({1, 3}, {1.0, 10.0, 100.0}));
+        auto sweep = [&](Tape<double>& tp) { return ag::sum(tp.param(c) / tp.param(r) - tp.param(c) * tp.param(r)); };
+        CHECK(ctx, grad_check(c, sweep) < 1e-7);
+        CHECK(ctx, grad_check(r, sweep) < 1e-7);
+    }
+
+    {
+        Parameter<double> p(ramp({2, 3}, 0.2, 0.5));
+        auto scalars = [&](Tape<double>& tp) {
+            auto v = tp.param(p);
+            return ag::mean(2.0 - v / 4.0 + 1.5 / v - (-v) * 0.5);
+        };
+        CHECK(ctx, grad_check(p, scalars) < 1e-7);
+    }
+
+    // ── Matmul and a small network ────────────────────────────────────────────
+    SUITE(ctx, "Autograd — matmul and MLP gradients");
+
+    {
+        Parameter<double> W1(ramp({4, 5}));
+        Parameter<double> b1(ramp({5}, 0.05, 0.0));
+        Parameter<double> W2(ramp({5, 2}, 0.15, -0.5));
+        const auto X = ramp({3, 4}, 0.3, -1.0);
+        const auto target = ramp({3, 2}, 0.2, 0.0);
+
+        auto mlp = [&](Tape<double>& tp) {
+            auto h = ag::tanh(ag::matmul(tp.input(X), tp.param(W1)) + tp.param(b1));
+            auto out = ag::sigmoid(ag::matmul(h, tp.param(W2)));
+            return ag::mean(ag::square(out - tp.input(target)));
+        };
+        CHECK(ctx, grad_check(W1, mlp) < 1e-8);
+        CHECK(ctx, grad_check(b1, mlp) < 1e-8);
+        CHECK(ctx, grad_check(W2, mlp) < 1e-8);
+    }
+
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        Tape<double> tape;
+        ag::matmul(tape.input(tl::Tensor<double>({2, 3})), tape.input(tl::Tensor<double>({2, 3})));
+    }));
+
+    // ── Element-wise functions ────────────────────────────────────────────────
+    SUITE(ctx, "Autograd — activations and elementary functions");
+
+    {
+        Parameter<double> p(ramp({7}, 0.25, -0.8));   // avoids the kinks at 0
+        using F = std::function<Var<double>(const Var<double>&)>;
+        const F fns[] = {
+            [](const Var<double>& v) { return ag::relu(v); },
+            [](const Var<double>& v) { return ag::leaky_relu(v, 0.1); },
+            [](const Var<double>& v) { return ag::sigmoid(v); },
+            [](const Var<double>& v) { return ag::tanh(v); },
+            [](const Var<double>& v) { return ag::exp(v); },
+            [](const Var<double>& v) { return ag::sin(v) * ag::cos(v); },
+            [](const Var<double>& v) { return ag::abs(v); },
+            [](const Var<double>& v) { return ag::clip(v, -0.5, 0.5); },
+            [](const Var<double>& v) { return ag::log(ag::square(v) + 1.0); },
+            [](const Var<double>& v) { return ag::sqrt(ag::power(v, 2.0) + 2.0); },
+            [](const Var<double>& v) { return ag::reshape(v, {7, 1}) * 2.0; },
+        };
+        double worst = 0.0;
+        for (const auto& fn : fns) {
+            worst = std::max(worst, grad_check(p, [&](Tape<double>& tp) { return ag::sum(fn(tp.param(p))); }));
+        }
+        CHECK(ctx, worst < 1e-7);
+    }
+
+    // ── Accumulation and buffer reuse ─────────────────────────────────────────
+    SUITE(ctx, "Autograd — accumulation and buffer reuse");
+
+    {
+        Parameter<double> w(tl::Tensor<double>({2}, {1.0, 2.0}));
+        Tape<double> tape;
+        for (int step = 0; step < 2; ++step) {
+            tape.clear();
+            ag::sum(tape.param(w) * 3.0).backward();
+        }
+        CHECK_NEAR(ctx, w.grad.data[0], 6.0, 1e-12);   // two passes accumulate
+        w.zero_grad();
+        CHECK(ctx, w.grad.data[1] == 0.0);
+
+        // Intermediate gradients are queryable, and slot buffers survive clear().
+        Parameter<double> W(ramp({8, 8}));
+        const auto X = ramp({16, 8}, 0.05, 0.1);
+        const double* first_buffer = nullptr;
+        std::size_t slots = 0;
+        bool stable = true;
+        for (int step = 0; step < 3; ++step) {
+            tape.clear();
+            W.zero_grad();
+            auto h = ag::relu(ag::matmul(tape.input(X), tape.param(W)));
+            auto loss = ag::sum(h);
+            loss.backward();
+            if (step == 0) {
+                first_buffer = h.grad().data.data();
+                slots = tape.capacity();
+            } else {
+                stable = stable && h.grad().data.data() == first_buffer && tape.capacity() == slots;
+            }
+        }
+        CHECK(ctx, stable);
+
+        // A variable() leaf keeps its own gradient.
+        tape.clear();
+        auto v = tape.variable(tl::Tensor<double>({2}, {3.0, 4.0}));
+        ag::sum(ag::square(v)).backward();
+        CHECK_NEAR(ctx, v.grad().data[1], 8.0, 1e-12);
+    }
+
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        Tape<double> tape;
+        auto c = tape.input(tl::Tensor<double>({2}, {1.0, 2.0}));
+        ag::sum(c * 2.0).backward();     // nothing requires a gradient
+    }));
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        Tape<double> t1, t2;
+        Parameter<double> p(tl::Tensor<double>({1}, {1.0}));
+        t1.param(p) + t2.param(p);
+    }));
+}
@@ -0,0 +1,199 @@
+// tests/test_compare.cpp — Tests for comparison operators, logical ops, mask reductions and BitMask
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+using Bytes = std::vector<std::uint8_t>;
+
+// Byte-mask reference for a packed compare: op applied element by element in double.
+tl::Tensor<std::uint8_t> reference_mask(const tl::Tensor<float>& a, tl::Cmp op, float s) {
+    tl::Tensor<std::uint8_t> m(a.shape);
+    for (std::size_t i = 0; i < a.data.size(); ++i) {
+        const float x = a.data[i];
+        bool r = false;
+        switch (op) {
+            case tl::Cmp::Eq: r = x == s; break;
+            case tl::Cmp::Ne: r = x != s; break;
+            case tl::Cmp::Lt: r = x < s; break;
+            case tl::Cmp::Le: r = x <= s; break;
+            case tl::Cmp::Gt: r = x > s; break;
+            case tl::Cmp::Ge: r = x >= s; break;
+        }
+        m.data[i] = r;
+    }
+    return m;
+}
+
+} // namespace
+
+void run_compare_tests(tl::TestContext& ctx) {
+
+    tl::random::Generator gen(49);
+
+    // ── Operators ─────────────────────────────────────────────────────────────
+    SUITE(ctx, "Compare — operators, broadcasting and scalars");
+
+    {
+        tl::Tensor<float> a({2, 3}, {1, 2, 3, 4, 5, 6});
+        tl::Tensor<float> b({2, 3}, {1, 0, 3, 9, 5, 0});
+        CHECK(ctx, (a == b).data == (Bytes{1, 0, 1, 0, 1, 0}));
+        CHECK(ctx, (a != b).data == (Bytes{0, 1, 0, 1, 0, 1}));
+        CHECK(ctx, (a < b).data == (Bytes{0, 0, 0, 1, 0, 0}));
+        CHECK(ctx, (a <= b).data == (Bytes{1, 0, 1, 1, 1, 0}));
+        CHECK(ctx, (a > b).data == (Bytes{0, 1, 0, 0, 0, 1}));
+        CHECK(ctx, (a >= b).data == (Bytes{1, 1, 1, 0, 1, 1}));
+        CHECK(ctx, (a > b).shape == a.shape);
+
+        // Broadcast a column against a row, and mixed element types.
+        tl::Tensor<int> col({2, 1}, {2, 5});
+        const auto m = a >= col;
+        CHECK(ctx, m.shape == (std::vector<std::size_t>{2, 3}));
+        CHECK(ctx, m.data == (Bytes{0, 1, 1, 0, 1, 1}));
+        tl::Tensor<double> row({3}, {1.5, 2.0, 2.5});
+        CHECK(ctx, (a < row).data == (Bytes{1, 0, 0, 0, 0, 0}));
+        CHECK_THROWS(ctx, std::runtime_error, a == tl::Tensor<float>({2}));
+
+        // Scalars on either side; 3 > a mirrors to a < 3.
+        CHECK(ctx, (a > 3).data == (Bytes{0, 0, 0, 1, 1, 1}));
+        CHECK(ctx, (3 > a).data == (Bytes{1, 1, 0, 0, 0, 0}));
+        CHECK(ctx, (a == 2.0f).data == (Bytes{0, 1, 0, 0, 0, 0}));
+        tl::Tensor<int> ints({3}, {1, 2, 3});
+        CHECK(ctx, (ints > 1.5).data == (Bytes{0, 1, 1}));       // double scalar outranks int
+
+        // A weak scalar is rounded to a 16-bit tensor's type, in the operators and compare_bits alike.
+        tl::Tensor<tl::float16> h({3}, {tl::float16(0.1f), tl::float16(0.5f), tl::float16(0.2f)});
+        CHECK(ctx, (h == 0.1f).data == (Bytes{1, 0, 0}));
+        CHECK(ctx, (0.1f == h).data == (Bytes{1, 0, 0}));
+        CHECK(ctx, tl::compare_bits(h, tl::Cmp::Eq, 0.1f).unpack().data == (h == 0.1f).data);
+        CHECK(ctx, tl::compare_bits(h, tl::Cmp::Le, 0.2).unpack().data == (h <= 0.2).data);
+
+        // Integer scalars beyond a narrow tensor's range decide the compare instead of wrapping.
+        tl::Tensor<std::uint8_t> u({3}, {10, 100, 250});
+        CHECK(ctx, (u < 300).data == (Bytes{1, 1, 1}));
+        CHECK(ctx, (u == 266).data == (Bytes{0, 0, 0}));       // 266 would wrap to 10
+        CHECK(ctx, (u > -1).data == (Bytes{1, 1, 1}));
+        CHECK(ctx, (300 > u).data == (Bytes{1, 1, 1}));
+        CHECK(ctx, (u <= 255).data == (Bytes{1, 1, 1}) && (u >= 250).data == (Bytes{0, 0, 1}));
+        tl::Tensor<std::int8_t> i8({3}, {-100, 0, 100});
+        CHECK(ctx, (i8 > 200).data == (Bytes{0, 0, 0}));
+        CHECK(ctx, (i8 != 200).data == (Bytes{1, 1, 1}));
+        CHECK(ctx, (i8 >= -129).data == (Bytes{1, 1, 1}) && (i8 < -129).data == (Bytes{0, 0, 0}));
+        CHECK(ctx, (i8 == -128).data == (Bytes{0, 0, 0}) && (i8 > 127).data == (Bytes{0, 0, 0}));
+        CHECK(ctx, tl::compare_bits(u, tl::Cmp::Lt, 300).unpack().data == (Bytes{1, 1, 1}));
+        CHECK(ctx, tl::compare_bits(u, tl::Cmp::Ge, -5).count() == 3);
+        CHECK(ctx, tl::compare_bits(i8, tl::Cmp::Gt, 200).count() == 0);
+        CHECK(ctx, tl::compare_bits(i8, tl::Cmp::Ne, -300).count() == 3);
+
+        // NaN compares unequal to everything.
+        tl::Tensor<double> nan({2}, {std::numeric_limits<double>::quiet_NaN(), 1.0});
+        CHECK(ctx, (nan == nan).data == (Bytes{0, 1}));
+        CHECK(ctx, (nan != nan).data == (Bytes{1, 0}));
+        CHECK(ctx, (nan < 2.0).data == (Bytes{0, 1}));
+
+        tl::Tensor<std::complex<double>> z({2}, {{1, 2}, {3, 0}});
+        CHECK(ctx, (z == std::complex<double>(1, 2)).data == (Bytes{1, 0}));
+        CHECK_THROWS(ctx, std::runtime_error, z < z);
+    }
+
+    // ── Logical ops and reductions ────────────────────────────────────────────
+    SUITE(ctx, "Compare — logical ops, any / all / count_nonzero / nonzero");
+
+    {
+        tl::Tensor<int> p({4}, {0, 1, 0, 7});
+        tl::Tensor<float> q({4}, {0, 0, 2, -1});
+        CHECK(ctx, tl::logical_and(p, q).data == (Bytes{0, 0, 0, 1}));
+        CHECK(ctx, tl::logical_or(p, q).data == (Bytes{0, 1, 1, 1}));
+        CHECK(ctx, tl::logical_xor(p, q).data == (Bytes{0, 1, 1, 0}));
+        CHECK(ctx, tl::logical_not(p).data == (Bytes{1, 0, 1, 0}));
+
+        CHECK(ctx, tl::count_nonzero(p) == 2);
+        CHECK(ctx, tl::any(p) && !tl::all(p));
+        CHECK(ctx, tl::all(tl::ones<int>({5})) && !tl::any(tl::zeros<float>({5})));
+        CHECK(ctx, tl::all(tl::Tensor<int>({0})) && !tl::any(tl::Tensor<int>({0})));
+
+        tl::Tensor<int> g({2, 3}, {0, 4, 0, 5, 0, 6});
+        const auto nz = tl::nonzero(g);
+        CHECK(ctx, nz.shape == (std::vector<std::size_t>{3, 2}));
+        CHECK(ctx, nz.data == (std::vector<std::size_t>{0, 1, 1, 0, 1, 2}));
+        CHECK(ctx, tl::nonzero(tl::zeros<int>({4, 4})).shape == (std::vector<std::size_t>{0, 2}));
+
+        // Large inputs cross the parallel and chunking thresholds.
+        const auto big = tl::random::uniform<float>({3, 100000}, -1.0f, 1.0f, gen);
+        const auto pos = big > 0.5f;
+        std::size_t ref = 0;
+        for (float v : big.data) ref += v > 0.5f;
+        CHECK(ctx, tl::count_nonzero(pos) == ref);
+        const auto coords = tl::nonzero(pos);
+        bool ok = coords.shape == (std::vector<std::size_t>{ref, 2});
+        std::size_t prev = 0;
+        for (std::size_t k = 0; ok && k < ref; ++k) {
+            const std::size_t flat = coords.data[2 * k] * 100000 + coords.data[2 * k + 1];
+            ok = big.data[flat] > 0.5f && (k == 0 || flat > prev);
+            prev = flat;
+        }
+        CHECK(ctx, ok);
+        CHECK(ctx, !tl::any(big > 1.0f) && tl::all(big >= -1.0f));
+    }
+
+    // ── Packed masks ──────────────────────────────────────────────────────────
+    SUITE(ctx, "Compare — BitMask and compare_bits");
+
+    {
+        tl::Tensor<std::uint8_t> bytes({2, 35});
+        for (std::size_t i = 0; i < bytes.data.size(); ++i) bytes.data[i] = (i % 3 == 0) ? 1 : 0;
+        const auto bm = tl::BitMask::pack(bytes);
+        CHECK(ctx, bm.words.size() == 2 && bm.size() == 70);
+        CHECK(ctx, bm.unpack().data == bytes.data);
+        CHECK(ctx, bm.count() == tl::count_nonzero(bytes));
+        CHECK(ctx, (~bm).count() == 70 - bm.count());              // tail bits stay clear
+        CHECK(ctx, (~bm & bm).count() == 0 && (~bm | bm).all());
+        CHECK(ctx, (bm ^ bm).count() == 0 && !(bm ^ bm).any());
+        CHECK_THROWS(ctx, std::runtime_error, bm & tl::BitMask({70}));
+
+        tl::BitMask s({10});
+        s.set(3); s.set(9); s.set(3, false);
+        CHECK(ctx, !s.test(3) && s.test(9) && s.count() == 1);
+    }
+
+    {
+        // Every predicate, on lengths around the 64-bit word and SIMD block sizes.
+        bool ok = true;
+        for (std::size_t n : {1u, 7u, 63u, 64u, 65u, 200u, 100003u}) {
+            auto a = tl::random::uniform<float>({n}, -1.0f, 1.0f, gen);
+            if (n > 10) { a.data[3] = 0.25f; a.data[5] = std::numeric_limits<float>::quiet_NaN(); }
+            for (tl::Cmp op : {tl::Cmp::Eq, tl::Cmp::Ne, tl::Cmp::Lt, tl::Cmp::Le, tl::Cmp::Gt, tl::Cmp::Ge}) {
+                const auto bits = tl::compare_bits(a, op, 0.25f);
+                ok = ok && bits.unpack().data == reference_mask(a, op, 0.25f).data;
+            }
+        }
+        CHECK(ctx, ok);
+
+        const auto x = tl::random::uniform<double>({1000}, -1.0, 1.0, gen);
+        const auto y = tl::random::uniform<double>({1000}, -1.0, 1.0, gen);
+        CHECK(ctx, tl::compare_bits(x, tl::Cmp::Lt, y).unpack().data == (x < y).data);
+        CHECK(ctx, tl::compare_bits(x, tl::Cmp::Ge, y).unpack().data == (x >= y).data);
+        tl::Tensor<int> xi({1000});
+        for (std::size_t i = 0; i < xi.data.size(); ++i) xi.data[i] = static_cast<int>(i % 7);
+        CHECK(ctx, tl::compare_bits(xi, tl::Cmp::Eq, 3).count() == tl::count_nonzero(xi == 3));
+        CHECK(ctx, tl::compare_bits(xi, tl::Cmp::Gt, x).unpack().data == (xi > x).data);
+
+        // Broadcast shapes fall back to packing the byte mask.
+        tl::Tensor<double> col({4, 1}, {0.0, 0.5, -0.5, 1.0});
+        tl::Tensor<double> row({1, 5}, {-1.0, -0.25, 0.0, 0.25, 1.0});
+        CHECK(ctx, tl::compare_bits(col, tl::Cmp::Gt, row).unpack().data == (col > row).data);
+    }
+
+    {
+        // masked_select through the bits matches the byte-mask path.
+        const auto v = tl::random::uniform<float>({4, 50000}, -1.0f, 1.0f, gen);
+        const auto keep = tl::compare_bits(v, tl::Cmp::Gt, 0.1f);
+        CHECK(ctx, tl::masked_select(v, keep).data == tl::masked_select(v, v > 0.1f).data);
+        CHECK(ctx, tl::masked_select(v, tl::BitMask(v.shape)).data.empty());
+        CHECK_THROWS(ctx, std::runtime_error, tl::masked_select(v, tl::BitMask({10})));
+    }
+}
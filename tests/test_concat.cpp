@@ -0,0 +1,179 @@
+// tests/test_concat.cpp — Tests for concatenate, stack, narrow / split / chunk slices and pad
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+// base, base + 1, ... laid out in `shape`.
+tl::Tensor<int> iota_tensor(const std::vector<std::size_t>& shape, int base = 0) {
+    tl::Tensor<int> t(shape);
+    for (std::size_t i = 0; i < t.data.size(); ++i) t.data[i] = base + static_cast<int>(i);
+    return t;
+}
+
+// Element at `coords` of a row-major tensor.
+template <typename T>
+T at(const tl::Tensor<T>& t, const std::vector<std::size_t>& coords) {
+    std::size_t off = 0;
+    for (std::size_t d = 0; d < coords.size(); ++d) off += coords[d] * t.strides[d];
+    return t.data[off];
+}
+
+} // namespace
+
+void run_concat_tests(tl::TestContext& ctx) {
+
+    tl::random::Generator gen(50);
+
+    // ── concatenate / stack ───────────────────────────────────────────────────
+    SUITE(ctx, "Concat — concatenate and stack");
+
+    {
+        const auto a = iota_tensor({2, 3});                            // [[0 1 2] [3 4 5]]
+        const auto b = iota_tensor({1, 3}, 10);                        // [[10 11 12]]
+        const auto c = iota_tensor({2, 2}, 20);                        // [[20 21] [22 23]]
+        const auto r0 = tl::concatenate<int>({a, b});
+        CHECK(ctx, r0.shape == (std::vector<std::size_t>{3, 3}));
+        CHECK(ctx, r0.data == (std::vector<int>{0, 1, 2, 3, 4, 5, 10, 11, 12}));
+        const auto r1 = tl::concatenate<int>({a, c}, -1);
+        CHECK(ctx, r1.shape == (std::vector<std::size_t>{2, 5}));
+        CHECK(ctx, r1.data == (std::vector<int>{0, 1, 2, 20, 21, 3, 4, 5, 22, 23}));
+        CHECK(ctx, tl::concatenate<int>({a, tl::Tensor<int>({0, 3})}).data == a.data);
+        CHECK_THROWS(ctx, std::runtime_error, tl::concatenate<int>({a, c}));
+        CHECK_THROWS(ctx, std::runtime_error, tl::concatenate<int>({a, iota_tensor({3})}));
+        CHECK_THROWS(ctx, std::runtime_error, tl::concatenate<int>({a, b}, 2));
+        CHECK_THROWS(ctx, std::runtime_error, tl::concatenate(std::vector<tl::Tensor<int>>{}));
+
+        const auto s0 = tl::stack<int>({a, a});
+        CHECK(ctx, s0.shape == (std::vector<std::size_t>{2, 2, 3}));
+        CHECK(ctx, s0.data == (std::vector<int>{0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5}));
+        const auto s2 = tl::stack<int>({a, iota_tensor({2, 3}, 100)}, -1);
+        CHECK(ctx, s2.shape == (std::vector<std::size_t>{2, 3, 2}));
+        CHECK(ctx, s2.data == (std::vector<int>{0, 100, 1, 101, 2, 102, 3, 103, 4, 104, 5, 105}));
+        CHECK(ctx, tl::stack<int>({a, a}, 1).shape == (std::vector<std::size_t>{2, 2, 3}));
+        CHECK_THROWS(ctx, std::runtime_error, tl::stack<int>({a, b}));
+        CHECK_THROWS(ctx, std::runtime_error, tl::stack<int>({a, a}, 3));
+    }
+
+    {
+        // Mini-batch assembly: 64 samples of [3, 32, 32] stacked, then joined on every axis.
+        std::vector<tl::Tensor<float>> samples;
+        for (int i = 0; i < 64; ++i) samples.push_back(tl::random::uniform<float>({3, 32, 32}, -1.0f, 1.0f, gen));
+        const auto batch = tl::stack(samples);
+        bool ok = batch.shape == (std::vector<std::size_t>{64, 3, 32, 32});
+        for (std::size_t i = 0; ok && i < samples.size(); ++i)
+            ok = std::equal(samples[i].data.begin(), samples[i].data.end(), batch.data.begin() + static_cast<std::ptrdiff_t>(i * 3072));
+        CHECK(ctx, ok);
+
+        // Long runs split across copy blocks, and many short runs along the last axis.
+        for (int axis = 0; axis < 3; ++axis) {
+            const auto x = tl::random::uniform<float>({40, 30, 50}, -1.0f, 1.0f, gen);
+            std::vector<std::size_t> ys = x.shape;
+            ys[static_cast<std::size_t>(axis)] = 7;
+            const auto y = tl::random::uniform<float>(ys, -1.0f, 1.0f, gen);
+            const auto z = tl::concatenate<float>({x, y, x}, axis);
+            const std::size_t len = x.shape[static_cast<std::size_t>(axis)];
+            bool match = z.shape[static_cast<std::size_t>(axis)] == 2 * len + 7;
+            for (std::size_t i = 0; match && i < z.shape[0]; ++i)
+                for (std::size_t j = 0; match && j < z.shape[1]; ++j)
+                    for (std::size_t k = 0; match && k < z.shape[2]; ++k) {
+                        std::vector<std::size_t> c{i, j, k};
+                        std::size_t& ca = c[static_cast<std::size_t>(axis)];
+                        const float v = at(z, c);
+                        if (ca < len) match = v == at(x, c);
+                        else if (ca < len + 7) { ca -= len; match = v == at(y, c); }
+                        else { ca -= len + 7; match = v == at(x, c); }
+                    }
+            CHECK(ctx, match);
+        }
+    }
+
+    // ── narrow / split / chunk ────────────────────────────────────────────────
+    SUITE(ctx, "Concat — zero-copy narrow, split and chunk");
+
+    {
+        auto x = iota_tensor({4, 6});
+        const auto rows = tl::split(x, 3);                              // 3 + 1 rows
+        CHECK(ctx, rows.size() == 2);
+        CHECK(ctx, rows[0].shape == (std::vector<std::size_t>{3, 6}) && rows[1].shape == (std::vector<std::size_t>{1, 6}));
+        CHECK(ctx, rows[1].data_ptr == x.data.data() + 18);             // points into x
+        CHECK(ctx, rows[0].is_contiguous() && rows[1].is_contiguous());
+        CHECK(ctx, rows[1].to_tensor().data == (std::vector<int>{18, 19, 20, 21, 22, 23}));
+
+        const auto cols = tl::split(x, {1, 0, 5}, 1);
+        CHECK(ctx, cols.size() == 3 && cols[1].size() == 0);
+        CHECK(ctx, !cols[2].is_contiguous());
+        CHECK(ctx, cols[0].to_tensor().data == (std::vector<int>{0, 6, 12, 18}));
+        CHECK(ctx, static_cast<int>(cols[2][1][0]) == 7);
+        CHECK(ctx, cols[1].to_tensor().data.empty());
+
+        // Writing through a slice updates the parent.
+        auto mid = tl::narrow(x, 1, 2, 2);
+        mid[3][1] = -1;
+        CHECK(ctx, x.data[3 * 6 + 3] == -1);
+        CHECK_THROWS(ctx, std::runtime_error, tl::narrow(x, 1, 5, 2));
+        CHECK_THROWS(ctx, std::runtime_error, tl::split(x, {2, 2, 3}, 1));
+        CHECK_THROWS(ctx, std::runtime_error, tl::split(x, std::size_t(0)));
+        CHECK_THROWS(ctx, std::out_of_range, mid[4]);
+
+        // torch.chunk: 6 columns in 4 chunks are 2 + 2 + 2; 5 rows in 2 chunks are 3 + 2.
+        const auto& cx = x;
+        const auto ch = tl::chunk(cx, 4, -1);
+        CHECK(ctx, ch.size() == 3 && ch[2].shape == (std::vector<std::size_t>{4, 2}));
+        const auto five = iota_tensor({5, 2});
+        const auto halves = tl::chunk(five, 2);
+        CHECK(ctx, halves.size() == 2 && halves[0].shape[0] == 3 && halves[1].shape[0] == 2);
+        CHECK_THROWS(ctx, std::runtime_error, tl::chunk(five, 0));
+    }
+
+    {
+        // split along a middle axis and concatenate back.
+        const auto x = tl::random::uniform<double>({6, 50, 40}, -1.0, 1.0, gen);
+        std::vector<tl::Tensor<double>> parts;
+        for (const auto& s : tl::split(x, {13, 30, 7}, 1)) parts.push_back(s.to_tensor());
+        CHECK(ctx, parts[1].shape == (std::vector<std::size_t>{6, 30, 40}));
+        CHECK(ctx, tl::concatenate(parts, 1).data == x.data);
+        CHECK(ctx, at(parts[2], {5, 6, 39}) == at(x, {5, 49, 39}));
+
+        std::vector<tl::Tensor<double>> pieces;
+        for (const auto& s : tl::chunk(x, 3, -1)) pieces.push_back(s.to_tensor());
+        CHECK(ctx, pieces.size() == 3 && tl::concatenate(pieces, -1).data == x.data);
+    }
+
+    // ── pad ───────────────────────────────────────────────────────────────────
+    SUITE(ctx, "Concat — constant padding");
+
+    {
+        const auto a = iota_tensor({2, 2}, 1);                         // [[1 2] [3 4]]
+        const auto p = tl::pad(a, {{1, 0}, {0, 2}});
+        CHECK(ctx, p.shape == (std::vector<std::size_t>{3, 4}));
+        CHECK(ctx, p.data == (std::vector<int>{0, 0, 0, 0, 1, 2, 0, 0, 3, 4, 0, 0}));
+        CHECK(ctx, tl::pad(a, 0, 0, 1, 9).data == (std::vector<int>{1, 2, 3, 4, 9, 9}));
+        CHECK(ctx, tl::pad(a, -1, 1, 1, -5).data == (std::vector<int>{-5, 1, 2, -5, -5, 3, 4, -5}));
+        CHECK(ctx, tl::pad(a, {{0, 0}, {0, 0}}).data == a.data);
+        CHECK_THROWS(ctx, std::runtime_error, tl::pad(a, {{1, 1}}));
+
+        // Image-style padding of [N, C, H, W] on the two spatial axes, against the definition.
+        const auto img = tl::random::uniform<float>({4, 3, 33, 65}, -1.0f, 1.0f, gen);
+        const auto padded = tl::pad(img, {{0, 0}, {0, 0}, {2, 3}, {1, 4}}, 0.5f);
+        bool ok = padded.shape == (std::vector<std::size_t>{4, 3, 38, 70});
+        for (std::size_t n = 0; ok && n < 4; ++n)
+            for (std::size_t c = 0; c < 3; ++c)
+                for (std::size_t h = 0; h < 38; ++h)
+                    for (std::size_t w = 0; w < 70; ++w) {
+                        const bool inside = h >= 2 && h < 35 && w >= 1 && w < 66;
+                        const float expect = inside ? at(img, {n, c, h - 2, w - 1}) : 0.5f;
+                        ok = ok && at(padded, {n, c, h, w}) == expect;
+                    }
+        CHECK(ctx, ok);
+
+        // Padding only the leading axis keeps whole rows in one run.
+        const auto big = tl::random::uniform<double>({300, 200}, -1.0, 1.0, gen);
+        const auto tall = tl::pad(big, 0, 5, 0);
+        CHECK(ctx, std::equal(big.data.begin(), big.data.end(), tall.data.begin() + 1000));
+        CHECK(ctx, tl::count_nonzero(tall) == tl::count_nonzero(big));
+    }
+}
@@ -0,0 +1,173 @@
+// tests/test_conv.cpp — Tests for tl::nn::conv2d (im2col, Winograd, autograd backward)
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// Direct seven-loop reference convolution.
+tl::Tensor<double> conv_reference(const tl::Tensor<double>& x, const tl::Tensor<double>& w,
+                                  const tl::Tensor<double>* bias, const tl::nn::Conv2dOptions& o) {
+    const std::size_t N = x.shape[0], C = x.shape[1], H = x.shape[2], W = x.shape[3];
+    const std::size_t O = w.shape[0], Cg = w.shape[1], KH = w.shape[2], KW = w.shape[3];
+    const std::size_t Og = O / o.groups;
+    const std::size_t OH = (H + 2 * o.padding[0] - o.dilation[0] * (KH - 1) - 1) / o.stride[0] + 1;
+    const std::size_t OW = (W + 2 * o.padding[1] - o.dilation[1] * (KW - 1) - 1) / o.stride[1] + 1;
+    tl::Tensor<double> y({N, O, OH, OW});
+    for (std::size_t n = 0; n < N; ++n)
+        for (std::size_t oc = 0; oc < O; ++oc)
+            for (std::size_t oh = 0; oh < OH; ++oh)
+                for (std::size_t ow = 0; ow < OW; ++ow) {
+                    double acc = bias ? bias->data[oc] : 0.0;
+                    for (std::size_t c = 0; c < Cg; ++c)
+                        for (std::size_t kh = 0; kh < KH; ++kh)
+                            for (std::size_t kw = 0; kw < KW; ++kw) {
+                                const long ih = long(oh * o.stride[0] + kh * o.dilation[0]) - long(o.padding[0]);
+                                const long iw = long(ow * o.stride[1] + kw * o.dilation[1]) - long(o.padding[1]);
+                                if (ih < 0 || iw < 0 || ih >= long(H) || iw >= long(W)) continue;
+                                const std::size_t ic = (oc / Og) * Cg + c;
+                                acc += w.data[((oc * Cg + c) * KH + kh) * KW + kw] *
+                                       x.data[((n * C + ic) * H + std::size_t(ih)) * W + std::size_t(iw)];
+                            }
+                    y.data[((n * O + oc) * OH + oh) * OW + ow] = acc;
+                }
+    return y;
+}
+
+tl::Tensor<double> pattern(std::vector<std::size_t> shape, std::size_t salt) {
+    tl::Tensor<double> t(shape);
+    for (std::size_t i = 0; i < t.data.size(); ++i)
+        t.data[i] = std::sin(0.37 * static_cast<double>(i + salt)) + 0.1 * static_cast<double>((i * 5 + salt) % 7);
+    return t;
+}
+
+} // namespace
+
+void run_conv_tests(tl::TestContext& ctx) {
+
+    using tl::nn::ConvAlgorithm;
+    using tl::nn::Conv2dOptions;
+
+    // ── im2col + GEMM ─────────────────────────────────────────────────────────
+    SUITE(ctx, "Conv2d — im2col against direct convolution");
+
+    {
+        const auto x = pattern({2, 4, 9, 8}, 1);
+        const auto bias = pattern({6}, 3);
+        struct Case { std::size_t k, s, p, d, g; };
+        const Case cases[] = {{3, 1, 0, 1, 1}, {3, 2, 1, 1, 1}, {5, 1, 2, 1, 2}, {3, 1, 2, 2, 1}, {1, 1, 0, 1, 2}, {2, 3, 1, 1, 2}};
+        double worst = 0.0;
+        for (const auto& c : cases) {
+            Conv2dOptions o;
+            o.stride = {c.s, c.s};
+            o.padding = {c.p, c.p};
+            o.dilation = {c.d, c.d};
+            o.groups = c.g;
+            o.algorithm = ConvAlgorithm::Im2col;
+            const auto w = pattern({6, 4 / c.g, c.k, c.k}, c.k + c.g);
+            worst = std::max(worst, tl::max_abs_diff(tl::nn::conv2d(x, w, bias, o), conv_reference(x, w, &bias, o)));
+        }
+        CHECK(ctx, worst < 1e-12);
+
+        // Asymmetric stride / padding and a depthwise (groups == C) layer.
+        Conv2dOptions o;
+        o.stride = {2, 1};
+        o.padding = {0, 1};
+        o.groups = 4;
+        const auto w = pattern({4, 1, 3, 2}, 9);
+        const auto y = tl::nn::conv2d(x, w, o);
+        CHECK(ctx, (y.shape == std::vector<std::size_t>{2, 4, 4, 9}));
+        CHECK(ctx, tl::max_abs_diff(y, conv_reference(x, w, nullptr, o)) < 1e-12);
+    }
+
+    // ── Winograd F(2x2, 3x3) ──────────────────────────────────────────────────
+    SUITE(ctx, "Conv2d — Winograd F(2x2,3x3)");
+
+    {
+        double worst = 0.0;
+        for (std::size_t pad : {0, 1}) {
+            for (std::size_t groups : {1, 3}) {
+                const auto x = pattern({2, 6, 7, 10}, pad + groups);   // odd height exercises edge tiles
+                const auto w = pattern({9, 6 / groups, 3, 3}, 4);
+                const auto bias = pattern({9}, 2);
+                Conv2dOptions o;
+                o.padding = {pad, pad};
+                o.groups = groups;
+                o.algorithm = ConvAlgorithm::Winograd;
+                worst = std::max(worst, tl::max_abs_diff(tl::nn::conv2d(x, w, bias, o), conv_reference(x, w, &bias, o)));
+                o.algorithm = ConvAlgorithm::Auto;
+                worst = std::max(worst, tl::max_abs_diff(tl::nn::conv2d(x, w, bias, o), conv_reference(x, w, &bias, o)));
+            }
+        }
+        CHECK(ctx, worst < 1e-11);
+
+        // float input stays close to the double reference.
+        const auto xd = pattern({1, 3, 12, 12}, 0);
+        const auto wd = pattern({4, 3, 3, 3}, 5);
+        tl::Tensor<float> xf(xd.shape), wf(wd.shape);
+        for (std::size_t i = 0; i < xd.data.size(); ++i) xf.data[i] = static_cast<float>(xd.data[i]);
+        for (std::size_t i = 0; i < wd.data.size(); ++i) wf.data[i] = static_cast<float>(wd.data[i]);
+        const auto yf = tl::nn::conv2d(xf, wf);
+        const auto yd = conv_reference(xd, wd, nullptr, {});
+        double err = 0.0;
+        for (std::size_t i = 0; i < yd.data.size(); ++i) err = std::max(err, std::abs(yd.data[i] - double(yf.data[i])));
+        CHECK(ctx, err < 1e-4);
+    }
+
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        Conv2dOptions o;
+        o.stride = {2, 2};
+        o.algorithm = ConvAlgorithm::Winograd;
+        tl::nn::conv2d(tl::Tensor<double>({1, 1, 8, 8}), tl::Tensor<double>({1, 1, 3, 3}), o);
+    }));
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        Conv2dOptions o;
+        o.groups = 2;
+        tl::nn::conv2d(tl::Tensor<double>({1, 3, 8, 8}), tl::Tensor<double>({2, 1, 3, 3}), o);
+    }));
+    CHECK_THROWS(ctx, std::runtime_error,
+                 tl::nn::conv2d(tl::Tensor<double>({1, 1, 2, 2}), tl::Tensor<double>({1, 1, 3, 3})));
+
+    // ── Backward pass ─────────────────────────────────────────────────────────
+    SUITE(ctx, "Conv2d — autograd gradients");
+
+    {
+        namespace ag = tl::autograd;
+        ag::Parameter<double> X(pattern({2, 4, 6, 5}, 7));
+        ag::Parameter<double> W(pattern({4, 2, 3, 3}, 8));
+        ag::Parameter<double> B(pattern({4}, 6));
+        const auto target = pattern({2, 4, 3, 3}, 11);
+        Conv2dOptions o;
+        o.stride = {2, 2};
+        o.padding = {1, 1};
+        o.groups = 2;
+
+        auto loss = [&](ag::Tape<double>& tp) {
+            auto y = ag::conv2d(tp.param(X), tp.param(W), tp.param(B), o);
+            return ag::mean(ag::square(ag::tanh(y) - tp.input(target)));
+        };
+        auto check = [&](ag::Parameter<double>& p) {
+            ag::Tape<double> tape;
+            X.zero_grad(); W.zero_grad(); B.zero_grad();
+            loss(tape).backward();
+            const auto analytic = p.grad;
+            double worst = 0.0;
+            for (std::size_t i = 0; i < p.value.data.size(); ++i) {
+                const double v = p.value.data[i];
+                p.value.data[i] = v + 1e-6;
+                tape.clear();
+                const double up = loss(tape).value().data[0];
+                p.value.data[i] = v - 1e-6;
+                tape.clear();
+                const double down = loss(tape).value().data[0];
+                p.value.data[i] = v;
+                worst = std::max(worst, std::abs(analytic.data[i] - (up - down) / 2e-6));
+            }
+            return worst;
+        };
+        CHECK(ctx, check(X) < 1e-8);
+        CHECK(ctx, check(W) < 1e-8);
+        CHECK(ctx, check(B) < 1e-8);
+    }
+}
@@ -0,0 +1,136 @@
+// tests/test_convolve.cpp — Tests for tl::fft::convolve / correlate (modes, direct and overlap-add paths)
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+// Full 2-D convolution by definition, cropped to `mode`; 1-D inputs are single rows.
+std::vector<double> naive_convolve(const tl::Tensor<double>& x, const tl::Tensor<double>& k, tl::fft::ConvMode mode) {
+    const bool one_d = x.shape.size() == 1;
+    const std::size_t R = one_d ? 1 : x.shape[0], N = x.shape.back(), KR = one_d ? 1 : k.shape[0], KC = k.shape.back();
+    const std::size_t FR = R + KR - 1, FC = N + KC - 1;
+    std::vector<double> full(FR * FC, 0.0);
+    for (std::size_t i = 0; i < R; ++i)
+        for (std::size_t j = 0; j < N; ++j)
+            for (std::size_t a = 0; a < KR; ++a)
+                for (std::size_t b = 0; b < KC; ++b) full[(i + a) * FC + j + b] += x.data[i * N + j] * k.data[a * KC + b];
+    std::size_t r0 = 0, c0 = 0, rows = FR, cols = FC;
+    if (mode == tl::fft::ConvMode::Same) { r0 = (KR - 1) / 2; c0 = (KC - 1) / 2; rows = R; cols = N; }
+    if (mode == tl::fft::ConvMode::Valid) { r0 = KR - 1; c0 = KC - 1; rows = R - KR + 1; cols = N - KC + 1; }
+    std::vector<double> out;
+    for (std::size_t i = 0; i < rows; ++i)
+        for (std::size_t j = 0; j < cols; ++j) out.push_back(full[(r0 + i) * FC + c0 + j]);
+    return out;
+}
+
+double conv_err(const std::vector<double>& a, const std::vector<double>& b) {
+    if (a.size() != b.size()) return 1e30;
+    double m = 0.0;
+    for (std::size_t i = 0; i < a.size(); ++i) m = std::max(m, std::abs(a[i] - b[i]));
+    return m;
+}
+
+} // namespace
+
+void run_convolve_tests(tl::TestContext& ctx) {
+
+    namespace fft = tl::fft;
+    using fft::ConvMode;
+    using fft::ConvMethod;
+    tl::random::Generator gen(47);
+
+    // ── Small exact cases ─────────────────────────────────────────────────────
+    SUITE(ctx, "Convolve — modes and correlation");
+
+    {
+        tl::Tensor<double> x({4}, {1, 2, 3, 4});
+        tl::Tensor<double> k({3}, {1, 0, -1});
+        CHECK(ctx, fft::convolve(x, k).data == (std::vector<double>{1, 2, 2, 2, -3, -4}));
+        CHECK(ctx, fft::convolve(x, k, ConvMode::Same).data == (std::vector<double>{2, 2, 2, -3}));
+        CHECK(ctx, fft::convolve(x, k, ConvMode::Valid).data == (std::vector<double>{2, 2}));
+        CHECK(ctx, fft::correlate(x, k).data == (std::vector<double>{-1, -2, -2, -2, 3, 4}));
+        CHECK(ctx, fft::correlate(x, k, ConvMode::Valid).data == (std::vector<double>{-2, -2}));
+        CHECK(ctx, fft::convolve(x, k, ConvMode::Full, ConvMethod::FFT).shape == std::vector<std::size_t>{6});
+        CHECK(ctx, conv_err(fft::convolve(x, k, ConvMode::Full, ConvMethod::FFT).data, {1, 2, 2, 2, -3, -4}) < 1e-14);
+
+        // Kernel longer than the signal.
+        tl::Tensor<double> one({1}, {2});
+        CHECK(ctx, fft::convolve(one, x, ConvMode::Same).data == (std::vector<double>{4}));
+        CHECK_THROWS(ctx, std::runtime_error, fft::convolve(k, x, ConvMode::Valid));
+        CHECK_THROWS(ctx, std::runtime_error, fft::convolve(x, tl::Tensor<double>({1, 3})));
+        CHECK_THROWS(ctx, std::runtime_error, fft::convolve(x, tl::Tensor<double>({0})));
+    }
+
+    // ── Direct and FFT paths against the definition ───────────────────────────
+    SUITE(ctx, "Convolve — direct and overlap-add against the definition");
+
+    {
+        bool direct_ok = true, fft_ok = true;
+        const std::vector<std::pair<std::size_t, std::size_t>> sizes = {{1, 1}, {7, 3}, {50, 50}, {300, 17}, {1000, 129}, {2000, 600}, {5, 40}};
+        for (const auto& [n, m] : sizes) {
+            const auto x = tl::random::uniform<double>({n}, -1.0, 1.0, gen);
+            const auto k = tl::random::uniform<double>({m}, -1.0, 1.0, gen);
+            for (ConvMode mode : {ConvMode::Full, ConvMode::Same, ConvMode::Valid}) {
+                if (mode == ConvMode::Valid && m > n) continue;
+                const auto ref = naive_convolve(x, k, mode);
+                direct_ok = direct_ok && conv_err(fft::convolve(x, k, mode, ConvMethod::Direct).data, ref) < 1e-12;
+                fft_ok = fft_ok && conv_err(fft::convolve(x, k, mode, ConvMethod::FFT).data, ref) < 1e-10;
+            }
+        }
+        CHECK(ctx, direct_ok);
+        CHECK(ctx, fft_ok);
+    }
+
+    {
+        bool direct_ok = true, fft_ok = true, corr_ok = true;
+        const std::vector<std::vector<std::size_t>> shapes = {{9, 11}, {3, 5}, {40, 70}, {1, 9}, {25, 4}};
+        const auto x = tl::random::uniform<double>({40, 70}, -1.0, 1.0, gen);
+        for (const auto& ks : shapes) {
+            const auto k = tl::random::uniform<double>(ks, -1.0, 1.0, gen);
+            for (ConvMode mode : {ConvMode::Full, ConvMode::Same, ConvMode::Valid}) {
+                const auto ref = naive_convolve(x, k, mode);
+                direct_ok = direct_ok && conv_err(fft::convolve(x, k, mode, ConvMethod::Direct).data, ref) < 1e-12;
+                fft_ok = fft_ok && conv_err(fft::convolve(x, k, mode, ConvMethod::FFT).data, ref) < 1e-10;
+            }
+            // correlate(x, k) == convolve(x, k flipped on both axes).
+            tl::Tensor<double> kf(ks);
+            std::reverse_copy(k.data.begin(), k.data.end(), kf.data.begin());
+            corr_ok = corr_ok && conv_err(fft::correlate(x, k, ConvMode::Same, ConvMethod::FFT).data,
+                                          naive_convolve(x, kf, ConvMode::Same)) < 1e-10;
+        }
+        CHECK(ctx, direct_ok);
+        CHECK(ctx, fft_ok);
+        CHECK(ctx, corr_ok);
+        const auto y = fft::convolve(x, tl::Tensor<double>({3, 4}), ConvMode::Full);
+        CHECK(ctx, y.shape == (std::vector<std::size_t>{42, 73}));
+    }
+
+    {
+        // Many overlap-add tiles along a long signal, in single precision.
+        const auto xd = tl::random::uniform<double>({100000}, -1.0, 1.0, gen);
+        const auto kd = tl::random::uniform<double>({1000}, -1.0, 1.0, gen);
+        tl::Tensor<float> xf(xd.shape), kf(kd.shape);
+        for (std::size_t i = 0; i < xd.data.size(); ++i) xf.data[i] = static_cast<float>(xd.data[i]);
+        for (std::size_t i = 0; i < kd.data.size(); ++i) kf.data[i] = static_cast<float>(kd.data[i]);
+        const auto yf = fft::convolve(xf, kf, ConvMode::Same, ConvMethod::FFT);
+        const auto yd = fft::convolve(xd, kd, ConvMode::Same, ConvMethod::Direct);
+        double err = 0.0;
+        for (std::size_t i = 0; i < yd.data.size(); ++i) err = std::max(err, std::abs(static_cast<double>(yf.data[i]) - yd.data[i]));
+        CHECK(ctx, err < 1e-3);
+        CHECK(ctx, conv_err(fft::convolve(xd, kd, ConvMode::Valid, ConvMethod::FFT).data,
+                            fft::convolve(xd, kd, ConvMode::Valid, ConvMethod::Direct).data) < 1e-9);
+    }
+
+    // ── Method selection ──────────────────────────────────────────────────────
+    SUITE(ctx, "Convolve — cost model");
+
+    {
+        CHECK(ctx, fft::conv_method({100000}, {5}) == ConvMethod::Direct);
+        CHECK(ctx, fft::conv_method({100000}, {4096}) == ConvMethod::FFT);
+        CHECK(ctx, fft::conv_method({512, 512}, {3, 3}) == ConvMethod::Direct);
+        CHECK(ctx, fft::conv_method({512, 512}, {64, 64}) == ConvMethod::FFT);
+    }
+}
@@ -0,0 +1,163 @@
+// tests/test_einsum.cpp — Tests for tl::einsum (parsing, contraction order, lowering)
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace {
+
+// Direct evaluation: one nested loop over every label, accumulated in double.
+tl::Tensor<float> naive_einsum(const std::vector<std::string>& ins, const std::string& out,
+                               const std::vector<const tl::Tensor<float>*>& ops) {
+    std::string labels;
+    std::vector<std::size_t> dim(128, 1);
+    for (std::size_t t = 0; t < ins.size(); ++t)
+        for (std::size_t d = 0; d < ins[t].size(); ++d) {
+            if (labels.find(ins[t][d]) == std::string::npos) labels += ins[t][d];
+            dim[static_cast<unsigned char>(ins[t][d])] = ops[t]->shape[d];
+        }
+    std::vector<std::size_t> out_shape;
+    for (char c : out) out_shape.push_back(dim[static_cast<unsigned char>(c)]);
+    std::vector<double> acc(1, 0.0);
+    std::size_t out_n = 1, total = 1;
+    for (auto d : out_shape) out_n *= d;
+    for (char c : labels) total *= dim[static_cast<unsigned char>(c)];
+    acc.assign(out_n, 0.0);
+    std::vector<std::size_t> val(128, 0);
+    for (std::size_t f = 0; f < total; ++f) {
+        std::size_t rem = f;
+        for (std::size_t i = labels.size(); i-- > 0;) {
+            const auto c = static_cast<unsigned char>(labels[i]);
+            val[c] = rem % dim[c];
+            rem /= dim[c];
+        }
+        double p = 1.0;
+        for (std::size_t t = 0; t < ins.size(); ++t) {
+            std::size_t off = 0;
+            for (std::size_t d = 0; d < ins[t].size(); ++d) off += val[static_cast<unsigned char>(ins[t][d])] * ops[t]->strides[d];
+            p *= ops[t]->data[off];
+        }
+        std::size_t o = 0;
+        for (char c : out) o = o * dim[static_cast<unsigned char>(c)] + val[static_cast<unsigned char>(c)];
+        acc[o] += p;
+    }
+    tl::Tensor<float> r(out_shape);
+    for (std::size_t i = 0; i < out_n; ++i) r.data[i] = static_cast<float>(acc[i]);
+    return r;
+}
+
+} // namespace
+
+void run_einsum_tests(tl::TestContext& ctx) {
+
+    tl::random::Generator gen(45);
+    auto rnd = [&](std::vector<std::size_t> shape) { return tl::random::uniform<float>(shape, -1.0f, 1.0f, gen); };
+
+    // ── Two-operand contractions ──────────────────────────────────────────────
+    SUITE(ctx, "Einsum — pairwise contractions");
+
+    {
+        const auto A = rnd({7, 5}), B = rnd({5, 9});
+        CHECK(ctx, tl::max_abs_diff(tl::einsum("ij,jk->ik", A, B), tl::linalg::matmul(A, B)) < 1e-5);
+        CHECK(ctx, tl::max_abs_diff(tl::einsum("ij,jk", A, B), tl::linalg::matmul(A, B)) < 1e-5);
+        CHECK(ctx, tl::max_abs_diff(tl::einsum("ij,jk->ki", A, B), tl::linalg::transpose(tl::linalg::matmul(A, B))) < 1e-5);
+
+        // Transposed operands are read in place through their strides.
+        const auto At = tl::linalg::transpose(A), Bt = tl::linalg::transpose(B);
+        CHECK(ctx, tl::max_abs_diff(tl::einsum("ji,kj->ik", At, Bt), tl::linalg::matmul(A, B)) < 1e-5);
+    }
+
+    {
+        const auto A = rnd({3, 4, 6}), B = rnd({3, 6, 5});
+        CHECK(ctx, tl::max_abs_diff(tl::einsum("bij,bjk->bik", A, B), naive_einsum({"bij", "bjk"}, "bik", {&A, &B})) < 1e-5);
+        CHECK(ctx, tl::max_abs_diff(tl::einsum("bij,bjk->ik", A, B), naive_einsum({"bij", "bjk"}, "ik", {&A, &B})) < 1e-5);
+
+        // Attention scores: batch and head labels, contraction over the last axis of both.
+        const auto Q = rnd({2, 3, 5, 8}), K = rnd({2, 3, 7, 8});
+        CHECK(ctx, tl::max_abs_diff(tl::einsum("bhqd,bhkd->bhqk", Q, K), naive_einsum({"bhqd", "bhkd"}, "bhqk", {&Q, &K})) < 1e-5);
+        // Batch label in the middle of one operand forces a pack; the result is the same.
+        const auto Kp = rnd({2, 7, 3, 8});
+        CHECK(ctx, tl::max_abs_diff(tl::einsum("bhqd,bkhd->hbqk", Q, Kp), naive_einsum({"bhqd", "bkhd"}, "hbqk", {&Q, &Kp})) < 1e-5);
+
+        const auto x = rnd({4}), y = rnd({6});
+        CHECK(ctx, tl::max_abs_diff(tl::einsum("i,j->ij", x, y), naive_einsum({"i", "j"}, "ij", {&x, &y})) < 1e-6);
+    }
+
+    // ── Single operand ────────────────────────────────────────────────────────
+    SUITE(ctx, "Einsum — transposes, diagonals and reductions");
+
+    {
+        const auto S = rnd({5, 5}), T = rnd({2, 3, 4});
+        CHECK(ctx, tl::max_abs_diff(tl::einsum("ii->i", S), naive_einsum({"ii"}, "i", {&S})) == 0.0);
+        CHECK_NEAR(ctx, tl::einsum("ii", S).data[0], tl::linalg::trace(S), 1e-5);
+        CHECK(ctx, tl::einsum("ii->", S).shape.empty());
+        CHECK(ctx, tl::max_abs_diff(tl::einsum("ijk->kji", T), naive_einsum({"ijk"}, "kji", {&T})) == 0.0);
+        CHECK(ctx, tl::max_abs_diff(tl::einsum("ijk->j", T), naive_einsum({"ijk"}, "j", {&T})) < 1e-6);
+        CHECK(ctx, tl::max_abs_diff(tl::einsum("ijk", T), T) == 0.0);
+    }
+
+    // ── Multi-operand expressions and ordering ────────────────────────────────
+    SUITE(ctx, "Einsum — contraction order");
+
+    {
+        const auto x = rnd({6}), M = rnd({6, 9}), y = rnd({9});
+        CHECK(ctx, tl::max_abs_diff(tl::einsum("i,ij,j->", x, M, y), naive_einsum({"i", "ij", "j"}, "", {&x, &M, &y})) < 1e-5);
+
+        const auto a = rnd({4, 5}), b = rnd({5, 6}), c = rnd({6, 3}), d = rnd({3, 4});
+        CHECK(ctx, tl::max_abs_diff(tl::einsum("ab,bc,cd,da->", a, b, c, d),
+                              naive_einsum({"ab", "bc", "cd", "da"}, "", {&a, &b, &c, &d})) < 1e-4);
+        CHECK(ctx, tl::max_abs_diff(tl::einsum("ab,bc,cd->ad", a, b, c),
+                              naive_einsum({"ab", "bc", "cd"}, "ad", {&a, &b, &c})) < 1e-5);
+    }
+
+    {
+        // i, k large and j, l small: contracting the two small-result operands first wins.
+        const auto path = tl::einsum_path("ij,jk,kl->il", {{64, 2}, {2, 64}, {64, 2}});
+        CHECK(ctx, path.pairs.size() == 2);
+        CHECK(ctx, path.pairs[0] == std::make_pair(std::size_t(1), std::size_t(2)));
+        CHECK(ctx, path.flops == 2.0 * 2 * 64 * 2 + 2.0 * 64 * 2 * 2);
+        CHECK(ctx, path.naive_flops == 3.0 * 64 * 2 * 64 * 2);
+
+        // Operands sharing no label are contracted last.
+        const auto outer = tl::einsum_path("i,j,ij->", {{8}, {8}, {8, 8}});
+        CHECK(ctx, outer.pairs[0].second == 2);
+    }
+
+    // ── Element types ─────────────────────────────────────────────────────────
+    SUITE(ctx, "Einsum — element types");
+
+    {
+        tl::Tensor<double> A({2, 2}, {1, 2, 3, 4}), B({2, 2}, {5, 6, 7, 8});
+        const auto C = tl::einsum("ij,jk->ik", A, B);
+        CHECK(ctx, C.data == (std::vector<double>{19, 22, 43, 50}));
+
+        tl::Tensor<int> I({2, 3}, {1, 2, 3, 4, 5, 6});
+        CHECK(ctx, tl::einsum("ij->", I).data[0] == 21);
+
+        const auto Af = rnd({8, 16}), Bf = rnd({16, 4});
+        tl::Tensor<tl::float16> Ah(Af.shape), Bh(Bf.shape);
+        for (std::size_t i = 0; i < Af.data.size(); ++i) Ah.data[i] = tl::float16(Af.data[i]);
+        for (std::size_t i = 0; i < Bf.data.size(); ++i) Bh.data[i] = tl::float16(Bf.data[i]);
+        const auto Ch = tl::einsum("ij,jk->ik", Ah, Bh);
+        const auto Cf = tl::linalg::matmul(Af, Bf);
+        double worst = 0.0;
+        for (std::size_t i = 0; i < Cf.data.size(); ++i)
+            worst = std::max(worst, std::abs(static_cast<double>(static_cast<float>(Ch.data[i])) - Cf.data[i]));
+        CHECK(ctx, worst < 2e-2);
+    }
+
+    // ── Errors ────────────────────────────────────────────────────────────────
+    SUITE(ctx, "Einsum — errors");
+
+    {
+        const auto A = rnd({3, 4}), B = rnd({5, 6});
+        CHECK_THROWS(ctx, std::runtime_error, tl::einsum("ij,jk->ik", A, B));
+        CHECK_THROWS(ctx, std::runtime_error, tl::einsum("ij,jk->ik", A));
+        CHECK_THROWS(ctx, std::runtime_error, tl::einsum("ijk->i", A));
+        CHECK_THROWS(ctx, std::runtime_error, tl::einsum("ij->iz", A));
+        CHECK_THROWS(ctx, std::runtime_error, tl::einsum("ij->ii", A));
+        CHECK_THROWS(ctx, std::runtime_error, tl::einsum("i1->i", A));
+    }
+}
@@ -0,0 +1,192 @@
+// tests/test_fft.cpp — Tests for complex tensors and tl::fft (plans, 1-D / N-D / real transforms)
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+namespace {
+
+using cd = std::complex<double>;
+
+// O(n^2) reference in long double.
+std::vector<cd> naive_dft(const std::vector<cd>& x, bool inverse = false) {
+    const std::size_t n = x.size();
+    std::vector<cd> X(n);
+    const long double pi = 3.141592653589793238462643383279L;
+    for (std::size_t k = 0; k < n; ++k) {
+        long double re = 0, im = 0;
+        for (std::size_t j = 0; j < n; ++j) {
+            const long double a = (inverse ? 2 : -2) * pi * static_cast<long double>((j * k) % n) / n;
+            re += x[j].real() * std::cos(a) - x[j].imag() * std::sin(a);
+            im += x[j].real() * std::sin(a) + x[j].imag() * std::cos(a);
+        }
+        X[k] = cd(static_cast<double>(re), static_cast<double>(im));
+    }
+    return X;
+}
+
+template <typename C>
+double cmax_diff(const std::vector<C>& a, const std::vector<C>& b) {
+    if (a.size() != b.size()) return 1e30;
+    double m = 0.0;
+    for (std::size_t i = 0; i < a.size(); ++i) m = std::max(m, static_cast<double>(std::abs(a[i] - b[i])));
+    return m;
+}
+
+tl::Tensor<cd> complex_signal(std::vector<std::size_t> shape, tl::random::Generator& gen) {
+    return tl::make_complex(tl::random::uniform<double>(shape, -1.0, 1.0, gen), tl::random::uniform<double>(shape, -1.0, 1.0, gen));
+}
+
+} // namespace
+
+void run_fft_tests(tl::TestContext& ctx) {
+
+    namespace fft = tl::fft;
+    tl::random::Generator gen(46);
+
+    // ── Complex tensors ───────────────────────────────────────────────────────
+    SUITE(ctx, "Complex — arithmetic, promotion and parts");
+
+    {
+        tl::Tensor<cd> a({2, 2}, {cd(1, 2), cd(3, -1), cd(0, 1), cd(-2, 0)});
+        tl::Tensor<cd> row({2}, {cd(0, 1), cd(2, 0)});
+        const auto p = a * row;
+        CHECK(ctx, p.data[0] == cd(-2, 1) && p.data[1] == cd(6, -2) && p.data[2] == cd(-1, 0));
+        CHECK(ctx, (a + row).data[3] == cd(0, 0));
+        CHECK(ctx, (a / cd(0, 1)).data[0] == cd(2, -1));
+        CHECK(ctx, tl::sum(a) == cd(2, 2));
+
+        tl::Tensor<float> r({2}, {2.0f, -1.0f});
+        const auto m = a * r;                                // complex<double> * float -> complex<double>
+        CHECK(ctx, (std::is_same_v<decltype(m), const tl::Tensor<cd>>));
+        CHECK(ctx, m.data[1] == cd(-3, 1));
+        const auto s = r * std::complex<float>(0, 1);        // complex scalar outranks float
+        CHECK(ctx, (std::is_same_v<decltype(s), const tl::Tensor<std::complex<float>>>));
+        CHECK(ctx, s.data[0] == std::complex<float>(0, 2));
+
+        CHECK(ctx, tl::real(a).data == (std::vector<double>{1, 3, 0, -2}));
+        CHECK(ctx, tl::imag(a).data == (std::vector<double>{2, -1, 1, 0}));
+        CHECK(ctx, tl::conj(a).data[0] == cd(1, -2));
+        CHECK_NEAR(ctx, tl::abs(a).data[1], std::sqrt(10.0), 1e-12);
+        CHECK_NEAR(ctx, tl::angle(a).data[3], 3.141592653589793, 1e-12);
+        CHECK(ctx, tl::to_complex(r).data[1] == std::complex<float>(-1, 0));
+        CHECK_THROWS(ctx, std::runtime_error, tl::make_complex(r, tl::Tensor<float>({3})));
+    }
+
+    // ── Plans ─────────────────────────────────────────────────────────────────
+    SUITE(ctx, "FFT — plans and cache");
+
+    {
+        CHECK(ctx, fft::plan<double>(48) == fft::plan<double>(48));
+        CHECK(ctx, fft::plan<float>(60)->factors() == (std::vector<std::size_t>{4, 3, 5}));
+        CHECK(ctx, !fft::plan<double>(7 * 11 * 13)->uses_bluestein());
+        CHECK(ctx, fft::plan<double>(97)->uses_bluestein());
+        CHECK(ctx, fft::plan<double>(2 * 17)->uses_bluestein());
+        CHECK_THROWS(ctx, std::runtime_error, fft::FFTPlan<double>(0));
+    }
+
+    // ── 1-D complex transforms ────────────────────────────────────────────────
+    SUITE(ctx, "FFT — complex transforms against a direct DFT");
+
+    {
+        bool all_ok = true, round_ok = true;
+        for (std::size_t n : {1, 2, 3, 4, 5, 6, 7, 8, 9, 12, 15, 16, 30, 34, 49, 60, 64, 97, 100, 128, 210, 1000, 1024}) {
+            const auto x = complex_signal({n}, gen);
+            const auto X = fft::fft(x);
+            const double err = cmax_diff(X.data, naive_dft(x.data));
+            if (err > 1e-11 * static_cast<double>(n)) all_ok = false;
+            if (cmax_diff(fft::ifft(X).data, x.data) > 1e-13 * static_cast<double>(n)) round_ok = false;
+        }
+        CHECK(ctx, all_ok);
+        CHECK(ctx, round_ok);
+    }
+
+    {
+        // Single precision, and a real tensor promoted on the way in.
+        const auto xd = tl::random::uniform<double>({360}, -1.0, 1.0, gen);
+        tl::Tensor<float> xf(xd.shape);
+        for (std::size_t i = 0; i < xd.data.size(); ++i) xf.data[i] = static_cast<float>(xd.data[i]);
+        const auto Xf = fft::fft(xf);
+        const auto ref = naive_dft(tl::to_complex(xd).data);
+        double err = 0.0;
+        for (std::size_t i = 0; i < ref.size(); ++i) err = std::max(err, std::abs(cd(Xf.data[i]) - ref[i]));
+        CHECK(ctx, err < 1e-4);
+
+        // Parseval: sum |x|^2 = sum |X|^2 / n.
+        double ex = 0.0, eX = 0.0;
+        for (double v : xd.data) ex += v * v;
+        for (const auto& v : fft::fft(xd).data) eX += std::norm(v);
+        CHECK_NEAR(ctx, ex, eX / 360.0, 1e-9);
+    }
+
+    // ── Real transforms ───────────────────────────────────────────────────────
+    SUITE(ctx, "FFT — rfft / irfft");
+
+    {
+        bool ok = true, round_ok = true;
+        for (std::size_t n : {1, 2, 5, 8, 9, 34, 100, 97, 256}) {
+            const auto x = tl::random::uniform<double>({n}, -1.0, 1.0, gen);
+            const auto X = fft::rfft(x);
+            const auto full = fft::fft(x);
+            if (X.shape != std::vector<std::size_t>{n / 2 + 1}) ok = false;
+            for (std::size_t k = 0; k <= n / 2; ++k) ok = ok && std::abs(X.data[k] - full.data[k]) < 1e-11 * static_cast<double>(n);
+            if (cmax_diff(fft::irfft(X, n).data, x.data) > 1e-13 * static_cast<double>(n)) round_ok = false;
+        }
+        CHECK(ctx, ok);
+        CHECK(ctx, round_ok);
+
+        // Default length is 2 * (bins - 1); the imaginary parts of DC / Nyquist are ignored.
+        tl::Tensor<cd> X({3}, {cd(4, 5), cd(0, 0), cd(0, 7)});
+        const auto x = fft::irfft(X);
+        CHECK(ctx, x.shape == std::vector<std::size_t>{4});
+        CHECK(ctx, cmax_diff(x.data, std::vector<double>{1, 1, 1, 1}) < 1e-15);
+    }
+
+    // ── Axes and N-D ──────────────────────────────────────────────────────────
+    SUITE(ctx, "FFT — axes and N-D transforms");
+
+    {
+        const auto x = complex_signal({3, 12, 5}, gen);
+        const auto X = fft::fft(x, 1);
+        bool ok = true;
+        for (std::size_t o = 0; o < 3; ++o)
+            for (std::size_t i = 0; i < 5; ++i) {
+                std::vector<cd> line(12), got(12);
+                for (std::size_t k = 0; k < 12; ++k) { line[k] = x.data[(o * 12 + k) * 5 + i]; got[k] = X.data[(o * 12 + k) * 5 + i]; }
+                ok = ok && cmax_diff(got, naive_dft(line)) < 1e-12;
+            }
+        CHECK(ctx, ok);
+        CHECK(ctx, cmax_diff(fft::fft(x, -2).data, X.data) == 0.0);
+
+        const auto all = fft::fftn(x);
+        const auto composed = fft::fft(fft::fft(fft::fft(x, 0), 1), 2);
+        CHECK(ctx, cmax_diff(all.data, composed.data) < 1e-12);
+        CHECK(ctx, cmax_diff(fft::ifftn(all).data, x.data) < 1e-14);
+        CHECK(ctx, cmax_diff(fft::fftn(x, {2, 0}).data, fft::fft(fft::fft(x, 0), 2).data) < 1e-12);
+
+        const auto img = tl::random::uniform<double>({16, 10}, -1.0, 1.0, gen);
+        const auto F = fft::rfftn(img);
+        CHECK(ctx, F.shape == (std::vector<std::size_t>{16, 6}));
+        const auto full = fft::fftn(tl::to_complex(img));
+        double err = 0.0;
+        for (std::size_t r = 0; r < 16; ++r)
+            for (std::size_t c = 0; c < 6; ++c) err = std::max(err, std::abs(F.data[r * 6 + c] - full.data[r * 10 + c]));
+        CHECK(ctx, err < 1e-12);
+        CHECK(ctx, cmax_diff(fft::irfftn(F, 10).data, img.data) < 1e-14);
+
+        // Many independent lines (the parallel path).
+        const auto big = complex_signal({512, 128}, gen);
+        CHECK(ctx, cmax_diff(fft::ifft(fft::fft(big)).data, big.data) < 1e-13);
+    }
+
+    {
+        CHECK(ctx, cmax_diff(fft::fftfreq(5, 0.5).data, std::vector<double>{0, 0.4, 0.8, -0.8, -0.4}) < 1e-15);
+        CHECK(ctx, cmax_diff(fft::rfftfreq(4).data, std::vector<double>{0, 0.25, 0.5}) < 1e-15);
+
+        tl::Tensor<cd> z({4});
+        CHECK_THROWS(ctx, std::runtime_error, fft::fft(z, 1));
+        CHECK_THROWS(ctx, std::runtime_error, fft::fftn(z, {0, -1}));
+    }
+}
@@ -0,0 +1,167 @@
+// tests/test_graph.cpp — Tests for graph capture and compiled replay (tl/graph/)
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+void run_graph_tests(tl::TestContext& ctx) {
+
+    namespace gr = tl::graph;
+    namespace F = tl::functional;
+    tl::random::Generator gen(44);
+
+    // ── Linear fusion ─────────────────────────────────────────────────────────
+    SUITE(ctx, "Graph — matmul + bias + activation fusion");
+
+    {
+        auto W1 = tl::random::normal<float>({16, 32}, 0.0f, 0.3f, gen);
+        auto b1 = tl::random::normal<float>({32}, 0.0f, 0.1f, gen);
+        auto W2 = tl::random::normal<float>({32, 10}, 0.0f, 0.3f, gen);
+        auto b2 = tl::random::normal<float>({1, 10}, 0.0f, 0.1f, gen);
+
+        gr::Graph<float> g;
+        auto x = g.input({8, 16});
+        auto h = gr::relu(gr::matmul(x, g.param(W1)) + g.param(b1));
+        g.output(gr::softmax(gr::matmul(h, g.param(W2)) + g.param(b2)));
+        auto plan = gr::compile(g);
+
+        CHECK(ctx, plan.stats().fused_linear == 2);
+        CHECK(ctx, plan.stats().steps == 3);
+        CHECK(ctx, plan.describe().find("linear [8,16]x[16,32] +bias relu") != std::string::npos);
+
+        auto eager = [&](const tl::Tensor<float>& in) {
+            return F::softmax(tl::linalg::matmul(F::relu(tl::linalg::matmul(in, W1) + b1), W2) + b2);
+        };
+        for (int rep = 0; rep < 2; ++rep) {
+            const auto in = tl::random::uniform<float>({8, 16}, -1.0f, 1.0f, gen);
+            plan.run({in});
+            CHECK(ctx, tl::max_abs_diff(plan.output(), eager(in)) < 1e-6);
+        }
+
+        // Parameters are read in place: an update is visible on the next replay.
+        const auto in = tl::random::uniform<float>({8, 16}, -1.0f, 1.0f, gen);
+        for (auto& w : W1.data) w *= -1.5f;
+        plan.run({in});
+        CHECK(ctx, tl::max_abs_diff(plan.output(), eager(in)) < 1e-6);
+    }
+
+    {
+        // A bias recorded after the matmul: the fused step must wait for it.
+        tl::Tensor<float> W({2, 2}, {1, 2, 3, 4});
+        tl::Tensor<float> b({2}, {10, 20});
+        gr::Graph<float> g;
+        auto x = g.input({1, 2});
+        auto mm = gr::matmul(x, g.param(W));
+        auto b2 = g.param(b) * 2.0f;
+        g.output(gr::relu(mm + b2));
+        auto plan = gr::compile(g);
+        CHECK(ctx, plan.stats().fused_linear == 1);
+        const std::string d = plan.describe();
+        CHECK(ctx, d.find("mul_scalar") < d.find("linear"));
+        const tl::Tensor<float> ones({1, 2}, {1, 1});
+        plan.run({ones});
+        CHECK(ctx, plan.output().data == (std::vector<float>{24, 46}));
+    }
+
+    // ── Element-wise fusion ───────────────────────────────────────────────────
+    SUITE(ctx, "Graph — element-wise fusion with broadcasting");
+
+    {
+        gr::Graph<float> g;
+        auto a = g.input({2, 3, 40});
+        auto b = g.input({3, 1});
+        auto c = g.input({40});
+        g.output(gr::sigmoid((a * b + 1.0f) * 2.0f - c) / (gr::square(a) + 0.5f));
+        auto plan = gr::compile(g);
+
+        CHECK(ctx, plan.stats().steps == 1);
+        CHECK(ctx, plan.stats().fused_elementwise == 8);
+        CHECK(ctx, plan.stats().arena_bytes == 0);
+
+        const auto ta = tl::random::uniform<float>({2, 3, 40}, -2.0f, 2.0f, gen);
+        const auto tb = tl::random::uniform<float>({3, 1}, -2.0f, 2.0f, gen);
+        const auto tc = tl::random::uniform<float>({40}, -2.0f, 2.0f, gen);
+        plan.run({ta, tb, tc});
+        const auto ref = F::sigmoid((ta * tb + 1.0f) * 2.0f - tc) / (ta * ta + 0.5f);
+        CHECK(ctx, tl::max_abs_diff(plan.output(), ref) < 1e-6);
+    }
+
+    {
+        // A value read by two kernels is materialised once; a scalar broadcasts too.
+        gr::Graph<float> g;
+        auto x = g.input({300, 7});
+        auto s = g.input({1});
+        auto t = gr::tanh(x * s);
+        g.output(t + 1.0f);
+        g.output(gr::exp(t) * 2.0f);
+        auto plan = gr::compile(g);
+        CHECK(ctx, plan.stats().steps == 3 && plan.num_outputs() == 2);
+
+        const auto tx = tl::random::uniform<float>({300, 7}, -1.0f, 1.0f, gen);
+        tl::Tensor<float> ts({1});
+        ts.data[0] = 0.75f;
+        plan.run({tx, ts});
+        const auto tt = F::tanh(tx * 0.75f);
+        CHECK(ctx, tl::max_abs_diff(plan.output(0), tt + 1.0f) < 1e-6);
+        CHECK(ctx, tl::max_abs_diff(plan.output(1), F::exp(tt) * 2.0f) < 1e-6);
+    }
+
+    // ── Dead code and memory planning ─────────────────────────────────────────
+    SUITE(ctx, "Graph — dead-code elimination and arena reuse");
+
+    {
+        auto W = tl::random::normal<float>({64, 64}, 0.0f, 0.1f, gen);
+        gr::Graph<float> g;
+        auto x = g.input({64, 64});
+        auto w = g.param(W);
+        auto unused = gr::exp(x) * 3.0f;
+        (void)unused;
+        auto y = x;
+        for (int i = 0; i < 4; ++i) y = gr::matmul(y, w);
+        g.output(y);
+        g.output(x);
+        auto plan = gr::compile(g);
+
+        CHECK(ctx, plan.stats().captured_nodes == 8 && plan.stats().live_nodes == 6);
+        CHECK(ctx, plan.stats().steps == 4);
+        CHECK(ctx, plan.stats().unplanned_bytes == 3 * 64 * 64 * sizeof(float));
+        CHECK(ctx, plan.stats().arena_bytes == 2 * 64 * 64 * sizeof(float));
+
+        const auto in = tl::random::uniform<float>({64, 64}, -1.0f, 1.0f, gen);
+        plan.run({in});
+        auto ref = in;
+        for (int i = 0; i < 4; ++i) ref = tl::linalg::matmul(ref, W);
+        CHECK(ctx, tl::max_abs_diff(plan.output(0), ref) < 1e-6);
+        CHECK(ctx, tl::max_abs_diff(plan.output(1), in) == 0.0);
+
+#ifdef TL_PROFILE
+        // Replays allocate nothing.
+        const auto before = tl::profile::memory_stats().allocations;
+        for (int i = 0; i < 3; ++i) plan.run({in});
+        CHECK(ctx, tl::profile::memory_stats().allocations == before);
+#endif
+    }
+
+    // ── Errors ────────────────────────────────────────────────────────────────
+    SUITE(ctx, "Graph — errors");
+
+    {
+        gr::Graph<float> g, other;
+        auto x = g.input({4, 3});
+        auto y = other.input({4, 3});
+        CHECK_THROWS(ctx, std::runtime_error, x + y);
+        CHECK_THROWS(ctx, std::runtime_error, g.output(y));
+        CHECK_THROWS(ctx, std::runtime_error, gr::matmul(x, x));
+        CHECK_THROWS(ctx, std::runtime_error, y + other.input({2}));
+        CHECK_THROWS(ctx, std::runtime_error, gr::compile(g));
+
+        g.output(gr::relu(x));
+        auto plan = gr::compile(g);
+        tl::Tensor<float> wrong({3, 4});
+        CHECK_THROWS(ctx, std::runtime_error, plan.run({wrong}));
+        CHECK_THROWS(ctx, std::runtime_error, plan.run({}));
+        CHECK_THROWS(ctx, std::out_of_range, plan.output(1));
+    }
+}
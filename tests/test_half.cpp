@@ -0,0 +1,191 @@
+// tests/test_half.cpp — Tests for tl::float16 / tl::bfloat16 storage and float accumulation
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace {
+
+template <typename H>
+tl::Tensor<H> narrow_tensor(const tl::Tensor<float>& t) {
+    tl::Tensor<H> r(t.shape);
+    tl::convert_from_float(t.data.data(), r.data.data(), t.data.size());
+    return r;
+}
+
+template <typename H>
+tl::Tensor<float> widen_tensor(const tl::Tensor<H>& t) {
+    tl::Tensor<float> r(t.shape);
+    tl::convert_to_float(t.data.data(), r.data.data(), t.data.size());
+    return r;
+}
+
+template <typename H>
+double half_rel_err(const tl::Tensor<H>& got, const tl::Tensor<float>& ref) {
+    double num = 0.0, den = 0.0;
+    for (std::size_t i = 0; i < ref.data.size(); ++i) {
+        const double d = static_cast<double>(static_cast<float>(got.data[i])) - ref.data[i];
+        num += d * d;
+        den += static_cast<double>(ref.data[i]) * ref.data[i];
+    }
+    return std::sqrt(num / den);
+}
+
+} // namespace
+
+void run_half_tests(tl::TestContext& ctx) {
+
+    using tl::float16;
+    using tl::bfloat16;
+
+    // ── Conversions ───────────────────────────────────────────────────────────
+    SUITE(ctx, "Half — float16 / bfloat16 conversions");
+
+    {
+        CHECK(ctx, sizeof(float16) == 2 && sizeof(bfloat16) == 2);
+        CHECK(ctx, float16(1.0f).bits == 0x3C00 && float16(-2.0f).bits == 0xC000);
+        CHECK(ctx, float16(65504.0f).bits == 0x7BFF);
+        CHECK(ctx, float16(65520.0f).bits == 0x7C00);                    // ties away from max -> inf
+        CHECK(ctx, float16(std::ldexp(1.0f, -24)).bits == 0x0001);        // smallest subnormal
+        CHECK(ctx, float16(1.0f / 3.0f).bits == 0x3555);
+        CHECK(ctx, float16(1.0f + std::ldexp(1.0f, -11)).bits == 0x3C00);     // tie -> even
+        CHECK(ctx, float16(1.0f + 3 * std::ldexp(1.0f, -11)).bits == 0x3C02);
+        CHECK(ctx, std::isnan(static_cast<float>(float16(std::numeric_limits<float>::quiet_NaN()))));
+
+        CHECK(ctx, bfloat16(1.0f).bits == 0x3F80 && bfloat16(3.14159265f).bits == 0x4049);
+        CHECK(ctx, bfloat16(1.0f + std::ldexp(1.0f, -8)).bits == 0x3F80);
+        CHECK(ctx, bfloat16(1.0f + 3 * std::ldexp(1.0f, -8)).bits == 0x3F82);
+        CHECK(ctx, std::isnan(static_cast<float>(bfloat16(std::numeric_limits<float>::quiet_NaN()))));
+        CHECK(ctx, static_cast<float>(std::numeric_limits<float16>::max()) == 65504.0f);
+        CHECK(ctx, static_cast<float>(std::numeric_limits<bfloat16>::epsilon()) == std::ldexp(1.0f, -7));
+    }
+
+    {
+        // Every non-NaN bit pattern survives a round trip through float.
+        bool half_ok = true, bf_ok = true;
+        for (std::uint32_t b = 0; b < 0x10000u; ++b) {
+            const auto h = float16::from_bits(static_cast<std::uint16_t>(b));
+            const auto g = bfloat16::from_bits(static_cast<std::uint16_t>(b));
+            if (!std::isnan(static_cast<float>(h))) half_ok = half_ok && float16(static_cast<float>(h)).bits == b;
+            if (!std::isnan(static_cast<float>(g))) bf_ok = bf_ok && bfloat16(static_cast<float>(g)).bits == b;
+        }
+        CHECK(ctx, half_ok);
+        CHECK(ctx, bf_ok);
+    }
+
+    {
+        // Portable and hardware paths agree bit for bit, and bulk matches scalar (with a tail).
+        std::vector<float> src(1037);
+        for (std::size_t i = 0; i < src.size(); ++i)
+            src[i] = std::ldexp(std::sin(0.37f * float(i)) + 1.1f, int(i % 41) - 26) * (i % 3 ? 1.0f : -1.0f);
+        std::vector<float16> h(src.size());
+        std::vector<bfloat16> g(src.size());
+        tl::convert_from_float(src.data(), h.data(), src.size());
+        tl::convert_from_float(src.data(), g.data(), src.size());
+        bool same = true;
+        for (std::size_t i = 0; i < src.size(); ++i) {
+            same = same && h[i].bits == tl::detail::half_from_float_portable(src[i]);
+            same = same && h[i].bits == float16(src[i]).bits;
+            same = same && g[i].bits == tl::detail::bfloat_from_float_portable(src[i]);
+            same = same && static_cast<float>(h[i]) == tl::detail::float_from_half_portable(h[i].bits);
+        }
+        CHECK(ctx, same);
+
+        std::vector<float> back(src.size()), back_bf(src.size());
+        tl::convert_to_float(h.data(), back.data(), h.size());
+        tl::convert_to_float(g.data(), back_bf.data(), g.size());
+        bool exact = true;
+        for (std::size_t i = 0; i < src.size(); ++i)
+            exact = exact && back[i] == static_cast<float>(h[i]) && back_bf[i] == static_cast<float>(g[i]);
+        CHECK(ctx, exact);
+    }
+
+    // ── Tensor arithmetic and reductions ──────────────────────────────────────
+    SUITE(ctx, "Half — Tensor arithmetic and float-accumulated reductions");
+
+    {
+        tl::Tensor<float16> a({2, 2}, {1.0f, 2.0f, 3.0f, 4.0f});
+        tl::Tensor<float16> b({2, 2}, {0.5f, 0.25f, -1.0f, 8.0f});
+        const auto c = (a + b) * float16(2.0f) - a / b;
+        CHECK(ctx, static_cast<float>(c.data[0]) == 1.0f && static_cast<float>(c.data[1]) == -3.5f);
+        CHECK(ctx, static_cast<float>(c.data[2]) == 7.0f && static_cast<float>(c.data[3]) == 23.5f);
+        CHECK(ctx, static_cast<float>(tl::max(b)) == 8.0f && static_cast<float>(tl::min(b)) == -1.0f);
+        CHECK(ctx, -a.data[1] == float16(-2.0f) && a.data[0] < a.data[1]);
+    }
+
+    {
+        // 10000 ones: a float16 running sum would stall at 2048, a float one does not.
+        const auto ones = tl::ones<float16>({10000});
+        CHECK(ctx, static_cast<float>(tl::sum(ones)) == 10000.0f);
+        CHECK(ctx, static_cast<float>(tl::mean(ones)) == 1.0f);
+        CHECK(ctx, static_cast<float>(tl::dot(ones, ones)) == 10000.0f);
+        const auto bf = tl::full<bfloat16>({2000}, bfloat16(0.5f));
+        CHECK(ctx, static_cast<float>(tl::sum(bf)) == 1000.0f);
+    }
+
+    // ── matmul ────────────────────────────────────────────────────────────────
+    SUITE(ctx, "Half — matmul with float accumulation");
+
+    {
+        // Long inner dimension and several B panels: exact for a representable answer.
+        const auto A = tl::ones<float16>({3, 3000});
+        const auto B = tl::ones<float16>({3000, 70});
+        const auto C = tl::linalg::matmul(A, B);
+        bool exact = C.shape == std::vector<std::size_t>{3, 70};
+        for (const auto& v : C.data) exact = exact && static_cast<float>(v) == 3000.0f;
+        CHECK(ctx, exact);
+    }
+
+    {
+        tl::Tensor<float> A({37, 129}), B({129, 53});
+        for (std::size_t i = 0; i < A.data.size(); ++i) A.data[i] = std::sin(0.1f * float(i));
+        for (std::size_t i = 0; i < B.data.size(); ++i) B.data[i] = std::cos(0.07f * float(i));
+        // Against a float product of the same rounded inputs, only the final rounding remains.
+        const auto Ah = narrow_tensor<float16>(A), Bh = narrow_tensor<float16>(B);
+        const auto Ab = narrow_tensor<bfloat16>(A), Bb = narrow_tensor<bfloat16>(B);
+        const auto Ch = tl::linalg::matmul(Ah, Bh);
+        const auto Cb = tl::linalg::matmul(Ab, Bb);
+        CHECK(ctx, half_rel_err(Ch, tl::linalg::matmul(widen_tensor(Ah), widen_tensor(Bh))) < 6e-4);
+        CHECK(ctx, half_rel_err(Cb, tl::linalg::matmul(widen_tensor(Ab), widen_tensor(Bb))) < 5e-3);
+    }
+
+    // ── functional:: kernels ──────────────────────────────────────────────────
+    SUITE(ctx, "Half — functional kernels keep 16-bit storage");
+
+    {
+        tl::Tensor<float> x({2, 5}, {-2.0f, -0.5f, 0.0f, 0.75f, 3.0f, 1.0f, 2.0f, -1.0f, 0.1f, 4.0f});
+        const auto xh = narrow_tensor<float16>(x);
+        const auto e = tl::functional::exp(xh);
+        const auto s = tl::functional::sigmoid(narrow_tensor<bfloat16>(x));
+        const auto c = tl::functional::clip(xh, -1.0f, 1.0f);
+        static_assert(std::is_same_v<decltype(e), const tl::Tensor<float16>>);
+        static_assert(std::is_same_v<decltype(s), const tl::Tensor<bfloat16>>);
+        bool ok = true;
+        for (std::size_t i = 0; i < x.data.size(); ++i) {
+            const float xv = static_cast<float>(xh.data[i]);
+            ok = ok && e.data[i].bits == float16(std::exp(xv)).bits;
+            ok = ok && s.data[i].bits == bfloat16(1.0f / (1.0f + std::exp(-static_cast<float>(bfloat16(x.data[i]))))).bits;
+            ok = ok && static_cast<float>(c.data[i]) == std::max(-1.0f, std::min(1.0f, xv));
+        }
+        CHECK(ctx, ok);
+
+        const auto p = tl::functional::softmax(xh);
+        for (std::size_t r = 0; r < 2; ++r) {
+            float total = 0.0f;
+            for (std::size_t j = 0; j < 5; ++j) total += static_cast<float>(p.data[r * 5 + j]);
+            CHECK_NEAR(ctx, total, 1.0f, 2e-3f);
+        }
+        const auto lp = tl::functional::log_softmax(xh, 0);
+        CHECK_NEAR(ctx, static_cast<float>(lp.data[0]), -2.0f - std::log(std::exp(-2.0f) + std::exp(1.0f)), 4e-3f);
+
+        const auto ce = tl::functional::softmax_cross_entropy(xh, std::vector<std::size_t>{4, 2});
+        const auto ce_ref = tl::functional::softmax_cross_entropy(tl::Tensor<float>({2, 5}, {
+            static_cast<float>(xh.data[0]), static_cast<float>(xh.data[1]), static_cast<float>(xh.data[2]),
+            static_cast<float>(xh.data[3]), static_cast<float>(xh.data[4]), static_cast<float>(xh.data[5]),
+            static_cast<float>(xh.data[6]), static_cast<float>(xh.data[7]), static_cast<float>(xh.data[8]),
+            static_cast<float>(xh.data[9])}), std::vector<std::size_t>{4, 2});
+        CHECK(ctx, ce.loss.bits == float16(ce_ref.loss).bits);
+    }
+}
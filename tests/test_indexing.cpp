@@ -0,0 +1,152 @@
+// tests/test_indexing.cpp — Tests for index_select, gather, scatter / scatter_add, masked_select and where
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+// 0, 1, 2, ... laid out in `shape`.
+tl::Tensor<float> seq_tensor(const std::vector<std::size_t>& shape) {
+    tl::Tensor<float> t(shape);
+    for (std::size_t i = 0; i < t.data.size(); ++i) t.data[i] = static_cast<float>(i);
+    return t;
+}
+
+} // namespace
+
+void run_indexing_tests(tl::TestContext& ctx) {
+
+    tl::random::Generator gen(48);
+
+    // ── index_select / gather ─────────────────────────────────────────────────
+    SUITE(ctx, "Indexing — index_select and gather");
+
+    {
+        const auto x = seq_tensor({3, 4});                            // [[0..3], [4..7], [8..11]]
+        tl::Tensor<std::int64_t> rows({4}, {2, 0, 2, 1});
+        const auto r = tl::index_select(x, 0, rows);
+        CHECK(ctx, r.shape == (std::vector<std::size_t>{4, 4}));
+        CHECK(ctx, r.data[0] == 8 && r.data[4] == 0 && r.data[8] == 8 && r.data[15] == 7);
+        tl::Tensor<int> cols({2}, {3, 1});
+        const auto c = tl::index_select(x, -1, cols);
+        CHECK(ctx, c.data == (std::vector<float>{3, 1, 7, 5, 11, 9}));
+        CHECK_THROWS(ctx, std::runtime_error, tl::index_select(x, 0, tl::Tensor<int>({1}, {3})));
+        CHECK_THROWS(ctx, std::runtime_error, tl::index_select(x, 1, tl::Tensor<int>({1}, {-1})));
+        CHECK_THROWS(ctx, std::runtime_error, tl::index_select(x, 2, cols));
+
+        // Embedding lookup: token ids into a [vocab, dim] table.
+        const auto table = tl::random::uniform<float>({1000, 64}, -1.0f, 1.0f, gen);
+        tl::Tensor<std::size_t> ids({4096});
+        for (std::size_t i = 0; i < ids.data.size(); ++i) ids.data[i] = (i * 7919) % 1000;
+        const auto emb = tl::index_select(table, 0, ids);
+        bool ok = emb.shape == (std::vector<std::size_t>{4096, 64});
+        for (std::size_t i = 0; ok && i < ids.data.size(); ++i)
+            for (std::size_t d = 0; d < 64; ++d) ok = ok && emb.data[i * 64 + d] == table.data[ids.data[i] * 64 + d];
+        CHECK(ctx, ok);
+    }
+
+    {
+        const auto x = seq_tensor({2, 3});
+        tl::Tensor<int> idx({2, 2}, {2, 0, 1, 1});
+        CHECK(ctx, tl::gather(x, 1, idx).data == (std::vector<float>{2, 0, 4, 4}));
+        tl::Tensor<int> idx0({1, 3}, {1, 0, 1});
+        CHECK(ctx, tl::gather(x, 0, idx0).data == (std::vector<float>{3, 1, 5}));
+        CHECK_THROWS(ctx, std::runtime_error, tl::gather(x, 0, tl::Tensor<int>({1, 2})));
+
+        // Middle axis of a 3-D tensor, against the definition.
+        const auto y = seq_tensor({4, 5, 6});
+        tl::Tensor<int> g({4, 3, 6});
+        for (std::size_t i = 0; i < g.data.size(); ++i) g.data[i] = static_cast<int>((i * 13) % 5);
+        const auto out = tl::gather(y, 1, g);
+        bool ok = true;
+        for (std::size_t a = 0; a < 4; ++a)
+            for (std::size_t j = 0; j < 3; ++j)
+                for (std::size_t c = 0; c < 6; ++c) {
+                    const std::size_t k = static_cast<std::size_t>(g.data[(a * 3 + j) * 6 + c]);
+                    ok = ok && out.data[(a * 3 + j) * 6 + c] == y.data[(a * 5 + k) * 6 + c];
+                }
+        CHECK(ctx, ok);
+    }
+
+    // ── scatter / scatter_add ─────────────────────────────────────────────────
+    SUITE(ctx, "Indexing — scatter and scatter_add");
+
+    {
+        const auto x = tl::zeros<float>({3, 2});
+        tl::Tensor<int> idx({2, 2}, {2, 0, 0, 0});
+        tl::Tensor<float> src({2, 2}, {1, 2, 3, 4});
+        CHECK(ctx, tl::scatter(x, 0, idx, src).data == (std::vector<float>{3, 4, 0, 0, 1, 0}));
+        CHECK(ctx, tl::scatter_add(x, 0, idx, src).data == (std::vector<float>{3, 6, 0, 0, 1, 0}));
+        CHECK_THROWS(ctx, std::runtime_error, tl::scatter_add(x, 0, idx, tl::Tensor<float>({2, 3})));
+
+        // gather and scatter are inverses on a permutation.
+        const auto y = seq_tensor({2, 5});
+        tl::Tensor<int> perm({2, 5}, {4, 2, 0, 1, 3, 1, 0, 3, 2, 4});
+        CHECK(ctx, tl::scatter(tl::zeros<float>({2, 5}), 1, perm, tl::gather(y, 1, perm)).data == y.data);
+    }
+
+    {
+        // Histogram: 1-D scatter_add with many duplicates (the atomic path when threaded).
+        const std::size_t n = 200000, bins = 17;
+        tl::Tensor<std::uint32_t> idx({n});
+        for (std::size_t i = 0; i < n; ++i) idx.data[i] = static_cast<std::uint32_t>((i * i + 3 * i) % bins);
+        const auto h = tl::scatter_add(tl::zeros<double>({bins}), 0, idx, tl::ones<double>({n}));
+        std::vector<double> ref(bins, 0.0);
+        for (auto v : idx.data) ref[v] += 1.0;
+        CHECK(ctx, h.data == ref);
+
+        // Gradient of an embedding lookup: rows of a [n, dim] tensor summed into [vocab, dim].
+        const std::size_t vocab = 50, dim = 96, m = 3000;
+        tl::Tensor<double> grads({m, dim});                           // small integers: exact in any summation order
+        for (std::size_t i = 0; i < grads.data.size(); ++i) grads.data[i] = static_cast<double>((i * 37) % 11) - 5.0;
+        tl::Tensor<std::int64_t> rows({m, dim});
+        for (std::size_t i = 0; i < m; ++i)
+            for (std::size_t d = 0; d < dim; ++d) rows.data[i * dim + d] = static_cast<std::int64_t>((i * 31) % vocab);
+        const auto acc = tl::scatter_add(tl::zeros<double>({vocab, dim}), 0, rows, grads);
+        std::vector<double> expect(vocab * dim, 0.0);
+        for (std::size_t i = 0; i < m; ++i)
+            for (std::size_t d = 0; d < dim; ++d) expect[((i * 31) % vocab) * dim + d] += grads.data[i * dim + d];
+        CHECK(ctx, acc.data == expect);
+    }
+
+    // ── masked_select / where ─────────────────────────────────────────────────
+    SUITE(ctx, "Indexing — masked_select and where");
+
+    {
+        const auto x = seq_tensor({2, 3});
+        tl::Tensor<std::uint8_t> mask({2, 3}, {1, 0, 1, 0, 0, 1});
+        const auto s = tl::masked_select(x, mask);
+        CHECK(ctx, s.shape == std::vector<std::size_t>{3});
+        CHECK(ctx, s.data == (std::vector<float>{0, 2, 5}));
+        tl::Tensor<int> row_mask({3}, {0, 1, 1});                     // broadcast over rows
+        CHECK(ctx, tl::masked_select(x, row_mask).data == (std::vector<float>{1, 2, 4, 5}));
+        CHECK(ctx, tl::masked_select(x, tl::zeros<int>({2, 3})).data.empty());
+
+        const auto big = tl::random::uniform<float>({300000}, -1.0f, 1.0f, gen);
+        tl::Tensor<std::uint8_t> pos(big.shape);
+        std::vector<float> ref;
+        for (std::size_t i = 0; i < big.data.size(); ++i) {
+            pos.data[i] = big.data[i] > 0.25f;
+            if (pos.data[i]) ref.push_back(big.data[i]);
+        }
+        CHECK(ctx, tl::masked_select(big, pos).data == ref);
+    }
+
+    {
+        tl::Tensor<std::uint8_t> cond({2, 2}, {1, 0, 0, 1});
+        tl::Tensor<float> a({2, 2}, {1, 2, 3, 4});
+        tl::Tensor<float> b({2, 2}, {-1, -2, -3, -4});
+        CHECK(ctx, tl::where(cond, a, b).data == (std::vector<float>{1, -2, -3, 4}));
+        CHECK(ctx, tl::where(cond, a, 0.0f).data == (std::vector<float>{1, 0, 0, 4}));
+        CHECK(ctx, tl::where(cond, 9.0f, b).data == (std::vector<float>{9, -2, -3, 9}));
+
+        tl::Tensor<int> col({3, 1}, {1, 0, 1});
+        tl::Tensor<float> row({4}, {1, 2, 3, 4});
+        tl::Tensor<float> other({3, 4});
+        const auto w = tl::where(col, row, other);
+        CHECK(ctx, w.shape == (std::vector<std::size_t>{3, 4}));
+        CHECK(ctx, w.data == (std::vector<float>{1, 2, 3, 4, 0, 0, 0, 0, 1, 2, 3, 4}));
+        CHECK_THROWS(ctx, std::runtime_error, tl::where(col, tl::Tensor<float>({2}), other));
+    }
+}
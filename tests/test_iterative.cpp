@@ -0,0 +1,228 @@
+// tests/test_iterative.cpp — Tests for tl::linalg sparse matrices and Krylov solvers
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace {
+
+// 1D Poisson matrix tridiag(-1, 2, -1) of size n (SPD).
+tl::linalg::CSRMatrix<double> poisson_1d(std::size_t n) {
+    std::vector<std::tuple<std::size_t, std::size_t, double>> t;
+    for (std::size_t i = 0; i < n; ++i) {
+        t.emplace_back(i, i, 2.0);
+        if (i > 0)     t.emplace_back(i, i - 1, -1.0);
+        if (i + 1 < n) t.emplace_back(i, i + 1, -1.0);
+    }
+    return tl::linalg::CSRMatrix<double>::from_triplets(n, n, t);
+}
+
+// Non-symmetric convection-diffusion matrix tridiag(-1.5, 3, -0.5).
+tl::linalg::CSRMatrix<double> convection_1d(std::size_t n) {
+    std::vector<std::tuple<std::size_t, std::size_t, double>> t;
+    for (std::size_t i = 0; i < n; ++i) {
+        t.emplace_back(i, i, 3.0);
+        if (i > 0)     t.emplace_back(i, i - 1, -1.5);
+        if (i + 1 < n) t.emplace_back(i, i + 1, -0.5);
+    }
+    return tl::linalg::CSRMatrix<double>::from_triplets(n, n, t);
+}
+
+double residual_norm(const tl::linalg::CSRMatrix<double>& A,
+                     const tl::Tensor<double>& x, const tl::Tensor<double>& b) {
+    auto r = b - A * x;
+    return std::sqrt(tl::dot(r, r));
+}
+
+} // namespace
+
+void run_iterative_tests(tl::TestContext& ctx) {
+
+    // ── CSR construction ──────────────────────────────────────────────────────
+    SUITE(ctx, "Sparse — CSRMatrix");
+
+    {
+        tl::Tensor<double> D({3, 3}, {4, 0, 1,
+                                      0, 0, 0,
+                                      2, 0, 5});
+        auto A = tl::linalg::CSRMatrix<double>::from_dense(D);
+        CHECK_EQ(ctx, A.nnz(), 4u);
+        CHECK_EQ(ctx, A.row_ptr[1], 2u);
+        CHECK_EQ(ctx, A.row_ptr[2], 2u);   // empty row
+
+        auto y = A * tl::Tensor<double>({3}, {1, 2, 3});
+        CHECK_NEAR(ctx, y.data[0], 7.0, 1e-12);
+        CHECK_NEAR(ctx, y.data[1], 0.0, 1e-12);
+        CHECK_NEAR(ctx, y.data[2], 17.0, 1e-12);
+
+        auto back = A.to_dense();
+        CHECK(ctx, back.data == D.data);
+    }
+
+    // Duplicate triplets are summed; out-of-range triplets throw
+    {
+        auto A = tl::linalg::CSRMatrix<double>::from_triplets(2, 2,
+            {{1, 0, 1.0}, {0, 1, 2.0}, {1, 0, 3.0}});
+        CHECK_EQ(ctx, A.nnz(), 2u);
+        CHECK_NEAR(ctx, A.to_dense().data[2], 4.0, 1e-12);
+        CHECK_THROWS(ctx, std::out_of_range,
+            tl::linalg::CSRMatrix<double>::from_triplets(2, 2, {{2, 0, 1.0}}));
+    }
+
+    // ── Conjugate Gradient ────────────────────────────────────────────────────
+    SUITE(ctx, "Krylov — conjugate gradient");
+
+    {
+        const std::size_t n = 100;
+        auto A = poisson_1d(n);
+        auto b = tl::ones<double>({n});
+        auto x = tl::zeros<double>({n});
+
+        tl::linalg::SolverOptions<double> opts;
+        opts.rtol = 1e-10;
+        auto res = tl::linalg::cg(A, b, x, tl::linalg::IdentityPreconditioner<double>{}, opts);
+        CHECK(ctx, res.converged);
+        CHECK(ctx, res.iterations <= n);
+        CHECK(ctx, residual_norm(A, x, b) < 1e-8);
+        CHECK_EQ(ctx, res.residual_history.size(), res.iterations + 1);
+        CHECK(ctx, res.residual_history.back() < res.residual_history.front());
+        // Exact solution of -u'' = 1 with zero boundaries: x_i = (i+1)(n-i)/2
+        CHECK_NEAR(ctx, x.data[0], 50.0, 1e-6);
+        CHECK_NEAR(ctx, x.data[49], 50.0 * 51.0 / 2.0, 1e-6);
+    }
+
+    // Incomplete Cholesky needs far fewer iterations than plain CG
+    {
+        const std::size_t n = 200;
+        std::vector<std::tuple<std::size_t, std::size_t, double>> t;
+        for (std::size_t i = 0; i < n; ++i) {
+            t.emplace_back(i, i, 2.0 + 1e-2 * static_cast<double>(i));
+            if (i > 0)     t.emplace_back(i, i - 1, -1.0);
+            if (i + 1 < n) t.emplace_back(i, i + 1, -1.0);
+        }
+        auto A = tl::linalg::CSRMatrix<double>::from_triplets(n, n, t);
+        auto b = tl::ones<double>({n});
+
+        auto x0 = tl::zeros<double>({n});
+        auto plain = tl::linalg::cg(A, b, x0);
+
+        auto x1 = tl::zeros<double>({n});
+        tl::linalg::IncompleteCholeskyPreconditioner<double> ic(A);
+        auto pre = tl::linalg::cg(A, b, x1, ic);
+
+        auto x2 = tl::zeros<double>({n});
+        tl::linalg::JacobiPreconditioner<double> jac(A);
+        auto pj = tl::linalg::cg(A, b, x2, jac);
+
+        CHECK(ctx, plain.converged && pre.converged && pj.converged);
+        // IC(0) of a tridiagonal matrix is an exact factorisation.
+        CHECK(ctx, pre.iterations <= 2);
+        CHECK(ctx, pre.iterations < plain.iterations);
+        CHECK(ctx, residual_norm(A, x1, b) < 1e-6);
+        CHECK(ctx, residual_norm(A, x2, b) < 1e-6);
+    }
+
+    // Matrix-free operator (functor) and dense tensor operator
+    {
+        const std::size_t n = 50;
+        auto laplace = [n](const tl::Tensor<double>& in, tl::Tensor<double>& out) {
+            for (std::size_t i = 0; i < n; ++i) {
+                double v = 2.0 * in.data[i];
+                if (i > 0)     v -= in.data[i - 1];
+                if (i + 1 < n) v -= in.data[i + 1];
+                out.data[i] = v;
+            }
+        };
+        auto b = tl::ones<double>({n});
+        auto x = tl::zeros<double>({n});
+        auto res = tl::linalg::cg<double>(laplace, b, x);
+        CHECK(ctx, res.converged);
+        CHECK(ctx, residual_norm(poisson_1d(n), x, b) < 1e-6);
+
+        auto dense = poisson_1d(n).to_dense();
+        auto xd = tl::zeros<double>({n});
+        auto rd = tl::linalg::cg(dense, b, xd);
+        CHECK(ctx, rd.converged);
+        CHECK_NEAR(ctx, xd.data[10], x.data[10], 1e-6);
+    }
+
+    // Telemetry callback is invoked once per recorded residual
+    {
+        auto A = poisson_1d(20);
+        auto b = tl::ones<double>({20});
+        auto x = tl::zeros<double>({20});
+        std::size_t calls = 0;
+        tl::linalg::SolverOptions<double> opts;
+        opts.record_history = false;
+        opts.callback = [&calls](std::size_t, double) { ++calls; };
+        auto res = tl::linalg::cg(A, b, x, tl::linalg::IdentityPreconditioner<double>{}, opts);
+        CHECK(ctx, res.residual_history.empty());
+        CHECK_EQ(ctx, calls, res.iterations + 1);
+    }
+
+    // ── BiCGSTAB ──────────────────────────────────────────────────────────────
+    SUITE(ctx, "Krylov — BiCGSTAB");
+
+    {
+        const std::size_t n = 120;
+        auto A = convection_1d(n);
+        auto b = tl::ones<double>({n});
+
+        auto x = tl::zeros<double>({n});
+        auto res = tl::linalg::bicgstab(A, b, x);
+        CHECK(ctx, res.converged);
+        CHECK(ctx, residual_norm(A, x, b) < 1e-6);
+
+        auto xp = tl::zeros<double>({n});
+        tl::linalg::ILU0Preconditioner<double> ilu(A);
+        auto rp = tl::linalg::bicgstab(A, b, xp, ilu);
+        CHECK(ctx, rp.converged);
+        CHECK(ctx, rp.iterations <= res.iterations);
+        CHECK(ctx, residual_norm(A, xp, b) < 1e-6);
+    }
+
+    // ── GMRES ─────────────────────────────────────────────────────────────────
+    SUITE(ctx, "Krylov — restarted GMRES");
+
+    {
+        const std::size_t n = 120;
+        auto A = convection_1d(n);
+        auto b = tl::ones<double>({n});
+
+        tl::linalg::SolverOptions<double> opts;
+        opts.restart = 10;
+        opts.max_iter = 2000;
+        auto x = tl::zeros<double>({n});
+        auto res = tl::linalg::gmres(A, b, x, tl::linalg::IdentityPreconditioner<double>{}, opts);
+        CHECK(ctx, res.converged);
+        CHECK(ctx, residual_norm(A, x, b) < 1e-6);
+
+        auto xp = tl::zeros<double>({n});
+        tl::linalg::ILU0Preconditioner<double> ilu(A);
+        auto rp = tl::linalg::gmres(A, b, xp, ilu, opts);
+        CHECK(ctx, rp.converged);
+        CHECK(ctx, rp.iterations < res.iterations);
+        CHECK(ctx, residual_norm(A, xp, b) < 1e-6);
+    }
+
+    // Size mismatch and zero pivots throw
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        auto A = poisson_1d(4);
+        tl::Tensor<double> b({4});
+        tl::Tensor<double> x({5});
+        tl::linalg::cg(A, b, x);
+    }));
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        auto A = tl::linalg::CSRMatrix<double>::from_triplets(2, 2, {{0, 1, 1.0}, {1, 0, 1.0}});
+        tl::linalg::ILU0Preconditioner<double> ilu(A);
+    }));
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        auto A = poisson_1d(4);
+        auto b = tl::ones<double>({4});
+        tl::Tensor<double> x({4});
+        tl::linalg::JacobiPreconditioner<double> jac(tl::ones<double>({3}));
+        tl::linalg::bicgstab(A, b, x, jac);
+    }));
+}
@@ -93,4 +93,44 @@ void run_linalg_tests(tl::TestContext& ctx) {
     // Unknown norm type must throw
     CHECK_THROWS(ctx, std::runtime_error,
         tl::linalg::matrix_norm(tl::Tensor<double>({2,2}), "bad"));
+
+    // ── LU factorisation ──────────────────────────────────────────────────────
+    SUITE(ctx, "Linalg — LU decomposition");
+
+    {
+        // Needs a row swap at the first pivot.
+        tl::Tensor<double> A({3, 3}, {0.0, 2.0, 1.0,
+                                      1.0, 1.0, 1.0,
+                                      4.0, 3.0, 6.0});
+        tl::Tensor<double> b({3}, {7.0, 6.0, 28.0});
+        tl::linalg::LUDecomposition<double> lu(A);
+        auto x = lu.solve(b);
+        CHECK_NEAR(ctx, x.data[0], 1.0, 1e-12);
+        CHECK_NEAR(ctx, x.data[1], 2.0, 1e-12);
+        CHECK_NEAR(ctx, x.data[2], 3.0, 1e-12);
+        CHECK_NEAR(ctx, lu.determinant(), -5.0, 1e-12);
+
+        // Factors are reusable for further right-hand sides.
+        tl::Tensor<double> c({3}, {3.0, 3.0, 13.0});
+        lu.solve_in_place(c);
+        CHECK_NEAR(ctx, c.data[0], 1.0, 1e-12);
+        CHECK_NEAR(ctx, c.data[2], 1.0, 1e-12);
+
+        auto y = tl::linalg::solve(A, b);
+        CHECK_NEAR(ctx, y.data[1], 2.0, 1e-12);
+    }
+
+    {
+        tl::Tensor<double> S({2, 2}, {1.0, 2.0, 2.0, 4.0});
+        tl::linalg::LUDecomposition<double> lu;
+        CHECK(ctx, !lu.try_factor(S));
+        CHECK(ctx, lu.empty());
+    }
+
+    CHECK_THROWS(ctx, std::runtime_error,
+        tl::linalg::LUDecomposition<double>(tl::Tensor<double>({2, 2}, {1.0, 2.0, 2.0, 4.0})));
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        tl::linalg::LUDecomposition<double> lu(tl::linalg::eye<double>(3));
+        lu.solve(tl::Tensor<double>({2}, {1.0, 1.0}));
+    }));
 }
\ No newline at end of file
@@ -0,0 +1,101 @@
+// tests/test_memory.cpp — Tests for tensor memory accounting (tl/profile/memory.hpp)
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+void run_memory_tests(tl::TestContext& ctx) {
+
+    namespace prof = tl::profile;
+
+    // ── Scopes without allocations ────────────────────────────────────────────
+    SUITE(ctx, "Memory — scopes and report");
+
+    {
+        prof::clear_memory_scopes();
+        { prof::MemoryScope idle("idle"); }
+        const auto scopes = prof::memory_scopes();
+        CHECK(ctx, scopes.size() == 1 && scopes[0].name == "idle" && scopes[0].allocations == 0);
+
+        std::ostringstream os;
+        prof::dump_memory(os);
+        CHECK(ctx, os.str().find("tensor memory: current") != std::string::npos);
+        CHECK(ctx, os.str().find("idle") != std::string::npos);
+    }
+
+#ifdef TL_PROFILE
+    // ── Global counters ───────────────────────────────────────────────────────
+    SUITE(ctx, "Memory — current, peak and live tensors");
+
+    {
+        const auto base = prof::memory_stats();
+        {
+            tl::Tensor<float> a({1000});
+            const auto s = prof::memory_stats();
+            CHECK(ctx, s.current_bytes == base.current_bytes + 4000);
+            CHECK(ctx, s.allocations == base.allocations + 1 && s.live_tensors == base.live_tensors + 1);
+
+            tl::Tensor<float> b = std::move(a);              // ownership moves, nothing new
+            tl::Tensor<float> c = b;                         // a copy is a new buffer
+            CHECK(ctx, prof::memory_stats().current_bytes == base.current_bytes + 8000);
+            c = tl::Tensor<float>({10});                     // move-assign releases c's buffer
+            CHECK(ctx, prof::memory_stats().current_bytes == base.current_bytes + 4040);
+
+            std::swap(b.data, c.data);                       // buffers keep their owners' books
+        }
+        const auto after = prof::memory_stats();
+        CHECK(ctx, after.current_bytes == base.current_bytes);
+        CHECK(ctx, after.live_tensors == base.live_tensors);
+        CHECK(ctx, after.frees == base.frees + 3);
+    }
+
+    {
+        prof::reset_peak_memory();
+        const auto base = prof::memory_stats();
+        CHECK(ctx, base.peak_bytes == base.current_bytes);
+        {
+            tl::Tensor<double> x({100}), y({100});
+        }
+        tl::Tensor<double> z({50});
+        CHECK(ctx, prof::memory_stats().peak_bytes == base.current_bytes + 1600);
+
+        tl::Tensor<double> big({256, 256});
+        const auto top = prof::largest_live_tensors(1);
+        CHECK(ctx, top.size() == 1 && top[0].bytes == 256 * 256 * sizeof(double));
+        CHECK(ctx, top[0].shape == (std::vector<std::size_t>{256, 256}));
+    }
+
+    // ── Per-scope counters ────────────────────────────────────────────────────
+    SUITE(ctx, "Memory — per-scope allocation, peak and net bytes");
+
+    {
+        prof::clear_memory_scopes();
+        tl::Tensor<float> keep({0});
+        {
+            prof::MemoryScope outer("forward");
+            {
+                TL_MEMORY_SCOPE("block");
+                tl::Tensor<float> tmp({10, 100});            // 4000 B, freed at block exit
+                keep = tl::Tensor<float>({500});             // 2000 B, retained
+                std::string owner;
+                for (const auto& r : prof::largest_live_tensors(prof::memory_stats().live_tensors))
+                    if (r.shape == tmp.shape) owner = r.scope;
+                CHECK(ctx, owner == "block");
+            }
+            const auto s = outer.stats();
+            CHECK(ctx, s.allocations == 2 && s.allocated_bytes == 6000);
+            CHECK(ctx, s.peak_bytes == 6000 && s.net_bytes == 2000);
+        }
+        const auto scopes = prof::memory_scopes();
+        CHECK(ctx, scopes.size() == 2 && scopes[0].name == "block" && scopes[1].name == "forward");
+        CHECK(ctx, scopes[0].net_bytes == 2000 && scopes[0].peak_bytes == 6000);
+        CHECK(ctx, scopes[0].largest.size() == 2 && scopes[0].largest[0].shape == (std::vector<std::size_t>{10, 100}));
+
+        std::ostringstream os;
+        prof::dump_memory(os);
+        CHECK(ctx, os.str().find("forward") != std::string::npos && os.str().find("[10,100]") != std::string::npos);
+    }
+#endif
+}
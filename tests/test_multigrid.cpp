@@ -0,0 +1,171 @@
+// tests/test_multigrid.cpp — Tests for tl::pde::Multigrid (standalone and as a CG preconditioner)
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+tl::Tensor<double> smooth_rhs(std::vector<std::size_t> shape) {
+    tl::Tensor<double> f(shape);
+    for (std::size_t i = 0; i < f.data.size(); ++i)
+        f.data[i] = 1.0 + 0.5 * std::sin(0.1 * static_cast<double>(i));
+    return f;
+}
+
+} // namespace
+
+void run_multigrid_tests(tl::TestContext& ctx) {
+
+    using tl::pde::Boundaries;
+    using tl::pde::BoundaryType;
+
+    // ── Level hierarchy ───────────────────────────────────────────────────────
+    SUITE(ctx, "Multigrid — level hierarchy");
+
+    {
+        tl::pde::Multigrid<double> mg({31, 31}, 1.0 / 32, Boundaries<double>::dirichlet(2));
+        CHECK_EQ(ctx, mg.levels(), 5u);              // 31 → 15 → 7 → 3 → 1
+        CHECK_EQ(ctx, mg.level_shape(1)[0], 15u);
+        CHECK_EQ(ctx, mg.level_shape(4)[1], 1u);
+
+        Boundaries<double> mixed = Boundaries<double>::dirichlet(2);
+        mixed.faces[1] = {{{BoundaryType::Periodic, 0.0}, {BoundaryType::Periodic, 0.0}}};
+        tl::pde::Multigrid<double> mp({15, 16}, 1.0 / 16, mixed);
+        CHECK_EQ(ctx, mp.level_shape(1)[0], 7u);
+        CHECK_EQ(ctx, mp.level_shape(1)[1], 8u);
+    }
+
+    CHECK_THROWS(ctx, std::runtime_error,
+        tl::pde::Multigrid<double>({30, 30}, 1.0, Boundaries<double>::dirichlet(2)));
+
+    // ── Standalone V / W cycles ───────────────────────────────────────────────
+    SUITE(ctx, "Multigrid — standalone solve");
+
+    {
+        // Convergence rate is independent of the grid size.
+        tl::linalg::SolverOptions<double> opts;
+        opts.rtol = 1e-8;
+        opts.max_iter = 50;
+
+        std::size_t cycles[2];
+        const std::size_t sizes[2] = {31, 127};
+        for (int k = 0; k < 2; ++k) {
+            const std::size_t n = sizes[k];
+            const double h = 1.0 / static_cast<double>(n + 1);
+            tl::pde::Multigrid<double> mg({n, n}, h, Boundaries<double>::dirichlet(2));
+            auto f = smooth_rhs({n, n});
+            auto u = tl::zeros<double>({n, n});
+            auto res = mg.solve(u, &f, opts);
+            CHECK(ctx, res.converged);
+            cycles[k] = res.iterations;
+        }
+        CHECK(ctx, cycles[0] <= 12);
+        CHECK(ctx, cycles[1] <= cycles[0] + 2);
+    }
+
+    {
+        // Agrees with red-black Gauss-Seidel on a Laplace problem with a hot wall.
+        const std::size_t n = 15;
+        Boundaries<double> bc = Boundaries<double>::dirichlet(2, 0.0);
+        bc.faces[0][0].value = 1.0;
+        tl::linalg::SolverOptions<double> opts;
+        opts.rtol = 1e-11;
+        opts.max_iter = 20000;
+
+        auto ref = tl::zeros<double>({n, n});
+        tl::pde::poisson_gauss_seidel<double>(ref, nullptr, 1.0, bc, 1.0, opts);
+
+        tl::pde::MultigridOptions mopts;
+        mopts.cycle = tl::pde::CycleType::W;
+        tl::pde::Multigrid<double> mg({n, n}, 1.0, bc, mopts);
+        auto u = tl::zeros<double>({n, n});
+        auto res = mg.solve(u, nullptr, opts);
+        CHECK(ctx, res.converged);
+        CHECK(ctx, res.iterations < 20);
+        double diff = 0.0;
+        for (std::size_t i = 0; i < u.data.size(); ++i) diff = std::max(diff, std::abs(u.data[i] - ref.data[i]));
+        CHECK(ctx, diff < 1e-8);
+    }
+
+    {
+        // 3D grid, and a 2D grid periodic along one axis.
+        tl::linalg::SolverOptions<double> opts;
+        opts.rtol = 1e-8;
+        opts.max_iter = 40;
+
+        tl::pde::Multigrid<double> mg3({15, 15, 15}, 1.0 / 16, Boundaries<double>::dirichlet(3));
+        auto f3 = smooth_rhs({15, 15, 15});
+        auto u3 = tl::zeros<double>({15, 15, 15});
+        auto r3 = mg3.solve(u3, &f3, opts);
+        CHECK(ctx, r3.converged);
+        CHECK(ctx, r3.iterations <= 12);
+
+        Boundaries<double> mixed = Boundaries<double>::dirichlet(2);
+        mixed.faces[1] = {{{BoundaryType::Periodic, 0.0}, {BoundaryType::Periodic, 0.0}}};
+        tl::pde::Multigrid<double> mgp({31, 32}, 1.0 / 32, mixed);
+        auto fp = smooth_rhs({31, 32});
+        auto up = tl::zeros<double>({31, 32});
+        auto rp = mgp.solve(up, &fp, opts);
+        CHECK(ctx, rp.converged);
+    }
+
+    // ── Multigrid-preconditioned CG ───────────────────────────────────────────
+    SUITE(ctx, "Multigrid — CG preconditioner");
+
+    {
+        const std::size_t n = 63;
+        const double h = 1.0 / 64;
+        auto bc = Boundaries<double>::dirichlet(2, 0.0);
+        bc.faces[1][1].value = 2.0;
+        auto f = smooth_rhs({n, n});
+
+        tl::pde::PoissonOperator<double> A({n, n}, h, bc);
+        tl::pde::Multigrid<double> mg({n, n}, h, bc);
+        auto b = A.rhs(&f);
+
+        tl::linalg::SolverOptions<double> opts;
+        opts.rtol = 1e-9;
+        opts.max_iter = 2000;
+
+        // The operator and the preconditioner only look at the flat data, so the
+        // Krylov solver can work on 1D views of the 2D grid.
+        b = tl::reshape(b, {n * n});
+        auto x_plain = tl::zeros<double>({n * n});
+        auto plain = tl::linalg::cg(A, b, x_plain, tl::linalg::IdentityPreconditioner<double>{}, opts);
+        auto x_mg = tl::zeros<double>({n * n});
+        auto pre = tl::linalg::cg(A, b, x_mg, mg, opts);
+
+        CHECK(ctx, plain.converged && pre.converged);
+        CHECK(ctx, pre.iterations <= 12);
+        CHECK(ctx, pre.iterations * 5 < plain.iterations);
+
+        // Same answer as the standalone multigrid solve.
+        auto u = tl::zeros<double>({n, n});
+        mg.solve(u, &f, opts);
+        double diff = 0.0;
+        for (std::size_t i = 0; i < u.data.size(); ++i) diff = std::max(diff, std::abs(u.data[i] - x_mg.data[i]));
+        CHECK(ctx, diff < 1e-6);
+    }
+
+    {
+        // One cycle is a symmetric operator even when the coarsest solve is inexact:
+        // <M a, b> == <a, M b>.
+        const std::size_t n = 31;
+        tl::pde::MultigridOptions mopts;
+        mopts.max_levels = 2;
+        mopts.coarse_sweeps = 3;
+        tl::pde::Multigrid<double> mg({n, n}, 1.0 / 32, Boundaries<double>::dirichlet(2), mopts);
+        auto a = smooth_rhs({n * n}), b = tl::zeros<double>({n * n});
+        for (std::size_t i = 0; i < b.data.size(); ++i) b.data[i] = std::cos(0.37 * static_cast<double>(i));
+        auto ma = tl::zeros<double>({n * n}), mb = tl::zeros<double>({n * n});
+        mg.apply(a, ma);
+        mg.apply(b, mb);
+        double lhs = 0.0, rhs = 0.0;
+        for (std::size_t i = 0; i < a.data.size(); ++i) {
+            lhs += ma.data[i] * b.data[i];
+            rhs += a.data[i] * mb.data[i];
+        }
+        CHECK(ctx, std::abs(lhs - rhs) < 1e-12 * std::abs(lhs));
+    }
+}
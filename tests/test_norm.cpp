@@ -0,0 +1,156 @@
+// tests/test_norm.cpp — Tests for tl::nn layer_norm / rms_norm / batch_norm_inference
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+namespace {
+
+tl::Tensor<double> norm_input(std::vector<std::size_t> shape, double offset) {
+    tl::Tensor<double> t(shape);
+    for (std::size_t i = 0; i < t.data.size(); ++i) t.data[i] = offset + std::cos(0.9 * static_cast<double>(i)) * (1.0 + 0.05 * static_cast<double>(i % 13));
+    return t;
+}
+
+// Two-pass layer norm over the last `cols` elements of each row.
+tl::Tensor<double> layer_norm_reference(const tl::Tensor<double>& x, const tl::Tensor<double>& g,
+                                        const tl::Tensor<double>& b, double eps) {
+    const std::size_t cols = g.data.size(), rows = x.data.size() / cols;
+    tl::Tensor<double> y(x.shape);
+    for (std::size_t r = 0; r < rows; ++r) {
+        double mean = 0.0, var = 0.0;
+        for (std::size_t j = 0; j < cols; ++j) mean += x.data[r * cols + j];
+        mean /= double(cols);
+        for (std::size_t j = 0; j < cols; ++j) var += (x.data[r * cols + j] - mean) * (x.data[r * cols + j] - mean);
+        var /= double(cols);
+        for (std::size_t j = 0; j < cols; ++j)
+            y.data[r * cols + j] = (x.data[r * cols + j] - mean) / std::sqrt(var + eps) * g.data[j] + b.data[j];
+    }
+    return y;
+}
+
+} // namespace
+
+void run_norm_tests(tl::TestContext& ctx) {
+
+    // ── LayerNorm / RMSNorm ───────────────────────────────────────────────────
+    SUITE(ctx, "Norm — layer norm and RMS norm");
+
+    {
+        // Row widths around the 8-lane Welford blocking, and a 2D normalised shape.
+        double worst = 0.0;
+        for (std::size_t cols : {1, 5, 8, 17, 64}) {
+            const auto x = norm_input({6, cols}, 0.3);
+            const auto g = norm_input({cols}, 1.0), b = norm_input({cols}, -0.2);
+            worst = std::max(worst, tl::max_abs_diff(tl::nn::layer_norm(x, g, b), layer_norm_reference(x, g, b, 1e-5)));
+        }
+        const auto x3 = norm_input({3, 4, 6}, 0.0);
+        const auto g2 = norm_input({4, 6}, 1.0), b2 = norm_input({4, 6}, 0.5);
+        worst = std::max(worst, tl::max_abs_diff(tl::nn::layer_norm(x3, g2, b2, 1e-3), layer_norm_reference(x3, g2, b2, 1e-3)));
+        CHECK(ctx, worst < 1e-12);
+
+        // Large offset: Welford keeps the variance accurate where E[x^2] - E[x]^2 would not.
+        tl::Tensor<float> big({1, 64});
+        for (std::size_t j = 0; j < 64; ++j) big.data[j] = 1e4f + static_cast<float>(j % 2);
+        tl::Tensor<float> ones({64}), zeros({64});
+        for (auto& v : ones.data) v = 1.0f;
+        const auto yb = tl::nn::layer_norm(big, ones, zeros, 0.0f);
+        CHECK_NEAR(ctx, yb.data[0], -1.0f, 1e-3f);
+        CHECK_NEAR(ctx, yb.data[1], 1.0f, 1e-3f);
+
+        // RMS norm of a constant row is gamma (up to eps).
+        tl::Tensor<double> c({2, 3}, {2.0, 2.0, 2.0, -3.0, 4.0, 0.0});
+        tl::Tensor<double> gam({3}, {1.0, 2.0, 3.0});
+        const auto r = tl::nn::rms_norm(c, gam, 0.0);
+        CHECK_NEAR(ctx, r.data[2], 3.0, 1e-12);
+        const double rms = std::sqrt(25.0 / 3.0);
+        CHECK_NEAR(ctx, r.data[4], 4.0 / rms * 2.0, 1e-12);
+    }
+
+    CHECK_THROWS(ctx, std::runtime_error, tl::nn::layer_norm(tl::Tensor<double>({2, 3}), tl::Tensor<double>({2}), tl::Tensor<double>({2})));
+    CHECK_THROWS(ctx, std::runtime_error, tl::nn::layer_norm(tl::Tensor<double>({2, 3}), tl::Tensor<double>({3}), tl::Tensor<double>({1, 3})));
+    CHECK_THROWS(ctx, std::runtime_error, tl::nn::rms_norm(tl::Tensor<double>({2, 3}), tl::Tensor<double>({2, 2})));
+
+    // ── Inference BatchNorm ───────────────────────────────────────────────────
+    SUITE(ctx, "Norm — folded inference batch norm");
+
+    {
+        const auto x = norm_input({2, 3, 4, 5}, 0.1);
+        tl::Tensor<double> mean({3}, {0.1, -0.4, 0.3}), var({3}, {0.5, 2.0, 1.5});
+        tl::Tensor<double> gamma({3}, {1.2, 0.7, -0.3}), beta({3}, {0.0, 0.25, 1.0});
+        const auto y = tl::nn::batch_norm_inference(x, mean, var, gamma, beta);
+        double worst = 0.0;
+        for (std::size_t i = 0; i < x.data.size(); ++i) {
+            const std::size_t c = (i / 20) % 3;
+            const double ref = (x.data[i] - mean.data[c]) / std::sqrt(var.data[c] + 1e-5) * gamma.data[c] + beta.data[c];
+            worst = std::max(worst, std::abs(y.data[i] - ref));
+        }
+        CHECK(ctx, worst < 1e-12);
+
+        // Channels-last gives the same values, permuted.
+        const auto fold = tl::nn::fold_batch_norm(mean, var, gamma, beta);
+        tl::Tensor<double> xh({2, 4, 5, 3});
+        for (std::size_t n = 0; n < 2; ++n)
+            for (std::size_t c = 0; c < 3; ++c)
+                for (std::size_t p = 0; p < 20; ++p) xh.data[(n * 20 + p) * 3 + c] = x.data[(n * 3 + c) * 20 + p];
+        const auto yh = tl::nn::batch_norm_inference(xh, fold, tl::nn::Layout::NHWC);
+        double err = 0.0;
+        for (std::size_t n = 0; n < 2; ++n)
+            for (std::size_t c = 0; c < 3; ++c)
+                for (std::size_t p = 0; p < 20; ++p)
+                    err = std::max(err, std::abs(yh.data[(n * 20 + p) * 3 + c] - y.data[(n * 3 + c) * 20 + p]));
+        CHECK(ctx, err < 1e-15);
+
+        // [N, C] input (a BatchNorm1d after a linear layer).
+        const auto y2 = tl::nn::batch_norm_inference(norm_input({4, 3}, 0.0), fold);
+        CHECK(ctx, (y2.shape == std::vector<std::size_t>{4, 3}));
+    }
+
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        tl::Tensor<double> s({2}, {1.0, 1.0});
+        tl::nn::batch_norm_inference(tl::Tensor<double>({1, 3, 2, 2}), s, s, s, s);
+    }));
+
+    // ── Backward passes ───────────────────────────────────────────────────────
+    SUITE(ctx, "Norm — autograd gradients");
+
+    {
+        namespace ag = tl::autograd;
+        ag::Parameter<double> X(norm_input({5, 9}, 0.4));
+        ag::Parameter<double> G(norm_input({9}, 1.0));
+        ag::Parameter<double> B(norm_input({9}, 0.0));
+        const auto w = norm_input({5, 9}, -0.1);
+        using Loss = std::function<ag::Var<double>(ag::Tape<double>&)>;
+        const Loss ln = [&](ag::Tape<double>& tp) {
+            return ag::sum(ag::sin(ag::layer_norm(tp.param(X), tp.param(G), tp.param(B))) * tp.input(w));
+        };
+        const Loss rn = [&](ag::Tape<double>& tp) {
+            return ag::sum(ag::sin(ag::rms_norm(tp.param(X), tp.param(G))) * tp.input(w));
+        };
+        auto check = [&](ag::Parameter<double>& p, const Loss& loss) {
+            ag::Tape<double> tape;
+            X.zero_grad(); G.zero_grad(); B.zero_grad();
+            loss(tape).backward();
+            const auto analytic = p.grad;
+            double worst = 0.0;
+            for (std::size_t i = 0; i < p.value.data.size(); ++i) {
+                const double v = p.value.data[i];
+                p.value.data[i] = v + 1e-6;
+                tape.clear();
+                const double up = loss(tape).value().data[0];
+                p.value.data[i] = v - 1e-6;
+                tape.clear();
+                const double down = loss(tape).value().data[0];
+                p.value.data[i] = v;
+                worst = std::max(worst, std::abs(analytic.data[i] - (up - down) / 2e-6));
+            }
+            return worst;
+        };
+        CHECK(ctx, check(X, ln) < 1e-8);
+        CHECK(ctx, check(G, ln) < 1e-8);
+        CHECK(ctx, check(B, ln) < 1e-8);
+        CHECK(ctx, check(X, rn) < 1e-8);
+        CHECK(ctx, check(G, rn) < 1e-8);
+    }
+}
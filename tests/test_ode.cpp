@@ -0,0 +1,261 @@
+// tests/test_ode.cpp — Tests for tl::ode (RK4, Dormand-Prince, batched and stiff integration)
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+// y'' = -y as a first-order system: (x, v)' = (v, -x)
+void oscillator(double, const tl::Tensor<double>& y, tl::Tensor<double>& dy) {
+    dy.data[0] = y.data[1];
+    dy.data[1] = -y.data[0];
+}
+
+// Robertson's chemical kinetics problem (stiffness ratio ~1e11).
+void robertson(double, const tl::Tensor<double>& y, tl::Tensor<double>& dy) {
+    dy.data[0] = -0.04 * y.data[0] + 1e4 * y.data[1] * y.data[2];
+    dy.data[2] = 3e7 * y.data[1] * y.data[1];
+    dy.data[1] = -dy.data[0] - dy.data[2];
+}
+
+void robertson_jac(double, const tl::Tensor<double>& y, tl::Tensor<double>& J) {
+    const double a = y.data[1], b = y.data[2];
+    J.data = {-0.04,  1e4 * b,             1e4 * a,
+               0.04, -1e4 * b - 6e7 * a,  -1e4 * a,
+               0.0,   6e7 * a,             0.0};
+}
+
+} // namespace
+
+void run_ode_tests(tl::TestContext& ctx) {
+
+    auto decay = [](double, const tl::Tensor<double>& y, tl::Tensor<double>& dy) {
+        for (std::size_t i = 0; i < y.data.size(); ++i) dy.data[i] = -y.data[i];
+    };
+
+    // ── Fixed-step RK4 ────────────────────────────────────────────────────────
+    SUITE(ctx, "ODE — RK4");
+
+    {
+        tl::Tensor<double> y({1}, {1.0});
+        auto res = tl::ode::rk4(decay, 0.0, 1.0, y, 20);
+        CHECK(ctx, res.success);
+        CHECK_EQ(ctx, res.fevals, 80u);
+        CHECK_NEAR(ctx, y.data[0], std::exp(-1.0), 1e-7);
+
+        // Fourth order: halving h cuts the error by ~16.
+        tl::Tensor<double> a({1}, {1.0}), b({1}, {1.0});
+        tl::ode::rk4(decay, 0.0, 1.0, a, 10);
+        tl::ode::rk4(decay, 0.0, 1.0, b, 20);
+        const double ratio = std::abs(a.data[0] - std::exp(-1.0)) / std::abs(b.data[0] - std::exp(-1.0));
+        CHECK(ctx, ratio > 14.0 && ratio < 18.0);
+    }
+
+    {
+        // Integrator reuse across calls, and time-dependent right-hand sides.
+        tl::ode::RK4<double> rk({2});
+        tl::Tensor<double> y({2}, {1.0, 0.0});
+        rk.integrate(oscillator, 0.0, 3.14159265358979323846, y, 200);
+        CHECK_NEAR(ctx, y.data[0], -1.0, 1e-8);
+        CHECK_NEAR(ctx, y.data[1], 0.0, 1e-8);
+
+        tl::Tensor<double> q({1}, {0.0});
+        auto ramp = [](double t, const tl::Tensor<double>&, tl::Tensor<double>& dy) { dy.data[0] = 3.0 * t * t; };
+        rk.integrate(ramp, 0.0, 2.0, q, 4);
+        CHECK_NEAR(ctx, q.data[0], 8.0, 1e-12);   // exact for cubic quadrature
+    }
+
+    // ── Adaptive Dormand-Prince ───────────────────────────────────────────────
+    SUITE(ctx, "ODE — Dormand-Prince 5(4)");
+
+    {
+        tl::ode::ODEOptions<double> opts;
+        opts.rtol = 1e-10;
+        opts.atol = 1e-12;
+        tl::Tensor<double> y({2}, {1.0, 0.0});
+        auto res = tl::ode::solve_ivp(oscillator, 0.0, 10.0, y, opts);
+        CHECK(ctx, res.success);
+        CHECK(ctx, res.t == 10.0);
+        CHECK_NEAR(ctx, y.data[0], std::cos(10.0), 1e-8);
+        CHECK_NEAR(ctx, y.data[1], -std::sin(10.0), 1e-8);
+        // FSAL: six evaluations per attempted step plus the start-up calls.
+        CHECK_EQ(ctx, res.fevals, 6 * (res.steps + res.rejected) + 2);
+
+        // Looser tolerance takes far fewer steps.
+        opts.rtol = 1e-4;
+        opts.atol = 1e-6;
+        tl::Tensor<double> z({2}, {1.0, 0.0});
+        auto loose = tl::ode::solve_ivp(oscillator, 0.0, 10.0, z, opts);
+        CHECK(ctx, loose.steps * 4 < res.steps);
+        CHECK_NEAR(ctx, z.data[0], std::cos(10.0), 1e-3);
+    }
+
+    {
+        // Backward integration and the max_step / max_steps limits.
+        tl::Tensor<double> y({3}, {1.0, 2.0, 3.0});
+        tl::ode::ODEOptions<double> opts;
+        opts.max_step = 0.05;
+        auto res = tl::ode::solve_ivp(decay, 1.0, 0.0, y, opts);
+        CHECK(ctx, res.success);
+        CHECK(ctx, res.steps >= 20);
+        CHECK_NEAR(ctx, y.data[2], 3.0 * std::exp(1.0), 1e-6);
+
+        opts.max_steps = 5;
+        tl::Tensor<double> w({1}, {1.0});
+        auto capped = tl::ode::solve_ivp(decay, 0.0, 1.0, w, opts);
+        CHECK(ctx, !capped.success);
+        CHECK(ctx, capped.t < 1.0);
+    }
+
+    {
+        // Dense output is accurate between steps and the observer sees every step.
+        tl::ode::ODEOptions<double> opts;
+        opts.rtol = 1e-9;
+        opts.atol = 1e-12;
+        opts.dense_output = true;
+        std::size_t observed = 0;
+        opts.observer = [&observed](double, const tl::Tensor<double>&) { ++observed; };
+
+        tl::Tensor<double> y({2}, {1.0, 0.0});
+        auto res = tl::ode::solve_ivp(oscillator, 0.0, 6.0, y, opts);
+        CHECK(ctx, res.success);
+        CHECK_EQ(ctx, observed, res.steps);
+        CHECK_EQ(ctx, res.dense.segments(), res.steps);
+
+        double worst = 0.0;
+        for (int i = 0; i <= 60; ++i) {
+            const double t = 0.1 * i;
+            auto yt = res.dense(t);
+            worst = std::max(worst, std::abs(yt.data[0] - std::cos(t)));
+        }
+        CHECK(ctx, worst < 1e-7);
+        CHECK_THROWS(ctx, std::out_of_range, res.dense(6.5));
+    }
+
+    // ── Batched integration ───────────────────────────────────────────────────
+    SUITE(ctx, "ODE — batched systems");
+
+    {
+        // Parameter sweep: row b decays at rate k_b = 0.5 + b / 100.
+        const std::size_t B = 300;
+        auto Y = tl::ones<double>({B, 2});
+        auto sweep = [](std::size_t b, double, const tl::Tensor<double>& y, tl::Tensor<double>& dy) {
+            const double k = 0.5 + static_cast<double>(b) / 100.0;
+            dy.data[0] = -k * y.data[0];
+            dy.data[1] = -2.0 * k * y.data[1];
+        };
+        tl::ode::ODEOptions<double> opts;
+        opts.rtol = 1e-9;
+        opts.atol = 1e-12;
+        auto results = tl::ode::solve_ivp_batch(sweep, 0.0, 1.0, Y, opts);
+        CHECK_EQ(ctx, results.size(), B);
+
+        bool all_ok = true;
+        double worst = 0.0;
+        for (std::size_t b = 0; b < B; ++b) {
+            const double k = 0.5 + static_cast<double>(b) / 100.0;
+            all_ok = all_ok && results[b].success;
+            worst = std::max(worst, std::abs(Y.data[2 * b] - std::exp(-k)));
+            worst = std::max(worst, std::abs(Y.data[2 * b + 1] - std::exp(-2.0 * k)));
+        }
+        CHECK(ctx, all_ok);
+        CHECK(ctx, worst < 1e-8);
+        // Stiffer rows need more steps.
+        CHECK(ctx, results[B - 1].steps > results[0].steps);
+
+        // RK4 batch with an index-free right-hand side matches the unbatched call.
+        tl::Tensor<double> Z({4, 2}, {1, 0, 0, 1, 2, 0, 0.5, 0.5});
+        auto ref = Z;
+        tl::ode::rk4_batch(oscillator, 0.0, 1.0, Z, 50);
+        for (std::size_t b = 0; b < 4; ++b) {
+            tl::Tensor<double> y({2}, {ref.data[2 * b], ref.data[2 * b + 1]});
+            tl::ode::rk4(oscillator, 0.0, 1.0, y, 50);
+            CHECK_NEAR(ctx, Z.data[2 * b], y.data[0], 1e-15);
+            CHECK_NEAR(ctx, Z.data[2 * b + 1], y.data[1], 1e-15);
+        }
+    }
+
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        auto y = tl::ones<double>({4});
+        tl::ode::rk4_batch(oscillator, 0.0, 1.0, y, 10);
+    }));
+    // Bad arguments are rejected before the parallel region, not thrown out of it.
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        auto Y = tl::ones<double>({8, 2});
+        tl::ode::rk4_batch(oscillator, 0.0, 1.0, Y, 0);
+    }));
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        auto Y = tl::ones<double>({8, 2});
+        tl::ode::ODEOptions<double> zero;
+        zero.rtol = zero.atol = 0.0;
+        tl::ode::solve_ivp_batch(oscillator, 0.0, 1.0, Y, zero);
+    }));
+
+    // ── Stiff integrators ─────────────────────────────────────────────────────
+    SUITE(ctx, "ODE — stiff integrators (BDF, Rosenbrock)");
+
+    {
+        // Reference values at t = 40 (Hairer & Wanner).
+        const double ref[3] = {0.7158270687, 9.185534764e-6, 0.2841637457};
+        tl::ode::StiffOptions<double> opts;
+        opts.rtol = 1e-6;
+        opts.atol = 1e-10;
+
+        tl::Tensor<double> y({3}, {1.0, 0.0, 0.0});
+        auto fd = tl::ode::bdf(robertson, 0.0, 40.0, y, opts);
+        CHECK(ctx, fd.success);
+        CHECK_NEAR(ctx, y.data[0], ref[0], 1e-5);
+        CHECK_NEAR(ctx, y.data[1], ref[1], 1e-9);
+        CHECK_NEAR(ctx, y.data[2], ref[2], 1e-5);
+        CHECK_NEAR(ctx, y.data[0] + y.data[1] + y.data[2], 1.0, 1e-10);
+        // The iteration matrix is reused across many steps.
+        CHECK(ctx, fd.lu_decompositions * 3 < fd.steps);
+        CHECK(ctx, fd.jac_evals <= 10);
+
+        tl::Tensor<double> ya({3}, {1.0, 0.0, 0.0});
+        auto an = tl::ode::bdf(robertson, 0.0, 40.0, ya, opts, robertson_jac);
+        CHECK(ctx, an.success);
+        CHECK_NEAR(ctx, ya.data[0], ref[0], 1e-5);
+        CHECK(ctx, an.fevals < fd.fevals);   // no columns of finite differences
+
+        tl::Tensor<double> yr({3}, {1.0, 0.0, 0.0});
+        auto ros = tl::ode::rosenbrock23(robertson, 0.0, 40.0, yr, opts, robertson_jac);
+        CHECK(ctx, ros.success);
+        CHECK_NEAR(ctx, yr.data[0], ref[0], 1e-5);
+        CHECK_NEAR(ctx, yr.data[2], ref[2], 1e-5);
+        CHECK(ctx, ros.lu_decompositions < ros.steps + ros.rejected);
+    }
+
+    {
+        // y' = -1000 (y - cos t): the explicit method is stability-limited.
+        auto stiff = [](double t, const tl::Tensor<double>& y, tl::Tensor<double>& dy) {
+            dy.data[0] = -1000.0 * (y.data[0] - std::cos(t));
+        };
+        const double exact = (1e6 * std::cos(2.0) + 1e3 * std::sin(2.0)) / (1e6 + 1.0);
+        tl::ode::StiffOptions<double> opts;
+
+        tl::Tensor<double> yb({1}, {0.0});
+        auto b = tl::ode::bdf(stiff, 0.0, 2.0, yb, opts);
+        tl::Tensor<double> ye({1}, {0.0});
+        auto e = tl::ode::solve_ivp(stiff, 0.0, 2.0, ye, static_cast<const tl::ode::ODEOptions<double>&>(opts));
+        CHECK(ctx, b.success && e.success);
+        CHECK_NEAR(ctx, yb.data[0], exact, 1e-6);
+        CHECK(ctx, b.steps * 4 < e.steps);
+
+        // Backward integration of a smooth decay with tight tolerances.
+        tl::Tensor<double> yd({2}, {1.0, 2.0});
+        opts.rtol = 1e-9;
+        opts.atol = 1e-12;
+        auto d = tl::ode::bdf(decay, 1.0, 0.0, yd, opts);
+        CHECK(ctx, d.success);
+        CHECK_NEAR(ctx, yd.data[1], 2.0 * std::exp(1.0), 1e-6);
+    }
+
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        tl::ode::StiffOptions<double> opts;
+        opts.dense_output = true;
+        tl::Tensor<double> y({3}, {1.0, 0.0, 0.0});
+        tl::ode::bdf(robertson, 0.0, 1.0, y, opts);
+    }));
+}
@@ -0,0 +1,223 @@
+// tests/test_optim.cpp — Tests for tl::optim (SGD, Adam, AdamW; per-tensor and multi-tensor)
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <cmath>
+#include <vector>
+
+namespace {
+
+using tl::autograd::Parameter;
+
+// Deterministic pseudo-gradient for step s.
+void fake_grads(std::vector<Parameter<double>>& ps, int s) {
+    for (std::size_t k = 0; k < ps.size(); ++k)
+        for (std::size_t i = 0; i < ps[k].grad.data.size(); ++i)
+            ps[k].grad.data[i] = std::sin(0.3 * double(i) + 1.7 * double(k) + 0.9 * s) + 0.1 * ps[k].value.data[i];
+}
+
+std::vector<Parameter<double>> make_params(const std::vector<std::size_t>& sizes) {
+    std::vector<Parameter<double>> ps;
+    for (std::size_t k = 0; k < sizes.size(); ++k) {
+        tl::Tensor<double> v({sizes[k]});
+        for (std::size_t i = 0; i < sizes[k]; ++i) v.data[i] = std::cos(0.5 * double(i) + double(k));
+        ps.emplace_back(std::move(v));
+    }
+    return ps;
+}
+
+std::vector<Parameter<double>*> pointers(std::vector<Parameter<double>>& ps) {
+    std::vector<Parameter<double>*> out;
+    for (auto& p : ps) out.push_back(&p);
+    return out;
+}
+
+double param_diff(const std::vector<Parameter<double>>& a, const std::vector<Parameter<double>>& b) {
+    if (a.size() != b.size()) return 1e30;
+    double worst = 0.0;
+    for (std::size_t k = 0; k < a.size(); ++k) worst = std::max(worst, tl::max_abs_diff(a[k].value, b[k].value));
+    return worst;
+}
+
+} // namespace
+
+void run_optim_tests(tl::TestContext& ctx) {
+
+    namespace opt = tl::optim;
+    const std::vector<std::size_t> sizes{3, 1, 5000, 17, 9000};   // spans several chunks
+
+    // ── Update rules against scalar references ────────────────────────────────
+    SUITE(ctx, "Optim — update rules");
+
+    {
+        // Adam / AdamW, written out longhand for one element.
+        for (bool decoupled : {false, true}) {
+            auto ps = make_params(sizes);
+            opt::AdamOptions<double> o;
+            o.lr = 0.05;
+            o.weight_decay = 0.1;
+            opt::Adam<double> adam(pointers(ps), o);
+            opt::AdamW<double> adamw(pointers(ps), o);
+            double p = ps[2].value.data[7], m = 0.0, v = 0.0;
+            for (int s = 1; s <= 5; ++s) {
+                fake_grads(ps, s);
+                double g = ps[2].grad.data[7];
+                if (!decoupled) g += o.weight_decay * p;
+                m = o.beta1 * m + (1 - o.beta1) * g;
+                v = o.beta2 * v + (1 - o.beta2) * g * g;
+                const double mh = m / (1 - std::pow(o.beta1, s)), vh = v / (1 - std::pow(o.beta2, s));
+                if (decoupled) p *= 1 - o.lr * o.weight_decay;
+                p -= o.lr * mh / (std::sqrt(vh) + o.eps);
+                if (decoupled) adamw.step(); else adam.step();
+            }
+            CHECK_NEAR(ctx, ps[2].value.data[7], p, 1e-12);
+            CHECK_NEAR(ctx, (decoupled ? adamw.exp_avg(2) : adam.exp_avg(2))[7], m, 1e-12);
+        }
+    }
+
+    {
+        // SGD with momentum, Nesterov and weight decay.
+        for (bool nesterov : {false, true}) {
+            auto ps = make_params(sizes);
+            opt::SGDOptions<double> o;
+            o.lr = 0.1;
+            o.momentum = 0.9;
+            o.weight_decay = 0.01;
+            o.nesterov = nesterov;
+            opt::SGD<double> sgd(pointers(ps), o);
+            double p = ps[4].value.data[8001], buf = 0.0;
+            for (int s = 1; s <= 4; ++s) {
+                fake_grads(ps, s);
+                const double g = ps[4].grad.data[8001] + o.weight_decay * p;
+                buf = s == 1 ? g : o.momentum * buf + g;
+                p -= o.lr * (nesterov ? g + o.momentum * buf : buf);
+                sgd.step();
+            }
+            CHECK_NEAR(ctx, ps[4].value.data[8001], p, 1e-12);
+            CHECK_NEAR(ctx, sgd.momentum_buffer(4)[8001], buf, 1e-12);
+        }
+
+        // Plain SGD keeps no state.
+        auto ps = make_params({4});
+        opt::SGD<double> plain(pointers(ps));
+        fake_grads(ps, 0);
+        const double expect = ps[0].value.data[1] - 0.01 * ps[0].grad.data[1];
+        plain.step();
+        CHECK_NEAR(ctx, ps[0].value.data[1], expect, 1e-15);
+        CHECK(ctx, plain.momentum_buffer(0) == nullptr);
+
+        // Options changed between steps: momentum switched on later seeds its buffer then.
+        plain.options().momentum = 0.9;
+        fake_grads(ps, 1);
+        const double g1 = ps[0].grad.data[1], before = ps[0].value.data[1];
+        plain.step();
+        CHECK(ctx, plain.momentum_buffer(0) != nullptr);
+        CHECK_NEAR(ctx, plain.momentum_buffer(0)[1], g1, 1e-15);
+        CHECK_NEAR(ctx, ps[0].value.data[1], before - 0.01 * g1, 1e-15);
+
+        // Switched off and on again: the stale buffer is reseeded, not decayed into.
+        plain.options().momentum = 0.0;
+        fake_grads(ps, 2);
+        plain.step();
+        plain.options().momentum = 0.9;
+        fake_grads(ps, 3);
+        const double g3 = ps[0].grad.data[1];
+        plain.step();
+        CHECK_NEAR(ctx, plain.momentum_buffer(0)[1], g3, 1e-15);
+        plain.options().nesterov = true;
+        plain.options().dampening = 0.5;
+        CHECK_THROWS(ctx, std::runtime_error, plain.step());
+
+        opt::Adam<double> adam(pointers(ps));
+        adam.options().beta1 = 1.5;
+        CHECK_THROWS(ctx, std::runtime_error, adam.step());
+        opt::AdamW<double> adamw(pointers(ps));
+        adamw.options().eps = -1.0;
+        CHECK_THROWS(ctx, std::runtime_error, adamw.step());
+    }
+
+    // ── Multi-tensor mode ─────────────────────────────────────────────────────
+    SUITE(ctx, "Optim — multi-tensor mode and state reuse");
+
+    {
+        auto a = make_params(sizes), b = make_params(sizes);
+        opt::AdamOptions<double> o;
+        opt::AdamOptions<double> om = o;
+        om.multi_tensor = true;
+        opt::AdamW<double> per_tensor(pointers(a), o), batched(pointers(b), om);
+        const double* m0 = batched.exp_avg(0);
+        for (int s = 0; s < 3; ++s) {
+            fake_grads(a, s);
+            fake_grads(b, s);
+            per_tensor.step();
+            batched.step();
+        }
+        CHECK(ctx, param_diff(a, b) == 0.0);
+        CHECK(ctx, batched.exp_avg(0) == m0);     // state buffers allocated once
+        CHECK(ctx, batched.steps() == 3);
+
+        auto c = make_params(sizes), d = make_params(sizes);
+        opt::SGDOptions<double> so;
+        so.momentum = 0.5;
+        opt::SGDOptions<double> sm = so;
+        sm.multi_tensor = true;
+        opt::SGD<double> s1(pointers(c), so), s2(pointers(d), sm);
+        for (int s = 0; s < 3; ++s) {
+            fake_grads(c, s);
+            fake_grads(d, s);
+            s1.step();
+            s2.step();
+        }
+        CHECK(ctx, param_diff(c, d) == 0.0);
+    }
+
+    // ── Training with autograd ────────────────────────────────────────────────
+    SUITE(ctx, "Optim — fitting a linear model");
+
+    {
+        // y = X w* + b*; Adam recovers w*, b*.
+        namespace ag = tl::autograd;
+        tl::Tensor<double> X({32, 3}), Y({32, 1});
+        for (std::size_t i = 0; i < 32; ++i) {
+            for (std::size_t j = 0; j < 3; ++j) X.data[i * 3 + j] = std::sin(0.7 * double(i * (j + 1)) + double(j));
+            Y.data[i] = 2.0 * X.data[i * 3] - 1.0 * X.data[i * 3 + 1] + 0.5 * X.data[i * 3 + 2] + 0.3;
+        }
+        Parameter<double> W(tl::Tensor<double>({3, 1}));
+        Parameter<double> b(tl::Tensor<double>({1}));
+        opt::AdamOptions<double> o;
+        o.lr = 0.05;
+        o.multi_tensor = true;
+        opt::Adam<double> adam({&W, &b}, o);
+        ag::Tape<double> tape;
+        double loss = 0.0;
+        for (int it = 0; it < 600; ++it) {
+            tape.clear();
+            adam.zero_grad();
+            auto l = ag::mean(ag::square(ag::matmul(tape.input(X), tape.param(W)) + tape.param(b) - tape.input(Y)));
+            l.backward();
+            loss = l.value().data[0];
+            adam.step();
+        }
+        CHECK(ctx, loss < 1e-8);
+        CHECK_NEAR(ctx, W.value.data[0], 2.0, 1e-4);
+        CHECK_NEAR(ctx, b.value.data[0], 0.3, 1e-4);
+    }
+
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        auto ps = make_params({2});
+        opt::SGDOptions<double> o;
+        o.nesterov = true;
+        opt::SGD<double> bad(pointers(ps), o);
+    }));
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        auto ps = make_params({2});
+        opt::AdamOptions<double> o;
+        o.beta1 = 1.0;
+        opt::Adam<double> bad(pointers(ps), o);
+    }));
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        auto ps = make_params({2});
+        opt::Adam<double> adam(pointers(ps));
+        ps[0].grad = tl::Tensor<double>({3});
+        adam.step();
+    }));
+}
@@ -0,0 +1,198 @@
+// tests/test_pde.cpp — Tests for tl::pde (stencil engine, heat and Poisson solvers)
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+tl::Tensor<double> bumpy_grid(std::vector<std::size_t> shape) {
+    tl::Tensor<double> u(shape);
+    for (std::size_t i = 0; i < u.data.size(); ++i)
+        u.data[i] = std::sin(0.37 * static_cast<double>(i)) + 0.01 * static_cast<double>(i % 7);
+    return u;
+}
+
+} // namespace
+
+void run_pde_tests(tl::TestContext& ctx) {
+
+    using tl::pde::Stencil;
+    using tl::pde::Boundaries;
+    using tl::pde::BoundaryType;
+
+    // ── Stencil application and boundary conditions ───────────────────────────
+    SUITE(ctx, "PDE — stencil boundary conditions");
+
+    {
+        // Discrete Laplacian of x^2 is exactly 2 away from the boundary.
+        tl::Tensor<double> u({6});
+        for (std::size_t i = 0; i < 6; ++i) u.data[i] = static_cast<double>(i * i);
+        auto lap = Stencil<double>::laplacian(1);
+
+        auto d = tl::pde::apply_stencil(lap, u, Boundaries<double>::dirichlet(1, 0.0));
+        CHECK_NEAR(ctx, d.data[2], 2.0, 1e-12);
+        CHECK_NEAR(ctx, d.data[0], 0.0 - 0.0 + 1.0, 1e-12);      // ghost 0: 0 - 2*0 + 1
+        CHECK_NEAR(ctx, d.data[5], 16.0 - 50.0 + 0.0, 1e-12);    // ghost 0: 16 - 50 + 0
+
+        auto p = tl::pde::apply_stencil(lap, u, Boundaries<double>::periodic(1));
+        CHECK_NEAR(ctx, p.data[0], 25.0 - 0.0 + 1.0, 1e-12);     // left ghost wraps to u[5]
+
+        auto n = tl::pde::apply_stencil(lap, u, Boundaries<double>::neumann(1));
+        CHECK_NEAR(ctx, n.data[0], 2.0 * 1.0 - 0.0, 1e-12);      // mirror: u[-1] = u[1]
+        CHECK_NEAR(ctx, n.data[5], 2.0 * 16.0 - 50.0, 1e-12);    // mirror: u[6] = u[4]
+    }
+
+    // Mixed faces and a 2D cross stencil
+    {
+        tl::Tensor<double> u({2, 2}, {1, 2, 3, 4});
+        Boundaries<double> bc;
+        bc.faces = {{{{BoundaryType::Dirichlet, 10.0}, {BoundaryType::Dirichlet, 20.0}}},
+                    {{{BoundaryType::Periodic, 0.0},   {BoundaryType::Periodic, 0.0}}}};
+        Stencil<double> up(2);
+        up.add({-1, 0}, 1.0);          // value of the row above
+        Stencil<double> left(2);
+        left.add({0, -1}, 1.0);        // value of the column to the left
+        auto a = tl::pde::apply_stencil(up, u, bc);
+        CHECK_NEAR(ctx, a.data[0], 10.0, 1e-12);   // low Dirichlet face
+        CHECK_NEAR(ctx, a.data[2], 1.0, 1e-12);
+        auto b = tl::pde::apply_stencil(left, u, bc);
+        CHECK_NEAR(ctx, b.data[0], 2.0, 1e-12);    // periodic wrap
+        CHECK_NEAR(ctx, b.data[3], 3.0, 1e-12);
+    }
+
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        Boundaries<double> bc;
+        bc.faces = {{{{BoundaryType::Periodic, 0.0}, {BoundaryType::Dirichlet, 0.0}}}};
+        tl::pde::StencilOperator<double> op(Stencil<double>::laplacian(1), {8}, bc);
+    }));
+    CHECK_THROWS(ctx, std::runtime_error,
+        tl::pde::apply_stencil(Stencil<double>::laplacian(2), tl::Tensor<double>({4}),
+                               Boundaries<double>::dirichlet(1)));
+
+    // ── Tiling and temporal blocking give the same answer as plain sweeps ────
+    SUITE(ctx, "PDE — temporal blocking equivalence");
+
+    {
+        const auto step = Stencil<double>::identity(2) + Stencil<double>::laplacian(2) * 0.2;
+        tl::pde::TilingOptions plain{1 << 20, 1 << 20, 1 << 20, 1};
+        tl::pde::TilingOptions tiled{5, 3, 1, 4};   // odd tiles exercise partial edges
+
+        for (auto bc : {Boundaries<double>::dirichlet(2, 1.5),
+                        Boundaries<double>::periodic(2),
+                        Boundaries<double>::neumann(2)}) {
+            auto a = bumpy_grid({11, 13});
+            auto b = a;
+            tl::pde::StencilOperator<double> op_a(step, a.shape, bc, plain);
+            tl::pde::StencilOperator<double> op_b(step, b.shape, bc, tiled);
+            op_a.iterate(a, 10);
+            op_b.iterate(b, 10);
+            CHECK(ctx, tl::max_abs_diff(a, b) < 1e-12);
+        }
+    }
+
+    // 3D grid with a radius-2 stencil and a source term
+    {
+        Stencil<double> s(3);
+        s.add({0, 0, 0}, 0.5).add({0, 0, 2}, 0.1).add({0, 0, -2}, 0.1)
+         .add({1, 0, 0}, 0.1).add({-1, 0, 0}, 0.1).add({0, 1, 0}, 0.05).add({0, -1, 0}, 0.05);
+        auto bc = Boundaries<double>::periodic(3);
+        auto f = bumpy_grid({4, 5, 9});
+        auto a = bumpy_grid({4, 5, 9});
+        auto b = a;
+        tl::pde::StencilOperator<double> op_a(s, a.shape, bc, {1 << 20, 1 << 20, 1 << 20, 1});
+        tl::pde::StencilOperator<double> op_b(s, b.shape, bc, {4, 2, 3, 3});
+        op_a.iterate(a, 7, &f, 0.25);
+        op_b.iterate(b, 7, &f, 0.25);
+        CHECK(ctx, tl::max_abs_diff(a, b) < 1e-12);
+    }
+
+    // ── Heat equation ─────────────────────────────────────────────────────────
+    SUITE(ctx, "PDE — explicit heat equation");
+
+    {
+        // A single Fourier mode decays by exactly (1 - 4 r sin^2(pi k / N))^steps.
+        const std::size_t N = 64, k = 3, steps = 50;
+        const double pi = 3.14159265358979323846;
+        const double r = 0.25;
+        tl::Tensor<double> u({N});
+        for (std::size_t i = 0; i < N; ++i) u.data[i] = std::cos(2.0 * pi * k * i / N);
+        tl::pde::heat_explicit(u, 1.0, r, 1.0, steps, Boundaries<double>::periodic(1));
+        const double factor = std::pow(1.0 - 4.0 * r * std::pow(std::sin(pi * k / N), 2), steps);
+        CHECK_NEAR(ctx, u.data[0], factor, 1e-10);
+        CHECK_NEAR(ctx, tl::sum(u), 0.0, 1e-10);
+    }
+
+    {
+        // Insulated (Neumann) boundaries keep a constant field constant.
+        auto u = tl::full<double>({8, 8}, 3.0);
+        tl::pde::heat_explicit(u, 1.0, 0.2, 1.0, 20, Boundaries<double>::neumann(2));
+        CHECK_NEAR(ctx, tl::min(u), 3.0, 1e-12);
+        CHECK_NEAR(ctx, tl::max(u), 3.0, 1e-12);
+
+        // Hot Dirichlet walls heat a cold plate monotonically.
+        auto v = tl::zeros<double>({8, 8});
+        tl::pde::heat_explicit(v, 1.0, 0.2, 1.0, 200, Boundaries<double>::dirichlet(2, 1.0));
+        CHECK(ctx, tl::min(v) > 0.5);
+        CHECK(ctx, tl::max(v) <= 1.0);
+    }
+
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        auto u = tl::zeros<double>({8, 8});
+        tl::pde::heat_explicit(u, 1.0, 0.3, 1.0, 1, Boundaries<double>::dirichlet(2));
+    }));
+
+    // ── Poisson / Laplace ─────────────────────────────────────────────────────
+    SUITE(ctx, "PDE — Poisson solvers (Jacobi, red-black Gauss-Seidel)");
+
+    {
+        // -u'' = 1 with zero ghosts has the exact discrete solution (i+1)(n-i)/2.
+        const std::size_t n = 20;
+        auto f = tl::ones<double>({n});
+        tl::linalg::SolverOptions<double> opts;
+        opts.rtol = 1e-10;
+        opts.max_iter = 20000;
+
+        auto uj = tl::zeros<double>({n});
+        auto rj = tl::pde::poisson_jacobi(uj, &f, 1.0, Boundaries<double>::dirichlet(1), opts);
+        CHECK(ctx, rj.converged);
+        CHECK_NEAR(ctx, uj.data[9], 10.0 * 11.0 / 2.0, 1e-6);
+
+        auto ug = tl::zeros<double>({n});
+        auto rg = tl::pde::poisson_gauss_seidel(ug, &f, 1.0, Boundaries<double>::dirichlet(1), 1.0, opts);
+        CHECK(ctx, rg.converged);
+        CHECK_NEAR(ctx, ug.data[0], 10.0, 1e-6);
+        CHECK(ctx, rg.iterations < rj.iterations);
+    }
+
+    {
+        // Laplace on a 2D plate with one hot wall: Jacobi, GS and SOR agree.
+        const std::size_t n = 24;
+        Boundaries<double> bc = Boundaries<double>::dirichlet(2, 0.0);
+        bc.faces[0][0].value = 1.0;   // top edge held at 1
+        tl::linalg::SolverOptions<double> opts;
+        opts.rtol = 1e-9;
+        opts.max_iter = 50000;
+
+        auto uj = tl::zeros<double>({n, n});
+        auto rj = tl::pde::poisson_jacobi<double>(uj, nullptr, 1.0, bc, opts);
+        auto ug = tl::zeros<double>({n, n});
+        auto rg = tl::pde::poisson_gauss_seidel<double>(ug, nullptr, 1.0, bc, 1.0, opts);
+        auto us = tl::zeros<double>({n, n});
+        auto rs = tl::pde::poisson_gauss_seidel<double>(us, nullptr, 1.0, bc, 1.8, opts);
+
+        CHECK(ctx, rj.converged && rg.converged && rs.converged);
+        CHECK(ctx, tl::max_abs_diff(uj, ug) < 1e-6);
+        CHECK(ctx, tl::max_abs_diff(ug, us) < 1e-6);
+        CHECK(ctx, rs.iterations < rg.iterations);
+        CHECK(ctx, rg.iterations < rj.iterations);
+        // Maximum principle: solution bounded by the boundary data.
+        CHECK(ctx, tl::min(ug) > 0.0 && tl::max(ug) < 1.0);
+        CHECK(ctx, ug.data[0] > ug.data[(n - 1) * n]);
+    }
+
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        auto u = tl::zeros<double>({4, 4});
+        tl::pde::poisson_gauss_seidel<double>(u, nullptr, 1.0, Boundaries<double>::dirichlet(2), 2.5);
+    }));
+}
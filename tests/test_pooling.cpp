@@ -0,0 +1,207 @@
+// tests/test_pooling.cpp — Tests for tl::nn pooling and upsampling (NCHW and NHWC)
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <cmath>
+#include <functional>
+#include <stdexcept>
+
+namespace {
+
+tl::Tensor<double> wave(std::vector<std::size_t> shape, double phase = 0.0) {
+    tl::Tensor<double> t(shape);
+    for (std::size_t i = 0; i < t.data.size(); ++i) t.data[i] = std::sin(0.71 * static_cast<double>(i) + phase) + 0.01 * static_cast<double>(i);
+    return t;
+}
+
+// [N, C, H, W] -> [N, H, W, C]
+tl::Tensor<double> to_nhwc(const tl::Tensor<double>& x) {
+    const std::size_t N = x.shape[0], C = x.shape[1], H = x.shape[2], W = x.shape[3];
+    tl::Tensor<double> y({N, H, W, C});
+    for (std::size_t n = 0; n < N; ++n)
+        for (std::size_t c = 0; c < C; ++c)
+            for (std::size_t h = 0; h < H; ++h)
+                for (std::size_t w = 0; w < W; ++w) y.data[((n * H + h) * W + w) * C + c] = x.data[((n * C + c) * H + h) * W + w];
+    return y;
+}
+
+double pool_grad_check(tl::autograd::Parameter<double>& p,
+                       const std::function<tl::autograd::Var<double>(tl::autograd::Tape<double>&)>& loss) {
+    tl::autograd::Tape<double> tape;
+    p.zero_grad();
+    loss(tape).backward();
+    const auto analytic = p.grad;
+    double worst = 0.0;
+    for (std::size_t i = 0; i < p.value.data.size(); ++i) {
+        const double v = p.value.data[i];
+        p.value.data[i] = v + 1e-6;
+        tape.clear();
+        const double up = loss(tape).value().data[0];
+        p.value.data[i] = v - 1e-6;
+        tape.clear();
+        const double down = loss(tape).value().data[0];
+        p.value.data[i] = v;
+        worst = std::max(worst, std::abs(analytic.data[i] - (up - down) / 2e-6));
+    }
+    return worst;
+}
+
+} // namespace
+
+void run_pooling_tests(tl::TestContext& ctx) {
+
+    using tl::nn::Layout;
+    using tl::nn::Pool2dOptions;
+
+    // ── Max / average pooling ─────────────────────────────────────────────────
+    SUITE(ctx, "Pooling — max and average");
+
+    {
+        tl::Tensor<double> x({1, 1, 4, 4}, {1, 5, 2, 0,
+                                            3, 4, 8, 1,
+                                            0, 2, 7, 6,
+                                            9, 1, 3, 4});
+        auto r = tl::nn::max_pool2d_with_indices(x);
+        CHECK(ctx, (r.output.shape == std::vector<std::size_t>{1, 1, 2, 2}));
+        CHECK(ctx, r.output.data == std::vector<double>({5, 8, 9, 7}));
+        CHECK(ctx, r.indices.data == std::vector<std::size_t>({1, 6, 12, 10}));
+
+        const auto avg = tl::nn::avg_pool2d(x);
+        CHECK_NEAR(ctx, avg.data[0], 13.0 / 4.0, 1e-12);
+        CHECK_NEAR(ctx, avg.data[3], 20.0 / 4.0, 1e-12);
+
+        // Padded 3x3 window at the corner: 4 valid entries of 9.
+        Pool2dOptions o;
+        o.kernel = {3, 3};
+        o.stride = {1, 1};
+        o.padding = {1, 1};
+        CHECK_NEAR(ctx, tl::nn::avg_pool2d(x, o).data[0], 13.0 / 9.0, 1e-12);
+        o.count_include_pad = false;
+        CHECK_NEAR(ctx, tl::nn::avg_pool2d(x, o).data[0], 13.0 / 4.0, 1e-12);
+        CHECK(ctx, tl::nn::max_pool2d(x, o).data[15] == 7.0);
+
+        const auto dx = tl::nn::max_pool2d_backward(tl::Tensor<double>({1, 1, 2, 2}, {1, 2, 3, 4}), r.indices, x.shape);
+        CHECK(ctx, dx.data[1] == 1.0 && dx.data[6] == 2.0 && dx.data[12] == 3.0 && dx.data[10] == 4.0 && dx.data[0] == 0.0);
+    }
+
+    {
+        // NHWC results equal the NCHW results transposed, for several geometries.
+        const auto x = wave({2, 5, 9, 7});
+        const auto xh = to_nhwc(x);
+        double worst = 0.0;
+        bool same_idx = true;
+        for (std::size_t k : {2, 3}) {
+            for (std::size_t s : {1, 2}) {
+                Pool2dOptions o;
+                o.kernel = {k, k};
+                o.stride = {s, s};
+                o.padding = {k / 2, k / 2};
+                Pool2dOptions oh = o;
+                oh.layout = Layout::NHWC;
+                const auto a = tl::nn::max_pool2d_with_indices(x, o);
+                const auto b = tl::nn::max_pool2d_with_indices(xh, oh);
+                worst = std::max(worst, tl::max_abs_diff(to_nhwc(a.output), b.output));
+                worst = std::max(worst, tl::max_abs_diff(to_nhwc(tl::nn::avg_pool2d(x, o)), tl::nn::avg_pool2d(xh, oh)));
+                const auto dxa = tl::nn::max_pool2d_backward(a.output, a.indices, x.shape);
+                const auto dxb = tl::nn::max_pool2d_backward(b.output, b.indices, xh.shape, Layout::NHWC);
+                worst = std::max(worst, tl::max_abs_diff(to_nhwc(dxa), dxb));
+                // Indices are plane-local (h * W + w) in either layout.
+                const std::size_t P = a.indices.shape[2] * a.indices.shape[3];
+                for (std::size_t i = 0; i < a.indices.data.size(); ++i) {
+                    const std::size_t n = i / (5 * P), c = (i / P) % 5, p = i % P;
+                    same_idx = same_idx && a.indices.data[i] == b.indices.data[(n * P + p) * 5 + c];
+                }
+            }
+        }
+        CHECK(ctx, worst < 1e-12);
+        CHECK(ctx, same_idx);
+
+        const auto g = tl::nn::global_avg_pool2d(x);
+        CHECK(ctx, (g.shape == std::vector<std::size_t>{2, 5, 1, 1}));
+        double ref = 0.0;
+        for (std::size_t i = 0; i < 63; ++i) ref += x.data[63 * 7 + i];
+        CHECK_NEAR(ctx, g.data[7], ref / 63.0, 1e-12);
+        const auto gh = tl::nn::global_avg_pool2d(xh, Layout::NHWC);
+        CHECK(ctx, (gh.shape == std::vector<std::size_t>{2, 1, 1, 5}));
+        CHECK(ctx, tl::max_abs_diff(to_nhwc(g), gh) < 1e-12);
+    }
+
+    CHECK_THROWS(ctx, std::runtime_error, tl::nn::max_pool2d(tl::Tensor<double>({4, 4})));
+    CHECK_THROWS(ctx, std::runtime_error, ({
+        Pool2dOptions o;
+        o.kernel = {2, 2};
+        o.padding = {2, 2};
+        tl::nn::avg_pool2d(tl::Tensor<double>({1, 1, 4, 4}), o);
+    }));
+
+    // ── Upsampling ────────────────────────────────────────────────────────────
+    SUITE(ctx, "Pooling — nearest and bilinear upsampling");
+
+    {
+        tl::Tensor<double> x({1, 1, 2, 2}, {1, 2, 3, 4});
+        const auto n = tl::nn::upsample_nearest2d(x, {4, 4});
+        CHECK(ctx, n.data == std::vector<double>({1, 1, 2, 2, 1, 1, 2, 2, 3, 3, 4, 4, 3, 3, 4, 4}));
+
+        // Half-pixel centres: [1, 2] -> [1, 1.25, 1.75, 2] along each axis.
+        const auto b = tl::nn::upsample_bilinear2d(x, {2, 4});
+        CHECK(ctx, tl::max_abs_diff(b, tl::Tensor<double>({1, 1, 2, 4}, {1, 1.25, 1.75, 2, 3, 3.25, 3.75, 4})) < 1e-12);
+
+        // Corner-aligned sampling reproduces an affine function exactly.
+        tl::Tensor<double> ramp({1, 2, 3, 4});
+        for (std::size_t c = 0; c < 2; ++c)
+            for (std::size_t h = 0; h < 3; ++h)
+                for (std::size_t w = 0; w < 4; ++w) ramp.data[(c * 3 + h) * 4 + w] = 2.0 * h - 0.5 * w + c;
+        const auto up = tl::nn::upsample_bilinear2d(ramp, {5, 7}, true);
+        double err = 0.0;
+        for (std::size_t c = 0; c < 2; ++c)
+            for (std::size_t h = 0; h < 5; ++h)
+                for (std::size_t w = 0; w < 7; ++w)
+                    err = std::max(err, std::abs(up.data[(c * 5 + h) * 7 + w] - (2.0 * (h * 0.5) - 0.5 * (w * 0.5) + c)));
+        CHECK(ctx, err < 1e-12);
+
+        const auto xw = wave({2, 3, 4, 5});
+        const auto xh = to_nhwc(xw);
+        double worst = tl::max_abs_diff(to_nhwc(tl::nn::upsample_nearest2d(xw, {7, 11})),
+                                tl::nn::upsample_nearest2d(xh, {7, 11}, Layout::NHWC));
+        worst = std::max(worst, tl::max_abs_diff(to_nhwc(tl::nn::upsample_bilinear2d(xw, {9, 6})),
+                                         tl::nn::upsample_bilinear2d(xh, {9, 6}, false, Layout::NHWC)));
+        CHECK(ctx, worst < 1e-12);
+    }
+
+    // ── Backward passes ───────────────────────────────────────────────────────
+    SUITE(ctx, "Pooling — autograd gradients");
+
+    {
+        namespace ag = tl::autograd;
+        ag::Parameter<double> X(wave({2, 3, 6, 5}, 0.3));
+        ag::Parameter<double> Xh(to_nhwc(X.value));
+        Pool2dOptions o;
+        o.kernel = {3, 2};
+        o.stride = {2, 1};
+        o.padding = {1, 1};
+        Pool2dOptions oh = o;
+        oh.layout = Layout::NHWC;
+        const auto weights = [](const ag::Var<double>& v) {
+            return ag::sum(ag::square(v) + ag::sin(v));
+        };
+
+        double worst = 0.0;
+        worst = std::max(worst, pool_grad_check(X, [&](ag::Tape<double>& tp) { return weights(ag::max_pool2d(tp.param(X), o)); }));
+        worst = std::max(worst, pool_grad_check(X, [&](ag::Tape<double>& tp) { return weights(ag::avg_pool2d(tp.param(X), o)); }));
+        worst = std::max(worst, pool_grad_check(Xh, [&](ag::Tape<double>& tp) { return weights(ag::max_pool2d(tp.param(Xh), oh)); }));
+        worst = std::max(worst, pool_grad_check(Xh, [&](ag::Tape<double>& tp) { return weights(ag::avg_pool2d(tp.param(Xh), oh)); }));
+        worst = std::max(worst, pool_grad_check(X, [&](ag::Tape<double>& tp) { return weights(ag::global_avg_pool2d(tp.param(X))); }));
+        worst = std::max(worst, pool_grad_check(Xh, [&](ag::Tape<double>& tp) {
+            return weights(ag::global_avg_pool2d(tp.param(Xh), Layout::NHWC));
+        }));
+        worst = std::max(worst, pool_grad_check(X, [&](ag::Tape<double>& tp) {
+            return weights(ag::upsample_nearest2d(tp.param(X), {9, 8}));
+        }));
+        worst = std::max(worst, pool_grad_check(X, [&](ag::Tape<double>& tp) {
+            return weights(ag::upsample_bilinear2d(tp.param(X), {11, 7}));
+        }));
+        worst = std::max(worst, pool_grad_check(Xh, [&](ag::Tape<double>& tp) {
+            return weights(ag::upsample_bilinear2d(tp.param(Xh), {4, 9}, true, Layout::NHWC));
+        }));
+        CHECK(ctx, worst < 1e-6);
+    }
+}
@@ -0,0 +1,104 @@
+// tests/test_profile.cpp — Tests for tl::profile (op timing, shapes, FLOPs, allocations, traces)
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <string>
+#include <vector>
+
+namespace {
+
+std::vector<tl::profile::Event> events_named(const std::string& name) {
+    std::vector<tl::profile::Event> out;
+    for (const auto& e : tl::profile::events())
+        if (e.name == name) out.push_back(e);
+    return out;
+}
+
+} // namespace
+
+void run_profile_tests(tl::TestContext& ctx) {
+
+    namespace prof = tl::profile;
+
+    // ── Scopes and reports ────────────────────────────────────────────────────
+    SUITE(ctx, "Profile — scopes, nesting and reports");
+
+    {
+        {
+            prof::Session session;
+            prof::ScopedOp outer("stage");
+            { prof::ScopedOp inner("step", 10.0); }
+            { prof::ScopedOp inner("step", 6.0); }
+        }
+        CHECK(ctx, !prof::enabled());
+        const auto steps = events_named("step");
+        const auto stage = events_named("stage");
+        CHECK(ctx, steps.size() == 2 && stage.size() == 1);
+        CHECK(ctx, steps[0].depth == 1 && stage[0].depth == 0);
+        CHECK(ctx, stage[0].self_ns == stage[0].duration_ns - steps[0].duration_ns - steps[1].duration_ns);
+        CHECK(ctx, stage[0].start_ns <= steps[0].start_ns);
+
+        const auto rows = prof::summary();
+        bool found = false;
+        for (const auto& r : rows)
+            if (r.name == "step") found = r.calls == 2 && r.flops == 16.0;
+        CHECK(ctx, found && rows.size() == 2);
+
+        const std::string trace = prof::chrome_trace();
+        CHECK(ctx, trace.find("\"traceEvents\"") != std::string::npos);
+        CHECK(ctx, trace.find("\"name\": \"stage\", \"cat\": \"tl\", \"ph\": \"X\"") != std::string::npos);
+    }
+
+    {
+        // Nothing is recorded outside a session.
+        prof::clear();
+        { prof::ScopedOp op("idle"); }
+        CHECK(ctx, prof::events().empty());
+    }
+
+#ifdef TL_PROFILE
+    // ── Instrumented kernels ──────────────────────────────────────────────────
+    SUITE(ctx, "Profile — instrumented kernels");
+
+    {
+        tl::Tensor<float> x({4, 3}), w({3, 5}), b({5});
+        {
+            prof::Session session;
+            TL_PROFILE_SCOPE("layer");
+            auto y = tl::functional::relu(tl::linalg::matmul(x, w) + b);
+            (void)tl::sum(y);
+        }
+        const auto mm = events_named("matmul");
+        CHECK(ctx, mm.size() == 1);
+        CHECK(ctx, mm[0].flops == 2.0 * 4 * 5 * 3);
+        CHECK(ctx, mm[0].shapes == "[4,3] [3,5]");
+        CHECK(ctx, mm[0].bytes_allocated == 4 * 5 * sizeof(float));
+        CHECK(ctx, mm[0].depth == 1);
+
+        const auto add = events_named("add");
+        CHECK(ctx, add.size() == 1 && add[0].shapes == "[4,5] [5]" && add[0].flops == 20.0);
+        CHECK(ctx, events_named("relu").size() == 1 && events_named("sum").size() == 1);
+
+        // The enclosing scope sees every allocation; its own share is zero.
+        const auto layer = events_named("layer");
+        CHECK(ctx, layer.size() == 1);
+        CHECK(ctx, layer[0].bytes_allocated == 3 * 4 * 5 * sizeof(float));
+        CHECK(ctx, layer[0].self_bytes_allocated == 0);
+
+        // Disabled at run time: the hooks stay silent.
+        (void)tl::linalg::matmul(x, w);
+        CHECK(ctx, events_named("matmul").size() == 1);
+    }
+
+    {
+        tl::Tensor<int> mask({2, 3});
+        tl::Tensor<float> v({3});
+        {
+            prof::Session session;
+            (void)(mask * v);
+            (void)tl::functional::softmax(v);
+        }
+        CHECK(ctx, events_named("mul").size() == 1 && events_named("mul")[0].flops == 6.0);
+        CHECK(ctx, events_named("softmax").size() == 1);
+    }
+#endif
+}
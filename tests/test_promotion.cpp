@@ -0,0 +1,106 @@
+// tests/test_promotion.cpp — Tests for mixed-dtype operators and type promotion
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+
+void run_promotion_tests(tl::TestContext& ctx) {
+
+    using tl::promote_t;
+
+    // ── Promotion table ───────────────────────────────────────────────────────
+    SUITE(ctx, "Promotion — result types");
+
+    static_assert(std::is_same_v<promote_t<int, float>, float>);
+    static_assert(std::is_same_v<promote_t<float, double>, double>);
+    static_assert(std::is_same_v<promote_t<bool, std::int8_t>, std::int8_t>);
+    static_assert(std::is_same_v<promote_t<std::int16_t, std::int64_t>, std::int64_t>);
+    static_assert(std::is_same_v<promote_t<std::uint8_t, std::int8_t>, std::int16_t>);
+    static_assert(std::is_same_v<promote_t<std::uint8_t, std::int32_t>, std::int32_t>);
+    static_assert(std::is_same_v<promote_t<std::uint32_t, std::int32_t>, std::int64_t>);
+    static_assert(std::is_same_v<promote_t<std::uint64_t, std::int64_t>, double>);
+    static_assert(std::is_same_v<promote_t<std::uint16_t, std::uint32_t>, std::uint32_t>);
+    static_assert(std::is_same_v<promote_t<tl::float16, float>, float>);
+    static_assert(std::is_same_v<promote_t<tl::float16, tl::bfloat16>, float>);
+    static_assert(std::is_same_v<promote_t<int, tl::bfloat16>, tl::bfloat16>);
+    static_assert(std::is_same_v<promote_t<double, float>, promote_t<float, double>>);
+    static_assert(std::is_same_v<tl::scalar_promote_t<int, double>, double>);
+    static_assert(std::is_same_v<tl::scalar_promote_t<float, double>, float>);
+    CHECK(ctx, true);
+
+    // ── Tensor op Tensor ──────────────────────────────────────────────────────
+    SUITE(ctx, "Promotion — mixed tensor operators");
+
+    {
+        tl::Tensor<int> mask({2, 3}, {1, 0, 1, 0, 1, 1});
+        tl::Tensor<float> x({2, 3}, {0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f});
+        const auto y = x * mask;
+        static_assert(std::is_same_v<decltype(y), const tl::Tensor<float>>);
+        CHECK(ctx, y.data == (std::vector<float>{0.5f, 0.0f, 2.5f, 0.0f, 4.5f, 5.5f}));
+
+        const auto d = mask / tl::Tensor<double>({2, 3}, {2, 2, 4, 4, 8, 8});
+        static_assert(std::is_same_v<decltype(d), const tl::Tensor<double>>);
+        CHECK(ctx, d.data[0] == 0.5 && d.data[5] == 0.125);
+
+        // Broadcasting: int column against a float row.
+        tl::Tensor<int> col({2, 1}, {10, 20});
+        tl::Tensor<float> row({3}, {0.25f, 0.5f, 0.75f});
+        const auto s = col + row;
+        CHECK(ctx, s.shape == (std::vector<std::size_t>{2, 3}));
+        CHECK(ctx, s.data == (std::vector<float>{10.25f, 10.5f, 10.75f, 20.25f, 20.5f, 20.75f}));
+        const auto m = row - col;
+        CHECK(ctx, m.data[3] == -19.75f);
+        CHECK_THROWS(ctx, std::runtime_error, tl::Tensor<int>({4}) + tl::Tensor<float>({3}));
+    }
+
+    {
+        // Mixed signedness widens instead of wrapping.
+        tl::Tensor<std::uint8_t> u({3}, {200, 255, 0});
+        tl::Tensor<std::int8_t> i({3}, {-100, 100, -128});
+        const auto r = u - i;
+        static_assert(std::is_same_v<decltype(r), const tl::Tensor<std::int16_t>>);
+        CHECK(ctx, r.data == (std::vector<std::int16_t>{300, 155, 128}));
+
+        // float16 activations against float accumulators give float.
+        tl::Tensor<tl::float16> h({2}, {1.5f, -2.0f});
+        tl::Tensor<float> acc({2}, {0.125f, 1024.0f});
+        const auto f = h + acc;
+        static_assert(std::is_same_v<decltype(f), const tl::Tensor<float>>);
+        CHECK(ctx, f.data[0] == 1.625f && f.data[1] == 1022.0f);
+    }
+
+    // ── In-place and scalars ──────────────────────────────────────────────────
+    SUITE(ctx, "Promotion — in-place and weak scalars");
+
+    {
+        tl::Tensor<double> acc({3}, {1.0, 2.0, 3.0});
+        acc += tl::Tensor<float>({3}, {0.5f, 0.25f, 0.125f});
+        acc *= tl::Tensor<int>({3}, {2, 2, 2});
+        CHECK(ctx, acc.data == (std::vector<double>{3.0, 4.5, 6.25}));
+        CHECK_THROWS(ctx, std::runtime_error, acc -= tl::Tensor<int>({2}));
+
+        tl::Tensor<int> counts({3}, {1, 2, 3});
+        counts += tl::Tensor<float>({3}, {0.75f, 0.75f, 0.75f});   // keeps int: truncates like a cast
+        CHECK(ctx, counts.data == (std::vector<int>{1, 2, 3}));
+    }
+
+    {
+        tl::Tensor<int> t({3}, {1, 2, 3});
+        const auto a = t * 2.5;
+        static_assert(std::is_same_v<decltype(a), const tl::Tensor<double>>);
+        CHECK(ctx, a.data == (std::vector<double>{2.5, 5.0, 7.5}));
+        const auto b = 1.0f / t;
+        static_assert(std::is_same_v<decltype(b), const tl::Tensor<float>>);
+        CHECK(ctx, b.data[1] == 0.5f);
+        CHECK(ctx, (t - 0.5f).data[0] == 0.5f && (0.5 + t).data[2] == 3.5);
+
+        // Same-kind scalars keep the tensor's type.
+        tl::Tensor<float> x({2}, {1.0f, 2.0f});
+        const auto c = x * 2.0;
+        static_assert(std::is_same_v<decltype(c), const tl::Tensor<float>>);
+        const auto k = t + 1;
+        static_assert(std::is_same_v<decltype(k), const tl::Tensor<int>>);
+        CHECK(ctx, c.data[1] == 4.0f && k.data[2] == 4);
+    }
+}
@@ -0,0 +1,163 @@
+// tests/test_quant.cpp — Tests for tl::quant (affine int8 quantisation, qgemm, qlinear)
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+tl::Tensor<std::int32_t> naive_qgemm(const tl::Tensor<std::uint8_t>& a, const tl::Tensor<std::int8_t>& b) {
+    const std::size_t M = a.shape[0], K = a.shape[1], N = b.shape[1];
+    tl::Tensor<std::int32_t> c({M, N});
+    for (std::size_t i = 0; i < M; ++i)
+        for (std::size_t k = 0; k < K; ++k)
+            for (std::size_t n = 0; n < N; ++n) c.data[i * N + n] += std::int32_t(a.data[i * K + k]) * b.data[k * N + n];
+    return c;
+}
+
+// Float reference on the dequantised operands: x @ W + bias, optionally ReLU.
+tl::Tensor<float> quant_ref_linear(const tl::Tensor<float>& x, const tl::Tensor<float>& w, const tl::Tensor<float>& bias, bool relu) {
+    auto y = tl::linalg::matmul(x, w) + bias;
+    if (relu) for (auto& v : y.data) v = std::max(v, 0.0f);
+    return y;
+}
+
+} // namespace
+
+void run_quant_tests(tl::TestContext& ctx) {
+
+    namespace q = tl::quant;
+    tl::random::Generator gen(2024);
+
+    // ── Parameters and round trips ────────────────────────────────────────────
+    SUITE(ctx, "Quant — affine parameters, quantize / dequantize");
+
+    {
+        tl::Tensor<float> x({5}, {-1.0f, 0.0f, 0.5f, 2.0f, 3.0f});
+        const auto p = q::choose_qparams<std::uint8_t>(x);
+        CHECK_NEAR(ctx, p.scale[0], 4.0f / 255.0f, 1e-7f);
+        CHECK(ctx, p.zero_point[0] == 64 && !p.per_channel());
+        const auto xq = q::quantize<std::uint8_t>(x, p);
+        CHECK(ctx, xq.values.data[1] == 64);                     // zero is exact
+        CHECK(ctx, xq.values.data[0] == 0);
+
+        const auto s = q::choose_qparams<std::int8_t>(x, true);
+        CHECK(ctx, s.zero_point[0] == 0);
+        CHECK_NEAR(ctx, s.scale[0], 3.0f / 127.0f, 1e-7f);
+        const auto su = q::choose_qparams<std::uint8_t>(x, true);
+        CHECK(ctx, su.zero_point[0] == 128);
+
+        const auto zeros = q::choose_qparams<std::int8_t>(tl::zeros<float>({4}));
+        CHECK(ctx, zeros.scale[0] == 1.0f);
+    }
+
+    {
+        const auto x = tl::random::uniform<float>({64, 33}, -2.0f, 5.0f, gen);
+        const auto xq = q::quantize<std::uint8_t>(x);
+        const auto back = q::dequantize(xq);
+        double worst = 0.0;
+        for (std::size_t i = 0; i < x.data.size(); ++i) worst = std::max(worst, double(std::abs(back.data[i] - x.data[i])));
+        CHECK(ctx, worst <= 0.5 * xq.params.scale[0] + 1e-6);
+
+        // Per-channel along axis 1: each column gets its own range.
+        tl::Tensor<float> w({40, 6});
+        for (std::size_t k = 0; k < 40; ++k)
+            for (std::size_t n = 0; n < 6; ++n) w.data[k * 6 + n] = std::sin(0.3f * float(k) + float(n)) * float(n + 1);
+        const auto pw = q::choose_qparams<std::int8_t>(w, 1, true);
+        CHECK(ctx, pw.axis == 1 && pw.scale.size() == 6);
+        CHECK(ctx, pw.scale[5] > 4.0f * pw.scale[0]);
+        const auto wq = q::quantize<std::int8_t>(w, pw);
+        const auto wb = q::dequantize(wq);
+        bool within = true;
+        for (std::size_t k = 0; k < 40; ++k)
+            for (std::size_t n = 0; n < 6; ++n)
+                within = within && std::abs(wb.data[k * 6 + n] - w.data[k * 6 + n]) <= 0.5f * pw.scale[n] + 1e-6f;
+        CHECK(ctx, within);
+
+        // Per-channel along a leading axis of a 3-D tensor.
+        const auto t = tl::random::normal<float>({3, 4, 5}, 0.0f, 1.0f, gen);
+        const auto pt = q::choose_qparams<std::uint8_t>(t, 0, false);
+        const auto tb = q::dequantize<double>(q::quantize<std::uint8_t>(t, pt));
+        bool ok = true;
+        for (std::size_t i = 0; i < t.data.size(); ++i) ok = ok && std::abs(tb.data[i] - t.data[i]) <= 0.5 * pt.scale[i / 20] + 1e-6;
+        CHECK(ctx, ok);
+    }
+
+    {
+        const auto x = tl::ones<float>({2, 3});
+        q::QParams bad;
+        bad.scale = {1.0f, 1.0f};
+        bad.zero_point = {0, 0};
+        CHECK_THROWS(ctx, std::runtime_error, q::quantize<std::int8_t>(x, bad));
+        CHECK_THROWS(ctx, std::runtime_error, q::choose_qparams<std::int8_t>(x, 2, true));
+    }
+
+    // ── qgemm ─────────────────────────────────────────────────────────────────
+    SUITE(ctx, "Quant — int8 GEMM");
+
+    {
+        // Odd sizes exercise the K tail group, the partial row tile and the partial panel.
+        for (auto dims : {std::vector<std::size_t>{7, 37, 21}, std::vector<std::size_t>{1, 1, 1}, std::vector<std::size_t>{33, 256, 48}}) {
+            const std::size_t M = dims[0], K = dims[1], N = dims[2];
+            const auto a = tl::random::randint<std::uint8_t>({M, K}, 0, 256, gen);
+            q::QTensor<std::int8_t> b{tl::random::randint<std::int8_t>({K, N}, -128, 128, gen), q::QParams{{1.0f}, {0}, -1}};
+            const auto c = q::qgemm(a, q::PackedWeights(b));
+            CHECK(ctx, c.shape == (std::vector<std::size_t>{M, N}) && c.data == naive_qgemm(a, b.values).data);
+        }
+
+        q::QTensor<std::int8_t> w{tl::Tensor<std::int8_t>({8, 4}), q::QParams{{1.0f}, {0}, -1}};
+        CHECK_THROWS(ctx, std::runtime_error, q::qgemm(tl::Tensor<std::uint8_t>({2, 9}), q::PackedWeights(w)));
+        q::QTensor<std::int8_t> rows_wise{tl::Tensor<std::int8_t>({8, 4}), q::QParams{std::vector<float>(8, 1.0f), std::vector<std::int32_t>(8, 0), 0}};
+        CHECK_THROWS(ctx, std::runtime_error, q::PackedWeights{rows_wise});
+    }
+
+    // ── qlinear epilogue ──────────────────────────────────────────────────────
+    SUITE(ctx, "Quant — qlinear with bias, ReLU and requantisation");
+
+    {
+        const std::size_t M = 9, K = 50, N = 19;
+        const auto x = tl::random::uniform<float>({M, K}, -1.0f, 2.0f, gen);
+        const auto w = tl::random::normal<float>({K, N}, 0.1f, 0.3f, gen);
+        const auto bias = tl::random::uniform<float>({N}, -0.5f, 0.5f, gen);
+        const auto xq = q::quantize<std::uint8_t>(x);
+        const auto xd = q::dequantize(xq);
+
+        // Symmetric per-channel weights (zero points 0) and asymmetric ones (non-zero).
+        for (bool symmetric : {true, false}) {
+            const auto wq = q::quantize<std::int8_t>(w, q::choose_qparams<std::int8_t>(w, 1, symmetric));
+            const q::PackedWeights wp(wq);
+            CHECK(ctx, wp.has_zero_point() == !symmetric);
+            for (bool relu : {false, true}) {
+                const auto ref = quant_ref_linear(xd, q::dequantize(wq), bias, relu);
+                const auto y = q::qlinear(xq, wp, bias, relu);
+                double worst = 0.0;
+                for (std::size_t i = 0; i < ref.data.size(); ++i) worst = std::max(worst, double(std::abs(y.data[i] - ref.data[i])));
+                CHECK(ctx, worst < 1e-4);
+            }
+
+            // Requantised output lands within one step of quantising the float result.
+            const auto ref = quant_ref_linear(xd, q::dequantize(wq), bias, true);
+            const auto out = q::choose_qparams<std::uint8_t>(ref);
+            const auto yq = q::qlinear(xq, wp, bias, out, true);
+            const auto expect = q::quantize<std::uint8_t>(ref, out);
+            int diff = 0;
+            for (std::size_t i = 0; i < ref.data.size(); ++i) diff = std::max(diff, std::abs(int(yq.values.data[i]) - int(expect.values.data[i])));
+            CHECK(ctx, diff <= 1);
+            CHECK(ctx, yq.params.scale[0] == out.scale[0]);
+        }
+
+        // End to end against the unquantised float layer.
+        const auto wq = q::quantize<std::int8_t>(w, q::choose_qparams<std::int8_t>(w, 1, true));
+        const auto y = q::qlinear(xq, q::PackedWeights(wq), bias);
+        const auto ref = quant_ref_linear(x, w, bias, false);
+        double num = 0.0, den = 0.0;
+        for (std::size_t i = 0; i < ref.data.size(); ++i) {
+            num += double(y.data[i] - ref.data[i]) * (y.data[i] - ref.data[i]);
+            den += double(ref.data[i]) * ref.data[i];
+        }
+        CHECK(ctx, std::sqrt(num / den) < 0.02);
+        CHECK_THROWS(ctx, std::runtime_error, q::qlinear(xq, q::PackedWeights(wq), tl::zeros<float>({N + 1})));
+    }
+}
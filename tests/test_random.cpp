@@ -0,0 +1,148 @@
+// tests/test_random.cpp — Tests for tl::random (Philox generator, factories) and nn::dropout
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+
+namespace {
+
+template <typename T>
+double sample_mean(const tl::Tensor<T>& t) {
+    double s = 0.0;
+    for (auto v : t.data) s += static_cast<double>(v);
+    return s / static_cast<double>(t.data.size());
+}
+
+template <typename T>
+double sample_var(const tl::Tensor<T>& t) {
+    const double m = sample_mean(t);
+    double s = 0.0;
+    for (auto v : t.data) s += (static_cast<double>(v) - m) * (static_cast<double>(v) - m);
+    return s / static_cast<double>(t.data.size());
+}
+
+} // namespace
+
+void run_random_tests(tl::TestContext& ctx) {
+
+    namespace rnd = tl::random;
+
+    // ── Philox stream ─────────────────────────────────────────────────────────
+    SUITE(ctx, "Random — Philox4x32-10 stream");
+
+    {
+        // Known-answer vectors from the Random123 distribution.
+        const auto a = rnd::detail::philox4x32(0, 0, 0, 0, 0, 0);
+        CHECK(ctx, a.w[0] == 0x6627e8d5u && a.w[1] == 0xe169c58du && a.w[2] == 0xbc57ac4cu && a.w[3] == 0x9b00dbd8u);
+        const auto b = rnd::detail::philox4x32(0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu, 0xffffffffu);
+        CHECK(ctx, b.w[0] == 0x408f276du && b.w[1] == 0x41c83b0eu && b.w[2] == 0xa20bc7c6u && b.w[3] == 0x6d5451fdu);
+        const auto c = rnd::detail::philox4x32(0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u, 0xa4093822u, 0x299f31d0u);
+        CHECK(ctx, c.w[0] == 0xd16cfe09u && c.w[1] == 0x94fdccebu && c.w[2] == 0x5001e420u && c.w[3] == 0x24126ea1u);
+    }
+
+    {
+        // Every element is a function of (seed, offset, index) alone, so a large
+        // parallel fill matches blocks computed one at a time.
+        rnd::Generator gen(1234);
+        gen.set_offset(77);
+        const auto t = rnd::randint<std::int64_t>({100003}, 0, std::int64_t(1) << 32, gen);
+        bool match = true;
+        for (std::size_t i : {std::size_t(0), std::size_t(5), std::size_t(65537), std::size_t(100002)}) {
+            const std::uint64_t ctr = 77 + i / 4;
+            const auto blk = rnd::detail::philox4x32(std::uint32_t(ctr), std::uint32_t(ctr >> 32), 0, 0, 1234u, 0u);
+            match = match && t.data[i] == std::int64_t(blk.w[i % 4]);
+        }
+        CHECK(ctx, match);
+        CHECK(ctx, gen.offset() == 77 + (100003 + 3) / 4);
+
+        // Same seed -> same numbers; successive calls -> fresh numbers; manual_seed rewinds.
+        rnd::Generator g1(9), g2(9);
+        const auto u1 = rnd::uniform<float>({1000}, 0.0f, 1.0f, g1);
+        const auto u2 = rnd::uniform<float>({1000}, 0.0f, 1.0f, g2);
+        const auto u3 = rnd::uniform<float>({1000}, 0.0f, 1.0f, g1);
+        CHECK(ctx, u1.data == u2.data);
+        CHECK(ctx, u1.data != u3.data);
+        g1.manual_seed(9);
+        CHECK(ctx, rnd::uniform<float>({1000}, 0.0f, 1.0f, g1).data == u1.data);
+
+        // A split fill equals one fill over the concatenation when offsets line up.
+        rnd::Generator whole(5), parts(5);
+        const auto w = rnd::normal<double>({20}, 0.0, 1.0, whole);
+        const auto p0 = rnd::normal<double>({8}, 0.0, 1.0, parts);
+        const auto p1 = rnd::normal<double>({12}, 0.0, 1.0, parts);
+        bool same = true;
+        for (std::size_t i = 0; i < 8; ++i) same = same && w.data[i] == p0.data[i];
+        for (std::size_t i = 0; i < 12; ++i) same = same && w.data[8 + i] == p1.data[i];
+        CHECK(ctx, same);
+    }
+
+    // ── Distributions ─────────────────────────────────────────────────────────
+    SUITE(ctx, "Random — distribution moments");
+
+    {
+        rnd::Generator gen(42);
+        const auto u = rnd::uniform<double>({200000}, -1.0, 3.0, gen);
+        CHECK_NEAR(ctx, sample_mean(u), 1.0, 0.02);
+        CHECK_NEAR(ctx, sample_var(u), 16.0 / 12.0, 0.02);
+        double lo = 1e9, hi = -1e9;
+        for (auto v : u.data) { lo = std::min(lo, v); hi = std::max(hi, v); }
+        CHECK(ctx, lo >= -1.0 && hi < 3.0);
+
+        const auto n = rnd::normal<float>({200001}, 2.0f, 0.5f, gen);   // odd size exercises the tail
+        CHECK_NEAR(ctx, sample_mean(n), 2.0, 0.01);
+        CHECK_NEAR(ctx, sample_var(n), 0.25, 0.01);
+        bool finite = true;
+        for (auto v : n.data) finite = finite && std::isfinite(v);
+        CHECK(ctx, finite);
+
+        const auto b = rnd::bernoulli<float>({100000}, 0.3, gen);
+        CHECK_NEAR(ctx, sample_mean(b), 0.3, 0.01);
+
+        const auto r = rnd::randint<int>({50000}, -3, 4, gen);
+        std::size_t hist[7] = {};
+        bool in_range = true;
+        for (auto v : r.data) {
+            in_range = in_range && v >= -3 && v < 4;
+            if (v >= -3 && v < 4) ++hist[v + 3];
+        }
+        CHECK(ctx, in_range);
+        CHECK(ctx, *std::min_element(hist, hist + 7) > 6500);
+
+        tl::Tensor<double> f({3, 3});
+        rnd::fill_uniform(f, 5.0, 5.0, gen);
+        CHECK(ctx, f.data[4] == 5.0);
+    }
+
+    CHECK_THROWS(ctx, std::runtime_error, rnd::randint<int>({4}, 3, 3));
+    CHECK_THROWS(ctx, std::runtime_error, rnd::bernoulli<float>({4}, 1.5));
+    CHECK_THROWS(ctx, std::runtime_error, rnd::uniform<float>({4}, 1.0f, 0.0f));
+
+    // ── Dropout ───────────────────────────────────────────────────────────────
+    SUITE(ctx, "Random — dropout");
+
+    {
+        rnd::Generator gen(7);
+        const auto x = tl::ones<double>({50000});
+        const auto y = tl::nn::dropout(x, 0.25, gen);
+        std::size_t zeros = 0;
+        bool scaled = true;
+        for (auto v : y.data) {
+            if (v == 0.0) ++zeros;
+            else scaled = scaled && std::abs(v - 1.0 / 0.75) < 1e-15;
+        }
+        CHECK(ctx, scaled);
+        CHECK_NEAR(ctx, double(zeros) / 50000.0, 0.25, 0.01);
+        CHECK(ctx, tl::nn::dropout(x, 0.25, gen, false).data == x.data);
+
+        // Backward regenerates the forward mask from the counter.
+        namespace ag = tl::autograd;
+        ag::Parameter<double> P(tl::ones<double>({4099}));
+        ag::Tape<double> tape;
+        auto out = ag::dropout(tape.param(P), 0.5, gen);
+        ag::sum(out).backward();
+        CHECK(ctx, P.grad.data == out.value().data);
+    }
+
+    CHECK_THROWS(ctx, std::runtime_error, tl::nn::dropout(tl::ones<double>({3}), 1.0));
+}
@@ -0,0 +1,197 @@
+// tests/test_softmax.cpp — Tests for functional::softmax / log_softmax / cross-entropy
+#include "test.hpp"
+#include "../tl/tl.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+// Two-pass reference along the last axis of a [rows, cols] tensor.
+tl::Tensor<double> softmax_reference(const tl::Tensor<double>& x) {
+    const std::size_t R = x.shape[0], C = x.shape[1];
+    tl::Tensor<double> y(x.shape);
+    for (std::size_t r = 0; r < R; ++r) {
+        double m = x.data[r * C];
+        for (std::size_t c = 1; c < C; ++c) m = std::max(m, x.data[r * C + c]);
+        double s = 0.0;
+        for (std::size_t c = 0; c < C; ++c) s += std::exp(x.data[r * C + c] - m);
+        for (std::size_t c = 0; c < C; ++c) y.data[r * C + c] = std::exp(x.data[r * C + c] - m) / s;
+    }
+    return y;
+}
+
+tl::Tensor<double> logits_like(std::vector<std::size_t> shape, double scale) {
+    tl::Tensor<double> t(shape);
+    for (std::size_t i = 0; i < t.data.size(); ++i) t.data[i] = scale * std::sin(1.3 * static_cast<double>(i) + 0.2);
+    return t;
+}
+
+} // namespace
+
+void run_softmax_tests(tl::TestContext& ctx) {
+
+    namespace F = tl::functional;
+
+    // ── Softmax / log-softmax ─────────────────────────────────────────────────
+    SUITE(ctx, "Softmax — fused online softmax and log-softmax");
+
+    {
+        // Row lengths straddle the 8-lane blocking.
+        for (std::size_t cols : {1, 3, 8, 13, 40}) {
+            const auto x = logits_like({5, cols}, 3.0);
+            const auto y = F::softmax(x);
+            CHECK(ctx, tl::max_abs_diff(y, softmax_reference(x)) < 1e-14);
+            const auto ly = F::log_softmax(x);
+            double err = 0.0;
+            for (std::size_t i = 0; i < y.data.size(); ++i) err = std::max(err, std::abs(std::exp(ly.data[i]) - y.data[i]));
+            CHECK(ctx, err < 1e-14);
+        }
+
+        // Huge logits: no overflow, and exactly the shifted result.
+        tl::Tensor<double> big({2, 3}, {1000.0, 1001.0, 1002.0, -1000.0, -1000.0, -1000.0});
+        const auto y = F::softmax(big);
+        const auto ref = softmax_reference(tl::Tensor<double>({2, 3}, {0.0, 1.0, 2.0, 0.0, 0.0, 0.0}));
+        CHECK(ctx, tl::max_abs_diff(y, ref) < 1e-15);
+        CHECK_NEAR(ctx, F::log_softmax(big).data[2], -std::log(1.0 + std::exp(-1.0) + std::exp(-2.0)), 1e-12);
+
+        // float logits far beyond exp's range.
+        tl::Tensor<float> f({1, 2}, {200.0f, 200.0f});
+        const auto yf = F::softmax(f);
+        CHECK_NEAR(ctx, yf.data[0], 0.5f, 1e-7f);
+    }
+
+    {
+        // Non-last axes match the reference on the permuted tensor.
+        const auto x = logits_like({3, 4, 5}, 2.0);
+        const auto y0 = F::softmax(x, 0);
+        const auto y1 = F::softmax(x, 1);
+        const auto l1 = F::log_softmax(x, -2);
+        double err = 0.0;
+        for (std::size_t a = 0; a < 3; ++a)
+            for (std::size_t c = 0; c < 5; ++c) {
+                tl::Tensor<double> col({1, 4});
+                for (std::size_t b = 0; b < 4; ++b) col.data[b] = x.data[(a * 4 + b) * 5 + c];
+                const auto r = softmax_reference(col);
+                for (std::size_t b = 0; b < 4; ++b) {
+                    err = std::max(err, std::abs(y1.data[(a * 4 + b) * 5 + c] - r.data[b]));
+                    err = std::max(err, std::abs(std::exp(l1.data[(a * 4 + b) * 5 + c]) - r.data[b]));
+                }
+            }
+        CHECK(ctx, err < 1e-14);
+        double colsum = 0.0;
+        for (std::size_t a = 0; a < 3; ++a) colsum += y0.data[a * 20 + 7];
+        CHECK_NEAR(ctx, colsum, 1.0, 1e-14);
+    }
+
+    {
+        // Masked logits: -inf entries get probability 0 and leave the rest untouched, even
+        // when a lane starts with one (here lane 0 sees -inf, then the 5 in the tail).
+        const double ninf = -std::numeric_limits<double>::infinity();
+        tl::Tensor<double> x({1, 9}, {ninf, 0, 0, 0, 0, 0, 0, 0, 5});
+        const auto y = F::softmax(x);
+        const double denom = 7.0 + std::exp(5.0);
+        double sum = 0.0;
+        for (double v : y.data) sum += v;
+        CHECK_NEAR(ctx, sum, 1.0, 1e-14);
+        CHECK(ctx, y.data[0] == 0.0);
+        CHECK_NEAR(ctx, y.data[8], std::exp(5.0) / denom, 1e-14);
+        const auto ly = F::log_softmax(x);
+        CHECK(ctx, ly.data[0] == ninf);
+        CHECK_NEAR(ctx, ly.data[1], -std::log(denom), 1e-13);
+
+        // Strided axis: the same logits down the columns of a [9, 2] tensor.
+        tl::Tensor<double> xt({9, 2});
+        for (std::size_t j = 0; j < 9; ++j) xt.data[2 * j] = xt.data[2 * j + 1] = x.data[j];
+        const auto yt = F::softmax(xt, 0);
+        double err = 0.0;
+        for (std::size_t j = 0; j < 9; ++j) err = std::max({err, std::abs(yt.data[2 * j] - y.data[j]), std::abs(yt.data[2 * j + 1] - y.data[j])});
+        CHECK(ctx, err < 1e-14);
+
+        tl::Tensor<float> xf({1, 9}, {-std::numeric_limits<float>::infinity(), 0, 0, 0, 0, 0, 0, 0, 5});
+        CHECK_NEAR(ctx, F::softmax(xf).data[8], static_cast<float>(std::exp(5.0) / denom), 1e-6f);
+    }
+
+    CHECK_THROWS(ctx, std::runtime_error, F::softmax(tl::Tensor<double>({2, 3}), 2));
+    CHECK_THROWS(ctx, std::runtime_error, F::log_softmax(tl::Tensor<double>({2, 3}), -3));
+
+    // ── Cross-entropy ─────────────────────────────────────────────────────────
+    SUITE(ctx, "Softmax — cross-entropy loss and gradient");
+
+    {
+        const auto x = logits_like({6, 7}, 4.0);
+        const std::vector<std::size_t> labels{0, 3, 6, 2, 2, 5};
+        const auto r = F::softmax_cross_entropy(x, labels);
+        const auto p = softmax_reference(x);
+        double loss = 0.0;
+        for (std::size_t b = 0; b < 6; ++b) loss -= std::log(p.data[b * 7 + labels[b]]);
+        CHECK_NEAR(ctx, r.loss, loss / 6.0, 1e-13);
+        CHECK_NEAR(ctx, F::cross_entropy(x, labels), r.loss, 1e-15);
+
+        // Gradient against central differences of the loss-only path.
+        double worst = 0.0;
+        auto xp = x;
+        for (std::size_t i = 0; i < x.data.size(); ++i) {
+            xp.data[i] = x.data[i] + 1e-6;
+            const double up = F::cross_entropy(xp, labels);
+            xp.data[i] = x.data[i] - 1e-6;
+            const double down = F::cross_entropy(xp, labels);
+            xp.data[i] = x.data[i];
+            worst = std::max(worst, std::abs(r.grad.data[i] - (up - down) / 2e-6));
+        }
+        CHECK(ctx, worst < 1e-8);
+
+        // One-hot soft targets reproduce the label form.
+        tl::Tensor<double> onehot({6, 7});
+        for (std::size_t b = 0; b < 6; ++b) onehot.data[b * 7 + labels[b]] = 1.0;
+        const auto rs = F::softmax_cross_entropy(x, onehot);
+        CHECK_NEAR(ctx, rs.loss, r.loss, 1e-13);
+        CHECK(ctx, tl::max_abs_diff(rs.grad, r.grad) < 1e-15);
+
+        // Confident, correct logits of magnitude 1e4 give a finite, tiny loss.
+        tl::Tensor<float> big({1, 3}, {1e4f, -1e4f, 0.0f});
+        const float l = F::cross_entropy(big, {0});
+        CHECK(ctx, std::isfinite(l) && l < 1e-6f);
+    }
+
+    CHECK_THROWS(ctx, std::out_of_range, F::cross_entropy(tl::Tensor<double>({2, 3}), {0, 3}));
+    CHECK_THROWS(ctx, std::runtime_error, F::softmax_cross_entropy(tl::Tensor<double>({2, 3}), std::vector<std::size_t>{0}));
+
+    // ── Autograd ──────────────────────────────────────────────────────────────
+    SUITE(ctx, "Softmax — autograd gradients");
+
+    {
+        namespace ag = tl::autograd;
+        ag::Parameter<double> X(logits_like({3, 4, 5}, 1.5));
+        const auto weights = logits_like({3, 4, 5}, 0.7);
+        auto check = [&](const std::function<ag::Var<double>(ag::Tape<double>&)>& loss) {
+            ag::Tape<double> tape;
+            X.zero_grad();
+            loss(tape).backward();
+            const auto analytic = X.grad;
+            double worst = 0.0;
+            for (std::size_t i = 0; i < X.value.data.size(); ++i) {
+                const double v = X.value.data[i];
+                X.value.data[i] = v + 1e-6;
+                tape.clear();
+                const double up = loss(tape).value().data[0];
+                X.value.data[i] = v - 1e-6;
+                tape.clear();
+                const double down = loss(tape).value().data[0];
+                X.value.data[i] = v;
+                worst = std::max(worst, std::abs(analytic.data[i] - (up - down) / 2e-6));
+            }
+            return worst;
+        };
+        double worst = 0.0;
+        for (int axis : {0, 1, 2}) {
+            worst = std::max(worst, check([&](ag::Tape<double>& tp) { return ag::sum(ag::softmax(tp.param(X), axis) * tp.input(weights)); }));
+            worst = std::max(worst, check([&](ag::Tape<double>& tp) { return ag::sum(ag::log_softmax(tp.param(X), axis) * tp.input(weights)); }));
+        }
+        worst = std::max(worst, check([&](ag::Tape<double>& tp) {
+            return ag::cross_entropy(ag::reshape(tp.param(X), {12, 5}), {0, 1, 2, 3, 4, 0, 1, 2, 3, 4, 4, 4}) * 3.0;
+        }));
+        CHECK(ctx, worst < 1e-8);
+    }
+}
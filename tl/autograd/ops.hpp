@@ -0,0 +1,398 @@
+#pragma once
+
+#include "tape.hpp"
+#include "../tensor_core/tensor_utils.hpp"
+#include "../linalg/linalg_utils.hpp"
+#include "../functional/functions.hpp"
+#include "../functional/softmax.hpp"
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+// Differentiable operators on autograd::Var.
+//
+// Forward passes reuse the library kernels (Tensor operators, linalg::matmul,
+// functional::*); backward passes accumulate straight into the parents' gradient
+// buffers in a single loop per operand, with no temporary gradient tensors.
+// Broadcast operands receive their gradient summed over the broadcast dimensions.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace autograd {
+
+    namespace detail {
+
+        template <typename T>
+        Tape<T>& tape_of(const Var<T>& a, const Var<T>& b) {
+            if (a.tape() != b.tape()) throw std::runtime_error("autograd: operands are recorded on different tapes.");
+            return *a.tape();
+        }
+
+        // dst (shape of `self`) += fn(i, self[.], other[.]) over every index i of out_shape,
+        // reducing over the dimensions along which `self` was broadcast.
+        template <typename T, typename Fn>
+        void accumulate_broadcast(Tensor<T>& dst, const Tensor<T>& self, const Tensor<T>& other,
+                                  const std::vector<std::size_t>& out_shape, Fn fn) {
+            T* d = dst.data.data();
+            const T* s = self.data.data();
+            const T* o = other.data.data();
+            if (self.shape == out_shape && other.shape == out_shape) {
+                const std::size_t n = dst.data.size();
+                #pragma omp parallel for simd if(n > autograd_parallel_threshold)
+                for (std::size_t i = 0; i < n; ++i) d[i] += fn(i, s[i], o[i]);
+                return;
+            }
+            broadcast_for_each(out_shape, strides_for(self, out_shape), strides_for(other, out_shape),
+                [&](std::size_t i, std::size_t os, std::size_t oo) { d[os] += fn(i, s[os], o[oo]); });
+        }
+
+        // dst += fn(i, x[i], y[i]) for same-shaped unary ops.
+        template <typename T, typename Fn>
+        void accumulate_unary(Tensor<T>& dst, const Tensor<T>& x, const Tensor<T>& y, Fn fn) {
+            T* d = dst.data.data();
+            const T* xp = x.data.data();
+            const T* yp = y.data.data();
+            const std::size_t n = dst.data.size();
+            #pragma omp parallel for simd if(n > autograd_parallel_threshold)
+            for (std::size_t i = 0; i < n; ++i) d[i] += fn(i, xp[i], yp[i]);
+        }
+
+        // Records an element-wise unary op; dfn(x, y) returns dy/dx.
+        template <typename T, typename Dfn>
+        Var<T> unary(const Var<T>& a, Tensor<T> out, Dfn dfn) {
+            return a.tape()->record(std::move(out), {a},
+                [a, dfn](Tape<T>& tp, const Tensor<T>& y, const Tensor<T>& g) {
+                    const T* gp = g.data.data();
+                    accumulate_unary(tp.grad_buffer(a.id()), a.value(), y,
+                        [gp, &dfn](std::size_t i, T x, T yi) { return gp[i] * dfn(x, yi); });
+                });
+        }
+
+    } // namespace detail
+
+
+    // --- Arithmetic (with broadcasting) ---
+
+    template <typename T>
+    Var<T> operator+(const Var<T>& a, const Var<T>& b) {
+        Tape<T>& tape = detail::tape_of(a, b);
+        return tape.record(a.value() + b.value(), {a, b},
+            [a, b](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+                const T* gp = g.data.data();
+                auto pass = [gp](std::size_t i, T, T) { return gp[i]; };
+                if (tp.requires_grad(a.id())) detail::accumulate_broadcast(tp.grad_buffer(a.id()), a.value(), b.value(), g.shape, pass);
+                if (tp.requires_grad(b.id())) detail::accumulate_broadcast(tp.grad_buffer(b.id()), b.value(), a.value(), g.shape, pass);
+            });
+    }
+
+    template <typename T>
+    Var<T> operator-(const Var<T>& a, const Var<T>& b) {
+        Tape<T>& tape = detail::tape_of(a, b);
+        return tape.record(a.value() - b.value(), {a, b},
+            [a, b](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+                const T* gp = g.data.data();
+                if (tp.requires_grad(a.id()))
+                    detail::accumulate_broadcast(tp.grad_buffer(a.id()), a.value(), b.value(), g.shape,
+                        [gp](std::size_t i, T, T) { return gp[i]; });
+                if (tp.requires_grad(b.id()))
+                    detail::accumulate_broadcast(tp.grad_buffer(b.id()), b.value(), a.value(), g.shape,
+                        [gp](std::size_t i, T, T) { return -gp[i]; });
+            });
+    }
+
+    template <typename T>
+    Var<T> operator*(const Var<T>& a, const Var<T>& b) {
+        Tape<T>& tape = detail::tape_of(a, b);
+        return tape.record(a.value() * b.value(), {a, b},
+            [a, b](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+                const T* gp = g.data.data();
+                auto times_other = [gp](std::size_t i, T, T other) { return gp[i] * other; };
+                if (tp.requires_grad(a.id())) detail::accumulate_broadcast(tp.grad_buffer(a.id()), a.value(), b.value(), g.shape, times_other);
+                if (tp.requires_grad(b.id())) detail::accumulate_broadcast(tp.grad_buffer(b.id()), b.value(), a.value(), g.shape, times_other);
+            });
+    }
+
+    template <typename T>
+    Var<T> operator/(const Var<T>& a, const Var<T>& b) {
+        Tape<T>& tape = detail::tape_of(a, b);
+        return tape.record(a.value() / b.value(), {a, b},
+            [a, b](Tape<T>& tp, const Tensor<T>& out, const Tensor<T>& g) {
+                const T* gp = g.data.data();
+                const T* yp = out.data.data();
+                if (tp.requires_grad(a.id()))
+                    detail::accumulate_broadcast(tp.grad_buffer(a.id()), a.value(), b.value(), g.shape,
+                        [gp](std::size_t i, T, T bv) { return gp[i] / bv; });
+                if (tp.requires_grad(b.id()))   // d(a/b)/db = -(a/b) / b
+                    detail::accumulate_broadcast(tp.grad_buffer(b.id()), b.value(), a.value(), g.shape,
+                        [gp, yp](std::size_t i, T bv, T) { return -gp[i] * yp[i] / bv; });
+            });
+    }
+
+    template <typename T>
+    Var<T> operator-(const Var<T>& a) {
+        return detail::unary(a, a.value() * static_cast<T>(-1), [](T, T) { return static_cast<T>(-1); });
+    }
+
+    // --- Scalar operands ---
+
+    template <typename T>
+    Var<T> operator+(const Var<T>& a, T s) { return detail::unary(a, a.value() + s, [](T, T) { return static_cast<T>(1); }); }
+
+    template <typename T>
+    Var<T> operator+(T s, const Var<T>& a) { return a + s; }
+
+    template <typename T>
+    Var<T> operator-(const Var<T>& a, T s) { return detail::unary(a, a.value() - s, [](T, T) { return static_cast<T>(1); }); }
+
+    template <typename T>
+    Var<T> operator-(T s, const Var<T>& a) { return detail::unary(a, s - a.value(), [](T, T) { return static_cast<T>(-1); }); }
+
+    template <typename T>
+    Var<T> operator*(const Var<T>& a, T s) { return detail::unary(a, a.value() * s, [s](T, T) { return s; }); }
+
+    template <typename T>
+    Var<T> operator*(T s, const Var<T>& a) { return a * s; }
+
+    template <typename T>
+    Var<T> operator/(const Var<T>& a, T s) {
+        const T inv = static_cast<T>(1) / s;
+        return detail::unary(a, a.value() * inv, [inv](T, T) { return inv; });
+    }
+
+    template <typename T>
+    Var<T> operator/(T s, const Var<T>& a) {
+        return detail::unary(a, s / a.value(), [](T x, T y) { return -y / x; });
+    }
+
+
+    // --- Linear algebra ---
+
+    template <typename T>
+    Var<T> matmul(const Var<T>& a, const Var<T>& b) {
+        Tape<T>& tape = detail::tape_of(a, b);
+        return tape.record(linalg::matmul(a.value(), b.value()), {a, b},
+            [a, b](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+                const Tensor<T>& A = a.value();
+                const Tensor<T>& B = b.value();
+                const std::size_t M = A.shape[0], K = A.shape[1], N = B.shape[1];
+                const T* gp = g.data.data();
+                const T* Ap = A.data.data();
+                const T* Bp = B.data.data();
+                const bool big = M * N * K > detail::autograd_parallel_threshold;
+
+                if (tp.requires_grad(a.id())) {
+                    // dA += g B^T : row i of dA is a set of dot products of g[i, :] with B[k, :].
+                    T* dA = tp.grad_buffer(a.id()).data.data();
+                    #pragma omp parallel for schedule(static) if(big)
+                    for (std::ptrdiff_t ii = 0; ii < static_cast<std::ptrdiff_t>(M); ++ii) {
+                        const std::size_t i = static_cast<std::size_t>(ii);
+                        const T* grow = gp + i * N;
+                        for (std::size_t k = 0; k < K; ++k) {
+                            const T* brow = Bp + k * N;
+                            T acc = static_cast<T>(0);
+                            #pragma omp simd reduction(+:acc)
+                            for (std::size_t j = 0; j < N; ++j) acc += grow[j] * brow[j];
+                            dA[i * K + k] += acc;
+                        }
+                    }
+                }
+                if (tp.requires_grad(b.id())) {
+                    // dB += A^T g : i-k-j order, rows of dB are independent.
+                    T* dB = tp.grad_buffer(b.id()).data.data();
+                    #pragma omp parallel for schedule(static) if(big)
+                    for (std::ptrdiff_t kk = 0; kk < static_cast<std::ptrdiff_t>(K); ++kk) {
+                        const std::size_t k = static_cast<std::size_t>(kk);
+                        T* drow = dB + k * N;
+                        for (std::size_t i = 0; i < M; ++i) {
+                            const T aik = Ap[i * K + k];
+                            const T* grow = gp + i * N;
+                            #pragma omp simd
+                            for (std::size_t j = 0; j < N; ++j) drow[j] += aik * grow[j];
+                        }
+                    }
+                }
+            });
+    }
+
+
+    // --- Shape and reductions ---
+
+    template <typename T>
+    Var<T> reshape(const Var<T>& a, std::vector<std::size_t> new_shape) {
+        return a.tape()->record(tl::reshape(a.value(), std::move(new_shape)), {a},
+            [a](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+                Tensor<T>& d = tp.grad_buffer(a.id());
+                const std::size_t n = d.data.size();
+                #pragma omp simd
+                for (std::size_t i = 0; i < n; ++i) d.data[i] += g.data[i];
+            });
+    }
+
+    // Sum of all elements, as a shape-[1] tensor.
+    template <typename T>
+    Var<T> sum(const Var<T>& a) {
+        return a.tape()->record(Tensor<T>({1}, {tl::sum(a.value())}), {a},
+            [a](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+                Tensor<T>& d = tp.grad_buffer(a.id());
+                const T g0 = g.data[0];
+                d += g0;
+            });
+    }
+
+    template <typename T>
+    Var<T> mean(const Var<T>& a) {
+        return a.tape()->record(Tensor<T>({1}, {tl::mean(a.value())}), {a},
+            [a](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+                Tensor<T>& d = tp.grad_buffer(a.id());
+                d += g.data[0] / static_cast<T>(d.data.size());
+            });
+    }
+
+
+    // --- Element-wise functions (functional:: forward, analytic derivative backward) ---
+
+    template <typename T>
+    Var<T> relu(const Var<T>& a) {
+        return detail::unary(a, functional::relu(a.value()),
+            [](T x, T) { return x > T(0) ? T(1) : T(0); });
+    }
+
+    template <typename T>
+    Var<T> leaky_relu(const Var<T>& a, T alpha = static_cast<T>(0.01)) {
+        return detail::unary(a, functional::leaky_relu(a.value(), alpha),
+            [alpha](T x, T) { return x > T(0) ? T(1) : alpha; });
+    }
+
+    template <typename T>
+    Var<T> sigmoid(const Var<T>& a) {
+        return detail::unary(a, functional::sigmoid(a.value()), [](T, T y) { return y * (T(1) - y); });
+    }
+
+    template <typename T>
+    Var<T> tanh(const Var<T>& a) {
+        return detail::unary(a, functional::tanh(a.value()), [](T, T y) { return T(1) - y * y; });
+    }
+
+    template <typename T>
+    Var<T> exp(const Var<T>& a) {
+        return detail::unary(a, functional::exp(a.value()), [](T, T y) { return y; });
+    }
+
+    template <typename T>
+    Var<T> log(const Var<T>& a) {
+        return detail::unary(a, functional::log(a.value()), [](T x, T) { return T(1) / x; });
+    }
+
+    template <typename T>
+    Var<T> sqrt(const Var<T>& a) {
+        return detail::unary(a, functional::sqrt(a.value()), [](T, T y) { return T(0.5) / y; });
+    }
+
+    template <typename T>
+    Var<T> square(const Var<T>& a) {
+        return detail::unary(a, functional::square(a.value()), [](T x, T) { return T(2) * x; });
+    }
+
+    template <typename T>
+    Var<T> power(const Var<T>& a, T p) {
+        return detail::unary(a, functional::power(a.value(), p),
+            [p](T x, T) { return p * std::pow(x, p - T(1)); });
+    }
+
+    template <typename T>
+    Var<T> abs(const Var<T>& a) {
+        return detail::unary(a, functional::abs(a.value()),
+            [](T x, T) { return x > T(0) ? T(1) : (x < T(0) ? T(-1) : T(0)); });
+    }
+
+    template <typename T>
+    Var<T> sin(const Var<T>& a) {
+        return detail::unary(a, functional::sin(a.value()), [](T x, T) { return std::cos(x); });
+    }
+
+    template <typename T>
+    Var<T> cos(const Var<T>& a) {
+        return detail::unary(a, functional::cos(a.value()), [](T x, T) { return -std::sin(x); });
+    }
+
+    template <typename T>
+    Var<T> clip(const Var<T>& a, T min_val, T max_val) {
+        return detail::unary(a, functional::clip(a.value(), min_val, max_val),
+            [min_val, max_val](T x, T) { return (x >= min_val && x <= max_val) ? T(1) : T(0); });
+    }
+
+    // --- Softmax family ---
+
+    namespace detail {
+
+        // dx += y * (g - <g, y>) for softmax, dx += g - exp(y) * sum(g) for log_softmax,
+        // with the reductions taken along the softmax axis.
+        template <bool Log, typename T>
+        void softmax_backward(const Tensor<T>& y, const Tensor<T>& g, int axis, Tensor<T>& dx) {
+            const auto sp = functional::detail::split_axis(y.shape, axis, "softmax");
+            const std::ptrdiff_t slices = static_cast<std::ptrdiff_t>(sp.outer * sp.inner);
+            #pragma omp parallel for schedule(static) if(y.data.size() > autograd_parallel_threshold)
+            for (std::ptrdiff_t sl = 0; sl < slices; ++sl) {
+                const std::size_t base = (static_cast<std::size_t>(sl) / sp.inner) * sp.len * sp.inner +
+                                         static_cast<std::size_t>(sl) % sp.inner;
+                T dot = T(0);
+                for (std::size_t j = 0; j < sp.len; ++j) {
+                    const std::size_t i = base + j * sp.inner;
+                    dot += Log ? g.data[i] : g.data[i] * y.data[i];
+                }
+                for (std::size_t j = 0; j < sp.len; ++j) {
+                    const std::size_t i = base + j * sp.inner;
+                    if constexpr (Log) dx.data[i] += g.data[i] - std::exp(y.data[i]) * dot;
+                    else dx.data[i] += y.data[i] * (g.data[i] - dot);
+                }
+            }
+        }
+
+        // Records a scalar loss whose logits gradient was produced by the forward sweep.
+        template <typename T>
+        Var<T> record_loss(const Var<T>& logits, functional::CrossEntropyResult<T> r) {
+            return logits.tape()->record(Tensor<T>({1}, {r.loss}), {logits},
+                [logits, grad = std::move(r.grad)](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+                    Tensor<T>& dx = tp.grad_buffer(logits.id());
+                    const T scale = g.data[0];
+                    const std::size_t n = dx.data.size();
+                    #pragma omp parallel for simd if(n > autograd_parallel_threshold)
+                    for (std::size_t i = 0; i < n; ++i) dx.data[i] += scale * grad.data[i];
+                });
+        }
+
+    } // namespace detail
+
+    template <typename T>
+    Var<T> softmax(const Var<T>& a, int axis = -1) {
+        return a.tape()->record(functional::softmax(a.value(), axis), {a},
+            [a, axis](Tape<T>& tp, const Tensor<T>& y, const Tensor<T>& g) {
+                detail::softmax_backward<false>(y, g, axis, tp.grad_buffer(a.id()));
+            });
+    }
+
+    template <typename T>
+    Var<T> log_softmax(const Var<T>& a, int axis = -1) {
+        return a.tape()->record(functional::log_softmax(a.value(), axis), {a},
+            [a, axis](Tape<T>& tp, const Tensor<T>& y, const Tensor<T>& g) {
+                detail::softmax_backward<true>(y, g, axis, tp.grad_buffer(a.id()));
+            });
+    }
+
+    // Mean softmax cross-entropy of [batch, classes] logits; shape {1}.
+    template <typename T>
+    Var<T> cross_entropy(const Var<T>& logits, const std::vector<std::size_t>& labels) {
+        return detail::record_loss(logits, functional::softmax_cross_entropy(logits.value(), labels));
+    }
+
+    template <typename T>
+    Var<T> cross_entropy(const Var<T>& logits, const Tensor<T>& targets) {
+        return detail::record_loss(logits, functional::softmax_cross_entropy(logits.value(), targets));
+    }
+
+} // namespace autograd
+} // namespace tl
@@ -0,0 +1,284 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include "../tensor_core/broadcasting.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Tape-based reverse-mode automatic differentiation.
+//
+//   Parameter<T>  : trainable tensor with a persistent gradient buffer
+//   Tape<T>       : records operations in execution order and replays them backwards
+//   Var<T>        : lightweight handle (tape, node id) returned by every recorded op
+//
+// Typical training step:
+//
+//     tl::autograd::Tape<float> tape;
+//     for (...) {
+//         tape.clear();                          // keeps node slots and their buffers
+//         W.zero_grad(); b.zero_grad();
+//         auto x = tape.input(batch);
+//         auto loss = mean(square(matmul(x, tape.param(W)) + tape.param(b) - tape.input(target)));
+//         loss.backward();                       // gradients land in W.grad, b.grad
+//     }
+//
+// Gradients are accumulated in place: parameter gradients add into Parameter::grad
+// (call zero_grad() between steps), and intermediate gradient buffers are owned by
+// tape slots that survive clear(), so a loop with a fixed graph reaches a steady
+// state with no gradient allocations.  Vars are invalidated by clear().
+
+namespace tl {
+namespace autograd {
+
+    template <typename T> class Tape;
+    template <typename T> class Var;
+
+    template <typename T>
+    struct Parameter {
+        Tensor<T> value;
+        Tensor<T> grad;
+
+        explicit Parameter(Tensor<T> v) : value(std::move(v)), grad(value.shape) {}
+
+        void zero_grad() { std::fill(grad.data.begin(), grad.data.end(), static_cast<T>(0)); }
+    };
+
+
+    namespace detail {
+
+        constexpr std::size_t autograd_parallel_threshold = 1 << 15;
+
+        // Resizes t to shape and zero-fills it, reusing the existing allocation.
+        template <typename T>
+        void assign_zeros(Tensor<T>& t, const std::vector<std::size_t>& shape) {
+            std::size_t n = 1;
+            for (auto d : shape) n *= d;
+            if (t.shape != shape) {
+                t.shape = shape;
+                t.recalculate_strides();
+            }
+            t.data.assign(n, static_cast<T>(0));
+        }
+
+        // Calls fn(i, off_a, off_b) for every flat index i of out_shape, where off_a /
+        // off_b are the offsets into operands broadcast with strides str_a / str_b.
+        // The innermost dimension runs as a plain strided loop.
+        template <typename Fn>
+        void broadcast_for_each(const std::vector<std::size_t>& out_shape,
+                                const std::vector<std::size_t>& str_a,
+                                const std::vector<std::size_t>& str_b, Fn fn) {
+            const std::size_t rank = out_shape.size();
+            std::size_t total = 1;
+            for (auto d : out_shape) total *= d;
+            if (total == 0) return;
+            if (rank == 0) { fn(std::size_t(0), std::size_t(0), std::size_t(0)); return; }
+
+            const std::size_t inner = out_shape[rank - 1];
+            const std::size_t ia = str_a[rank - 1], ib = str_b[rank - 1];
+            std::vector<std::size_t> coord(rank, 0);
+            std::size_t off_a = 0, off_b = 0;
+            for (std::size_t base = 0; base < total; base += inner) {
+                for (std::size_t j = 0; j < inner; ++j) fn(base + j, off_a + j * ia, off_b + j * ib);
+                for (std::size_t d = rank - 1; d-- > 0;) {
+                    off_a += str_a[d];
+                    off_b += str_b[d];
+                    if (++coord[d] < out_shape[d]) break;
+                    off_a -= str_a[d] * out_shape[d];
+                    off_b -= str_b[d] * out_shape[d];
+                    coord[d] = 0;
+                }
+            }
+        }
+
+        // Strides that map the broadcast output shape back onto `shape`.
+        template <typename T>
+        std::vector<std::size_t> strides_for(const Tensor<T>& t, const std::vector<std::size_t>& out_shape) {
+            return get_broadcast_strides(t.shape, t.strides, out_shape);
+        }
+
+    } // namespace detail
+
+
+    template <typename T>
+    class Tape {
+        static_assert(std::is_floating_point_v<T>, "autograd requires a floating-point element type.");
+
+    public:
+        // backward(tape, output value, gradient w.r.t. the output)
+        using BackwardFn = std::function<void(Tape&, const Tensor<T>& out, const Tensor<T>& grad_out)>;
+
+        Tape() = default;
+        Tape(const Tape&) = delete;
+        Tape& operator=(const Tape&) = delete;
+
+        // --- Leaves ---
+
+        // Trainable parameter: read in place, gradient accumulated into p.grad.
+        Var<T> param(Parameter<T>& p) {
+            if (p.grad.shape != p.value.shape) detail::assign_zeros(p.grad, p.value.shape);
+            Node& n = push();
+            n.external = &p.value;
+            n.grad_target = &p.grad;
+            n.requires_grad = true;
+            return Var<T>(this, size_ - 1);
+        }
+
+        // Leaf that owns its value and receives a gradient (query it with Var::grad()).
+        Var<T> variable(Tensor<T> value) {
+            Node& n = push();
+            n.value = std::move(value);
+            n.requires_grad = true;
+            return Var<T>(this, size_ - 1);
+        }
+
+        // Constant input, referenced without a copy: x must outlive the tape pass.
+        Var<T> input(const Tensor<T>& x) {
+            Node& n = push();
+            n.external = &x;
+            return Var<T>(this, size_ - 1);
+        }
+
+        // Constant input taken by value.
+        Var<T> input(Tensor<T>&& x) {
+            Node& n = push();
+            n.value = std::move(x);
+            return Var<T>(this, size_ - 1);
+        }
+
+        // --- Recording (used by the operators in ops.hpp) ---
+
+        Var<T> record(Tensor<T> value, std::initializer_list<Var<T>> parents, BackwardFn backward) {
+            bool needs = false;
+            for (const auto& p : parents) {
+                check_owned(p);
+                needs = needs || nodes_[p.id()].requires_grad;
+            }
+            Node& n = push();
+            n.value = std::move(value);
+            n.requires_grad = needs;
+            if (needs) n.backward = std::move(backward);
+            return Var<T>(this, size_ - 1);
+        }
+
+        const Tensor<T>& value(std::size_t id) const { return nodes_[id].val(); }
+        bool requires_grad(std::size_t id) const { return nodes_[id].requires_grad; }
+
+        // Gradient accumulator of node id for the current backward pass.
+        Tensor<T>& grad_buffer(std::size_t id) {
+            Node& n = nodes_[id];
+            if (n.grad_target) return *n.grad_target;
+            if (!n.grad_ready) {
+                detail::assign_zeros(n.grad, n.val().shape);
+                n.grad_ready = true;
+            }
+            return n.grad;
+        }
+
+        // Gradient of node id after backward(); parameters report their Parameter::grad.
+        const Tensor<T>& grad(std::size_t id) const {
+            const Node& n = nodes_[id];
+            if (n.grad_target) return *n.grad_target;
+            if (!n.grad_ready) throw std::runtime_error("autograd: no gradient has reached this node.");
+            return n.grad;
+        }
+
+        // --- Backward pass ---
+
+        // Back-propagates from root, seeded with ones (or with `seed`, same shape as root).
+        void backward(const Var<T>& root, const Tensor<T>* seed = nullptr) {
+            check_owned(root);
+            const std::size_t r = root.id();
+            if (!nodes_[r].requires_grad) throw std::runtime_error("autograd: root does not depend on any parameter.");
+            for (std::size_t i = 0; i < size_; ++i) nodes_[i].grad_ready = false;
+
+            Tensor<T>& g = grad_buffer(r);
+            if (seed) {
+                if (seed->shape != nodes_[r].val().shape) throw std::runtime_error("autograd: seed shape mismatch.");
+                for (std::size_t i = 0; i < g.data.size(); ++i) g.data[i] += seed->data[i];
+            } else {
+                for (auto& v : g.data) v += static_cast<T>(1);
+            }
+
+            for (std::size_t i = r + 1; i-- > 0;) {
+                Node& n = nodes_[i];
+                if (!n.backward || !n.grad_ready) continue;
+                n.backward(*this, n.val(), n.grad);
+            }
+        }
+
+        // Forgets the recorded graph; slots and their gradient buffers are kept.
+        void clear() {
+            for (std::size_t i = 0; i < size_; ++i) {
+                Node& n = nodes_[i];
+                n.external = nullptr;
+                n.grad_target = nullptr;
+                n.requires_grad = false;
+                n.grad_ready = false;
+                n.backward = nullptr;
+            }
+            size_ = 0;
+        }
+
+        std::size_t size() const { return size_; }
+        std::size_t capacity() const { return nodes_.size(); }
+
+    private:
+        struct Node {
+            Tensor<T> value{std::vector<std::size_t>{0}};
+            const Tensor<T>* external = nullptr;
+            Tensor<T> grad{std::vector<std::size_t>{0}};
+            Tensor<T>* grad_target = nullptr;
+            bool requires_grad = false;
+            bool grad_ready = false;
+            BackwardFn backward;
+
+            const Tensor<T>& val() const { return external ? *external : value; }
+        };
+
+        std::vector<Node> nodes_;
+        std::size_t size_ = 0;
+
+        Node& push() {
+            if (size_ == nodes_.size()) nodes_.emplace_back();
+            return nodes_[size_++];
+        }
+
+        void check_owned(const Var<T>& v) const {
+            if (v.tape() != this || v.id() >= size_) {
+                throw std::runtime_error("autograd: Var does not belong to this tape (or the tape was cleared).");
+            }
+        }
+    };
+
+
+    template <typename T>
+    class Var {
+    public:
+        Var() = default;
+        Var(Tape<T>* tape, std::size_t id) : tape_(tape), id_(id) {}
+
+        Tape<T>* tape() const { return tape_; }
+        std::size_t id() const { return id_; }
+
+        const Tensor<T>& value() const { return tape_->value(id_); }
+        const Tensor<T>& grad() const { return tape_->grad(id_); }
+        const std::vector<std::size_t>& shape() const { return value().shape; }
+        bool requires_grad() const { return tape_->requires_grad(id_); }
+
+        void backward() const { tape_->backward(*this); }
+        void backward(const Tensor<T>& seed) const { tape_->backward(*this, &seed); }
+
+    private:
+        Tape<T>* tape_ = nullptr;
+        std::size_t id_ = 0;
+    };
+
+} // namespace autograd
+} // namespace tl
@@ -0,0 +1,324 @@
+#pragma once
+
+#include "plan.hpp"
+#include "fft.hpp"
+#include "../tensor_core/tensor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Linear convolution and cross-correlation of 1-D and 2-D signals (SciPy conventions).
+//
+//   convolve(x, k, mode, method)    y[i] = sum_j x[i - j] k[j]
+//   correlate(x, k, mode, method)   y[i] = sum_j x[i + j] k[j]  (convolve with k reversed)
+//
+//   ConvMode::Full    every overlap, extent N + K - 1
+//   ConvMode::Same    extent N, centred on the full result
+//   ConvMode::Valid   full overlaps only, extent N - K + 1 (the kernel must fit in x)
+//
+//   ConvMethod::Direct  register-blocked shift-and-multiply, O(N K); the inner loop
+//                       runs over contiguous outputs and vectorises
+//   ConvMethod::FFT     overlap-add: x is cut into tiles, each tile is transformed
+//                       with a cached real plan, multiplied by the kernel's spectrum
+//                       (computed once) and transformed back, O(N log K)
+//   ConvMethod::Auto    whichever conv_method() estimates cheaper
+//
+// A 1-D signal is handled as a single-row 2-D one.  Tiles are processed in parallel,
+// in four passes by tile parity so that neighbouring tiles never add into the same
+// outputs at the same time.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace fft {
+
+    enum class ConvMode { Full, Same, Valid };
+    enum class ConvMethod { Auto, Direct, FFT };
+
+
+    namespace detail {
+
+        // Relative cost of one estimated FFT flop against one direct multiply-add: the direct
+        // loop is a streaming FMA, the transforms shuffle and multiply complex values.
+        constexpr double conv_fft_weight = 3.0;
+        constexpr std::size_t conv_block = 256;    // outputs accumulated per direct-kernel block
+
+        // Shapes as [rows, cols]; the output is the window [r0, r0 + rows) x [c0, c0 + cols)
+        // of the full convolution.
+        struct ConvGeometry {
+            std::size_t R, N, KR, KC;          // input and kernel
+            std::size_t r0, c0, rows, cols;    // output window
+        };
+
+        // Overlap-add tiling: tiles of PR x PC samples hold LR x LC input samples each.
+        struct ConvTiling {
+            std::size_t PR, PC, LR, LC, tiles_r, tiles_c;
+            double cost;                       // estimated flops
+        };
+
+        inline std::size_t next_pow2(std::size_t n) {
+            std::size_t p = 1;
+            while (p < n) p *= 2;
+            return p;
+        }
+
+        inline ConvGeometry conv_geometry(const std::vector<std::size_t>& xs, const std::vector<std::size_t>& ks,
+                                          ConvMode mode, const char* op) {
+            if (xs.size() != ks.size() || xs.empty() || xs.size() > 2) {
+                throw std::runtime_error(std::string(op) + ": expects two 1-D or two 2-D tensors.");
+            }
+            const bool one_d = xs.size() == 1;
+            ConvGeometry g{one_d ? 1 : xs[0], xs.back(), one_d ? 1 : ks[0], ks.back(), 0, 0, 0, 0};
+            if (g.R == 0 || g.N == 0 || g.KR == 0 || g.KC == 0) throw std::runtime_error(std::string(op) + ": inputs must be non-empty.");
+            switch (mode) {
+                case ConvMode::Full:
+                    g.rows = g.R + g.KR - 1; g.cols = g.N + g.KC - 1;
+                    break;
+                case ConvMode::Same:
+                    g.r0 = (g.KR - 1) / 2; g.c0 = (g.KC - 1) / 2;
+                    g.rows = g.R; g.cols = g.N;
+                    break;
+                case ConvMode::Valid:
+                    if (g.KR > g.R || g.KC > g.N) throw std::runtime_error(std::string(op) + ": valid mode needs a kernel no larger than the input.");
+                    g.r0 = g.KR - 1; g.c0 = g.KC - 1;
+                    g.rows = g.R - g.KR + 1; g.cols = g.N - g.KC + 1;
+                    break;
+            }
+            return g;
+        }
+
+        // Candidate tile lengths along one axis of input length n and kernel length k: powers of
+        // two from 2k - 1 (so a tile's spill never reaches past its neighbour) up to a single
+        // tile covering the whole axis.
+        inline std::vector<std::size_t> tile_lengths(std::size_t n, std::size_t k) {
+            std::vector<std::size_t> out;
+            const std::size_t whole = next_pow2(n + k - 1);
+            for (std::size_t p = std::min(next_pow2(2 * k - 1), whole); p <= whole; p *= 2) out.push_back(p);
+            return out;
+        }
+
+        inline double log2_or_zero(std::size_t n) { return n > 1 ? std::log2(static_cast<double>(n)) : 0.0; }
+
+        inline ConvTiling conv_tiling(const ConvGeometry& g) {
+            ConvTiling best{};
+            best.cost = -1.0;
+            for (std::size_t PR : tile_lengths(g.R, g.KR)) {
+                for (std::size_t PC : tile_lengths(g.N, g.KC)) {
+                    const std::size_t LR = std::min(PR - g.KR + 1, g.R), LC = std::min(PC - g.KC + 1, g.N);
+                    const std::size_t tr = (g.R + LR - 1) / LR, tc = (g.N + LC - 1) / LC, bins = PC / 2 + 1;
+                    const double pr = static_cast<double>(PR), pc = static_cast<double>(PC), b = static_cast<double>(bins);
+                    // Forward and inverse: real transforms along rows, complex ones down the bins,
+                    // plus the spectrum product and the per-sample copies in and out of the tile.
+                    const double tile = 2.0 * (pr * 2.5 * pc * log2_or_zero(PC) + b * 5.0 * pr * log2_or_zero(PR)) + 6.0 * pr * b + 8.0 * pr * pc;
+                    const double cost = static_cast<double>(tr * tc) * tile;
+                    if (best.cost < 0.0 || cost < best.cost) best = ConvTiling{PR, PC, LR, LC, tr, tc, cost};
+                }
+            }
+            return best;
+        }
+
+        inline double direct_cost(const ConvGeometry& g) {
+            return static_cast<double>(g.rows) * static_cast<double>(g.cols) * static_cast<double>(g.KR) * static_cast<double>(g.KC);
+        }
+
+        // k reversed along every axis: correlation is convolution with the flipped kernel.
+        template <typename T>
+        std::vector<T> flipped(const Tensor<T>& k) {
+            return std::vector<T>(k.data.rbegin(), k.data.rend());
+        }
+
+        // --- Direct ---
+
+        // y[i][j] = sum_{a,b} k[a][b] x[f - a][g - b] with (f, g) = (r0 + i, c0 + j), evaluated as a
+        // correlation of the zero-padded window of x with the reversed kernel.
+        template <typename T>
+        void conv_direct(const T* x, const T* k, const ConvGeometry& g, T* y) {
+            const std::size_t PRows = g.rows + g.KR - 1, PCols = g.cols + g.KC - 1;
+            // P[t][u] = x[r0 + t - (KR - 1)][c0 + u - (KC - 1)], zero outside x.
+            std::vector<T> P(PRows * PCols, T(0));
+            for (std::size_t t = 0; t < PRows; ++t) {
+                const std::ptrdiff_t xr = static_cast<std::ptrdiff_t>(g.r0 + t) - static_cast<std::ptrdiff_t>(g.KR - 1);
+                if (xr < 0 || xr >= static_cast<std::ptrdiff_t>(g.R)) continue;
+                const std::ptrdiff_t lo = static_cast<std::ptrdiff_t>(g.KC - 1) - static_cast<std::ptrdiff_t>(g.c0);
+                const std::size_t u0 = static_cast<std::size_t>(std::max<std::ptrdiff_t>(lo, 0));
+                const std::size_t u1 = static_cast<std::size_t>(std::min<std::ptrdiff_t>(lo + static_cast<std::ptrdiff_t>(g.N), static_cast<std::ptrdiff_t>(PCols)));
+                for (std::size_t u = u0; u < u1; ++u) P[t * PCols + u] = x[static_cast<std::size_t>(xr) * g.N + static_cast<std::size_t>(static_cast<std::ptrdiff_t>(u) - lo)];
+            }
+            std::vector<T> kr(k, k + g.KR * g.KC);
+            std::reverse(kr.begin(), kr.end());
+
+            const std::size_t blocks_per_row = (g.cols + conv_block - 1) / conv_block;
+            const std::ptrdiff_t total = static_cast<std::ptrdiff_t>(g.rows * blocks_per_row);
+            const T* p = P.data();
+            #pragma omp parallel for schedule(static) if(direct_cost(g) > fft_parallel_threshold)
+            for (std::ptrdiff_t w = 0; w < total; ++w) {
+                const std::size_t i = static_cast<std::size_t>(w) / blocks_per_row;
+                const std::size_t j0 = (static_cast<std::size_t>(w) % blocks_per_row) * conv_block;
+                const std::size_t len = std::min(conv_block, g.cols - j0);
+                T acc[conv_block] = {};
+                for (std::size_t a = 0; a < g.KR; ++a) {
+                    const T* row = p + (i + a) * PCols + j0;
+                    const T* ka = kr.data() + a * g.KC;
+                    for (std::size_t b = 0; b < g.KC; ++b) {
+                        const T kv = ka[b];
+                        const T* src = row + b;
+                        #pragma omp simd
+                        for (std::size_t j = 0; j < len; ++j) acc[j] += kv * src[j];
+                    }
+                }
+                std::copy(acc, acc + len, y + i * g.cols + j0);
+            }
+        }
+
+        // --- Overlap-add FFT ---
+
+        // Transforms of PR x PC real tiles: real plans along the rows, complex plans down the
+        // PC / 2 + 1 bin columns.  Callers supply the spectrum, scratch and row buffers.
+        template <typename T>
+        struct TileTransform {
+            using C = std::complex<T>;
+            std::size_t PR, PC, bins;
+            std::shared_ptr<const RealFFTPlan<T>> rows;
+            std::shared_ptr<const FFTPlan<T>> cols;
+
+            TileTransform(std::size_t pr, std::size_t pc)
+                : PR(pr), PC(pc), bins(pc / 2 + 1), rows(real_plan<T>(pc)), cols(plan<T>(pr)) {}
+
+            std::size_t spectrum_size() const { return PR * bins; }
+            std::size_t scratch_size() const { return std::max(rows->scratch_size(), cols->scratch_size()) + PR; }
+
+            // spec <- 2-D DFT of the tile whose first `lr` rows are `line(r)` (PC reals each), the rest zero.
+            template <typename RowFn>
+            void forward(std::size_t lr, RowFn line, C* spec, C* scratch) const {
+                for (std::size_t r = 0; r < lr; ++r) rows->forward(line(r), spec + r * bins, scratch);
+                std::fill(spec + lr * bins, spec + PR * bins, C(0));
+                down_columns(spec, scratch, false);
+            }
+
+            // Rows [0, lr) of the unnormalised inverse, each handed to `emit(r, values)`.
+            template <typename EmitFn>
+            void inverse(C* spec, std::size_t lr, T* row, C* scratch, EmitFn emit) const {
+                down_columns(spec, scratch, true);
+                for (std::size_t r = 0; r < lr; ++r) {
+                    rows->inverse(spec + r * bins, row, scratch);
+                    emit(r, row);
+                }
+            }
+
+            void down_columns(C* spec, C* scratch, bool inverse) const {
+                if (PR == 1) return;
+                C* col = scratch + cols->scratch_size();
+                for (std::size_t c = 0; c < bins; ++c) {
+                    for (std::size_t r = 0; r < PR; ++r) col[r] = spec[r * bins + c];
+                    cols->execute(col, scratch, inverse);
+                    for (std::size_t r = 0; r < PR; ++r) spec[r * bins + c] = col[r];
+                }
+            }
+        };
+
+        template <typename T>
+        void conv_fft(const T* x, const T* k, const ConvGeometry& g, const ConvTiling& t, T* y) {
+            using C = std::complex<T>;
+            const TileTransform<T> tf(t.PR, t.PC);
+            const std::size_t PC = t.PC, spec_n = tf.spectrum_size(), scratch_n = tf.scratch_size();
+
+            // Kernel spectrum, shared by every tile.
+            std::vector<C> kspec(spec_n), kscratch(scratch_n);
+            std::vector<T> krow(PC, T(0));
+            tf.forward(g.KR, [&](std::size_t r) {
+                std::copy(k + r * g.KC, k + (r + 1) * g.KC, krow.begin());
+                return krow.data();
+            }, kspec.data(), kscratch.data());
+            const T scale = static_cast<T>(1) / static_cast<T>(t.PR * t.PC);
+            for (auto& v : kspec) v *= scale;
+
+            std::fill(y, y + g.rows * g.cols, T(0));
+            const C* ks = kspec.data();
+            // One workspace per thread for this call, freed on return; the implicit barrier
+            // after each phase keeps tiles that share output rows from overlapping in time.
+            #pragma omp parallel if(t.tiles_r * t.tiles_c > 1 && t.cost > fft_parallel_threshold)
+            {
+                std::vector<C> buf(spec_n + scratch_n);
+                std::vector<T> rowbuf(PC);
+                C* spec = buf.data();
+                C* scratch = spec + spec_n;
+                T* row = rowbuf.data();
+                for (std::size_t phase = 0; phase < 4; ++phase) {
+                    const std::size_t pr = phase / 2, pc = phase % 2;
+                    const std::size_t nr = (t.tiles_r + 1 - pr) / 2, nc = (t.tiles_c + 1 - pc) / 2;
+                    const std::ptrdiff_t total = static_cast<std::ptrdiff_t>(nr * nc);
+                    #pragma omp for schedule(static)
+                    for (std::ptrdiff_t w = 0; w < total; ++w) {
+                        const std::size_t ti = 2 * (static_cast<std::size_t>(w) / nc) + pr;
+                        const std::size_t tj = 2 * (static_cast<std::size_t>(w) % nc) + pc;
+                        const std::size_t xr0 = ti * t.LR, xc0 = tj * t.LC;
+                        const std::size_t lr = std::min(t.LR, g.R - xr0), lc = std::min(t.LC, g.N - xc0);
+
+                        tf.forward(lr, [&](std::size_t r) {
+                            const T* src = x + (xr0 + r) * g.N + xc0;
+                            std::copy(src, src + lc, row);
+                            std::fill(row + lc, row + PC, T(0));
+                            return row;
+                        }, spec, scratch);
+                        for (std::size_t i = 0; i < spec_n; ++i) spec[i] = cmul(spec[i], ks[i]);
+
+                        // Tile row r is full-result row xr0 + r; keep the part inside the output window.
+                        const std::size_t out_rows = std::min(t.PR, lr + g.KR - 1), out_cols = std::min(PC, lc + g.KC - 1);
+                        const std::size_t c_lo = std::max(g.c0, xc0), c_hi = std::min(g.c0 + g.cols, xc0 + out_cols);
+                        tf.inverse(spec, out_rows, row, scratch, [&](std::size_t r, const T* vals) {
+                            const std::size_t f = xr0 + r;
+                            if (f < g.r0 || f >= g.r0 + g.rows || c_lo >= c_hi) return;
+                            T* dst = y + (f - g.r0) * g.cols;
+                            for (std::size_t c = c_lo; c < c_hi; ++c) dst[c - g.c0] += vals[c - xc0];
+                        });
+                    }
+                }
+            }
+        }
+
+        template <typename T>
+        Tensor<T> conv_impl(const Tensor<T>& x, const T* k, const std::vector<std::size_t>& kshape,
+                            ConvMode mode, ConvMethod method, const char* op) {
+            static_assert(std::is_floating_point_v<T>, "convolve / correlate require float or double tensors.");
+            const ConvGeometry g = conv_geometry(x.shape, kshape, mode, op);
+            std::vector<std::size_t> shape = x.shape.size() == 1 ? std::vector<std::size_t>{g.cols} : std::vector<std::size_t>{g.rows, g.cols};
+            Tensor<T> y(shape);
+            const double direct = direct_cost(g);
+            const ConvTiling t = method == ConvMethod::Direct ? ConvTiling{} : conv_tiling(g);
+            const bool use_fft = method == ConvMethod::FFT || (method == ConvMethod::Auto && conv_fft_weight * t.cost < direct);
+            TL_PROFILE_OP(op, use_fft ? t.cost : 2.0 * direct, x.shape, kshape);
+            if (use_fft) conv_fft(x.data.data(), k, g, t, y.data.data());
+            else conv_direct(x.data.data(), k, g, y.data.data());
+            return y;
+        }
+
+    } // namespace detail
+
+
+    // The method Auto would pick for these shapes.
+    inline ConvMethod conv_method(const std::vector<std::size_t>& x_shape, const std::vector<std::size_t>& k_shape,
+                                  ConvMode mode = ConvMode::Full) {
+        const auto g = detail::conv_geometry(x_shape, k_shape, mode, "conv_method");
+        return detail::conv_fft_weight * detail::conv_tiling(g).cost < detail::direct_cost(g) ? ConvMethod::FFT : ConvMethod::Direct;
+    }
+
+    template <typename T>
+    Tensor<T> convolve(const Tensor<T>& x, const Tensor<T>& k, ConvMode mode = ConvMode::Full, ConvMethod method = ConvMethod::Auto) {
+        return detail::conv_impl(x, k.data.data(), k.shape, mode, method, "convolve");
+    }
+
+    template <typename T>
+    Tensor<T> correlate(const Tensor<T>& x, const Tensor<T>& k, ConvMode mode = ConvMode::Full, ConvMethod method = ConvMethod::Auto) {
+        const std::vector<T> kf = detail::flipped(k);
+        return detail::conv_impl(x, kf.data(), k.shape, mode, method, "correlate");
+    }
+
+} // namespace fft
+} // namespace tl
@@ -0,0 +1,258 @@
+#pragma once
+
+#include "plan.hpp"
+#include "../tensor_core/tensor.hpp"
+#include "../tensor_core/complex.hpp"
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+// Discrete Fourier transforms of tensors (NumPy conventions).
+//
+//   fft(x, axis) / ifft(X, axis)           complex <-> complex along one axis
+//   rfft(x, axis) / irfft(X, n, axis)      real -> n/2 + 1 bins, and back to length n
+//   fftn / ifftn (x, axes)                 along several axes (default: all)
+//   rfftn / irfftn (x, axes)               real N-D: rfft on the last listed axis, fft on the rest
+//   fftfreq(n, d) / rfftfreq(n, d)         sample frequencies of the bins
+//
+// Forward transforms are unnormalised, inverses scale by 1/n.  Real tensors passed
+// to fft are promoted to complex.  Every 1-D line along the axis is an independent
+// transform, and lines run in parallel (one cached plan, per-thread scratch).
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace fft {
+
+    namespace detail {
+
+        constexpr std::size_t fft_parallel_threshold = 1 << 15;
+
+        // Tensor viewed as [outer, len, inner] around `axis` (negative counts from the back).
+        struct Lines { std::size_t axis, outer, len, inner; };
+
+        inline Lines split_lines(const std::vector<std::size_t>& shape, int axis, const char* op) {
+            const int rank = static_cast<int>(shape.size());
+            const int a = axis < 0 ? axis + rank : axis;
+            if (rank == 0 || a < 0 || a >= rank) {
+                throw std::runtime_error(std::string(op) + ": axis " + std::to_string(axis) +
+                                         " out of range for rank " + std::to_string(rank) + ".");
+            }
+            Lines l{static_cast<std::size_t>(a), 1, shape[static_cast<std::size_t>(a)], 1};
+            for (std::size_t d = 0; d < l.axis; ++d) l.outer *= shape[d];
+            for (std::size_t d = l.axis + 1; d < shape.size(); ++d) l.inner *= shape[d];
+            return l;
+        }
+
+        inline double fft_flops(std::size_t n, std::size_t lines) {
+            return n > 1 ? 5.0 * static_cast<double>(n) * std::log2(static_cast<double>(n)) * static_cast<double>(lines) : 0.0;
+        }
+
+        // Complex transform of every line of t along `axis`, in place.
+        template <typename T>
+        void c2c_axis(Tensor<std::complex<T>>& t, int axis, bool inverse, const char* op) {
+            using C = std::complex<T>;
+            const Lines l = split_lines(t.shape, axis, op);
+            if (l.len <= 1 || t.data.empty()) return;
+            TL_PROFILE_OP(op, fft_flops(l.len, l.outer * l.inner), t.shape);
+            const auto p = plan<T>(l.len);
+            const std::size_t n = l.len, inner = l.inner, lines = l.outer * l.inner;
+            const T scale = inverse ? static_cast<T>(1) / static_cast<T>(n) : static_cast<T>(1);
+            C* data = t.data.data();
+            const std::ptrdiff_t total = static_cast<std::ptrdiff_t>(lines);
+            // Each thread allocates its workspace for this call only; nothing outlives the transform.
+            #pragma omp parallel if(lines > 1 && t.data.size() > fft_parallel_threshold)
+            {
+                std::vector<C> work(p->scratch_size() + (inner == 1 ? 0 : n));
+                C* scratch = work.data();
+                #pragma omp for schedule(static)
+                for (std::ptrdiff_t li = 0; li < total; ++li) {
+                    const std::size_t o = static_cast<std::size_t>(li) / inner, i = static_cast<std::size_t>(li) % inner;
+                    C* base = data + o * n * inner + i;
+                    C* line = inner == 1 ? base : scratch + p->scratch_size();
+                    if (inner != 1) for (std::size_t k = 0; k < n; ++k) line[k] = base[k * inner];
+                    p->execute(line, scratch, inverse);
+                    if (inner != 1) for (std::size_t k = 0; k < n; ++k) base[k * inner] = line[k] * scale;
+                    else if (inverse) for (std::size_t k = 0; k < n; ++k) line[k] *= scale;
+                }
+            }
+        }
+
+        template <typename T>
+        Tensor<std::complex<T>> r2c_axis(const Tensor<T>& x, int axis, const char* op) {
+            using C = std::complex<T>;
+            const Lines l = split_lines(x.shape, axis, op);
+            if (l.len == 0) throw std::runtime_error(std::string(op) + ": transform axis is empty.");
+            const auto p = real_plan<T>(l.len);
+            const std::size_t n = l.len, nb = p->bins(), inner = l.inner, lines = l.outer * l.inner;
+            std::vector<std::size_t> shape = x.shape;
+            shape[l.axis] = nb;
+            TL_PROFILE_OP(op, fft_flops(n, lines) / 2, x.shape);
+            Tensor<C> out(shape);
+            const T* src = x.data.data();
+            C* dst = out.data.data();
+            const std::ptrdiff_t total = static_cast<std::ptrdiff_t>(lines);
+            #pragma omp parallel if(lines > 1 && x.data.size() > fft_parallel_threshold)
+            {
+                std::vector<C> work(nb + p->scratch_size());
+                std::vector<T> line(n);
+                C* scratch = work.data();
+                C* bins = scratch + p->scratch_size();
+                #pragma omp for schedule(static)
+                for (std::ptrdiff_t li = 0; li < total; ++li) {
+                    const std::size_t o = static_cast<std::size_t>(li) / inner, i = static_cast<std::size_t>(li) % inner;
+                    const T* in = src + o * n * inner + i;
+                    C* res = dst + o * nb * inner + i;
+                    for (std::size_t k = 0; k < n; ++k) line[k] = in[k * inner];
+                    p->forward(line.data(), inner == 1 ? res : bins, scratch);
+                    if (inner != 1) for (std::size_t k = 0; k < nb; ++k) res[k * inner] = bins[k];
+                }
+            }
+            return out;
+        }
+
+        // Inverse real transform along `axis` to length n; missing bins count as zero.
+        template <typename T>
+        Tensor<T> c2r_axis(const Tensor<std::complex<T>>& X, std::size_t n, int axis, const char* op) {
+            using C = std::complex<T>;
+            const Lines l = split_lines(X.shape, axis, op);
+            if (n == 0) {
+                if (l.len == 0) throw std::runtime_error(std::string(op) + ": transform axis is empty.");
+                n = 2 * (l.len - 1);
+                if (n == 0) n = 1;
+            }
+            const auto p = real_plan<T>(n);
+            const std::size_t nb = p->bins(), m = l.len, inner = l.inner, lines = l.outer * l.inner;
+            std::vector<std::size_t> shape = X.shape;
+            shape[l.axis] = n;
+            TL_PROFILE_OP(op, fft_flops(n, lines) / 2, X.shape);
+            Tensor<T> out(shape);
+            const C* src = X.data.data();
+            T* dst = out.data.data();
+            const T scale = static_cast<T>(1) / static_cast<T>(n);
+            const std::ptrdiff_t total = static_cast<std::ptrdiff_t>(lines);
+            #pragma omp parallel if(lines > 1 && out.data.size() > fft_parallel_threshold)
+            {
+                std::vector<C> work(nb + p->scratch_size());
+                std::vector<T> line(n);
+                C* scratch = work.data();
+                C* bins = scratch + p->scratch_size();
+                #pragma omp for schedule(static)
+                for (std::ptrdiff_t li = 0; li < total; ++li) {
+                    const std::size_t o = static_cast<std::size_t>(li) / inner, i = static_cast<std::size_t>(li) % inner;
+                    const C* in = src + o * m * inner + i;
+                    T* res = dst + o * n * inner + i;
+                    for (std::size_t k = 0; k < nb; ++k) bins[k] = k < m ? in[k * inner] : C(0);
+                    p->inverse(bins, line.data(), scratch);
+                    for (std::size_t k = 0; k < n; ++k) res[k * inner] = line[k] * scale;
+                }
+            }
+            return out;
+        }
+
+        // Axes to transform: every axis when `axes` is empty, else the listed ones (no repeats).
+        inline std::vector<int> resolve_axes(std::vector<int> axes, std::size_t rank, const char* op) {
+            if (axes.empty()) for (std::size_t d = 0; d < rank; ++d) axes.push_back(static_cast<int>(d));
+            std::vector<std::size_t> seen;
+            for (int a : axes) {
+                const std::size_t d = split_lines(std::vector<std::size_t>(rank, 1), a, op).axis;
+                if (std::find(seen.begin(), seen.end(), d) != seen.end()) throw std::runtime_error(std::string(op) + ": axis repeated.");
+                seen.push_back(d);
+            }
+            return axes;
+        }
+
+    } // namespace detail
+
+
+    // --- One axis ---
+
+    template <typename T>
+    Tensor<std::complex<T>> fft(const Tensor<std::complex<T>>& x, int axis = -1) {
+        Tensor<std::complex<T>> out = x;
+        detail::c2c_axis(out, axis, false, "fft");
+        return out;
+    }
+
+    template <typename T>
+    Tensor<std::complex<T>> fft(const Tensor<T>& x, int axis = -1) { return fft(to_complex(x), axis); }
+
+    template <typename T>
+    Tensor<std::complex<T>> ifft(const Tensor<std::complex<T>>& X, int axis = -1) {
+        Tensor<std::complex<T>> out = X;
+        detail::c2c_axis(out, axis, true, "ifft");
+        return out;
+    }
+
+    // The n/2 + 1 non-negative frequency bins of a real signal.
+    template <typename T>
+    Tensor<std::complex<T>> rfft(const Tensor<T>& x, int axis = -1) { return detail::r2c_axis(x, axis, "rfft"); }
+
+    // Inverse of rfft; n defaults to 2 * (bins - 1).
+    template <typename T>
+    Tensor<T> irfft(const Tensor<std::complex<T>>& X, std::size_t n = 0, int axis = -1) { return detail::c2r_axis(X, n, axis, "irfft"); }
+
+
+    // --- Several axes ---
+
+    template <typename T>
+    Tensor<std::complex<T>> fftn(const Tensor<std::complex<T>>& x, std::vector<int> axes = {}) {
+        Tensor<std::complex<T>> out = x;
+        for (int a : detail::resolve_axes(std::move(axes), x.shape.size(), "fftn")) detail::c2c_axis(out, a, false, "fftn");
+        return out;
+    }
+
+    template <typename T>
+    Tensor<std::complex<T>> ifftn(const Tensor<std::complex<T>>& X, std::vector<int> axes = {}) {
+        Tensor<std::complex<T>> out = X;
+        for (int a : detail::resolve_axes(std::move(axes), X.shape.size(), "ifftn")) detail::c2c_axis(out, a, true, "ifftn");
+        return out;
+    }
+
+    template <typename T>
+    Tensor<std::complex<T>> rfftn(const Tensor<T>& x, std::vector<int> axes = {}) {
+        axes = detail::resolve_axes(std::move(axes), x.shape.size(), "rfftn");
+        Tensor<std::complex<T>> out = detail::r2c_axis(x, axes.back(), "rfftn");
+        for (std::size_t i = 0; i + 1 < axes.size(); ++i) detail::c2c_axis(out, axes[i], false, "rfftn");
+        return out;
+    }
+
+    // Inverse of rfftn; n is the length of the last listed axis (default 2 * (bins - 1)).
+    template <typename T>
+    Tensor<T> irfftn(const Tensor<std::complex<T>>& X, std::size_t n = 0, std::vector<int> axes = {}) {
+        axes = detail::resolve_axes(std::move(axes), X.shape.size(), "irfftn");
+        Tensor<std::complex<T>> tmp = X;
+        for (std::size_t i = 0; i + 1 < axes.size(); ++i) detail::c2c_axis(tmp, axes[i], true, "irfftn");
+        return detail::c2r_axis(tmp, n, axes.back(), "irfftn");
+    }
+
+
+    // --- Frequencies ---
+
+    // Bin frequencies for a length-n transform with sample spacing d:
+    // [0, 1, ..., ceil(n/2) - 1, -floor(n/2), ..., -1] / (d n).
+    template <typename T = double>
+    Tensor<T> fftfreq(std::size_t n, T d = static_cast<T>(1)) {
+        Tensor<T> f({n});
+        for (std::size_t i = 0; i < n; ++i) {
+            const double k = i < (n + 1) / 2 ? static_cast<double>(i) : static_cast<double>(i) - static_cast<double>(n);
+            f.data[i] = static_cast<T>(k / (static_cast<double>(d) * static_cast<double>(n)));
+        }
+        return f;
+    }
+
+    template <typename T = double>
+    Tensor<T> rfftfreq(std::size_t n, T d = static_cast<T>(1)) {
+        Tensor<T> f({n / 2 + 1});
+        for (std::size_t i = 0; i <= n / 2; ++i) f.data[i] = static_cast<T>(static_cast<double>(i) / (static_cast<double>(d) * static_cast<double>(n)));
+        return f;
+    }
+
+} // namespace fft
+} // namespace tl
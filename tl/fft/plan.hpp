@@ -0,0 +1,356 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// FFT plans: everything about a transform length that can be computed once.
+//
+//   FFTPlan<T>(n)      complex transform of length n
+//       n = product of factors <= 13   mixed-radix Stockham (radix 4, 2, 3 with
+//                                      hand-written butterflies, 5..13 generic)
+//       otherwise                      Bluestein: a chirp-z convolution through a
+//                                      power-of-two plan of length >= 2n - 1
+//   RealFFTPlan<T>(n)  real-input transform of length n, producing n/2 + 1 bins;
+//                      even n runs as one complex transform of length n/2
+//
+// Stockham ordering is self-sorting (no bit-reversal pass) and writes each stage
+// with unit stride, so the butterfly loops vectorise; complex products are spelled
+// out in real arithmetic to avoid the NaN-recovery path of std::complex operator*.
+//
+// plan<T>(n) / real_plan<T>(n) return shared plans from a process-wide cache, so
+// repeated transforms of one length pay for twiddles once.  Plans are immutable and
+// may be executed from several threads at once, each with its own scratch.
+
+namespace tl {
+namespace fft {
+
+    namespace detail {
+
+        constexpr std::size_t max_direct_radix = 13;   // larger prime factors go through Bluestein
+
+        template <typename T>
+        inline std::complex<T> cmul(const std::complex<T>& a, const std::complex<T>& b) {
+            return {a.real() * b.real() - a.imag() * b.imag(), a.real() * b.imag() + a.imag() * b.real()};
+        }
+
+        // exp(-2 pi i k / n), evaluated in double.
+        template <typename T>
+        std::complex<T> root(std::size_t k, std::size_t n) {
+            const double a = -2.0 * 3.14159265358979323846 * static_cast<double>(k % n) / static_cast<double>(n);
+            return {static_cast<T>(std::cos(a)), static_cast<T>(std::sin(a))};
+        }
+
+        // 4s first (fewest passes), then 2, then odd primes in increasing order.
+        inline std::vector<std::size_t> factorize(std::size_t n) {
+            std::vector<std::size_t> f;
+            while (n % 4 == 0) { f.push_back(4); n /= 4; }
+            while (n % 2 == 0) { f.push_back(2); n /= 2; }
+            for (std::size_t p = 3; p * p <= n; p += 2)
+                while (n % p == 0) { f.push_back(p); n /= p; }
+            if (n > 1) f.push_back(n);
+            return f;
+        }
+
+        // Visits the (j, k, o) triples of one Stockham stage: j = block * span + k is the
+        // input index, o = block * span * radix + k the first output index.  The unit-stride
+        // index goes innermost, whichever that is.
+        template <typename Fn>
+        inline void stage_indices(std::size_t blocks, std::size_t span, std::size_t radix, Fn&& fn) {
+            if (span >= 8) {
+                for (std::size_t b = 0; b < blocks; ++b) {
+                    const std::size_t j0 = b * span, o0 = b * span * radix;
+                    #pragma omp simd
+                    for (std::size_t k = 0; k < span; ++k) fn(j0 + k, k, o0 + k);
+                }
+            } else {
+                for (std::size_t k = 0; k < span; ++k) {
+                    #pragma omp simd
+                    for (std::size_t b = 0; b < blocks; ++b) fn(b * span + k, k, b * span * radix + k);
+                }
+            }
+        }
+
+        template <typename P>
+        std::shared_ptr<const P> cached_plan(std::size_t n) {
+            static std::mutex mu;
+            static std::unordered_map<std::size_t, std::shared_ptr<const P>> cache;
+            {
+                std::lock_guard<std::mutex> lock(mu);
+                const auto it = cache.find(n);
+                if (it != cache.end()) return it->second;
+            }
+            // Built outside the lock: a plan may itself request a (different) cached plan.
+            auto built = std::make_shared<const P>(n);
+            std::lock_guard<std::mutex> lock(mu);
+            return cache.emplace(n, std::move(built)).first->second;
+        }
+
+    } // namespace detail
+
+
+    template <typename T>
+    class FFTPlan {
+        static_assert(std::is_floating_point_v<T>, "FFTPlan requires float or double.");
+
+    public:
+        using C = std::complex<T>;
+
+        explicit FFTPlan(std::size_t n) : n_(n) {
+            if (n == 0) throw std::runtime_error("fft: transform length must be positive.");
+            factors_ = detail::factorize(n);
+            if (!factors_.empty() && factors_.back() > detail::max_direct_radix) {
+                init_bluestein();
+                return;
+            }
+            std::sort(factors_.begin(), factors_.end(), [](std::size_t a, std::size_t b) { return (a == 4) > (b == 4) || ((a == 4) == (b == 4) && a < b); });
+            std::size_t span = 1;
+            for (std::size_t r : factors_) {
+                Stage st{r, span, {}, {}};
+                st.twiddles.resize(r * span);
+                for (std::size_t q = 0; q < r; ++q)
+                    for (std::size_t k = 0; k < span; ++k) st.twiddles[q * span + k] = detail::root<T>(q * k, span * r);
+                if (r > 4) {
+                    st.roots.resize(r * r);
+                    for (std::size_t q = 0; q < r; ++q)
+                        for (std::size_t p = 0; p < r; ++p) st.roots[q * r + p] = detail::root<T>(q * p, r);
+                }
+                stages_.push_back(std::move(st));
+                span *= r;
+            }
+        }
+
+        std::size_t size() const { return n_; }
+        bool uses_bluestein() const { return conv_ != nullptr; }
+        const std::vector<std::size_t>& factors() const { return factors_; }
+
+        // Elements of scratch execute() needs.
+        std::size_t scratch_size() const { return conv_ ? 2 * conv_->size() : n_; }
+
+        // data <- DFT(data) in place; the inverse is unnormalised (no 1/n).
+        void execute(C* data, C* scratch, bool inverse = false) const {
+            if (inverse) for (std::size_t i = 0; i < n_; ++i) data[i] = std::conj(data[i]);
+            if (conv_) bluestein(data, scratch);
+            else stockham(data, scratch);
+            if (inverse) for (std::size_t i = 0; i < n_; ++i) data[i] = std::conj(data[i]);
+        }
+
+    private:
+        struct Stage {
+            std::size_t radix, span;        // span = product of the radices before this stage
+            std::vector<C> twiddles;        // [q * span + k] = w_{span * radix}^{q k}
+            std::vector<C> roots;           // [q * radix + p] = w_radix^{q p}, for the generic butterfly
+        };
+
+        void stockham(C* data, C* scratch) const {
+            C* src = data;
+            C* dst = scratch;
+            for (const auto& st : stages_) {
+                run_stage(st, src, dst);
+                std::swap(src, dst);
+            }
+            if (src != data) std::copy(src, src + n_, data);
+        }
+
+        void run_stage(const Stage& st, const C* in, C* out) const {
+            using detail::cmul;
+            const std::size_t R = st.radix, Ns = st.span, s = n_ / R, blocks = s / Ns;
+            const C* tw = st.twiddles.data();
+            switch (R) {
+                case 2:
+                    detail::stage_indices(blocks, Ns, R, [&](std::size_t j, std::size_t k, std::size_t o) {
+                        const C a = in[j], b = cmul(in[j + s], tw[Ns + k]);
+                        out[o] = a + b;
+                        out[o + Ns] = a - b;
+                    });
+                    break;
+                case 3: {
+                    const T h = static_cast<T>(0.5), r3 = static_cast<T>(0.86602540378443864676);
+                    detail::stage_indices(blocks, Ns, R, [&](std::size_t j, std::size_t k, std::size_t o) {
+                        const C a0 = in[j], a1 = cmul(in[j + s], tw[Ns + k]), a2 = cmul(in[j + 2 * s], tw[2 * Ns + k]);
+                        const C t1 = a1 + a2, d = a1 - a2;
+                        const C t2(a0.real() - h * t1.real(), a0.imag() - h * t1.imag());
+                        const C t3(r3 * d.imag(), -r3 * d.real());          // -i sin(2pi/3) d
+                        out[o] = a0 + t1;
+                        out[o + Ns] = t2 + t3;
+                        out[o + 2 * Ns] = t2 - t3;
+                    });
+                    break;
+                }
+                case 4:
+                    detail::stage_indices(blocks, Ns, R, [&](std::size_t j, std::size_t k, std::size_t o) {
+                        const C a0 = in[j], a1 = cmul(in[j + s], tw[Ns + k]);
+                        const C a2 = cmul(in[j + 2 * s], tw[2 * Ns + k]), a3 = cmul(in[j + 3 * s], tw[3 * Ns + k]);
+                        const C t0 = a0 + a2, t1 = a0 - a2, t2 = a1 + a3, d = a1 - a3;
+                        const C t3(d.imag(), -d.real());                    // -i d
+                        out[o] = t0 + t2;
+                        out[o + Ns] = t1 + t3;
+                        out[o + 2 * Ns] = t0 - t2;
+                        out[o + 3 * Ns] = t1 - t3;
+                    });
+                    break;
+                default: {
+                    const C* w = st.roots.data();
+                    for (std::size_t b = 0; b < blocks; ++b) {
+                        for (std::size_t k = 0; k < Ns; ++k) {
+                            const std::size_t j = b * Ns + k, o = b * Ns * R + k;
+                            C v[detail::max_direct_radix];
+                            v[0] = in[j];
+                            for (std::size_t q = 1; q < R; ++q) v[q] = cmul(in[j + q * s], tw[q * Ns + k]);
+                            for (std::size_t q = 0; q < R; ++q) {
+                                const C* wq = w + q * R;
+                                T re = v[0].real(), im = v[0].imag();
+                                for (std::size_t r = 1; r < R; ++r) {
+                                    re += v[r].real() * wq[r].real() - v[r].imag() * wq[r].imag();
+                                    im += v[r].real() * wq[r].imag() + v[r].imag() * wq[r].real();
+                                }
+                                out[o + q * Ns] = C(re, im);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        void init_bluestein() {
+            std::size_t m = 1;
+            while (m < 2 * n_ - 1) m *= 2;
+            conv_ = detail::cached_plan<FFTPlan>(m);
+            chirp_.resize(n_);
+            for (std::size_t k = 0; k < n_; ++k) {
+                // exp(-i pi k^2 / n), with k^2 reduced mod 2n to keep the angle small.
+                const std::size_t k2 = static_cast<std::size_t>((static_cast<unsigned long long>(k) * k) % (2 * n_));
+                chirp_[k] = detail::root<T>(k2, 2 * n_);
+            }
+            std::vector<C> b(m, C(0)), work(conv_->scratch_size());
+            b[0] = std::conj(chirp_[0]);
+            for (std::size_t k = 1; k < n_; ++k) b[k] = b[m - k] = std::conj(chirp_[k]);
+            conv_->execute(b.data(), work.data());
+            const T inv_m = static_cast<T>(1) / static_cast<T>(m);
+            for (auto& v : b) v *= inv_m;                              // folds in the inverse's 1/m
+            chirp_fft_ = std::move(b);
+        }
+
+        void bluestein(C* data, C* scratch) const {
+            using detail::cmul;
+            const std::size_t m = conv_->size();
+            C* a = scratch;
+            C* work = scratch + m;
+            for (std::size_t k = 0; k < n_; ++k) a[k] = cmul(data[k], chirp_[k]);
+            std::fill(a + n_, a + m, C(0));
+            conv_->execute(a, work);
+            for (std::size_t i = 0; i < m; ++i) a[i] = cmul(a[i], chirp_fft_[i]);
+            conv_->execute(a, work, true);
+            for (std::size_t k = 0; k < n_; ++k) data[k] = cmul(a[k], chirp_[k]);
+        }
+
+        std::size_t n_;
+        std::vector<std::size_t> factors_;
+        std::vector<Stage> stages_;
+        std::shared_ptr<const FFTPlan> conv_;     // Bluestein only
+        std::vector<C> chirp_, chirp_fft_;
+    };
+
+
+    template <typename T>
+    class RealFFTPlan {
+        static_assert(std::is_floating_point_v<T>, "RealFFTPlan requires float or double.");
+
+    public:
+        using C = std::complex<T>;
+
+        explicit RealFFTPlan(std::size_t n) : n_(n) {
+            if (n == 0) throw std::runtime_error("fft: transform length must be positive.");
+            const bool packed = n % 2 == 0;
+            inner_ = detail::cached_plan<FFTPlan<T>>(packed ? n / 2 : n);
+            if (packed) {
+                twiddles_.resize(n / 2 + 1);
+                for (std::size_t k = 0; k <= n / 2; ++k) twiddles_[k] = detail::root<T>(k, n);
+            }
+        }
+
+        std::size_t size() const { return n_; }
+        std::size_t bins() const { return n_ / 2 + 1; }
+        std::size_t scratch_size() const { return inner_->size() + inner_->scratch_size(); }
+
+        // X[0, n/2] <- DFT(x[0, n)).
+        void forward(const T* x, C* X, C* scratch) const {
+            C* z = scratch;
+            C* work = scratch + inner_->size();
+            if (twiddles_.empty()) {
+                for (std::size_t i = 0; i < n_; ++i) z[i] = C(x[i], T(0));
+                inner_->execute(z, work);
+                std::copy(z, z + bins(), X);
+                return;
+            }
+            // z_k = x_2k + i x_2k+1; its transform holds the even and odd halves' spectra.
+            const std::size_t h = n_ / 2;
+            for (std::size_t k = 0; k < h; ++k) z[k] = C(x[2 * k], x[2 * k + 1]);
+            inner_->execute(z, work);
+            const T half = static_cast<T>(0.5);
+            for (std::size_t k = 0; k <= h; ++k) {
+                const C zk = z[k % h], zc = std::conj(z[(h - k) % h]);
+                const C even = (zk + zc) * half;
+                const C d = (zk - zc) * half;
+                const C odd(d.imag(), -d.real());                      // (zk - zc) / 2i
+                X[k] = even + detail::cmul(twiddles_[k], odd);
+            }
+        }
+
+        // x[0, n) <- unnormalised inverse DFT of the Hermitian spectrum X[0, n/2]
+        // (the imaginary parts of the DC and Nyquist bins are ignored).
+        void inverse(const C* X, T* x, C* scratch) const {
+            C* z = scratch;
+            C* work = scratch + inner_->size();
+            const std::size_t nb = bins();
+            auto bin = [&](std::size_t k) {
+                const bool real_bin = k == 0 || (n_ % 2 == 0 && k == n_ / 2);
+                return real_bin ? C(X[k].real(), T(0)) : X[k];
+            };
+            if (twiddles_.empty()) {
+                for (std::size_t k = 0; k < nb; ++k) z[k] = bin(k);
+                for (std::size_t k = nb; k < n_; ++k) z[k] = std::conj(bin(n_ - k));
+                inner_->execute(z, work, true);
+                for (std::size_t i = 0; i < n_; ++i) x[i] = z[i].real();
+                return;
+            }
+            const std::size_t h = n_ / 2;
+            const T half = static_cast<T>(0.5);
+            for (std::size_t k = 0; k < h; ++k) {
+                const C xk = bin(k), xc = std::conj(bin(h - k));
+                const C even = (xk + xc) * half;
+                const C odd = detail::cmul((xk - xc) * half, std::conj(twiddles_[k]));
+                z[k] = C(even.real() - odd.imag(), even.imag() + odd.real());   // even + i odd
+            }
+            inner_->execute(z, work, true);
+            for (std::size_t k = 0; k < h; ++k) {
+                x[2 * k] = 2 * z[k].real();
+                x[2 * k + 1] = 2 * z[k].imag();
+            }
+        }
+
+    private:
+        std::size_t n_;
+        std::shared_ptr<const FFTPlan<T>> inner_;   // length n/2 (even n) or n
+        std::vector<C> twiddles_;                   // w_n^k, k <= n/2 (even n only)
+    };
+
+
+    // Shared plans from the process-wide cache.
+    template <typename T>
+    std::shared_ptr<const FFTPlan<T>> plan(std::size_t n) { return detail::cached_plan<FFTPlan<T>>(n); }
+
+    template <typename T>
+    std::shared_ptr<const RealFFTPlan<T>> real_plan(std::size_t n) { return detail::cached_plan<RealFFTPlan<T>>(n); }
+
+} // namespace fft
+} // namespace tl
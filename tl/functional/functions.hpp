@@ -22,18 +22,26 @@ namespace functional {
         Tout* dst = res.data.data();
         const std::size_t n = t.data.size();
 
+        // 16-bit outputs are computed in float and rounded on store.
+        using C = accum_t<Tout>;
+
         #pragma omp simd
         for (std::size_t i = 0; i < n; ++i) {
-            dst[i] = op(static_cast<Tout>(src[i]));
+            dst[i] = static_cast<Tout>(op(static_cast<C>(src[i])));
         }
         return res;
     }
 
     // Helper: deduce output type.
     // For floating-point T: output is T (preserves float or double).
+    // For float16 / bfloat16: output keeps the 16-bit storage type.
     // For integral T: output is float (sensible default for math functions on ints).
     template <typename T>
-    using math_result_t = std::conditional_t<std::is_floating_point_v<T>, T, float>;
+    using math_result_t = std::conditional_t<std::is_floating_point_v<T> || is_half_v<T>, T, float>;
+
+    // Type the element functions compute in (float for the 16-bit types).
+    template <typename T>
+    using math_compute_t = accum_t<math_result_t<T>>;
 
     // Convenience wrapper that applies the type promotion rule above.
     template <typename T, typename Op>
@@ -46,22 +54,26 @@ namespace functional {
 
     template <typename T>
     Tensor<math_result_t<T>> abs(const Tensor<T>& t) {
-        return apply_unary_math(t, [](math_result_t<T> v) { return std::abs(v); });
+        TL_PROFILE_OP("abs", t.data.size(), t.shape);
+        return apply_unary_math(t, [](math_compute_t<T> v) { return std::abs(v); });
     }
 
     template <typename T>
     Tensor<math_result_t<T>> exp(const Tensor<T>& t) {
-        return apply_unary_math(t, [](math_result_t<T> v) { return std::exp(v); });
+        TL_PROFILE_OP("exp", t.data.size(), t.shape);
+        return apply_unary_math(t, [](math_compute_t<T> v) { return std::exp(v); });
     }
 
     template <typename T>
     Tensor<math_result_t<T>> log(const Tensor<T>& t) {
-        return apply_unary_math(t, [](math_result_t<T> v) { return std::log(v); });
+        TL_PROFILE_OP("log", t.data.size(), t.shape);
+        return apply_unary_math(t, [](math_compute_t<T> v) { return std::log(v); });
     }
 
     template <typename T>
     Tensor<math_result_t<T>> sqrt(const Tensor<T>& t) {
-        return apply_unary_math(t, [](math_result_t<T> v) { return std::sqrt(v); });
+        TL_PROFILE_OP("sqrt", t.data.size(), t.shape);
+        return apply_unary_math(t, [](math_compute_t<T> v) { return std::sqrt(v); });
     }
 
 
@@ -69,32 +81,38 @@ namespace functional {
 
     template <typename T>
     Tensor<math_result_t<T>> sin(const Tensor<T>& t) {
-        return apply_unary_math(t, [](math_result_t<T> v) { return std::sin(v); });
+        TL_PROFILE_OP("sin", t.data.size(), t.shape);
+        return apply_unary_math(t, [](math_compute_t<T> v) { return std::sin(v); });
     }
 
     template <typename T>
     Tensor<math_result_t<T>> cos(const Tensor<T>& t) {
-        return apply_unary_math(t, [](math_result_t<T> v) { return std::cos(v); });
+        TL_PROFILE_OP("cos", t.data.size(), t.shape);
+        return apply_unary_math(t, [](math_compute_t<T> v) { return std::cos(v); });
     }
 
     template <typename T>
     Tensor<math_result_t<T>> tan(const Tensor<T>& t) {
-        return apply_unary_math(t, [](math_result_t<T> v) { return std::tan(v); });
+        TL_PROFILE_OP("tan", t.data.size(), t.shape);
+        return apply_unary_math(t, [](math_compute_t<T> v) { return std::tan(v); });
     }
 
     template <typename T>
     Tensor<math_result_t<T>> sinh(const Tensor<T>& t) {
-        return apply_unary_math(t, [](math_result_t<T> v) { return std::sinh(v); });
+        TL_PROFILE_OP("sinh", t.data.size(), t.shape);
+        return apply_unary_math(t, [](math_compute_t<T> v) { return std::sinh(v); });
     }
 
     template <typename T>
     Tensor<math_result_t<T>> cosh(const Tensor<T>& t) {
-        return apply_unary_math(t, [](math_result_t<T> v) { return std::cosh(v); });
+        TL_PROFILE_OP("cosh", t.data.size(), t.shape);
+        return apply_unary_math(t, [](math_compute_t<T> v) { return std::cosh(v); });
     }
 
     template <typename T>
     Tensor<math_result_t<T>> tanh(const Tensor<T>& t) {
-        return apply_unary_math(t, [](math_result_t<T> v) { return std::tanh(v); });
+        TL_PROFILE_OP("tanh", t.data.size(), t.shape);
+        return apply_unary_math(t, [](math_compute_t<T> v) { return std::tanh(v); });
     }
 
 
@@ -103,17 +121,20 @@ namespace functional {
 
     template <typename T>
     Tensor<math_result_t<T>> asinh(const Tensor<T>& t) {
-        return apply_unary_math(t, [](math_result_t<T> v) { return std::asinh(v); });
+        TL_PROFILE_OP("asinh", t.data.size(), t.shape);
+        return apply_unary_math(t, [](math_compute_t<T> v) { return std::asinh(v); });
     }
 
     template <typename T>
     Tensor<math_result_t<T>> acosh(const Tensor<T>& t) {
-        return apply_unary_math(t, [](math_result_t<T> v) { return std::acosh(v); });
+        TL_PROFILE_OP("acosh", t.data.size(), t.shape);
+        return apply_unary_math(t, [](math_compute_t<T> v) { return std::acosh(v); });
     }
 
     template <typename T>
     Tensor<math_result_t<T>> atanh(const Tensor<T>& t) {
-        return apply_unary_math(t, [](math_result_t<T> v) { return std::atanh(v); });
+        TL_PROFILE_OP("atanh", t.data.size(), t.shape);
+        return apply_unary_math(t, [](math_compute_t<T> v) { return std::atanh(v); });
     }
 
 
@@ -121,17 +142,20 @@ namespace functional {
 
     template <typename T>
     Tensor<math_result_t<T>> ceil(const Tensor<T>& t) {
-        return apply_unary_math(t, [](math_result_t<T> v) { return std::ceil(v); });
+        TL_PROFILE_OP("ceil", t.data.size(), t.shape);
+        return apply_unary_math(t, [](math_compute_t<T> v) { return std::ceil(v); });
     }
 
     template <typename T>
     Tensor<math_result_t<T>> floor(const Tensor<T>& t) {
-        return apply_unary_math(t, [](math_result_t<T> v) { return std::floor(v); });
+        TL_PROFILE_OP("floor", t.data.size(), t.shape);
+        return apply_unary_math(t, [](math_compute_t<T> v) { return std::floor(v); });
     }
 
     template <typename T>
     Tensor<math_result_t<T>> round(const Tensor<T>& t) {
-        return apply_unary_math(t, [](math_result_t<T> v) { return std::round(v); });
+        TL_PROFILE_OP("round", t.data.size(), t.shape);
+        return apply_unary_math(t, [](math_compute_t<T> v) { return std::round(v); });
     }
 
 
@@ -139,13 +163,15 @@ namespace functional {
 
     template <typename T>
     Tensor<math_result_t<T>> square(const Tensor<T>& t) {
-        return apply_unary_math(t, [](math_result_t<T> v) { return v * v; });
+        TL_PROFILE_OP("square", t.data.size(), t.shape);
+        return apply_unary_math(t, [](math_compute_t<T> v) { return v * v; });
     }
 
     // Element-wise power: result[i] = t[i]^p
     template <typename T>
-    Tensor<math_result_t<T>> power(const Tensor<T>& t, math_result_t<T> p) {
-        return apply_unary_math(t, [p](math_result_t<T> v) { return std::pow(v, p); });
+    Tensor<math_result_t<T>> power(const Tensor<T>& t, math_compute_t<T> p) {
+        TL_PROFILE_OP("power", t.data.size(), t.shape);
+        return apply_unary_math(t, [p](math_compute_t<T> v) { return std::pow(v, p); });
     }
 
 
@@ -153,19 +179,22 @@ namespace functional {
 
     template <typename T>
     Tensor<math_result_t<T>> relu(const Tensor<T>& t) {
-        using R = math_result_t<T>;
+        TL_PROFILE_OP("relu", t.data.size(), t.shape);
+        using R = math_compute_t<T>;
         return apply_unary_math(t, [](R v) { return (v > R{0}) ? v : R{0}; });
     }
 
     template <typename T>
-    Tensor<math_result_t<T>> leaky_relu(const Tensor<T>& t, math_result_t<T> alpha = 0.01f) {
-        using R = math_result_t<T>;
+    Tensor<math_result_t<T>> leaky_relu(const Tensor<T>& t, math_compute_t<T> alpha = 0.01f) {
+        TL_PROFILE_OP("leaky_relu", t.data.size(), t.shape);
+        using R = math_compute_t<T>;
         return apply_unary_math(t, [alpha](R v) { return (v > R{0}) ? v : alpha * v; });
     }
 
     template <typename T>
     Tensor<math_result_t<T>> sigmoid(const Tensor<T>& t) {
-        using R = math_result_t<T>;
+        TL_PROFILE_OP("sigmoid", t.data.size(), t.shape);
+        using R = math_compute_t<T>;
         return apply_unary_math(t, [](R v) { return R{1} / (R{1} + std::exp(-v)); });
     }
 
@@ -173,8 +202,9 @@ namespace functional {
     // --- Clamping ---
 
     template <typename T>
-    Tensor<math_result_t<T>> clip(const Tensor<T>& t, math_result_t<T> min_val, math_result_t<T> max_val) {
-        using R = math_result_t<T>;
+    Tensor<math_result_t<T>> clip(const Tensor<T>& t, math_compute_t<T> min_val, math_compute_t<T> max_val) {
+        TL_PROFILE_OP("clip", t.data.size(), t.shape);
+        using R = math_compute_t<T>;
         return apply_unary_math(t, [min_val, max_val](R v) {
             return std::max(min_val, std::min(max_val, v));
         });
@@ -0,0 +1,276 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include "functions.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+// Fused, numerically stable softmax family.
+//
+//   softmax(x, axis)                    : exp(x - max) / sum exp(x - max)
+//   log_softmax(x, axis)                : x - max - log(sum exp(x - max))
+//   softmax_cross_entropy(logits, y)    : mean loss and d loss / d logits in one sweep
+//   cross_entropy(logits, y)            : the loss alone
+//
+// Each slice along the axis is read twice: one pass keeps a running maximum and a
+// sum rescaled whenever the maximum grows (online softmax), and one pass writes
+// the output.  No intermediate exp() tensor is allocated, and large logits do not
+// overflow.  The running state is kept in independent lanes so the update loop
+// vectorises.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace functional {
+
+    template <typename T>
+    struct CrossEntropyResult {
+        T loss;             // mean over the batch
+        Tensor<T> grad;     // d loss / d logits, [B, C]
+    };
+
+
+    namespace detail {
+
+        constexpr std::size_t softmax_parallel_threshold = 1 << 15;
+        constexpr std::size_t softmax_lanes = 8;
+
+        // x viewed as [outer, len, inner] around `axis` (negative counts from the back).
+        struct AxisSplit { std::size_t outer, len, inner; };
+
+        inline AxisSplit split_axis(const std::vector<std::size_t>& shape, int axis, const char* op) {
+            const int rank = static_cast<int>(shape.size());
+            const int a = axis < 0 ? axis + rank : axis;
+            if (rank == 0 || a < 0 || a >= rank) {
+                throw std::runtime_error(std::string(op) + ": axis " + std::to_string(axis) +
+                                         " out of range for rank " + std::to_string(rank) + ".");
+            }
+            AxisSplit s{1, shape[static_cast<std::size_t>(a)], 1};
+            for (int d = 0; d < a; ++d) s.outer *= shape[static_cast<std::size_t>(d)];
+            for (int d = a + 1; d < rank; ++d) s.inner *= shape[static_cast<std::size_t>(d)];
+            if (s.len == 0) throw std::runtime_error(std::string(op) + ": reduction axis is empty.");
+            return s;
+        }
+
+        // Folds v into the running (m, s): s is the sum of exp(x - m) seen so far.
+        // One exp per element and no branch: exp(-|v - m|) rescales whichever side is smaller.
+        // A -inf (masked) logit contributes nothing, even before any finite one (where
+        // v - m would be -inf + inf = NaN).
+        template <typename T>
+        inline void online_update(T& m, T& s, T v) {
+            const T d = v == -std::numeric_limits<T>::infinity() ? v : v - m;
+            const T e = std::exp(-std::abs(d));
+            s = d > static_cast<T>(0) ? s * e + static_cast<T>(1) : s + e;
+            m = std::max(m, v);
+        }
+
+        // Running max and rescaled sum of a contiguous row.
+        template <typename Tout, typename T>
+        void online_max_sum(const T* x, std::size_t n, Tout& m_out, Tout& s_out) {
+            constexpr std::size_t L = softmax_lanes;
+            Tout m[L], s[L];
+            for (std::size_t l = 0; l < L; ++l) { m[l] = -std::numeric_limits<Tout>::infinity(); s[l] = static_cast<Tout>(0); }
+            std::size_t i = 0;
+            for (; i + L <= n; i += L) {
+                #pragma omp simd
+                for (std::size_t l = 0; l < L; ++l) online_update(m[l], s[l], static_cast<Tout>(x[i + l]));
+            }
+            for (std::size_t l = 0; i < n; ++i, ++l) online_update(m[l], s[l], static_cast<Tout>(x[i]));
+
+            Tout M = m[0];
+            for (std::size_t l = 1; l < L; ++l) M = std::max(M, m[l]);
+            Tout S = static_cast<Tout>(0);
+            for (std::size_t l = 0; l < L; ++l)
+                if (s[l] > static_cast<Tout>(0)) S += s[l] * std::exp(m[l] - M);
+            m_out = M;
+            s_out = S;
+        }
+
+        // Log selects log_softmax; otherwise softmax.  Statistics and exponentials are
+        // computed in accum_t<Tout> (float for 16-bit outputs) and rounded on store.
+        template <bool Log, typename Tout, typename T>
+        Tensor<Tout> softmax_impl(const Tensor<T>& x, int axis, const char* op) {
+            using A = accum_t<Tout>;
+            const AxisSplit sp = split_axis(x.shape, axis, op);
+            TL_PROFILE_OP(op, 4 * x.data.size(), x.shape);
+            Tensor<Tout> y(x.shape);
+            const T* xs = x.data.data();
+            Tout* ys = y.data.data();
+            const std::ptrdiff_t outer = static_cast<std::ptrdiff_t>(sp.outer);
+
+            if (sp.inner == 1) {
+                #pragma omp parallel for schedule(static) if(x.data.size() > softmax_parallel_threshold)
+                for (std::ptrdiff_t r = 0; r < outer; ++r) {
+                    const T* row = xs + static_cast<std::size_t>(r) * sp.len;
+                    Tout* out = ys + static_cast<std::size_t>(r) * sp.len;
+                    A m, s;
+                    online_max_sum<A>(row, sp.len, m, s);
+                    if constexpr (Log) {
+                        const A shift = m + std::log(s);
+                        #pragma omp simd
+                        for (std::size_t j = 0; j < sp.len; ++j) out[j] = static_cast<Tout>(static_cast<A>(row[j]) - shift);
+                    } else {
+                        const A inv = static_cast<A>(1) / s;
+                        #pragma omp simd
+                        for (std::size_t j = 0; j < sp.len; ++j) out[j] = static_cast<Tout>(std::exp(static_cast<A>(row[j]) - m) * inv);
+                    }
+                }
+                return y;
+            }
+
+            // Strided axis: the running state is one lane per inner index.
+            #pragma omp parallel if(x.data.size() > softmax_parallel_threshold)
+            {
+                std::vector<A> m(sp.inner), s(sp.inner);
+                #pragma omp for schedule(static)
+                for (std::ptrdiff_t r = 0; r < outer; ++r) {
+                    const T* block = xs + static_cast<std::size_t>(r) * sp.len * sp.inner;
+                    Tout* out = ys + static_cast<std::size_t>(r) * sp.len * sp.inner;
+                    std::fill(m.begin(), m.end(), -std::numeric_limits<A>::infinity());
+                    std::fill(s.begin(), s.end(), static_cast<A>(0));
+                    for (std::size_t j = 0; j < sp.len; ++j) {
+                        const T* row = block + j * sp.inner;
+                        #pragma omp simd
+                        for (std::size_t k = 0; k < sp.inner; ++k) online_update(m[k], s[k], static_cast<A>(row[k]));
+                    }
+                    if constexpr (Log) {
+                        for (std::size_t k = 0; k < sp.inner; ++k) m[k] += std::log(s[k]);
+                    } else {
+                        for (std::size_t k = 0; k < sp.inner; ++k) s[k] = static_cast<A>(1) / s[k];
+                    }
+                    for (std::size_t j = 0; j < sp.len; ++j) {
+                        const T* row = block + j * sp.inner;
+                        Tout* o = out + j * sp.inner;
+                        #pragma omp simd
+                        for (std::size_t k = 0; k < sp.inner; ++k) {
+                            if constexpr (Log) o[k] = static_cast<Tout>(static_cast<A>(row[k]) - m[k]);
+                            else o[k] = static_cast<Tout>(std::exp(static_cast<A>(row[k]) - m[k]) * s[k]);
+                        }
+                    }
+                }
+            }
+            return y;
+        }
+
+        template <typename T>
+        void check_logits(const Tensor<T>& logits, std::size_t batch, const char* op) {
+            if (logits.shape.size() != 2 || logits.shape[1] == 0) {
+                throw std::runtime_error(std::string(op) + " expects logits of shape [batch, classes].");
+            }
+            if (batch != logits.shape[0]) {
+                throw std::runtime_error(std::string(op) + ": " + std::to_string(batch) + " targets for a batch of " +
+                                         std::to_string(logits.shape[0]) + ".");
+            }
+        }
+
+        // Shared sweep for both target kinds: target(b, c) gives the target weight of
+        // class c in row b, target_sum(b) its row total.  grad may be null (loss only).
+        template <typename Tout, typename T, typename Target, typename TargetSum>
+        Tout cross_entropy_sweep(const Tensor<T>& logits, Target target, TargetSum target_sum, Tout* grad) {
+            using A = accum_t<Tout>;
+            const std::size_t B = logits.shape[0], C = logits.shape[1];
+            const A invB = static_cast<A>(1) / static_cast<A>(B);
+            const T* xs = logits.data.data();
+            A total = static_cast<A>(0);
+            const std::ptrdiff_t rows = static_cast<std::ptrdiff_t>(B);
+
+            #pragma omp parallel for schedule(static) reduction(+:total) if(logits.data.size() > softmax_parallel_threshold)
+            for (std::ptrdiff_t rb = 0; rb < rows; ++rb) {
+                const std::size_t b = static_cast<std::size_t>(rb);
+                const T* row = xs + b * C;
+                A m, s;
+                online_max_sum<A>(row, C, m, s);
+                const A lse = m + std::log(s);
+                const A tsum = static_cast<A>(target_sum(b));
+                // loss_b = sum_c t_c (lse - x_c)
+                A loss = tsum * lse;
+                for (std::size_t c = 0; c < C; ++c) loss -= static_cast<A>(target(b, c)) * static_cast<A>(row[c]);
+                total += loss;
+                if (grad) {
+                    Tout* g = grad + b * C;
+                    const A scale = tsum * invB;
+                    #pragma omp simd
+                    for (std::size_t c = 0; c < C; ++c)
+                        g[c] = static_cast<Tout>(std::exp(static_cast<A>(row[c]) - lse) * scale - static_cast<A>(target(b, c)) * invB);
+                }
+            }
+            return static_cast<Tout>(total * invB);
+        }
+
+        inline void check_labels(const std::vector<std::size_t>& labels, std::size_t classes, const char* op) {
+            for (auto l : labels)
+                if (l >= classes) throw std::out_of_range(std::string(op) + ": label " + std::to_string(l) +
+                                                          " out of range for " + std::to_string(classes) + " classes.");
+        }
+
+    } // namespace detail
+
+
+    // --- Softmax ---
+
+    template <typename T>
+    Tensor<math_result_t<T>> softmax(const Tensor<T>& x, int axis = -1) {
+        return detail::softmax_impl<false, math_result_t<T>>(x, axis, "softmax");
+    }
+
+    template <typename T>
+    Tensor<math_result_t<T>> log_softmax(const Tensor<T>& x, int axis = -1) {
+        return detail::softmax_impl<true, math_result_t<T>>(x, axis, "log_softmax");
+    }
+
+    // --- Cross-entropy over [batch, classes] logits (mean over the batch) ---
+
+    // Integer class labels.
+    template <typename T>
+    CrossEntropyResult<math_result_t<T>> softmax_cross_entropy(const Tensor<T>& logits, const std::vector<std::size_t>& labels) {
+        using Tout = math_result_t<T>;
+        detail::check_logits(logits, labels.size(), "softmax_cross_entropy");
+        detail::check_labels(labels, logits.shape[1], "softmax_cross_entropy");
+        TL_PROFILE_OP("softmax_cross_entropy", 5 * logits.data.size(), logits.shape);
+        CrossEntropyResult<Tout> r{static_cast<Tout>(0), Tensor<Tout>(logits.shape)};
+        r.loss = detail::cross_entropy_sweep<Tout>(logits,
+            [&](std::size_t b, std::size_t c) { return c == labels[b] ? static_cast<Tout>(1) : static_cast<Tout>(0); },
+            [](std::size_t) { return static_cast<Tout>(1); }, r.grad.data.data());
+        return r;
+    }
+
+    // Soft targets: one probability row per sample, same shape as logits.
+    template <typename T>
+    CrossEntropyResult<math_result_t<T>> softmax_cross_entropy(const Tensor<T>& logits, const Tensor<T>& targets) {
+        using Tout = math_result_t<T>;
+        if (targets.shape != logits.shape) throw std::runtime_error("softmax_cross_entropy: targets must match the logits shape.");
+        detail::check_logits(logits, targets.shape.empty() ? 0 : targets.shape[0], "softmax_cross_entropy");
+        using A = accum_t<Tout>;
+        const std::size_t C = logits.shape[1];
+        TL_PROFILE_OP("softmax_cross_entropy", 5 * logits.data.size(), logits.shape, targets.shape);
+        CrossEntropyResult<Tout> r{static_cast<Tout>(0), Tensor<Tout>(logits.shape)};
+        r.loss = detail::cross_entropy_sweep<Tout>(logits,
+            [&](std::size_t b, std::size_t c) { return static_cast<A>(targets.data[b * C + c]); },
+            [&](std::size_t b) {
+                A t = static_cast<A>(0);
+                for (std::size_t c = 0; c < C; ++c) t += static_cast<A>(targets.data[b * C + c]);
+                return t;
+            }, r.grad.data.data());
+        return r;
+    }
+
+    // Loss only; no gradient buffer is allocated.
+    template <typename T>
+    math_result_t<T> cross_entropy(const Tensor<T>& logits, const std::vector<std::size_t>& labels) {
+        using Tout = math_result_t<T>;
+        detail::check_logits(logits, labels.size(), "cross_entropy");
+        detail::check_labels(labels, logits.shape[1], "cross_entropy");
+        TL_PROFILE_OP("cross_entropy", 5 * logits.data.size(), logits.shape);
+        return detail::cross_entropy_sweep<Tout>(logits,
+            [&](std::size_t b, std::size_t c) { return c == labels[b] ? static_cast<Tout>(1) : static_cast<Tout>(0); },
+            [](std::size_t) { return static_cast<Tout>(1); }, static_cast<Tout*>(nullptr));
+    }
+
+} // namespace functional
+} // namespace tl
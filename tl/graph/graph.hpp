@@ -0,0 +1,241 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include "../tensor_core/broadcasting.hpp"
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Graph capture for replaying a fixed sequence of tensor ops.
+//
+//   Graph<T>  : records ops on symbolic tensors into a flat IR (one Node per op,
+//               in execution order) with every shape resolved at capture time
+//   Sym<T>    : handle (graph, node id) returned by every recorded op
+//
+//     tl::graph::Graph<float> g;
+//     auto x = g.input({32, 784});
+//     auto h = relu(matmul(x, g.param(W1)) + g.param(b1));
+//     g.output(softmax(matmul(h, g.param(W2)) + g.param(b2)));
+//     auto plan = tl::graph::compile(g);         // tl/graph/plan.hpp
+//     for (...) { plan.run({batch}); use(plan.output()); }
+//
+// Parameters are captured by reference and read on every replay, so updated
+// weights are picked up without recapturing; they must outlive the plan.  The op
+// set mirrors autograd::Var: broadcasting + - * /, scalar arithmetic, the
+// element-wise activations, 2D matmul and a last-axis softmax.
+
+namespace tl {
+namespace graph {
+
+    enum class Op {
+        Input, Param,
+        // element-wise binary (broadcasting)
+        Add, Sub, Mul, Div,
+        // element-wise with a scalar
+        AddScalar, SubScalar, MulScalar, DivScalar, RSubScalar, RDivScalar, LeakyRelu,
+        // element-wise unary
+        Neg, Relu, Sigmoid, Tanh, Exp, Log, Sqrt, Square, Abs,
+        // structured
+        Matmul, Softmax
+    };
+
+    inline const char* op_name(Op op) {
+        switch (op) {
+            case Op::Input: return "input";
+            case Op::Param: return "param";
+            case Op::Add: return "add";
+            case Op::Sub: return "sub";
+            case Op::Mul: return "mul";
+            case Op::Div: return "div";
+            case Op::AddScalar: return "add_scalar";
+            case Op::SubScalar: return "sub_scalar";
+            case Op::MulScalar: return "mul_scalar";
+            case Op::DivScalar: return "div_scalar";
+            case Op::RSubScalar: return "rsub_scalar";
+            case Op::RDivScalar: return "rdiv_scalar";
+            case Op::LeakyRelu: return "leaky_relu";
+            case Op::Neg: return "neg";
+            case Op::Relu: return "relu";
+            case Op::Sigmoid: return "sigmoid";
+            case Op::Tanh: return "tanh";
+            case Op::Exp: return "exp";
+            case Op::Log: return "log";
+            case Op::Sqrt: return "sqrt";
+            case Op::Square: return "square";
+            case Op::Abs: return "abs";
+            case Op::Matmul: return "matmul";
+            case Op::Softmax: return "softmax";
+        }
+        return "?";
+    }
+
+    inline bool is_elementwise(Op op) { return op >= Op::Add && op <= Op::Abs; }
+    inline bool is_binary(Op op) { return op >= Op::Add && op <= Op::Div; }
+
+    // Rank limit of captured tensors (fused kernels keep coordinates on the stack).
+    constexpr std::size_t max_rank = 8;
+
+    template <typename T>
+    struct Node {
+        Op op;
+        std::vector<std::size_t> args;
+        std::vector<std::size_t> shape;
+        T scalar = static_cast<T>(0);
+        const Tensor<T>* param = nullptr;
+
+        std::size_t numel() const {
+            std::size_t n = 1;
+            for (auto d : shape) n *= d;
+            return n;
+        }
+    };
+
+    template <typename T> class Graph;
+
+    template <typename T>
+    class Sym {
+    public:
+        Sym(Graph<T>* g, std::size_t id) : graph_(g), id_(id) {}
+
+        Graph<T>* graph() const { return graph_; }
+        std::size_t id() const { return id_; }
+        const std::vector<std::size_t>& shape() const { return graph_->nodes()[id_].shape; }
+
+    private:
+        Graph<T>* graph_;
+        std::size_t id_;
+    };
+
+
+    template <typename T>
+    class Graph {
+        static_assert(std::is_floating_point_v<T>, "graph capture requires a floating-point element type.");
+
+    public:
+        Graph() = default;
+        Graph(const Graph&) = delete;
+        Graph& operator=(const Graph&) = delete;
+
+        // --- Leaves ---
+
+        // Fed on every replay, in the order the inputs were declared.
+        Sym<T> input(std::vector<std::size_t> shape) {
+            inputs_.push_back(nodes_.size());
+            return record(Op::Input, {}, std::move(shape));
+        }
+
+        // Read in place on every replay; must outlive any plan compiled from this graph.
+        Sym<T> param(const Tensor<T>& t) {
+            Sym<T> s = record(Op::Param, {}, t.shape);
+            nodes_.back().param = &t;
+            return s;
+        }
+
+        void output(const Sym<T>& s) {
+            check(s);
+            outputs_.push_back(s.id());
+        }
+
+        // --- Recording (used by the op functions below) ---
+
+        Sym<T> record(Op op, std::vector<std::size_t> args, std::vector<std::size_t> shape, T scalar = static_cast<T>(0)) {
+            if (shape.size() > max_rank) {
+                throw std::runtime_error("graph: tensors of rank " + std::to_string(shape.size()) +
+                                         " exceed the supported rank " + std::to_string(max_rank) + ".");
+            }
+            Node<T> n;
+            n.op = op;
+            n.args = std::move(args);
+            n.shape = std::move(shape);
+            n.scalar = scalar;
+            nodes_.push_back(std::move(n));
+            return Sym<T>(this, nodes_.size() - 1);
+        }
+
+        void check(const Sym<T>& s) const {
+            if (s.graph() != this) throw std::runtime_error("graph: symbol belongs to a different graph.");
+        }
+
+        const std::vector<Node<T>>& nodes() const { return nodes_; }
+        const std::vector<std::size_t>& inputs() const { return inputs_; }
+        const std::vector<std::size_t>& outputs() const { return outputs_; }
+
+    private:
+        std::vector<Node<T>> nodes_;
+        std::vector<std::size_t> inputs_;
+        std::vector<std::size_t> outputs_;
+    };
+
+
+    namespace detail {
+
+        template <typename T>
+        Graph<T>& graph_of(const Sym<T>& a, const Sym<T>& b) {
+            if (a.graph() != b.graph()) throw std::runtime_error("graph: operands are recorded on different graphs.");
+            return *a.graph();
+        }
+
+        template <typename T>
+        Sym<T> binary(Op op, const Sym<T>& a, const Sym<T>& b) {
+            return graph_of(a, b).record(op, {a.id(), b.id()}, compute_broadcast_shape(a.shape(), b.shape()));
+        }
+
+        template <typename T>
+        Sym<T> unary(Op op, const Sym<T>& a, T scalar = static_cast<T>(0)) {
+            return a.graph()->record(op, {a.id()}, a.shape(), scalar);
+        }
+
+    } // namespace detail
+
+
+    // --- Arithmetic (with broadcasting) ---
+
+    template <typename T> Sym<T> operator+(const Sym<T>& a, const Sym<T>& b) { return detail::binary(Op::Add, a, b); }
+    template <typename T> Sym<T> operator-(const Sym<T>& a, const Sym<T>& b) { return detail::binary(Op::Sub, a, b); }
+    template <typename T> Sym<T> operator*(const Sym<T>& a, const Sym<T>& b) { return detail::binary(Op::Mul, a, b); }
+    template <typename T> Sym<T> operator/(const Sym<T>& a, const Sym<T>& b) { return detail::binary(Op::Div, a, b); }
+    template <typename T> Sym<T> operator-(const Sym<T>& a) { return detail::unary(Op::Neg, a); }
+
+    template <typename T> Sym<T> operator+(const Sym<T>& a, T s) { return detail::unary(Op::AddScalar, a, s); }
+    template <typename T> Sym<T> operator+(T s, const Sym<T>& a) { return detail::unary(Op::AddScalar, a, s); }
+    template <typename T> Sym<T> operator-(const Sym<T>& a, T s) { return detail::unary(Op::SubScalar, a, s); }
+    template <typename T> Sym<T> operator-(T s, const Sym<T>& a) { return detail::unary(Op::RSubScalar, a, s); }
+    template <typename T> Sym<T> operator*(const Sym<T>& a, T s) { return detail::unary(Op::MulScalar, a, s); }
+    template <typename T> Sym<T> operator*(T s, const Sym<T>& a) { return detail::unary(Op::MulScalar, a, s); }
+    template <typename T> Sym<T> operator/(const Sym<T>& a, T s) { return detail::unary(Op::DivScalar, a, s); }
+    template <typename T> Sym<T> operator/(T s, const Sym<T>& a) { return detail::unary(Op::RDivScalar, a, s); }
+
+    // --- Element-wise functions ---
+
+    template <typename T> Sym<T> relu(const Sym<T>& a) { return detail::unary(Op::Relu, a); }
+    template <typename T> Sym<T> leaky_relu(const Sym<T>& a, T alpha = static_cast<T>(0.01)) { return detail::unary(Op::LeakyRelu, a, alpha); }
+    template <typename T> Sym<T> sigmoid(const Sym<T>& a) { return detail::unary(Op::Sigmoid, a); }
+    template <typename T> Sym<T> tanh(const Sym<T>& a) { return detail::unary(Op::Tanh, a); }
+    template <typename T> Sym<T> exp(const Sym<T>& a) { return detail::unary(Op::Exp, a); }
+    template <typename T> Sym<T> log(const Sym<T>& a) { return detail::unary(Op::Log, a); }
+    template <typename T> Sym<T> sqrt(const Sym<T>& a) { return detail::unary(Op::Sqrt, a); }
+    template <typename T> Sym<T> square(const Sym<T>& a) { return detail::unary(Op::Square, a); }
+    template <typename T> Sym<T> abs(const Sym<T>& a) { return detail::unary(Op::Abs, a); }
+
+    // --- Structured ops ---
+
+    template <typename T>
+    Sym<T> matmul(const Sym<T>& a, const Sym<T>& b) {
+        Graph<T>& g = detail::graph_of(a, b);
+        if (a.shape().size() != 2 || b.shape().size() != 2) throw std::runtime_error("graph::matmul supports 2D matrices only.");
+        if (a.shape()[1] != b.shape()[0]) throw std::runtime_error("graph::matmul: inner dimensions must match.");
+        return g.record(Op::Matmul, {a.id(), b.id()}, {a.shape()[0], b.shape()[1]});
+    }
+
+    // Softmax over the last axis.
+    template <typename T>
+    Sym<T> softmax(const Sym<T>& a) {
+        if (a.shape().empty()) throw std::runtime_error("graph::softmax needs at least one dimension.");
+        return detail::unary(Op::Softmax, a);
+    }
+
+} // namespace graph
+} // namespace tl
@@ -0,0 +1,598 @@
+#pragma once
+
+#include "graph.hpp"
+#include "../linalg/linalg_utils.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Compilation of a captured Graph into a replayable Plan.
+//
+// compile(g) runs, in order:
+//   1. dead-code elimination   nodes that do not reach an output are dropped
+//   2. linear fusion           matmul -> (+ bias row) -> (relu | leaky_relu | sigmoid | tanh)
+//                              becomes one step whose epilogue runs on each output row
+//                              while it is still in cache
+//   3. element-wise fusion     chains of element-wise nodes whose intermediates have no
+//                              other consumer become one kernel, evaluated block by block
+//                              in stack registers so intermediates never reach memory
+//   4. memory planning         every remaining intermediate gets an offset in one arena;
+//                              values whose live ranges (first to last step) do not overlap
+//                              share storage (greedy by size, first fit)
+//
+// Plan::run() then replays the steps: shapes, broadcast strides and buffers were all
+// fixed at compile time, so a replay performs no validation beyond the input shapes and
+// no allocation.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace graph {
+
+    struct PlanStats {
+        std::size_t captured_nodes = 0;
+        std::size_t live_nodes = 0;          // after dead-code elimination
+        std::size_t steps = 0;
+        std::size_t fused_linear = 0;        // matmul steps that absorbed a bias and/or activation
+        std::size_t fused_elementwise = 0;   // element-wise nodes folded into a kernel with others
+        std::size_t arena_bytes = 0;         // intermediate storage after buffer reuse
+        std::size_t unplanned_bytes = 0;     // the same intermediates, one buffer each
+    };
+
+    template <typename T> class Plan;
+    template <typename T> Plan<T> compile(const Graph<T>& g);
+
+
+    namespace detail {
+
+        constexpr std::size_t graph_parallel_threshold = 1 << 15;
+        constexpr std::size_t fused_block = 128;           // elements per register
+        constexpr std::size_t fused_max_registers = 16;
+        constexpr std::size_t fused_max_sources = 48;      // operands + instructions
+        constexpr std::size_t arena_alignment = 16;        // elements
+        constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+        enum class Storage { Input, Param, Arena, Output };
+
+        struct Location {
+            Storage kind = Storage::Arena;
+            std::size_t index = 0;    // input slot, node id, arena offset or output slot
+        };
+
+        struct FusedOperand {
+            std::size_t value;
+            bool broadcast;
+            std::vector<std::size_t> strides;   // into the operand, over the kernel shape
+        };
+
+        template <typename T>
+        struct Instr {
+            Op op;
+            std::size_t a, b;                   // sources: operands first, then earlier results
+            T scalar;
+        };
+
+        template <typename T>
+        struct FusedKernel {
+            std::vector<std::size_t> shape;
+            std::size_t numel = 0;
+            std::size_t staged = 0;             // broadcast operands gathered per block
+            std::vector<FusedOperand> operands;
+            std::vector<Instr<T>> program;
+        };
+
+        enum class StepKind { Linear, Fused, Softmax };
+
+        template <typename T>
+        struct Step {
+            StepKind kind;
+            std::size_t out;                    // node id of the value produced
+            std::size_t a = 0, b = 0, bias = npos;
+            Op act = Op::Input;                 // Input = no activation
+            T alpha = static_cast<T>(0);
+            std::size_t M = 0, K = 0, N = 0;    // linear; softmax uses M rows of N
+            std::size_t kernel = 0;
+        };
+
+        // d = op(a, b) over n elements; b and s are ignored by ops that do not use them.
+        template <typename T>
+        void apply_op(Op op, const T* a, const T* b, T s, T* d, std::size_t n) {
+            const T one = static_cast<T>(1), zero = static_cast<T>(0);
+            switch (op) {
+                case Op::Add:        { _Pragma("omp simd") for (std::size_t j = 0; j < n; ++j) d[j] = a[j] + b[j]; break; }
+                case Op::Sub:        { _Pragma("omp simd") for (std::size_t j = 0; j < n; ++j) d[j] = a[j] - b[j]; break; }
+                case Op::Mul:        { _Pragma("omp simd") for (std::size_t j = 0; j < n; ++j) d[j] = a[j] * b[j]; break; }
+                case Op::Div:        { _Pragma("omp simd") for (std::size_t j = 0; j < n; ++j) d[j] = a[j] / b[j]; break; }
+                case Op::AddScalar:  { _Pragma("omp simd") for (std::size_t j = 0; j < n; ++j) d[j] = a[j] + s; break; }
+                case Op::SubScalar:  { _Pragma("omp simd") for (std::size_t j = 0; j < n; ++j) d[j] = a[j] - s; break; }
+                case Op::MulScalar:  { _Pragma("omp simd") for (std::size_t j = 0; j < n; ++j) d[j] = a[j] * s; break; }
+                case Op::DivScalar:  { _Pragma("omp simd") for (std::size_t j = 0; j < n; ++j) d[j] = a[j] / s; break; }
+                case Op::RSubScalar: { _Pragma("omp simd") for (std::size_t j = 0; j < n; ++j) d[j] = s - a[j]; break; }
+                case Op::RDivScalar: { _Pragma("omp simd") for (std::size_t j = 0; j < n; ++j) d[j] = s / a[j]; break; }
+                case Op::LeakyRelu:  { _Pragma("omp simd") for (std::size_t j = 0; j < n; ++j) d[j] = a[j] > zero ? a[j] : s * a[j]; break; }
+                case Op::Neg:        { _Pragma("omp simd") for (std::size_t j = 0; j < n; ++j) d[j] = -a[j]; break; }
+                case Op::Relu:       { _Pragma("omp simd") for (std::size_t j = 0; j < n; ++j) d[j] = a[j] > zero ? a[j] : zero; break; }
+                case Op::Sigmoid:    { for (std::size_t j = 0; j < n; ++j) d[j] = one / (one + std::exp(-a[j])); break; }
+                case Op::Tanh:       { for (std::size_t j = 0; j < n; ++j) d[j] = std::tanh(a[j]); break; }
+                case Op::Exp:        { for (std::size_t j = 0; j < n; ++j) d[j] = std::exp(a[j]); break; }
+                case Op::Log:        { for (std::size_t j = 0; j < n; ++j) d[j] = std::log(a[j]); break; }
+                case Op::Sqrt:       { _Pragma("omp simd") for (std::size_t j = 0; j < n; ++j) d[j] = std::sqrt(a[j]); break; }
+                case Op::Square:     { _Pragma("omp simd") for (std::size_t j = 0; j < n; ++j) d[j] = a[j] * a[j]; break; }
+                case Op::Abs:        { _Pragma("omp simd") for (std::size_t j = 0; j < n; ++j) d[j] = std::abs(a[j]); break; }
+                default: throw std::runtime_error(std::string("graph: op is not element-wise: ") + op_name(op));
+            }
+        }
+
+        // dst[j] = src[offset of flat index start + j], for an operand broadcast over `shape`.
+        template <typename T>
+        void gather(const T* src, const std::vector<std::size_t>& shape, const std::vector<std::size_t>& strides,
+                    std::size_t start, std::size_t len, T* dst) {
+            const std::size_t rank = shape.size();
+            if (rank == 0) { for (std::size_t j = 0; j < len; ++j) dst[j] = src[0]; return; }
+            std::array<std::size_t, max_rank> coord{};
+            std::size_t off = 0, rem = start;
+            for (std::size_t d = rank; d-- > 0;) {
+                coord[d] = rem % shape[d];
+                rem /= shape[d];
+                off += coord[d] * strides[d];
+            }
+            for (std::size_t j = 0; j < len; ++j) {
+                dst[j] = src[off];
+                for (std::size_t d = rank; d-- > 0;) {
+                    off += strides[d];
+                    if (++coord[d] < shape[d]) break;
+                    off -= strides[d] * shape[d];
+                    coord[d] = 0;
+                }
+            }
+        }
+
+        inline std::vector<std::size_t> contiguous_strides(const std::vector<std::size_t>& shape) {
+            std::vector<std::size_t> s(shape.size());
+            std::size_t stride = 1;
+            for (std::size_t i = shape.size(); i-- > 0;) { s[i] = stride; stride *= shape[i]; }
+            return s;
+        }
+
+        inline std::string shape_str(const std::vector<std::size_t>& shape) {
+            std::string s = "[";
+            for (std::size_t i = 0; i < shape.size(); ++i) s += (i ? "," : "") + std::to_string(shape[i]);
+            return s + "]";
+        }
+
+        inline bool is_activation(Op op) { return op == Op::Relu || op == Op::LeakyRelu || op == Op::Sigmoid || op == Op::Tanh; }
+
+    } // namespace detail
+
+
+    template <typename T>
+    class Plan {
+    public:
+        Plan(Plan&&) noexcept = default;
+        Plan& operator=(Plan&&) noexcept = default;
+
+        // Replays the plan on inputs given in declaration order.
+        void run(std::initializer_list<std::reference_wrapper<const Tensor<T>>> inputs) {
+            if (inputs.size() != input_ids_.size()) {
+                throw std::runtime_error("graph: plan expects " + std::to_string(input_ids_.size()) +
+                                         " inputs, got " + std::to_string(inputs.size()) + ".");
+            }
+            std::size_t k = 0;
+            for (const Tensor<T>& t : inputs) {
+                if (t.shape != nodes_[input_ids_[k]].shape) {
+                    throw std::runtime_error("graph: input " + std::to_string(k) + " has shape " + detail::shape_str(t.shape) +
+                                             ", captured as " + detail::shape_str(nodes_[input_ids_[k]].shape) + ".");
+                }
+                bound_[k++] = &t;
+            }
+            for (std::size_t id : param_ids_) {
+                if (nodes_[id].param->shape != nodes_[id].shape) throw std::runtime_error("graph: a parameter changed shape since capture.");
+            }
+
+            TL_PROFILE_OP("graph::run", flops_);
+            for (const auto& st : steps_) {
+                switch (st.kind) {
+                    case detail::StepKind::Linear: run_linear(st); break;
+                    case detail::StepKind::Fused: run_fused(kernels_[st.kernel], write(st.out)); break;
+                    case detail::StepKind::Softmax: run_softmax(st); break;
+                }
+            }
+            for (const auto& c : copies_) {
+                const T* src = read(c.first);
+                std::copy(src, src + outputs_[c.second].data.size(), outputs_[c.second].data.data());
+            }
+        }
+
+        std::size_t num_outputs() const { return outputs_.size(); }
+        const Tensor<T>& output(std::size_t i = 0) const {
+            if (i >= outputs_.size()) throw std::out_of_range("graph: output index " + std::to_string(i) + " out of range");
+            return outputs_[i];
+        }
+
+        const PlanStats& stats() const { return stats_; }
+
+        // One line per step, e.g. "linear [32,784]x[784,64] +bias relu -> arena@0".
+        std::string describe() const {
+            std::string s;
+            for (std::size_t i = 0; i < steps_.size(); ++i) {
+                const auto& st = steps_[i];
+                s += std::to_string(i) + ": ";
+                if (st.kind == detail::StepKind::Linear) {
+                    s += "linear " + detail::shape_str(nodes_[st.a].shape) + "x" + detail::shape_str(nodes_[st.b].shape);
+                    if (st.bias != detail::npos) s += " +bias";
+                    if (st.act != Op::Input) s += std::string(" ") + op_name(st.act);
+                } else if (st.kind == detail::StepKind::Fused) {
+                    const auto& k = kernels_[st.kernel];
+                    s += "fused " + detail::shape_str(k.shape) + " (";
+                    for (std::size_t j = 0; j < k.program.size(); ++j) s += std::string(j ? ", " : "") + op_name(k.program[j].op);
+                    s += ")";
+                } else {
+                    s += "softmax " + detail::shape_str(nodes_[st.out].shape);
+                }
+                const auto& loc = loc_[st.out];
+                s += loc.kind == detail::Storage::Output ? " -> output " + std::to_string(loc.index)
+                                                         : " -> arena@" + std::to_string(loc.index);
+                s += "\n";
+            }
+            return s;
+        }
+
+    private:
+        friend Plan compile<T>(const Graph<T>& g);
+        Plan() = default;
+
+        const T* read(std::size_t v) const {
+            const auto& l = loc_[v];
+            switch (l.kind) {
+                case detail::Storage::Input: return bound_[l.index]->data.data();
+                case detail::Storage::Param: return nodes_[v].param->data.data();
+                case detail::Storage::Arena: return arena_.data() + l.index;
+                case detail::Storage::Output: return outputs_[l.index].data.data();
+            }
+            return nullptr;
+        }
+
+        T* write(std::size_t v) {
+            const auto& l = loc_[v];
+            return l.kind == detail::Storage::Output ? outputs_[l.index].data.data() : arena_.data() + l.index;
+        }
+
+        void run_linear(const detail::Step<T>& st) {
+            TL_PROFILE_OP("graph::linear", 2.0 * st.M * st.N * st.K, nodes_[st.a].shape, nodes_[st.b].shape);
+            const T* A = read(st.a);
+            const T* B = read(st.b);
+            const T* bias = st.bias == detail::npos ? nullptr : read(st.bias);
+            T* C = write(st.out);
+            const std::size_t K = st.K, N = st.N;
+            const std::ptrdiff_t M = static_cast<std::ptrdiff_t>(st.M);
+            #pragma omp parallel for schedule(static) if(st.M * N * K > detail::graph_parallel_threshold)
+            for (std::ptrdiff_t i = 0; i < M; ++i) {
+                const std::size_t r = static_cast<std::size_t>(i);
+                linalg::detail::matmul_rows(A, B, C, r, r + 1, K, N);
+                T* c = C + r * N;
+                if (bias) {
+                    #pragma omp simd
+                    for (std::size_t j = 0; j < N; ++j) c[j] += bias[j];
+                }
+                if (st.act != Op::Input) detail::apply_op(st.act, c, c, st.alpha, c, N);
+            }
+        }
+
+        void run_fused(const detail::FusedKernel<T>& k, T* out) {
+            TL_PROFILE_OP("graph::fused", k.numel * k.program.size(), k.shape);
+            const std::size_t E = k.operands.size();
+            const std::size_t blocks = (k.numel + detail::fused_block - 1) / detail::fused_block;
+            const std::ptrdiff_t nb = static_cast<std::ptrdiff_t>(blocks);
+            std::array<const T*, detail::fused_max_sources> base{};
+            for (std::size_t e = 0; e < E; ++e) base[e] = read(k.operands[e].value);
+
+            #pragma omp parallel for schedule(static) if(k.numel > detail::graph_parallel_threshold)
+            for (std::ptrdiff_t blk = 0; blk < nb; ++blk) {
+                T regs[detail::fused_max_registers][detail::fused_block];
+                std::array<const T*, detail::fused_max_sources> src;
+                const std::size_t start = static_cast<std::size_t>(blk) * detail::fused_block;
+                const std::size_t len = std::min(detail::fused_block, k.numel - start);
+                std::size_t reg = 0;
+                for (std::size_t e = 0; e < E; ++e) {
+                    const auto& op = k.operands[e];
+                    if (op.broadcast) {
+                        detail::gather(base[e], k.shape, op.strides, start, len, regs[reg]);
+                        src[e] = regs[reg++];
+                    } else {
+                        src[e] = base[e] + start;
+                    }
+                }
+                const std::size_t last = k.program.size() - 1;
+                for (std::size_t i = 0; i <= last; ++i) {
+                    const auto& in = k.program[i];
+                    T* dst = i == last ? out + start : regs[reg++];
+                    detail::apply_op(in.op, src[in.a], src[in.b], in.scalar, dst, len);
+                    src[E + i] = dst;
+                }
+            }
+        }
+
+        void run_softmax(const detail::Step<T>& st) {
+            TL_PROFILE_OP("graph::softmax", 4 * st.M * st.N, nodes_[st.out].shape);
+            const T* X = read(st.a);
+            T* Y = write(st.out);
+            const std::size_t N = st.N;
+            const std::ptrdiff_t rows = static_cast<std::ptrdiff_t>(st.M);
+            #pragma omp parallel for schedule(static) if(st.M * N > detail::graph_parallel_threshold)
+            for (std::ptrdiff_t i = 0; i < rows; ++i) {
+                const T* x = X + static_cast<std::size_t>(i) * N;
+                T* y = Y + static_cast<std::size_t>(i) * N;
+                T m = -std::numeric_limits<T>::infinity();
+                for (std::size_t j = 0; j < N; ++j) m = std::max(m, x[j]);
+                T sum = static_cast<T>(0);
+                for (std::size_t j = 0; j < N; ++j) { y[j] = std::exp(x[j] - m); sum += y[j]; }
+                const T inv = static_cast<T>(1) / sum;
+                #pragma omp simd
+                for (std::size_t j = 0; j < N; ++j) y[j] *= inv;
+            }
+        }
+
+        std::vector<Node<T>> nodes_;
+        std::vector<std::size_t> input_ids_;
+        std::vector<std::size_t> param_ids_;
+        std::vector<const Tensor<T>*> bound_;
+        std::vector<detail::Location> loc_;
+        std::vector<detail::Step<T>> steps_;
+        std::vector<detail::FusedKernel<T>> kernels_;
+        std::vector<std::pair<std::size_t, std::size_t>> copies_;   // (value, output slot)
+        std::vector<T> arena_;
+        std::vector<Tensor<T>> outputs_;
+        double flops_ = 0.0;
+        PlanStats stats_;
+    };
+
+
+    // --- Compiler ---
+
+    template <typename T>
+    Plan<T> compile(const Graph<T>& g) {
+        using detail::npos;
+        const auto& nodes = g.nodes();
+        const std::size_t n = nodes.size();
+        if (g.outputs().empty()) throw std::runtime_error("graph: compile needs at least one output.");
+
+        Plan<T> plan;
+        plan.nodes_ = nodes;
+        plan.input_ids_ = g.inputs();
+        plan.bound_.assign(g.inputs().size(), nullptr);
+        plan.stats_.captured_nodes = n;
+
+        // 1. Dead-code elimination.
+        std::vector<char> live(n, 0), is_output(n, 0);
+        for (std::size_t o : g.outputs()) live[o] = is_output[o] = 1;
+        for (std::size_t i = n; i-- > 0;)
+            if (live[i]) for (std::size_t a : nodes[i].args) live[a] = 1;
+        std::vector<std::vector<std::size_t>> consumers(n);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!live[i]) continue;
+            ++plan.stats_.live_nodes;
+            if (nodes[i].op == Op::Param) plan.param_ids_.push_back(i);
+            for (std::size_t a : nodes[i].args) consumers[a].push_back(i);
+        }
+
+        // The only node reading v, if v is not itself an output.
+        auto sole_consumer = [&](std::size_t v) {
+            if (is_output[v] || consumers[v].empty()) return npos;
+            for (std::size_t c : consumers[v]) if (c != consumers[v][0]) return npos;
+            return consumers[v][0];
+        };
+
+        // 2. Linear fusion: matmul (+ bias row) (+ activation).
+        std::vector<char> absorbed(n, 0);
+        std::vector<detail::Step<T>> linear(n, detail::Step<T>{detail::StepKind::Linear, npos});
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!live[i] || nodes[i].op != Op::Matmul) continue;
+            auto& st = linear[i];
+            st.a = nodes[i].args[0];
+            st.b = nodes[i].args[1];
+            st.M = nodes[i].shape[0];
+            st.K = nodes[st.a].shape[1];
+            st.N = nodes[i].shape[1];
+            std::size_t root = i;
+            const std::size_t c = sole_consumer(root);
+            if (c != npos && nodes[c].op == Op::Add && nodes[c].shape == nodes[i].shape) {
+                const std::size_t other = nodes[c].args[0] == root ? nodes[c].args[1] : nodes[c].args[0];
+                const auto& bs = nodes[other].shape;
+                const bool row = (bs.size() == 1 && bs[0] == st.N) || (bs.size() == 2 && bs[0] == 1 && bs[1] == st.N);
+                if (other != root && row) {
+                    st.bias = other;
+                    absorbed[c] = 1;
+                    root = c;
+                }
+            }
+            const std::size_t r = sole_consumer(root);
+            if (r != npos && detail::is_activation(nodes[r].op)) {
+                st.act = nodes[r].op;
+                st.alpha = nodes[r].scalar;
+                absorbed[r] = 1;
+                root = r;
+            }
+            st.out = root;
+            if (root != i) ++plan.stats_.fused_linear;
+        }
+
+        // 3. Element-wise fusion, growing each group backwards from its last node.
+        std::vector<std::size_t> group_of(n, npos);
+        std::vector<std::vector<std::size_t>> groups;
+        auto external_operands = [&](const std::vector<std::size_t>& members, std::size_t gid, const std::vector<std::size_t>& shape,
+                                     std::size_t& staged) {
+            std::vector<std::size_t> ext;
+            staged = 0;
+            for (std::size_t m : members)
+                for (std::size_t a : nodes[m].args)
+                    if (group_of[a] != gid && std::find(ext.begin(), ext.end(), a) == ext.end()) {
+                        ext.push_back(a);
+                        if (nodes[a].shape != shape) ++staged;
+                    }
+            return ext;
+        };
+        for (std::size_t i = n; i-- > 0;) {
+            if (!live[i] || !is_elementwise(nodes[i].op) || absorbed[i] || group_of[i] != npos) continue;
+            const std::size_t gid = groups.size();
+            const auto& shape = nodes[i].shape;
+            std::vector<std::size_t> members{i}, work{i};
+            group_of[i] = gid;
+            while (!work.empty()) {
+                const std::size_t m = work.back();
+                work.pop_back();
+                for (std::size_t p : nodes[m].args) {
+                    if (group_of[p] != npos || !live[p] || absorbed[p] || is_output[p] || !is_elementwise(nodes[p].op)) continue;
+                    if (nodes[p].shape != shape) continue;
+                    bool all_inside = true;
+                    for (std::size_t c : consumers[p]) all_inside = all_inside && group_of[c] == gid;
+                    if (!all_inside) continue;
+                    group_of[p] = gid;
+                    members.push_back(p);
+                    std::size_t staged = 0;
+                    const auto ext = external_operands(members, gid, shape, staged);
+                    if (staged + members.size() - 1 > detail::fused_max_registers ||
+                        ext.size() + members.size() > detail::fused_max_sources) {
+                        group_of[p] = npos;
+                        members.pop_back();
+                        continue;
+                    }
+                    work.push_back(p);
+                }
+            }
+            std::sort(members.begin(), members.end());
+            if (members.size() > 1) plan.stats_.fused_elementwise += members.size();
+            groups.push_back(std::move(members));
+        }
+
+        // Steps in node order (each step sits at its last node, after all of its operands;
+        // a linear step at its last absorbed node, since the bias may be recorded after the matmul).
+        std::vector<std::size_t> linear_at(n, npos);
+        for (std::size_t i = 0; i < n; ++i)
+            if (live[i] && nodes[i].op == Op::Matmul) linear_at[linear[i].out] = i;
+        std::vector<std::size_t> step_of(n, npos);
+        for (std::size_t i = 0; i < n; ++i) {
+            if (!live[i]) continue;
+            const Op op = nodes[i].op;
+            if (linear_at[i] != npos) {
+                const auto& st = linear[linear_at[i]];
+                step_of[i] = plan.steps_.size();
+                plan.steps_.push_back(st);
+                plan.flops_ += 2.0 * st.M * st.N * st.K;
+            } else if (op == Op::Softmax) {
+                detail::Step<T> st{detail::StepKind::Softmax, i};
+                st.a = nodes[i].args[0];
+                st.N = nodes[i].shape.back();
+                st.M = st.N ? nodes[i].numel() / st.N : 0;
+                step_of[i] = plan.steps_.size();
+                plan.steps_.push_back(st);
+            } else if (is_elementwise(op) && !absorbed[i] && groups[group_of[i]].back() == i) {
+                const auto& members = groups[group_of[i]];
+                detail::FusedKernel<T> k;
+                k.shape = nodes[i].shape;
+                k.numel = nodes[i].numel();
+                const auto ext = external_operands(members, group_of[i], k.shape, k.staged);
+                for (std::size_t v : ext) {
+                    const bool bc = nodes[v].shape != k.shape;
+                    k.operands.push_back({v, bc, bc ? get_broadcast_strides(nodes[v].shape, detail::contiguous_strides(nodes[v].shape), k.shape)
+                                                    : std::vector<std::size_t>{}});
+                }
+                auto source = [&](std::size_t v) {
+                    const auto it = std::find(ext.begin(), ext.end(), v);
+                    if (it != ext.end()) return static_cast<std::size_t>(it - ext.begin());
+                    return ext.size() + static_cast<std::size_t>(std::find(members.begin(), members.end(), v) - members.begin());
+                };
+                for (std::size_t m : members) {
+                    const auto& nd = nodes[m];
+                    const std::size_t a = source(nd.args[0]);
+                    k.program.push_back({nd.op, a, nd.args.size() > 1 ? source(nd.args[1]) : a, nd.scalar});
+                }
+                plan.flops_ += static_cast<double>(k.numel * k.program.size());
+                detail::Step<T> st{detail::StepKind::Fused, i};
+                st.kernel = plan.kernels_.size();
+                plan.kernels_.push_back(std::move(k));
+                step_of[i] = plan.steps_.size();
+                plan.steps_.push_back(st);
+            }
+        }
+        plan.stats_.steps = plan.steps_.size();
+
+        // 4. Storage: inputs and parameters in place, outputs in their own tensors,
+        //    everything else in the arena.
+        plan.loc_.assign(n, detail::Location{});
+        for (std::size_t k = 0; k < plan.input_ids_.size(); ++k) plan.loc_[plan.input_ids_[k]] = {detail::Storage::Input, k};
+        for (std::size_t id : plan.param_ids_) plan.loc_[id] = {detail::Storage::Param, id};
+        std::vector<char> has_slot(n, 0);
+        for (std::size_t k = 0; k < g.outputs().size(); ++k) {
+            const std::size_t v = g.outputs()[k];
+            plan.outputs_.emplace_back(nodes[v].shape);
+            if (step_of[v] != npos && !has_slot[v]) {
+                plan.loc_[v] = {detail::Storage::Output, k};
+                has_slot[v] = 1;
+            } else {
+                plan.copies_.push_back({v, k});
+            }
+        }
+
+        // Live ranges of arena values, in step indices.
+        const std::size_t end = plan.steps_.size();
+        std::vector<std::size_t> first(n, npos), last(n, 0);
+        auto use = [&](std::size_t v, std::size_t s) { last[v] = std::max(last[v], s); };
+        for (std::size_t s = 0; s < plan.steps_.size(); ++s) {
+            const auto& st = plan.steps_[s];
+            first[st.out] = s;
+            last[st.out] = std::max(last[st.out], s);
+            if (st.kind == detail::StepKind::Fused) {
+                for (const auto& op : plan.kernels_[st.kernel].operands) use(op.value, s);
+            } else {
+                use(st.a, s);
+                if (st.kind == detail::StepKind::Linear) {
+                    use(st.b, s);
+                    if (st.bias != npos) use(st.bias, s);
+                }
+            }
+        }
+        for (const auto& c : plan.copies_) use(c.first, end);
+
+        // Greedy by size: place the largest buffers first at the lowest offset that does
+        // not overlap any placed buffer with an intersecting live range.
+        std::vector<std::size_t> values;
+        for (const auto& st : plan.steps_)
+            if (plan.loc_[st.out].kind == detail::Storage::Arena) values.push_back(st.out);
+        auto padded = [&](std::size_t v) {
+            return (nodes[v].numel() + detail::arena_alignment - 1) / detail::arena_alignment * detail::arena_alignment;
+        };
+        std::stable_sort(values.begin(), values.end(), [&](std::size_t x, std::size_t y) { return padded(x) > padded(y); });
+        std::vector<std::size_t> placed;
+        std::size_t arena_size = 0;
+        for (std::size_t v : values) {
+            const std::size_t size = padded(v);
+            plan.stats_.unplanned_bytes += size * sizeof(T);
+            std::vector<std::pair<std::size_t, std::size_t>> busy;
+            for (std::size_t p : placed)
+                if (first[p] <= last[v] && first[v] <= last[p]) busy.push_back({plan.loc_[p].index, plan.loc_[p].index + padded(p)});
+            std::sort(busy.begin(), busy.end());
+            std::size_t offset = 0;
+            for (const auto& b : busy) {
+                if (b.first >= offset + size) break;
+                offset = std::max(offset, b.second);
+            }
+            plan.loc_[v] = {detail::Storage::Arena, offset};
+            placed.push_back(v);
+            arena_size = std::max(arena_size, offset + size);
+        }
+        plan.arena_.assign(arena_size, static_cast<T>(0));
+        plan.stats_.arena_bytes = arena_size * sizeof(T);
+        return plan;
+    }
+
+} // namespace graph
+} // namespace tl
@@ -0,0 +1,404 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+// Einstein summation over any number of operands.
+//
+//   tl::einsum("bij,bjk->bik", A, B)       batched matmul
+//   tl::einsum("i,ij,j->", x, M, y)        bilinear form
+//   tl::einsum("ii->i", A) / ("ij->ji")    diagonal / transpose
+//   tl::einsum("ij,jk", A, B)              implicit output: labels used once, sorted
+//
+// Evaluation:
+//   1. labels that appear in a single operand and not in the output are summed out
+//      (and repeated labels within an operand take the diagonal) before anything else
+//   2. operands are contracted pairwise in a greedy order: at each step the pair whose
+//      result is smallest relative to its inputs, ties broken by FLOPs (einsum_path)
+//   3. each pair becomes one batched GEMM  C[b, m, n] = sum_k A[b, m, k] B[b, k, n]:
+//      the batch / free / contracted labels of each operand are grouped by strides
+//      alone, so an operand whose groups are already contiguous (any transpose of a
+//      dense tensor, for example) is read in place; only operands whose groups cannot
+//      be collapsed into a single stride are packed first
+//
+// 16-bit inputs are widened to float for the whole expression and the result
+// narrowed once, matching matmul's float accumulation.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+
+    struct EinsumPath {
+        std::vector<std::pair<std::size_t, std::size_t>> pairs;   // positions in the working list;
+                                                                  // each result is appended to its end
+        double flops = 0.0;                                        // of the chosen order
+        double naive_flops = 0.0;                                  // of a single nested loop over every label
+    };
+
+    namespace detail {
+
+        constexpr std::size_t einsum_parallel_threshold = 1 << 15;
+
+        struct EinsumSpec {
+            std::vector<std::string> inputs;
+            std::string output;
+        };
+
+        inline bool is_einsum_label(char c) { return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z'); }
+
+        inline EinsumSpec parse_einsum(const std::string& subscripts, std::size_t n_operands) {
+            std::string s;
+            for (char c : subscripts) if (c != ' ') s += c;
+            EinsumSpec spec;
+            const std::size_t arrow = s.find("->");
+            const std::string lhs = s.substr(0, arrow);
+            std::size_t start = 0;
+            while (true) {
+                const std::size_t comma = lhs.find(',', start);
+                spec.inputs.push_back(lhs.substr(start, comma == std::string::npos ? std::string::npos : comma - start));
+                if (comma == std::string::npos) break;
+                start = comma + 1;
+            }
+            for (const auto& term : spec.inputs)
+                for (char c : term)
+                    if (!is_einsum_label(c)) throw std::runtime_error("einsum: invalid character '" + std::string(1, c) + "' in \"" + subscripts + "\".");
+            if (spec.inputs.size() != n_operands) {
+                throw std::runtime_error("einsum: \"" + subscripts + "\" names " + std::to_string(spec.inputs.size()) +
+                                         " operands, got " + std::to_string(n_operands) + ".");
+            }
+
+            if (arrow != std::string::npos) {
+                spec.output = s.substr(arrow + 2);
+                for (std::size_t i = 0; i < spec.output.size(); ++i) {
+                    const char c = spec.output[i];
+                    if (!is_einsum_label(c)) throw std::runtime_error("einsum: invalid character '" + std::string(1, c) + "' in output.");
+                    if (spec.output.find(c, i + 1) != std::string::npos) throw std::runtime_error("einsum: output label '" + std::string(1, c) + "' repeated.");
+                    if (lhs.find(c) == std::string::npos) throw std::runtime_error("einsum: output label '" + std::string(1, c) + "' does not appear in any input.");
+                }
+            } else {
+                // Implicit mode: every label used exactly once, in alphabetical order.
+                for (char c : lhs)
+                    if (is_einsum_label(c) && std::count(lhs.begin(), lhs.end(), c) == 1) spec.output += c;
+                std::sort(spec.output.begin(), spec.output.end());
+            }
+            return spec;
+        }
+
+        // Extent of each label (indexed by the char), checked for consistency.
+        inline std::vector<std::size_t> einsum_extents(const EinsumSpec& spec, const std::vector<std::vector<std::size_t>>& shapes) {
+            std::vector<std::size_t> dim(128, 0);
+            std::vector<char> seen(128, 0);
+            for (std::size_t t = 0; t < spec.inputs.size(); ++t) {
+                const auto& labels = spec.inputs[t];
+                if (labels.size() != shapes[t].size()) {
+                    throw std::runtime_error("einsum: operand " + std::to_string(t) + " has rank " + std::to_string(shapes[t].size()) +
+                                             " but subscripts \"" + labels + "\".");
+                }
+                for (std::size_t d = 0; d < labels.size(); ++d) {
+                    const auto c = static_cast<unsigned char>(labels[d]);
+                    if (seen[c] && dim[c] != shapes[t][d]) {
+                        throw std::runtime_error("einsum: label '" + std::string(1, labels[d]) + "' has extents " +
+                                                 std::to_string(dim[c]) + " and " + std::to_string(shapes[t][d]) + ".");
+                    }
+                    seen[c] = 1;
+                    dim[c] = shapes[t][d];
+                }
+            }
+            return dim;
+        }
+
+        inline std::string unique_labels(const std::string& labels) {
+            std::string u;
+            for (char c : labels) if (u.find(c) == std::string::npos) u += c;
+            return u;
+        }
+
+        inline bool has_label(const std::string& s, char c) { return s.find(c) != std::string::npos; }
+
+        // Labels of `labels` still needed by `keep`, in first-appearance order.
+        inline std::string kept_labels(const std::string& labels, const std::string& keep) {
+            std::string out;
+            for (char c : unique_labels(labels)) if (has_label(keep, c)) out += c;
+            return out;
+        }
+
+        inline double label_volume(const std::string& labels, const std::vector<std::size_t>& dim) {
+            double v = 1.0;
+            for (char c : labels) v *= static_cast<double>(dim[static_cast<unsigned char>(c)]);
+            return v;
+        }
+
+        // Greedy pairwise order over operands with (already reduced) label sets.
+        inline EinsumPath plan_einsum(std::vector<std::string> terms, const std::string& output, const std::vector<std::size_t>& dim) {
+            EinsumPath path;
+            while (terms.size() > 1) {
+                std::size_t best_i = 0, best_j = 1;
+                bool best_shared = false;
+                double best_size = std::numeric_limits<double>::infinity(), best_flops = best_size;
+                std::string best_result;
+                for (std::size_t i = 0; i < terms.size(); ++i) {
+                    for (std::size_t j = i + 1; j < terms.size(); ++j) {
+                        std::string keep = output;
+                        for (std::size_t k = 0; k < terms.size(); ++k) if (k != i && k != j) keep += terms[k];
+                        const std::string joint = unique_labels(terms[i] + terms[j]);
+                        const std::string result = kept_labels(joint, keep);
+                        bool shared = false;
+                        for (char c : terms[i]) shared = shared || has_label(terms[j], c);
+                        const double size = label_volume(result, dim) - label_volume(terms[i], dim) - label_volume(terms[j], dim);
+                        const double flops = 2.0 * label_volume(joint, dim);
+                        // Prefer pairs that share a label (no outer products), then the
+                        // smallest growth in memory, then the cheapest contraction.
+                        const bool better = shared != best_shared ? shared
+                                          : size != best_size ? size < best_size
+                                          : flops < best_flops;
+                        if (better) {
+                            best_i = i; best_j = j;
+                            best_shared = shared; best_size = size; best_flops = flops;
+                            best_result = result;
+                        }
+                    }
+                }
+                path.pairs.push_back({best_i, best_j});
+                path.flops += best_flops;
+                terms.erase(terms.begin() + static_cast<std::ptrdiff_t>(best_j));
+                terms.erase(terms.begin() + static_cast<std::ptrdiff_t>(best_i));
+                terms.push_back(best_result);
+            }
+            return path;
+        }
+
+        // An operand as a strided view, optionally owning its buffer.
+        template <typename T>
+        struct EinsumTerm {
+            std::string labels;                     // one per dimension, may repeat
+            std::vector<std::size_t> shape, strides;
+            const T* ptr = nullptr;
+            std::shared_ptr<Tensor<T>> owned;
+
+            static EinsumTerm view_of(const Tensor<T>& t, std::string labels) {
+                return EinsumTerm{std::move(labels), t.shape, t.strides, t.data.data(), nullptr};
+            }
+            static EinsumTerm own(Tensor<T>&& t, std::string labels) {
+                auto p = std::make_shared<Tensor<T>>(std::move(t));
+                return EinsumTerm{std::move(labels), p->shape, p->strides, p->data.data(), p};
+            }
+        };
+
+        // Extent and (summed, for repeated labels) stride of each label in `order`.
+        template <typename T>
+        void label_geometry(const EinsumTerm<T>& t, const std::string& order,
+                            std::vector<std::size_t>& extent, std::vector<std::size_t>& stride) {
+            extent.assign(order.size(), 1);
+            stride.assign(order.size(), 0);
+            for (std::size_t i = 0; i < order.size(); ++i)
+                for (std::size_t d = 0; d < t.labels.size(); ++d)
+                    if (t.labels[d] == order[i]) { extent[i] = t.shape[d]; stride[i] += t.strides[d]; }
+        }
+
+        // out[coords over `out_order`] = sum over `sum_order` of t, written contiguously.
+        template <typename T>
+        Tensor<T> einsum_gather(const EinsumTerm<T>& t, const std::string& out_order, const std::string& sum_order) {
+            std::vector<std::size_t> oe, os, se, ss;
+            label_geometry(t, out_order, oe, os);
+            label_geometry(t, sum_order, se, ss);
+            Tensor<T> out(oe);
+            std::size_t n_sum = 1;
+            for (auto e : se) n_sum *= e;
+            const std::size_t n = out.data.size();
+            const std::ptrdiff_t total = static_cast<std::ptrdiff_t>(n);
+            const T* src = t.ptr;
+            T* dst = out.data.data();
+            #pragma omp parallel for schedule(static) if(n * n_sum > einsum_parallel_threshold)
+            for (std::ptrdiff_t f = 0; f < total; ++f) {
+                std::size_t rem = static_cast<std::size_t>(f), base = 0;
+                for (std::size_t d = oe.size(); d-- > 0;) { base += (rem % oe[d]) * os[d]; rem /= oe[d]; }
+                if (se.empty()) { dst[f] = src[base]; continue; }
+                T acc = static_cast<T>(0);
+                for (std::size_t g = 0; g < n_sum; ++g) {
+                    std::size_t r = g, off = base;
+                    for (std::size_t d = se.size(); d-- > 0;) { off += (r % se[d]) * ss[d]; r /= se[d]; }
+                    acc += src[off];
+                }
+                dst[f] = acc;
+            }
+            return out;
+        }
+
+        // Sums out labels not in `keep` and takes diagonals of repeated labels;
+        // returns the term untouched when there is nothing to do.
+        template <typename T>
+        EinsumTerm<T> einsum_reduce(EinsumTerm<T> t, const std::string& keep) {
+            const std::string u = unique_labels(t.labels);
+            const std::string kept = kept_labels(t.labels, keep);
+            if (u.size() == t.labels.size() && kept.size() == u.size()) return t;
+            std::string summed;
+            for (char c : u) if (!has_label(kept, c)) summed += c;
+            return EinsumTerm<T>::own(einsum_gather(t, kept, summed), kept);
+        }
+
+        // Collapses the labels of `group` (in order) to one (extent, stride), or
+        // returns false when their strides do not form a single arithmetic run.
+        template <typename T>
+        bool collapse_group(const EinsumTerm<T>& t, const std::string& group, std::size_t& extent, std::size_t& stride) {
+            std::vector<std::size_t> e, s;
+            label_geometry(t, group, e, s);
+            extent = 1;
+            stride = 0;
+            bool first = true;
+            for (std::size_t i = group.size(); i-- > 0;) {
+                if (e[i] == 1) continue;
+                if (first) { stride = s[i]; first = false; }
+                else if (s[i] != stride * extent) return false;
+                extent *= e[i];
+            }
+            return true;
+        }
+
+        // C[b, m, n] = sum_k A[b*ab + m*am + k*ak] * B[b*bb + k*bk + n*bn], C contiguous.
+        template <typename T>
+        void batched_gemm(const T* A, std::size_t ab, std::size_t am, std::size_t ak,
+                          const T* B, std::size_t bb, std::size_t bk, std::size_t bn,
+                          T* C, std::size_t batch, std::size_t M, std::size_t K, std::size_t N) {
+            const std::ptrdiff_t rows = static_cast<std::ptrdiff_t>(batch * M);
+            #pragma omp parallel for schedule(static) if(batch * M * N * K > einsum_parallel_threshold)
+            for (std::ptrdiff_t r = 0; r < rows; ++r) {
+                const std::size_t b = static_cast<std::size_t>(r) / M, i = static_cast<std::size_t>(r) % M;
+                T* c = C + static_cast<std::size_t>(r) * N;
+                std::fill(c, c + N, static_cast<T>(0));
+                const T* a = A + b * ab + i * am;
+                const T* bp = B + b * bb;
+                for (std::size_t k = 0; k < K; ++k) {
+                    const T a_ik = a[k * ak];
+                    const T* b_row = bp + k * bk;
+                    if (bn == 1) {
+                        #pragma omp simd
+                        for (std::size_t j = 0; j < N; ++j) c[j] += a_ik * b_row[j];
+                    } else {
+                        for (std::size_t j = 0; j < N; ++j) c[j] += a_ik * b_row[j * bn];
+                    }
+                }
+            }
+        }
+
+        // Contracts two terms; the result carries the labels of either that `keep` still needs.
+        template <typename T>
+        EinsumTerm<T> einsum_pair(EinsumTerm<T> a, EinsumTerm<T> b, const std::string& keep) {
+            a = einsum_reduce(std::move(a), b.labels + keep);
+            b = einsum_reduce(std::move(b), a.labels + keep);
+            std::string batch, left, contracted, right;
+            for (char c : a.labels) {
+                if (has_label(b.labels, c)) (has_label(keep, c) ? batch : contracted) += c;
+                else left += c;
+            }
+            for (char c : b.labels) if (!has_label(a.labels, c)) right += c;
+
+            std::size_t nb = 1, M = 1, K = 1, N = 1, ab = 0, am = 0, ak = 0, bb = 0, bk = 0, bn = 0, e = 0;
+            if (!(collapse_group(a, batch, nb, ab) && collapse_group(a, left, M, am) && collapse_group(a, contracted, K, ak))) {
+                a = EinsumTerm<T>::own(einsum_gather(a, batch + left + contracted, ""), batch + left + contracted);
+                collapse_group(a, batch, nb, ab); collapse_group(a, left, M, am); collapse_group(a, contracted, K, ak);
+            }
+            bool direct = collapse_group(b, batch, e, bb) && collapse_group(b, contracted, e, bk) && collapse_group(b, right, N, bn);
+            if (!direct || (bn != 1 && N > 1)) {
+                b = EinsumTerm<T>::own(einsum_gather(b, batch + contracted + right, ""), batch + contracted + right);
+                collapse_group(b, batch, e, bb); collapse_group(b, contracted, e, bk); collapse_group(b, right, N, bn);
+            }
+
+            const std::string labels = batch + left + right;
+            std::vector<std::size_t> shape;
+            for (char c : labels) {
+                const auto& src = has_label(a.labels, c) ? a : b;
+                shape.push_back(src.shape[src.labels.find(c)]);
+            }
+            Tensor<T> out(shape);
+            batched_gemm(a.ptr, ab, am, ak, b.ptr, bb, bk, bn, out.data.data(), nb, M, K, N);
+            return EinsumTerm<T>::own(std::move(out), labels);
+        }
+
+        template <typename T>
+        Tensor<T> einsum_impl(const std::string& subscripts, const std::vector<const Tensor<T>*>& operands) {
+            const EinsumSpec spec = parse_einsum(subscripts, operands.size());
+            std::vector<std::vector<std::size_t>> shapes;
+            for (const auto* t : operands) shapes.push_back(t->shape);
+            const auto dim = einsum_extents(spec, shapes);
+
+            // 1. Per-operand reductions.
+            std::vector<EinsumTerm<T>> terms;
+            for (std::size_t i = 0; i < operands.size(); ++i) {
+                std::string keep = spec.output;
+                for (std::size_t j = 0; j < operands.size(); ++j) if (j != i) keep += spec.inputs[j];
+                terms.push_back(einsum_reduce(EinsumTerm<T>::view_of(*operands[i], spec.inputs[i]), keep));
+            }
+
+            // 2-3. Pairwise contractions in greedy order.
+            std::vector<std::string> labels;
+            for (const auto& t : terms) labels.push_back(t.labels);
+            const EinsumPath path = plan_einsum(labels, spec.output, dim);
+            TL_PROFILE_OP("einsum", path.flops, shapes.front());
+            for (const auto& p : path.pairs) {
+                std::string keep = spec.output;
+                for (std::size_t k = 0; k < terms.size(); ++k) if (k != p.first && k != p.second) keep += terms[k].labels;
+                EinsumTerm<T> r = einsum_pair(std::move(terms[p.first]), std::move(terms[p.second]), keep);
+                terms.erase(terms.begin() + static_cast<std::ptrdiff_t>(p.second));
+                terms.erase(terms.begin() + static_cast<std::ptrdiff_t>(p.first));
+                terms.push_back(std::move(r));
+            }
+
+            // Final layout: reuse the buffer when it is already in output order.
+            EinsumTerm<T> t = einsum_reduce(std::move(terms[0]), spec.output);
+            if (t.owned && t.labels == spec.output) return std::move(*t.owned);
+            return einsum_gather(t, spec.output, "");
+        }
+
+    } // namespace detail
+
+    // Order in which einsum contracts operands of the given shapes, with its FLOP count.
+    inline EinsumPath einsum_path(const std::string& subscripts, const std::vector<std::vector<std::size_t>>& shapes) {
+        const auto spec = detail::parse_einsum(subscripts, shapes.size());
+        const auto dim = detail::einsum_extents(spec, shapes);
+        std::vector<std::string> terms;
+        for (std::size_t i = 0; i < spec.inputs.size(); ++i) {
+            std::string keep = spec.output;
+            for (std::size_t j = 0; j < spec.inputs.size(); ++j) if (j != i) keep += spec.inputs[j];
+            terms.push_back(detail::kept_labels(spec.inputs[i], keep));
+        }
+        EinsumPath path = detail::plan_einsum(terms, spec.output, dim);
+        std::string all;
+        for (const auto& t : spec.inputs) all += t;
+        path.naive_flops = detail::label_volume(detail::unique_labels(all), dim) * static_cast<double>(spec.inputs.size());
+        return path;
+    }
+
+    template <typename T, typename... Rest>
+    Tensor<T> einsum(const std::string& subscripts, const Tensor<T>& first, const Rest&... rest) {
+        static_assert((std::is_same_v<Rest, Tensor<T>> && ...), "einsum: all operands must share one element type.");
+        const std::vector<const Tensor<T>*> operands{&first, &rest...};
+        if constexpr (!std::is_same_v<accum_t<T>, T>) {
+            using F = accum_t<T>;
+            std::vector<Tensor<F>> wide;
+            wide.reserve(operands.size());
+            std::vector<const Tensor<F>*> ptrs;
+            for (const auto* t : operands) {
+                wide.emplace_back(t->shape);
+                convert_to_float(t->data.data(), wide.back().data.data(), t->data.size());
+                ptrs.push_back(&wide.back());
+            }
+            const Tensor<F> r = detail::einsum_impl(subscripts, ptrs);
+            Tensor<T> out(r.shape);
+            convert_from_float(r.data.data(), out.data.data(), r.data.size());
+            return out;
+        } else {
+            return detail::einsum_impl(subscripts, operands);
+        }
+    }
+
+} // namespace tl
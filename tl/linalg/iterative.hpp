@@ -0,0 +1,616 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include "sparse.hpp"
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+// Iterative Krylov solvers for A x = b: Conjugate Gradient (SPD), BiCGSTAB and
+// restarted GMRES (general).
+//
+// The operator A may be a CSRMatrix<T>, a dense 2D Tensor<T>, or any callable
+// with the signature  void(const Tensor<T>& x, Tensor<T>& y)  computing y = A x
+// into a preallocated y.  Preconditioners expose
+//     void apply(const Tensor<T>& r, Tensor<T>& z) const;   // z = M^{-1} r
+// and are applied on the left for CG and on the right for BiCGSTAB and GMRES.
+//
+// All work vectors are allocated once per solve; the inner loops use fused
+// kernels (e.g. "x += a p; r -= a Ap; return r.r" in a single sweep).
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace linalg {
+
+    // --- Options and telemetry ---
+
+    template <typename T>
+    struct SolverOptions {
+        T rtol = static_cast<T>(1e-8);   // stop when ||r|| <= max(rtol * ||b||, atol)
+        T atol = static_cast<T>(0);
+        std::size_t max_iter = 1000;
+        std::size_t restart = 30;        // GMRES Krylov subspace size
+        bool record_history = true;      // keep ||r|| for every iteration
+        // Optional per-iteration hook: (iteration, residual norm).
+        std::function<void(std::size_t, T)> callback;
+    };
+
+    template <typename T>
+    struct SolverResult {
+        bool converged = false;
+        std::size_t iterations = 0;
+        std::size_t matvecs = 0;
+        T initial_residual = static_cast<T>(0);
+        T residual_norm = static_cast<T>(0);
+        std::vector<T> residual_history;
+        std::string message;
+    };
+
+
+    // --- Preconditioners ---
+
+    template <typename T>
+    struct IdentityPreconditioner {
+        void apply(const Tensor<T>& r, Tensor<T>& z) const {
+            std::copy(r.data.begin(), r.data.end(), z.data.begin());
+        }
+    };
+
+    // Diagonal scaling: z = D^{-1} r.
+    template <typename T>
+    class JacobiPreconditioner {
+    public:
+        explicit JacobiPreconditioner(const CSRMatrix<T>& A) : inv_diag_(A.diagonal()) { invert(); }
+        explicit JacobiPreconditioner(const Tensor<T>& diag) : inv_diag_(diag) { invert(); }
+
+        void apply(const Tensor<T>& r, Tensor<T>& z) const {
+            if (r.data.size() != inv_diag_.data.size() || z.data.size() != inv_diag_.data.size()) {
+                throw std::runtime_error("JacobiPreconditioner: diagonal size does not match the system.");
+            }
+            const T* d = inv_diag_.data.data();
+            const T* rp = r.data.data();
+            T* zp = z.data.data();
+            const std::size_t n = r.data.size();
+            #pragma omp simd
+            for (std::size_t i = 0; i < n; ++i) zp[i] = d[i] * rp[i];
+        }
+
+    private:
+        Tensor<T> inv_diag_;
+
+        void invert() {
+            for (auto& v : inv_diag_.data) {
+                if (v == static_cast<T>(0)) {
+                    throw std::runtime_error("JacobiPreconditioner: zero on the diagonal.");
+                }
+                v = static_cast<T>(1) / v;
+            }
+        }
+    };
+
+    // Incomplete LU with zero fill-in. The factors share A's sparsity pattern:
+    // strictly-lower entries hold L (unit diagonal implied), the rest hold U.
+    template <typename T>
+    class ILU0Preconditioner {
+    public:
+        explicit ILU0Preconditioner(const CSRMatrix<T>& A) : LU_(A) {
+            if (A.rows != A.cols) throw std::runtime_error("ILU0Preconditioner requires a square matrix.");
+            const std::size_t n = A.rows;
+            const std::size_t none = static_cast<std::size_t>(-1);
+            diag_.assign(n, none);
+            std::vector<std::size_t> pos(n, none);
+
+            for (std::size_t i = 0; i < n; ++i) {
+                const std::size_t begin = LU_.row_ptr[i], end = LU_.row_ptr[i + 1];
+                for (std::size_t p = begin; p < end; ++p) pos[LU_.col_idx[p]] = p;
+
+                for (std::size_t p = begin; p < end && LU_.col_idx[p] < i; ++p) {
+                    const std::size_t k = LU_.col_idx[p];
+                    LU_.values[p] /= LU_.values[diag_[k]];
+                    const T l_ik = LU_.values[p];
+                    for (std::size_t q = diag_[k] + 1; q < LU_.row_ptr[k + 1]; ++q) {
+                        const std::size_t slot = pos[LU_.col_idx[q]];
+                        if (slot != none) LU_.values[slot] -= l_ik * LU_.values[q];
+                    }
+                }
+
+                for (std::size_t p = begin; p < end; ++p) {
+                    if (LU_.col_idx[p] == i) diag_[i] = p;
+                    pos[LU_.col_idx[p]] = none;
+                }
+                if (diag_[i] == none || LU_.values[diag_[i]] == static_cast<T>(0)) {
+                    throw std::runtime_error("ILU0Preconditioner: zero pivot in row " + std::to_string(i));
+                }
+            }
+        }
+
+        void apply(const Tensor<T>& r, Tensor<T>& z) const {
+            const std::size_t n = LU_.rows;
+            T* zp = z.data.data();
+            // Forward solve L y = r (unit diagonal), y stored in z.
+            for (std::size_t i = 0; i < n; ++i) {
+                T acc = r.data[i];
+                for (std::size_t p = LU_.row_ptr[i]; p < diag_[i]; ++p)
+                    acc -= LU_.values[p] * zp[LU_.col_idx[p]];
+                zp[i] = acc;
+            }
+            // Backward solve U z = y.
+            for (std::size_t i = n; i-- > 0; ) {
+                T acc = zp[i];
+                for (std::size_t p = diag_[i] + 1; p < LU_.row_ptr[i + 1]; ++p)
+                    acc -= LU_.values[p] * zp[LU_.col_idx[p]];
+                zp[i] = acc / LU_.values[diag_[i]];
+            }
+        }
+
+    private:
+        CSRMatrix<T> LU_;
+        std::vector<std::size_t> diag_;
+    };
+
+    // Incomplete Cholesky with zero fill-in, for symmetric positive definite A.
+    // Only the lower triangle of A is read; M = L L^T.
+    template <typename T>
+    class IncompleteCholeskyPreconditioner {
+    public:
+        explicit IncompleteCholeskyPreconditioner(const CSRMatrix<T>& A) {
+            if (A.rows != A.cols) throw std::runtime_error("IncompleteCholeskyPreconditioner requires a square matrix.");
+            const std::size_t n = A.rows;
+            L_.rows = L_.cols = n;
+            L_.row_ptr.assign(n + 1, 0);
+            for (std::size_t i = 0; i < n; ++i) {
+                for (std::size_t p = A.row_ptr[i]; p < A.row_ptr[i + 1]; ++p) {
+                    if (A.col_idx[p] <= i) {
+                        L_.col_idx.push_back(A.col_idx[p]);
+                        L_.values.push_back(A.values[p]);
+                    }
+                }
+                L_.row_ptr[i + 1] = L_.values.size();
+                if (L_.values.empty() || L_.row_ptr[i + 1] == L_.row_ptr[i] || L_.col_idx.back() != i) {
+                    throw std::runtime_error("IncompleteCholeskyPreconditioner: missing diagonal in row " + std::to_string(i));
+                }
+            }
+
+            for (std::size_t i = 0; i < n; ++i) {
+                for (std::size_t p = L_.row_ptr[i]; p < L_.row_ptr[i + 1]; ++p) {
+                    const std::size_t j = L_.col_idx[p];
+                    // s = a_ij - sum_{k<j} l_ik l_jk over the shared pattern (sorted merge).
+                    T s = L_.values[p];
+                    std::size_t a = L_.row_ptr[i], b = L_.row_ptr[j];
+                    while (a < p && b < L_.row_ptr[j + 1] - 1) {
+                        const std::size_t ca = L_.col_idx[a], cb = L_.col_idx[b];
+                        if (ca == cb) { s -= L_.values[a] * L_.values[b]; ++a; ++b; }
+                        else if (ca < cb) ++a;
+                        else ++b;
+                    }
+                    if (j < i) {
+                        L_.values[p] = s / L_.values[L_.row_ptr[j + 1] - 1];
+                    } else {
+                        if (s <= static_cast<T>(0)) {
+                            throw std::runtime_error("IncompleteCholeskyPreconditioner: breakdown (non-positive pivot) in row " + std::to_string(i));
+                        }
+                        L_.values[p] = std::sqrt(s);
+                    }
+                }
+            }
+        }
+
+        void apply(const Tensor<T>& r, Tensor<T>& z) const {
+            const std::size_t n = L_.rows;
+            T* zp = z.data.data();
+            // Forward solve L y = r.
+            for (std::size_t i = 0; i < n; ++i) {
+                const std::size_t last = L_.row_ptr[i + 1] - 1;
+                T acc = r.data[i];
+                for (std::size_t p = L_.row_ptr[i]; p < last; ++p)
+                    acc -= L_.values[p] * zp[L_.col_idx[p]];
+                zp[i] = acc / L_.values[last];
+            }
+            // Backward solve L^T z = y, column-oriented over the rows of L.
+            for (std::size_t i = n; i-- > 0; ) {
+                const std::size_t last = L_.row_ptr[i + 1] - 1;
+                zp[i] /= L_.values[last];
+                const T zi = zp[i];
+                for (std::size_t p = L_.row_ptr[i]; p < last; ++p)
+                    zp[L_.col_idx[p]] -= L_.values[p] * zi;
+            }
+        }
+
+    private:
+        CSRMatrix<T> L_;   // lower triangle including the diagonal (last entry of each row)
+    };
+
+
+    namespace detail {
+
+        constexpr std::size_t krylov_parallel_threshold = 1 << 15;
+
+        // --- Operator dispatch: y = A x ---
+
+        template <typename T>
+        void apply_operator(const CSRMatrix<T>& A, const Tensor<T>& x, Tensor<T>& y) {
+            A.matvec(x, y);
+        }
+
+        template <typename T>
+        void apply_operator(const Tensor<T>& A, const Tensor<T>& x, Tensor<T>& y) {
+            if (A.shape.size() != 2 || A.shape[1] != x.data.size() || A.shape[0] != y.data.size()) {
+                throw std::runtime_error("Dense operator shape does not match vector size.");
+            }
+            const std::size_t rows = A.shape[0], cols = A.shape[1];
+            const T* a = A.data.data();
+            const T* xp = x.data.data();
+            #pragma omp parallel for schedule(static) if(rows * cols > krylov_parallel_threshold)
+            for (std::ptrdiff_t i = 0; i < static_cast<std::ptrdiff_t>(rows); ++i) {
+                T acc = static_cast<T>(0);
+                const T* row = a + i * cols;
+                #pragma omp simd reduction(+:acc)
+                for (std::size_t j = 0; j < cols; ++j) acc += row[j] * xp[j];
+                y.data[i] = acc;
+            }
+        }
+
+        template <typename Op, typename T>
+        void apply_operator(const Op& A, const Tensor<T>& x, Tensor<T>& y) {
+            A(x, y);
+        }
+
+        // --- Fused vector kernels (one sweep over memory each) ---
+
+        template <typename T>
+        T vdot(const Tensor<T>& a, const Tensor<T>& b) {
+            const T* ap = a.data.data();
+            const T* bp = b.data.data();
+            const std::size_t n = a.data.size();
+            T acc = static_cast<T>(0);
+            #pragma omp parallel for simd reduction(+:acc) if(n > krylov_parallel_threshold)
+            for (std::size_t i = 0; i < n; ++i) acc += ap[i] * bp[i];
+            return acc;
+        }
+
+        template <typename T>
+        T norm2(const Tensor<T>& a) { return std::sqrt(vdot(a, a)); }
+
+        // r = b - r  (r holds A x on entry); returns ||r||^2.
+        template <typename T>
+        T residual_from_product(const Tensor<T>& b, Tensor<T>& r) {
+            const T* bp = b.data.data();
+            T* rp = r.data.data();
+            const std::size_t n = r.data.size();
+            T acc = static_cast<T>(0);
+            #pragma omp parallel for simd reduction(+:acc) if(n > krylov_parallel_threshold)
+            for (std::size_t i = 0; i < n; ++i) {
+                rp[i] = bp[i] - rp[i];
+                acc += rp[i] * rp[i];
+            }
+            return acc;
+        }
+
+        // x += alpha p;  r -= alpha q;  returns ||r||^2.
+        template <typename T>
+        T update_solution_and_residual(T alpha, const Tensor<T>& p, const Tensor<T>& q,
+                                       Tensor<T>& x, Tensor<T>& r) {
+            const T* pp = p.data.data();
+            const T* qp = q.data.data();
+            T* xp = x.data.data();
+            T* rp = r.data.data();
+            const std::size_t n = r.data.size();
+            T acc = static_cast<T>(0);
+            #pragma omp parallel for simd reduction(+:acc) if(n > krylov_parallel_threshold)
+            for (std::size_t i = 0; i < n; ++i) {
+                xp[i] += alpha * pp[i];
+                rp[i] -= alpha * qp[i];
+                acc += rp[i] * rp[i];
+            }
+            return acc;
+        }
+
+        // out = a - alpha b;  returns ||out||^2.
+        template <typename T>
+        T axpy_dot(const Tensor<T>& a, T alpha, const Tensor<T>& b, Tensor<T>& out) {
+            const T* ap = a.data.data();
+            const T* bp = b.data.data();
+            T* op = out.data.data();
+            const std::size_t n = out.data.size();
+            T acc = static_cast<T>(0);
+            #pragma omp parallel for simd reduction(+:acc) if(n > krylov_parallel_threshold)
+            for (std::size_t i = 0; i < n; ++i) {
+                op[i] = ap[i] - alpha * bp[i];
+                acc += op[i] * op[i];
+            }
+            return acc;
+        }
+
+        // Returns {t.s, t.t} in a single pass.
+        template <typename T>
+        std::pair<T, T> dot2(const Tensor<T>& t, const Tensor<T>& s) {
+            const T* tp = t.data.data();
+            const T* sp = s.data.data();
+            const std::size_t n = t.data.size();
+            T ts = static_cast<T>(0), tt = static_cast<T>(0);
+            #pragma omp parallel for simd reduction(+:ts, tt) if(n > krylov_parallel_threshold)
+            for (std::size_t i = 0; i < n; ++i) {
+                ts += tp[i] * sp[i];
+                tt += tp[i] * tp[i];
+            }
+            return {ts, tt};
+        }
+
+        // p = z + beta p
+        template <typename T>
+        void xpby(const Tensor<T>& z, T beta, Tensor<T>& p) {
+            const T* zp = z.data.data();
+            T* pp = p.data.data();
+            const std::size_t n = p.data.size();
+            #pragma omp parallel for simd if(n > krylov_parallel_threshold)
+            for (std::size_t i = 0; i < n; ++i) pp[i] = zp[i] + beta * pp[i];
+        }
+
+        // p = r + beta (p - omega v)
+        template <typename T>
+        void bicgstab_direction(const Tensor<T>& r, T beta, T omega, const Tensor<T>& v, Tensor<T>& p) {
+            const T* rp = r.data.data();
+            const T* vp = v.data.data();
+            T* pp = p.data.data();
+            const std::size_t n = p.data.size();
+            #pragma omp parallel for simd if(n > krylov_parallel_threshold)
+            for (std::size_t i = 0; i < n; ++i) pp[i] = rp[i] + beta * (pp[i] - omega * vp[i]);
+        }
+
+        // x += alpha p + omega s;  r = s - omega t;  returns ||r||^2.
+        template <typename T>
+        T bicgstab_update(T alpha, const Tensor<T>& p, T omega, const Tensor<T>& s,
+                          const Tensor<T>& sv, const Tensor<T>& t, Tensor<T>& x, Tensor<T>& r) {
+            const T* pp = p.data.data();
+            const T* shp = s.data.data();
+            const T* sp = sv.data.data();
+            const T* tp = t.data.data();
+            T* xp = x.data.data();
+            T* rp = r.data.data();
+            const std::size_t n = r.data.size();
+            T acc = static_cast<T>(0);
+            #pragma omp parallel for simd reduction(+:acc) if(n > krylov_parallel_threshold)
+            for (std::size_t i = 0; i < n; ++i) {
+                xp[i] += alpha * pp[i] + omega * shp[i];
+                rp[i] = sp[i] - omega * tp[i];
+                acc += rp[i] * rp[i];
+            }
+            return acc;
+        }
+
+        template <typename T>
+        void check_system(const Tensor<T>& b, const Tensor<T>& x) {
+            if (b.shape.size() != 1 || x.shape.size() != 1) {
+                throw std::runtime_error("Iterative solvers require 1D tensors for b and x.");
+            }
+            if (b.shape[0] != x.shape[0]) {
+                throw std::runtime_error("Right-hand side and solution vector sizes differ.");
+            }
+        }
+
+        // Records ||r|| and reports whether the stopping criterion is met.
+        template <typename T>
+        bool record(SolverResult<T>& res, const SolverOptions<T>& opts, T rnorm, T threshold) {
+            res.residual_norm = rnorm;
+            if (opts.record_history) res.residual_history.push_back(rnorm);
+            if (opts.callback) opts.callback(res.iterations, rnorm);
+            return rnorm <= threshold;
+        }
+
+        template <typename T>
+        T stopping_threshold(const Tensor<T>& b, const SolverOptions<T>& opts) {
+            return std::max(opts.rtol * norm2(b), opts.atol);
+        }
+
+    } // namespace detail
+
+
+    // --- Conjugate Gradient (A symmetric positive definite) ---
+
+    template <typename T, typename Op, typename Precond = IdentityPreconditioner<T>>
+    SolverResult<T> cg(const Op& A, const Tensor<T>& b, Tensor<T>& x,
+                       const Precond& M = Precond{}, const SolverOptions<T>& opts = {}) {
+        detail::check_system(b, x);
+        const std::size_t n = b.shape[0];
+        Tensor<T> r({n}), z({n}), p({n}), q({n});
+        SolverResult<T> res;
+
+        detail::apply_operator(A, x, r);
+        ++res.matvecs;
+        T rnorm = std::sqrt(detail::residual_from_product(b, r));
+        res.initial_residual = rnorm;
+        const T threshold = detail::stopping_threshold(b, opts);
+        if (detail::record(res, opts, rnorm, threshold)) { res.converged = true; return res; }
+
+        M.apply(r, z);
+        std::copy(z.data.begin(), z.data.end(), p.data.begin());
+        T rz = detail::vdot(r, z);
+
+        while (res.iterations < opts.max_iter) {
+            detail::apply_operator(A, p, q);
+            ++res.matvecs;
+            const T pq = detail::vdot(p, q);
+            if (pq == static_cast<T>(0)) { res.message = "breakdown: p.Ap == 0"; break; }
+            const T alpha = rz / pq;
+            rnorm = std::sqrt(detail::update_solution_and_residual(alpha, p, q, x, r));
+            ++res.iterations;
+            if (detail::record(res, opts, rnorm, threshold)) { res.converged = true; break; }
+
+            M.apply(r, z);
+            const T rz_new = detail::vdot(r, z);
+            detail::xpby(z, rz_new / rz, p);
+            rz = rz_new;
+        }
+        return res;
+    }
+
+
+    // --- BiCGSTAB (general non-singular A) ---
+
+    template <typename T, typename Op, typename Precond = IdentityPreconditioner<T>>
+    SolverResult<T> bicgstab(const Op& A, const Tensor<T>& b, Tensor<T>& x,
+                             const Precond& M = Precond{}, const SolverOptions<T>& opts = {}) {
+        detail::check_system(b, x);
+        const std::size_t n = b.shape[0];
+        Tensor<T> r({n}), r_hat({n}), p({n}), v({n}), p_hat({n}), s({n}), s_hat({n}), t({n});
+        SolverResult<T> res;
+
+        detail::apply_operator(A, x, r);
+        ++res.matvecs;
+        T rnorm = std::sqrt(detail::residual_from_product(b, r));
+        res.initial_residual = rnorm;
+        const T threshold = detail::stopping_threshold(b, opts);
+        if (detail::record(res, opts, rnorm, threshold)) { res.converged = true; return res; }
+
+        r_hat.data = r.data;
+        T rho = 1, alpha = 1, omega = 1;
+
+        while (res.iterations < opts.max_iter) {
+            const T rho_new = detail::vdot(r_hat, r);
+            if (rho_new == static_cast<T>(0)) { res.message = "breakdown: rho == 0"; break; }
+            const T beta = (rho_new / rho) * (alpha / omega);
+            detail::bicgstab_direction(r, beta, omega, v, p);
+            rho = rho_new;
+
+            M.apply(p, p_hat);
+            detail::apply_operator(A, p_hat, v);
+            ++res.matvecs;
+            const T rv = detail::vdot(r_hat, v);
+            if (rv == static_cast<T>(0)) { res.message = "breakdown: r_hat.v == 0"; break; }
+            alpha = rho / rv;
+
+            const T snorm = std::sqrt(detail::axpy_dot(r, alpha, v, s));
+            if (snorm <= threshold) {
+                const T* ph = p_hat.data.data();
+                for (std::size_t i = 0; i < n; ++i) x.data[i] += alpha * ph[i];
+                r.data = s.data;
+                ++res.iterations;
+                detail::record(res, opts, snorm, threshold);
+                res.converged = true;
+                break;
+            }
+
+            M.apply(s, s_hat);
+            detail::apply_operator(A, s_hat, t);
+            ++res.matvecs;
+            const auto [ts, tt] = detail::dot2(t, s);
+            if (tt == static_cast<T>(0)) { res.message = "breakdown: t.t == 0"; break; }
+            omega = ts / tt;
+
+            rnorm = std::sqrt(detail::bicgstab_update(alpha, p_hat, omega, s_hat, s, t, x, r));
+            ++res.iterations;
+            if (detail::record(res, opts, rnorm, threshold)) { res.converged = true; break; }
+            if (omega == static_cast<T>(0)) { res.message = "breakdown: omega == 0"; break; }
+        }
+        return res;
+    }
+
+
+    // --- Restarted GMRES(m), right-preconditioned, modified Gram-Schmidt ---
+
+    template <typename T, typename Op, typename Precond = IdentityPreconditioner<T>>
+    SolverResult<T> gmres(const Op& A, const Tensor<T>& b, Tensor<T>& x,
+                          const Precond& M = Precond{}, const SolverOptions<T>& opts = {}) {
+        detail::check_system(b, x);
+        const std::size_t n = b.shape[0];
+        const std::size_t m = std::max<std::size_t>(1, std::min(opts.restart, n));
+
+        // Krylov basis V (m+1 vectors) and preconditioned directions Z (m vectors).
+        std::vector<Tensor<T>> V(m + 1, Tensor<T>({n}));
+        std::vector<Tensor<T>> Z(m, Tensor<T>({n}));
+        std::vector<T> H((m + 1) * m), cs(m), sn(m), g(m + 1), y(m);
+        Tensor<T> w({n});
+        SolverResult<T> res;
+
+        detail::apply_operator(A, x, V[0]);
+        ++res.matvecs;
+        T beta = std::sqrt(detail::residual_from_product(b, V[0]));
+        res.initial_residual = beta;
+        const T threshold = detail::stopping_threshold(b, opts);
+        if (detail::record(res, opts, beta, threshold)) { res.converged = true; return res; }
+
+        while (res.iterations < opts.max_iter) {
+            V[0] *= static_cast<T>(1) / beta;
+            std::fill(g.begin(), g.end(), static_cast<T>(0));
+            g[0] = beta;
+
+            std::size_t k = 0;   // number of Arnoldi steps taken in this cycle
+            bool done = false;
+            for (; k < m && res.iterations < opts.max_iter; ++k) {
+                M.apply(V[k], Z[k]);
+                detail::apply_operator(A, Z[k], w);
+                ++res.matvecs;
+
+                for (std::size_t i = 0; i <= k; ++i) {
+                    const T h = detail::vdot(w, V[i]);
+                    H[i * m + k] = h;
+                    const T* vi = V[i].data.data();
+                    T* wp = w.data.data();
+                    #pragma omp simd
+                    for (std::size_t e = 0; e < n; ++e) wp[e] -= h * vi[e];
+                }
+                const T h_next = detail::norm2(w);
+                H[(k + 1) * m + k] = h_next;
+                if (h_next != static_cast<T>(0)) {
+                    const T inv = static_cast<T>(1) / h_next;
+                    const T* wp = w.data.data();
+                    T* vn = V[k + 1].data.data();
+                    #pragma omp simd
+                    for (std::size_t e = 0; e < n; ++e) vn[e] = wp[e] * inv;
+                }
+
+                // Apply accumulated Givens rotations, then form a new one.
+                for (std::size_t i = 0; i < k; ++i) {
+                    const T a = H[i * m + k], c = H[(i + 1) * m + k];
+                    H[i * m + k]       =  cs[i] * a + sn[i] * c;
+                    H[(i + 1) * m + k] = -sn[i] * a + cs[i] * c;
+                }
+                const T a = H[k * m + k], c = H[(k + 1) * m + k];
+                const T denom = std::sqrt(a * a + c * c);
+                cs[k] = (denom == static_cast<T>(0)) ? static_cast<T>(1) : a / denom;
+                sn[k] = (denom == static_cast<T>(0)) ? static_cast<T>(0) : c / denom;
+                H[k * m + k] = denom;
+                H[(k + 1) * m + k] = static_cast<T>(0);
+                g[k + 1] = -sn[k] * g[k];
+                g[k] = cs[k] * g[k];
+
+                ++res.iterations;
+                if (detail::record(res, opts, std::abs(g[k + 1]), threshold) || h_next == static_cast<T>(0)) {
+                    ++k;
+                    done = true;
+                    break;
+                }
+            }
+
+            // Solve the k x k upper-triangular system H y = g and update x += Z y.
+            for (std::size_t i = k; i-- > 0; ) {
+                T acc = g[i];
+                for (std::size_t j = i + 1; j < k; ++j) acc -= H[i * m + j] * y[j];
+                y[i] = acc / H[i * m + i];
+            }
+            T* xp = x.data.data();
+            for (std::size_t j = 0; j < k; ++j) {
+                const T yj = y[j];
+                const T* zj = Z[j].data.data();
+                #pragma omp simd
+                for (std::size_t e = 0; e < n; ++e) xp[e] += yj * zj[e];
+            }
+
+            // True residual for the restart (guards against drift in the estimate).
+            detail::apply_operator(A, x, V[0]);
+            ++res.matvecs;
+            beta = std::sqrt(detail::residual_from_product(b, V[0]));
+            res.residual_norm = beta;
+            if (beta <= threshold) { res.converged = true; break; }
+            if (done && beta == static_cast<T>(0)) break;
+        }
+        return res;
+    }
+
+} // namespace linalg
+} // namespace tl
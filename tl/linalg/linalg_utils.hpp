@@ -1,14 +1,41 @@
 #pragma once 
 
 #include "../tensor_core/tensor.hpp"
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
 #include <string>
 #include <stdexcept>
+#include <type_traits>
+#include <vector>
 
 namespace tl {
 namespace linalg {
 
+    namespace detail {
+
+        // C[i0:i1, :] = A[i0:i1, :] @ B for row-major A [M, K], B [K, N], C [M, N].
+        // Writes every element of those rows; callers can apply an epilogue per row.
+        template <typename T>
+        void matmul_rows(const T* A, const T* B, T* C, std::size_t i0, std::size_t i1, std::size_t K, std::size_t N) {
+            for (std::size_t i = i0; i < i1; ++i) {
+                T* c_row = C + i * N;
+                std::fill(c_row, c_row + N, static_cast<T>(0));
+                for (std::size_t k = 0; k < K; ++k) {
+                    const T a_ik = A[i * K + k];
+                    const T* b_row = B + k * N;
+
+                    // Vectorizable inner loop
+                    #pragma omp simd
+                    for (std::size_t j = 0; j < N; ++j) {
+                        c_row[j] += a_ik * b_row[j];
+                    }
+                }
+            }
+        }
+
+    } // namespace detail
+
     // Matrix multiplication (optimized version)
     template <typename T>
     Tensor<T> matmul(const Tensor<T>& A, const Tensor<T>& B) {
@@ -22,24 +49,37 @@ namespace linalg {
         const std::size_t M = A.shape[0];
         const std::size_t K = A.shape[1];
         const std::size_t N = B.shape[1];
+        TL_PROFILE_OP("matmul", 2.0 * M * N * K, A.shape, B.shape);
         
         Tensor<T> C({M, N});
-        std::fill(C.data.begin(), C.data.end(), static_cast<T>(0));
 
-        // Optimized i-k-j order for cache efficiency
-        for (std::size_t i = 0; i < M; ++i) {
-            for (std::size_t k = 0; k < K; ++k) {
-                const T a_ik = A.data[i * K + k];
-                T* c_row = &C.data[i * N];
-                const T* b_row = &B.data[k * N];
-                
-                // Vectorizable inner loop
-                #pragma omp simd
-                for (std::size_t j = 0; j < N; ++j) {
-                    c_row[j] += a_ik * b_row[j];
+        // 16-bit storage: accumulate in float.  B is widened one panel of rows at a
+        // time (sized to stay in L2) and reused across every row of A, so each
+        // element of B is converted once and read from memory at half width.
+        using Acc = accum_t<T>;
+        if constexpr (!std::is_same_v<Acc, T>) {
+            const std::size_t kc = std::max<std::size_t>(1, (std::size_t(1) << 16) / std::max<std::size_t>(N, 1));
+            std::vector<Acc> acc(M * N, static_cast<Acc>(0));
+            std::vector<Acc> panel(std::min(kc, K) * N);
+            for (std::size_t k0 = 0; k0 < K; k0 += kc) {
+                const std::size_t k1 = std::min(k0 + kc, K);
+                convert_to_float(B.data.data() + k0 * N, panel.data(), (k1 - k0) * N);
+                for (std::size_t i = 0; i < M; ++i) {
+                    Acc* c_row = acc.data() + i * N;
+                    for (std::size_t k = k0; k < k1; ++k) {
+                        const Acc a_ik = static_cast<Acc>(A.data[i * K + k]);
+                        const Acc* b_row = panel.data() + (k - k0) * N;
+                        #pragma omp simd
+                        for (std::size_t j = 0; j < N; ++j) c_row[j] += a_ik * b_row[j];
+                    }
                 }
             }
+            convert_from_float(acc.data(), C.data.data(), M * N);
+            return C;
         }
+
+        // Optimized i-k-j order for cache efficiency
+        detail::matmul_rows(A.data.data(), B.data.data(), C.data.data(), 0, M, K, N);
         return C;
     }
 
@@ -108,6 +148,7 @@ namespace linalg {
         
         const std::size_t rows = A.shape[0];
         const std::size_t cols = A.shape[1];
+        TL_PROFILE_OP("transpose", 0, A.shape);
         Tensor<T> result({cols, rows});
         
         for (std::size_t i = 0; i < rows; ++i) {
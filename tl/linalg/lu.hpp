@@ -0,0 +1,140 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Dense LU factorisation with partial pivoting, P A = L U.
+//
+// The factors are stored packed in one row-major n x n buffer (unit-diagonal L
+// below the diagonal, U on and above it), so a factorisation can be kept and
+// reused for many right-hand sides.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace linalg {
+
+    template <typename T>
+    class LUDecomposition {
+    public:
+        LUDecomposition() = default;
+        explicit LUDecomposition(const Tensor<T>& A) { factor(A); }
+
+        std::size_t size() const { return n_; }
+        bool empty() const { return n_ == 0; }
+
+        // Factors A; returns false (leaving the object empty) if A is singular.
+        bool try_factor(const Tensor<T>& A) {
+            if (A.shape.size() != 2 || A.shape[0] != A.shape[1]) {
+                throw std::runtime_error("LU factorisation requires a square 2D matrix.");
+            }
+            n_ = A.shape[0];
+            lu_ = A.data;
+            piv_.resize(n_);
+            sign_ = 1;
+            const std::size_t n = n_;
+            T* a = lu_.data();
+
+            for (std::size_t k = 0; k < n; ++k) {
+                std::size_t p = k;
+                T best = std::abs(a[k * n + k]);
+                for (std::size_t i = k + 1; i < n; ++i) {
+                    const T v = std::abs(a[i * n + k]);
+                    if (v > best) { best = v; p = i; }
+                }
+                piv_[k] = p;
+                if (best == static_cast<T>(0)) { n_ = 0; return false; }
+                if (p != k) {
+                    std::swap_ranges(a + k * n, a + (k + 1) * n, a + p * n);
+                    sign_ = -sign_;
+                }
+
+                const T inv = static_cast<T>(1) / a[k * n + k];
+                const T* __restrict urow = a + k * n;
+                const std::ptrdiff_t first = static_cast<std::ptrdiff_t>(k + 1);
+                // Rank-1 update of the trailing submatrix, one row per iteration.
+                #pragma omp parallel for schedule(static) if((n - k) * (n - k) > (1u << 16))
+                for (std::ptrdiff_t ii = first; ii < static_cast<std::ptrdiff_t>(n); ++ii) {
+                    T* __restrict row = a + static_cast<std::size_t>(ii) * n;
+                    const T l = row[k] * inv;
+                    row[k] = l;
+                    #pragma omp simd
+                    for (std::size_t j = k + 1; j < n; ++j) row[j] -= l * urow[j];
+                }
+            }
+            return true;
+        }
+
+        void factor(const Tensor<T>& A) {
+            if (!try_factor(A)) throw std::runtime_error("LU factorisation failed: matrix is singular.");
+        }
+
+        // Solves A x = b in place on the first n entries of b.
+        void solve_in_place(T* b) const {
+            const std::size_t n = n_;
+            const T* a = lu_.data();
+            for (std::size_t k = 0; k < n; ++k)
+                if (piv_[k] != k) std::swap(b[k], b[piv_[k]]);
+            for (std::size_t i = 1; i < n; ++i) {
+                const T* row = a + i * n;
+                T acc = b[i];
+                for (std::size_t j = 0; j < i; ++j) acc -= row[j] * b[j];
+                b[i] = acc;
+            }
+            for (std::size_t i = n; i-- > 0;) {
+                const T* row = a + i * n;
+                T acc = b[i];
+                for (std::size_t j = i + 1; j < n; ++j) acc -= row[j] * b[j];
+                b[i] = acc / row[i];
+            }
+        }
+
+        // In-place solve; b may have any shape with n elements.
+        void solve_in_place(Tensor<T>& b) const {
+            check_rhs(b);
+            solve_in_place(b.data.data());
+        }
+
+        Tensor<T> solve(const Tensor<T>& b) const {
+            check_rhs(b);
+            Tensor<T> x = b;
+            solve_in_place(x.data.data());
+            return x;
+        }
+
+        T determinant() const {
+            if (empty()) throw std::runtime_error("LUDecomposition is empty.");
+            T det = static_cast<T>(sign_);
+            for (std::size_t i = 0; i < n_; ++i) det *= lu_[i * n_ + i];
+            return det;
+        }
+
+    private:
+        std::size_t n_ = 0;
+        std::vector<T> lu_;
+        std::vector<std::size_t> piv_;
+        int sign_ = 1;
+
+        void check_rhs(const Tensor<T>& b) const {
+            if (empty()) throw std::runtime_error("LUDecomposition is empty.");
+            if (b.data.size() != n_) {
+                throw std::runtime_error("LU solve: right-hand side has " + std::to_string(b.data.size()) +
+                                         " entries, expected " + std::to_string(n_) + ".");
+            }
+        }
+    };
+
+    // Solves the dense system A x = b.
+    template <typename T>
+    Tensor<T> solve(const Tensor<T>& A, const Tensor<T>& b) {
+        return LUDecomposition<T>(A).solve(b);
+    }
+
+} // namespace linalg
+} // namespace tl
@@ -0,0 +1,126 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+namespace tl {
+namespace linalg {
+
+    // Compressed Sparse Row matrix.
+    // row_ptr has rows + 1 entries; the non-zeros of row i live in
+    // [row_ptr[i], row_ptr[i + 1]) of col_idx / values, sorted by column.
+    template <typename T>
+    struct CSRMatrix {
+        std::size_t rows = 0;
+        std::size_t cols = 0;
+        std::vector<std::size_t> row_ptr;
+        std::vector<std::size_t> col_idx;
+        std::vector<T> values;
+
+        std::size_t nnz() const { return values.size(); }
+
+        // Build from (row, col, value) triplets. Duplicate entries are summed.
+        static CSRMatrix from_triplets(std::size_t rows, std::size_t cols,
+                                       std::vector<std::tuple<std::size_t, std::size_t, T>> triplets) {
+            std::sort(triplets.begin(), triplets.end(), [](const auto& a, const auto& b) {
+                return std::get<0>(a) != std::get<0>(b) ? std::get<0>(a) < std::get<0>(b)
+                                                        : std::get<1>(a) < std::get<1>(b);
+            });
+
+            CSRMatrix m;
+            m.rows = rows;
+            m.cols = cols;
+            m.row_ptr.assign(rows + 1, 0);
+            const std::size_t none = static_cast<std::size_t>(-1);
+            std::size_t last_r = none, last_c = none;
+            for (const auto& [r, c, v] : triplets) {
+                if (r >= rows || c >= cols) {
+                    throw std::out_of_range(
+                        "Triplet (" + std::to_string(r) + ", " + std::to_string(c) +
+                        ") out of range for " + std::to_string(rows) + "x" + std::to_string(cols) + " matrix");
+                }
+                if (r == last_r && c == last_c) {
+                    m.values.back() += v;   // duplicate (r, c): accumulate
+                    continue;
+                }
+                m.col_idx.push_back(c);
+                m.values.push_back(v);
+                ++m.row_ptr[r + 1];
+                last_r = r;
+                last_c = c;
+            }
+            // Per-row counts -> offsets.
+            for (std::size_t i = 0; i < rows; ++i) m.row_ptr[i + 1] += m.row_ptr[i];
+            return m;
+        }
+
+        // Build from a dense 2D tensor, dropping exact zeros.
+        static CSRMatrix from_dense(const Tensor<T>& A) {
+            if (A.shape.size() != 2) {
+                throw std::runtime_error("CSRMatrix::from_dense requires a 2D tensor.");
+            }
+            CSRMatrix m;
+            m.rows = A.shape[0];
+            m.cols = A.shape[1];
+            m.row_ptr.assign(m.rows + 1, 0);
+            for (std::size_t i = 0; i < m.rows; ++i) {
+                for (std::size_t j = 0; j < m.cols; ++j) {
+                    const T v = A.data[i * m.cols + j];
+                    if (v != static_cast<T>(0)) {
+                        m.col_idx.push_back(j);
+                        m.values.push_back(v);
+                    }
+                }
+                m.row_ptr[i + 1] = m.values.size();
+            }
+            return m;
+        }
+
+        Tensor<T> to_dense() const {
+            Tensor<T> A({rows, cols});
+            for (std::size_t i = 0; i < rows; ++i)
+                for (std::size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k)
+                    A.data[i * cols + col_idx[k]] = values[k];
+            return A;
+        }
+
+        // y = A x, writing into a preallocated y (no allocation on the hot path).
+        void matvec(const Tensor<T>& x, Tensor<T>& y) const {
+            if (x.data.size() != cols || y.data.size() != rows) {
+                throw std::runtime_error("CSRMatrix::matvec: vector sizes do not match matrix shape.");
+            }
+            const T* xp = x.data.data();
+            T* yp = y.data.data();
+            #pragma omp parallel for schedule(static) if(rows > 4096)
+            for (std::ptrdiff_t i = 0; i < static_cast<std::ptrdiff_t>(rows); ++i) {
+                T acc = static_cast<T>(0);
+                for (std::size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k)
+                    acc += values[k] * xp[col_idx[k]];
+                yp[i] = acc;
+            }
+        }
+
+        Tensor<T> operator*(const Tensor<T>& x) const {
+            Tensor<T> y({rows});
+            matvec(x, y);
+            return y;
+        }
+
+        // Main diagonal as a 1D tensor (zeros where the diagonal is not stored).
+        Tensor<T> diagonal() const {
+            const std::size_t n = std::min(rows, cols);
+            Tensor<T> d({n});
+            for (std::size_t i = 0; i < n; ++i)
+                for (std::size_t k = row_ptr[i]; k < row_ptr[i + 1]; ++k)
+                    if (col_idx[k] == i) { d.data[i] = values[k]; break; }
+            return d;
+        }
+    };
+
+} // namespace linalg
+} // namespace tl
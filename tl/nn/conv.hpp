@@ -0,0 +1,399 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include "../linalg/linalg_utils.hpp"
+#include "../autograd/tape.hpp"
+#include <array>
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+// 2D convolution (cross-correlation, as in deep-learning frameworks) on [N, C, H, W]
+// tensors with weights [O, C / groups, KH, KW].
+//
+//   Im2col   : unfolds each (image, group) into a [C_g*KH*KW, OH*OW] matrix and
+//              multiplies it with the group's weights through linalg::matmul
+//   Winograd : F(2x2, 3x3) for 3x3, stride-1, dilation-1 kernels; 16 transformed
+//              GEMMs per (image, group) replace 9 multiplies per output with 4
+//   Auto     : Winograd when the kernel qualifies, Im2col otherwise
+//
+// Work is partitioned over (image, group) pairs across threads.  The autograd
+// overload tl::autograd::conv2d adds the backward pass for input, weights and bias.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace nn {
+
+    enum class ConvAlgorithm { Auto, Im2col, Winograd };
+
+    struct Conv2dOptions {
+        std::array<std::size_t, 2> stride{1, 1};
+        std::array<std::size_t, 2> padding{0, 0};
+        std::array<std::size_t, 2> dilation{1, 1};
+        std::size_t groups = 1;
+        ConvAlgorithm algorithm = ConvAlgorithm::Auto;
+    };
+
+
+    namespace detail {
+
+        // Problem dimensions shared by the forward and backward kernels.
+        struct ConvGeometry {
+            std::size_t N, C, H, W, O, KH, KW, OH, OW, groups, Cg, Og;
+            std::size_t sh, sw, ph, pw, dh, dw;
+
+            std::size_t kdim() const { return Cg * KH * KW; }
+            std::size_t pixels() const { return OH * OW; }
+            bool winograd_eligible() const { return KH == 3 && KW == 3 && sh == 1 && sw == 1 && dh == 1 && dw == 1; }
+        };
+
+        template <typename T>
+        ConvGeometry conv_geometry(const Tensor<T>& x, const Tensor<T>& w, const Tensor<T>* bias, const Conv2dOptions& o) {
+            if (x.shape.size() != 4 || w.shape.size() != 4) {
+                throw std::runtime_error("conv2d expects input [N, C, H, W] and weights [O, C/groups, KH, KW].");
+            }
+            ConvGeometry g{};
+            g.N = x.shape[0]; g.C = x.shape[1]; g.H = x.shape[2]; g.W = x.shape[3];
+            g.O = w.shape[0]; g.KH = w.shape[2]; g.KW = w.shape[3];
+            g.groups = o.groups;
+            g.sh = o.stride[0]; g.sw = o.stride[1];
+            g.ph = o.padding[0]; g.pw = o.padding[1];
+            g.dh = o.dilation[0]; g.dw = o.dilation[1];
+            if (g.groups == 0 || g.C % g.groups != 0 || g.O % g.groups != 0) {
+                throw std::runtime_error("conv2d: channels (" + std::to_string(g.C) + " in, " + std::to_string(g.O) +
+                                         " out) must be divisible by groups (" + std::to_string(g.groups) + ").");
+            }
+            g.Cg = g.C / g.groups;
+            g.Og = g.O / g.groups;
+            if (w.shape[1] != g.Cg) {
+                throw std::runtime_error("conv2d: weights expect " + std::to_string(w.shape[1]) +
+                                         " channels per group, input provides " + std::to_string(g.Cg) + ".");
+            }
+            if (g.sh == 0 || g.sw == 0 || g.dh == 0 || g.dw == 0) throw std::runtime_error("conv2d: stride and dilation must be positive.");
+            const std::size_t eh = g.dh * (g.KH - 1) + 1, ew = g.dw * (g.KW - 1) + 1;
+            if (g.KH == 0 || g.KW == 0 || g.H + 2 * g.ph < eh || g.W + 2 * g.pw < ew) {
+                throw std::runtime_error("conv2d: kernel larger than the padded input.");
+            }
+            g.OH = (g.H + 2 * g.ph - eh) / g.sh + 1;
+            g.OW = (g.W + 2 * g.pw - ew) / g.sw + 1;
+            if (bias && (bias->data.size() != g.O)) throw std::runtime_error("conv2d: bias must have one entry per output channel.");
+            return g;
+        }
+
+        // col[(c*KH + kh)*KW + kw, oh*OW + ow] = x[c, oh*sh - ph + kh*dh, ow*sw - pw + kw*dw] (0 outside).
+        template <typename T>
+        void im2col(const T* x, const ConvGeometry& g, T* col) {
+            const std::size_t P = g.pixels();
+            for (std::size_t c = 0; c < g.Cg; ++c)
+                for (std::size_t kh = 0; kh < g.KH; ++kh)
+                    for (std::size_t kw = 0; kw < g.KW; ++kw) {
+                        T* row = col + ((c * g.KH + kh) * g.KW + kw) * P;
+                        const T* plane = x + c * g.H * g.W;
+                        for (std::size_t oh = 0; oh < g.OH; ++oh) {
+                            const std::ptrdiff_t ih = static_cast<std::ptrdiff_t>(oh * g.sh + kh * g.dh) - static_cast<std::ptrdiff_t>(g.ph);
+                            T* out = row + oh * g.OW;
+                            if (ih < 0 || ih >= static_cast<std::ptrdiff_t>(g.H)) {
+                                std::fill(out, out + g.OW, static_cast<T>(0));
+                                continue;
+                            }
+                            const T* src = plane + static_cast<std::size_t>(ih) * g.W;
+                            for (std::size_t ow = 0; ow < g.OW; ++ow) {
+                                const std::ptrdiff_t iw = static_cast<std::ptrdiff_t>(ow * g.sw + kw * g.dw) - static_cast<std::ptrdiff_t>(g.pw);
+                                out[ow] = (iw < 0 || iw >= static_cast<std::ptrdiff_t>(g.W)) ? static_cast<T>(0) : src[iw];
+                            }
+                        }
+                    }
+        }
+
+        // Adjoint of im2col: scatters col back onto dx (accumulating).
+        template <typename T>
+        void col2im(const T* col, const ConvGeometry& g, T* dx) {
+            const std::size_t P = g.pixels();
+            for (std::size_t c = 0; c < g.Cg; ++c)
+                for (std::size_t kh = 0; kh < g.KH; ++kh)
+                    for (std::size_t kw = 0; kw < g.KW; ++kw) {
+                        const T* row = col + ((c * g.KH + kh) * g.KW + kw) * P;
+                        T* plane = dx + c * g.H * g.W;
+                        for (std::size_t oh = 0; oh < g.OH; ++oh) {
+                            const std::ptrdiff_t ih = static_cast<std::ptrdiff_t>(oh * g.sh + kh * g.dh) - static_cast<std::ptrdiff_t>(g.ph);
+                            if (ih < 0 || ih >= static_cast<std::ptrdiff_t>(g.H)) continue;
+                            T* dst = plane + static_cast<std::size_t>(ih) * g.W;
+                            const T* src = row + oh * g.OW;
+                            for (std::size_t ow = 0; ow < g.OW; ++ow) {
+                                const std::ptrdiff_t iw = static_cast<std::ptrdiff_t>(ow * g.sw + kw * g.dw) - static_cast<std::ptrdiff_t>(g.pw);
+                                if (iw >= 0 && iw < static_cast<std::ptrdiff_t>(g.W)) dst[iw] += src[ow];
+                            }
+                        }
+                    }
+        }
+
+        // Weights of group gi as a [Og, Cg*KH*KW] matrix.
+        template <typename T>
+        Tensor<T> group_weights(const Tensor<T>& w, const ConvGeometry& g, std::size_t gi) {
+            const std::size_t K = g.kdim();
+            Tensor<T> Wg({g.Og, K});
+            std::copy(w.data.begin() + gi * g.Og * K, w.data.begin() + (gi + 1) * g.Og * K, Wg.data.begin());
+            return Wg;
+        }
+
+        template <typename T>
+        void conv2d_im2col(const Tensor<T>& x, const Tensor<T>& w, const Tensor<T>* bias, const ConvGeometry& g, Tensor<T>& y) {
+            const std::size_t K = g.kdim(), P = g.pixels();
+            std::vector<Tensor<T>> Wg;
+            for (std::size_t gi = 0; gi < g.groups; ++gi) Wg.push_back(group_weights(w, g, gi));
+            const std::ptrdiff_t jobs = static_cast<std::ptrdiff_t>(g.N * g.groups);
+
+            #pragma omp parallel
+            {
+                Tensor<T> col({K, P});
+                #pragma omp for schedule(dynamic)
+                for (std::ptrdiff_t job = 0; job < jobs; ++job) {
+                    const std::size_t n = static_cast<std::size_t>(job) / g.groups;
+                    const std::size_t gi = static_cast<std::size_t>(job) % g.groups;
+                    im2col(x.data.data() + (n * g.C + gi * g.Cg) * g.H * g.W, g, col.data.data());
+                    const Tensor<T> out = linalg::matmul(Wg[gi], col);
+                    for (std::size_t o = 0; o < g.Og; ++o) {
+                        const std::size_t oc = gi * g.Og + o;
+                        const T b = bias ? bias->data[oc] : static_cast<T>(0);
+                        T* dst = y.data.data() + (n * g.O + oc) * P;
+                        const T* src = out.data.data() + o * P;
+                        #pragma omp simd
+                        for (std::size_t p = 0; p < P; ++p) dst[p] = src[p] + b;
+                    }
+                }
+            }
+        }
+
+        // Winograd F(2x2, 3x3): Y = A^T [ sum_c (G g G^T) .* (B^T d B) ] A.
+        template <typename T>
+        void conv2d_winograd(const Tensor<T>& x, const Tensor<T>& w, const Tensor<T>* bias, const ConvGeometry& g, Tensor<T>& y) {
+            const std::size_t TH = (g.OH + 1) / 2, TW = (g.OW + 1) / 2, P = TH * TW;
+
+            // Weight transform U[gi * 16 + xi] : [Og, Cg], xi indexes the 4x4 tile.
+            std::vector<Tensor<T>> U(g.groups * 16, Tensor<T>({g.Og, g.Cg}));
+            const T half = static_cast<T>(0.5);
+            for (std::size_t oc = 0; oc < g.O; ++oc)
+                for (std::size_t c = 0; c < g.Cg; ++c) {
+                    const T* k = w.data.data() + (oc * g.Cg + c) * 9;
+                    T tmp[4][3];   // G k
+                    for (std::size_t j = 0; j < 3; ++j) {
+                        tmp[0][j] = k[j];
+                        tmp[1][j] = half * (k[j] + k[3 + j] + k[6 + j]);
+                        tmp[2][j] = half * (k[j] - k[3 + j] + k[6 + j]);
+                        tmp[3][j] = k[6 + j];
+                    }
+                    const std::size_t gi = oc / g.Og, o = oc % g.Og;
+                    for (std::size_t i = 0; i < 4; ++i) {
+                        const T u[4] = {tmp[i][0], half * (tmp[i][0] + tmp[i][1] + tmp[i][2]),
+                                        half * (tmp[i][0] - tmp[i][1] + tmp[i][2]), tmp[i][2]};
+                        for (std::size_t j = 0; j < 4; ++j) U[gi * 16 + i * 4 + j].data[o * g.Cg + c] = u[j];
+                    }
+                }
+
+            const std::ptrdiff_t jobs = static_cast<std::ptrdiff_t>(g.N * g.groups);
+            #pragma omp parallel
+            {
+                std::vector<Tensor<T>> V(16, Tensor<T>({g.Cg, P}));
+                std::vector<Tensor<T>> M(16, Tensor<T>({g.Og, P}));
+                #pragma omp for schedule(dynamic)
+                for (std::ptrdiff_t job = 0; job < jobs; ++job) {
+                    const std::size_t n = static_cast<std::size_t>(job) / g.groups;
+                    const std::size_t gi = static_cast<std::size_t>(job) % g.groups;
+                    const T* xg = x.data.data() + (n * g.C + gi * g.Cg) * g.H * g.W;
+
+                    // Input transform V = B^T d B for every channel and tile.
+                    for (std::size_t c = 0; c < g.Cg; ++c) {
+                        const T* plane = xg + c * g.H * g.W;
+                        for (std::size_t th = 0; th < TH; ++th)
+                            for (std::size_t tw = 0; tw < TW; ++tw) {
+                                T d[4][4];
+                                for (std::size_t r = 0; r < 4; ++r) {
+                                    const std::ptrdiff_t ih = static_cast<std::ptrdiff_t>(2 * th + r) - static_cast<std::ptrdiff_t>(g.ph);
+                                    for (std::size_t s = 0; s < 4; ++s) {
+                                        const std::ptrdiff_t iw = static_cast<std::ptrdiff_t>(2 * tw + s) - static_cast<std::ptrdiff_t>(g.pw);
+                                        const bool inside = ih >= 0 && ih < static_cast<std::ptrdiff_t>(g.H) &&
+                                                            iw >= 0 && iw < static_cast<std::ptrdiff_t>(g.W);
+                                        d[r][s] = inside ? plane[static_cast<std::size_t>(ih) * g.W + static_cast<std::size_t>(iw)] : static_cast<T>(0);
+                                    }
+                                }
+                                T bd[4][4];   // B^T d
+                                for (std::size_t s = 0; s < 4; ++s) {
+                                    bd[0][s] = d[0][s] - d[2][s];
+                                    bd[1][s] = d[1][s] + d[2][s];
+                                    bd[2][s] = d[2][s] - d[1][s];
+                                    bd[3][s] = d[1][s] - d[3][s];
+                                }
+                                const std::size_t p = th * TW + tw;
+                                for (std::size_t r = 0; r < 4; ++r) {
+                                    V[r * 4 + 0].data[c * P + p] = bd[r][0] - bd[r][2];
+                                    V[r * 4 + 1].data[c * P + p] = bd[r][1] + bd[r][2];
+                                    V[r * 4 + 2].data[c * P + p] = bd[r][2] - bd[r][1];
+                                    V[r * 4 + 3].data[c * P + p] = bd[r][1] - bd[r][3];
+                                }
+                            }
+                    }
+
+                    // Elementwise products summed over channels: 16 GEMMs [Og, Cg] x [Cg, P].
+                    for (std::size_t xi = 0; xi < 16; ++xi) M[xi] = linalg::matmul(U[gi * 16 + xi], V[xi]);
+
+                    // Output transform A^T m A, clipped at odd edges.
+                    for (std::size_t o = 0; o < g.Og; ++o) {
+                        const std::size_t oc = gi * g.Og + o;
+                        const T b = bias ? bias->data[oc] : static_cast<T>(0);
+                        T* out = y.data.data() + (n * g.O + oc) * g.OH * g.OW;
+                        for (std::size_t th = 0; th < TH; ++th)
+                            for (std::size_t tw = 0; tw < TW; ++tw) {
+                                const std::size_t p = th * TW + tw;
+                                T m[4][4];
+                                for (std::size_t xi = 0; xi < 16; ++xi) m[xi / 4][xi % 4] = M[xi].data[o * P + p];
+                                T am[2][4];   // A^T m
+                                for (std::size_t s = 0; s < 4; ++s) {
+                                    am[0][s] = m[0][s] + m[1][s] + m[2][s];
+                                    am[1][s] = m[1][s] - m[2][s] - m[3][s];
+                                }
+                                for (std::size_t r = 0; r < 2; ++r) {
+                                    const std::size_t oh = 2 * th + r;
+                                    if (oh >= g.OH) break;
+                                    const T v0 = am[r][0] + am[r][1] + am[r][2];
+                                    const T v1 = am[r][1] - am[r][2] - am[r][3];
+                                    out[oh * g.OW + 2 * tw] = v0 + b;
+                                    if (2 * tw + 1 < g.OW) out[oh * g.OW + 2 * tw + 1] = v1 + b;
+                                }
+                            }
+                    }
+                }
+            }
+        }
+
+    } // namespace detail
+
+
+    namespace detail {
+
+        template <typename T>
+        Tensor<T> conv2d_forward(const Tensor<T>& x, const Tensor<T>& w, const Tensor<T>* bias, const Conv2dOptions& opts) {
+            const ConvGeometry g = conv_geometry(x, w, bias, opts);
+            Tensor<T> y({g.N, g.O, g.OH, g.OW});
+            const bool winograd = opts.algorithm == ConvAlgorithm::Winograd ||
+                                  (opts.algorithm == ConvAlgorithm::Auto && g.winograd_eligible());
+            if (winograd) {
+                if (!g.winograd_eligible()) {
+                    throw std::runtime_error("conv2d: the Winograd path needs a 3x3 kernel with stride 1 and dilation 1.");
+                }
+                conv2d_winograd(x, w, bias, g, y);
+            } else {
+                conv2d_im2col(x, w, bias, g, y);
+            }
+            return y;
+        }
+
+    } // namespace detail
+
+
+    // Output [N, O, OH, OW].
+    template <typename T>
+    Tensor<T> conv2d(const Tensor<T>& x, const Tensor<T>& w, const Conv2dOptions& opts = {}) {
+        return detail::conv2d_forward(x, w, static_cast<const Tensor<T>*>(nullptr), opts);
+    }
+
+    // Bias has one entry per output channel.
+    template <typename T>
+    Tensor<T> conv2d(const Tensor<T>& x, const Tensor<T>& w, const Tensor<T>& bias, const Conv2dOptions& opts = {}) {
+        return detail::conv2d_forward(x, w, &bias, opts);
+    }
+
+} // namespace nn
+
+
+namespace autograd {
+
+    // Differentiable conv2d; pass a bias Var through the overload below.
+    template <typename T>
+    Var<T> conv2d(const Var<T>& x, const Var<T>& w, const nn::Conv2dOptions& opts = {}) {
+        if (x.tape() != w.tape()) throw std::runtime_error("autograd: operands are recorded on different tapes.");
+        return x.tape()->record(nn::conv2d(x.value(), w.value(), opts), {x, w},
+            [x, w, opts](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& gy) {
+                const Tensor<T>& X = x.value();
+                const Tensor<T>& Wt = w.value();
+                const nn::detail::ConvGeometry g = nn::detail::conv_geometry(X, Wt, static_cast<const Tensor<T>*>(nullptr), opts);
+                const std::size_t K = g.kdim(), P = g.pixels();
+                const bool need_x = tp.requires_grad(x.id()), need_w = tp.requires_grad(w.id());
+                T* dX = need_x ? tp.grad_buffer(x.id()).data.data() : nullptr;
+                T* dW = need_w ? tp.grad_buffer(w.id()).data.data() : nullptr;
+                const std::ptrdiff_t N = static_cast<std::ptrdiff_t>(g.N);
+
+                #pragma omp parallel
+                {
+                    Tensor<T> col({K, P});
+                    std::vector<T> dW_local(need_w ? Wt.data.size() : 0, static_cast<T>(0));
+                    #pragma omp for schedule(dynamic)
+                    for (std::ptrdiff_t nn_ = 0; nn_ < N; ++nn_) {
+                        const std::size_t n = static_cast<std::size_t>(nn_);
+                        for (std::size_t gi = 0; gi < g.groups; ++gi) {
+                            const std::size_t xoff = (n * g.C + gi * g.Cg) * g.H * g.W;
+                            const T* gyg = gy.data.data() + (n * g.O + gi * g.Og) * P;
+                            const T* Wg = Wt.data.data() + gi * g.Og * K;
+                            if (need_w) {
+                                // dW_g += dY_g col^T
+                                nn::detail::im2col(X.data.data() + xoff, g, col.data.data());
+                                T* dWg = dW_local.data() + gi * g.Og * K;
+                                for (std::size_t o = 0; o < g.Og; ++o)
+                                    for (std::size_t k = 0; k < K; ++k) {
+                                        const T* a = gyg + o * P;
+                                        const T* b = col.data.data() + k * P;
+                                        T acc = static_cast<T>(0);
+                                        #pragma omp simd reduction(+:acc)
+                                        for (std::size_t p = 0; p < P; ++p) acc += a[p] * b[p];
+                                        dWg[o * K + k] += acc;
+                                    }
+                            }
+                            if (need_x) {
+                                // dcol = W_g^T dY_g, scattered back with col2im.
+                                std::fill(col.data.begin(), col.data.end(), static_cast<T>(0));
+                                for (std::size_t o = 0; o < g.Og; ++o)
+                                    for (std::size_t k = 0; k < K; ++k) {
+                                        const T wok = Wg[o * K + k];
+                                        T* dst = col.data.data() + k * P;
+                                        const T* src = gyg + o * P;
+                                        #pragma omp simd
+                                        for (std::size_t p = 0; p < P; ++p) dst[p] += wok * src[p];
+                                    }
+                                nn::detail::col2im(col.data.data(), g, dX + xoff);
+                            }
+                        }
+                    }
+                    if (need_w) {
+                        #pragma omp critical
+                        for (std::size_t i = 0; i < dW_local.size(); ++i) dW[i] += dW_local[i];
+                    }
+                }
+            });
+    }
+
+    template <typename T>
+    Var<T> conv2d(const Var<T>& x, const Var<T>& w, const Var<T>& bias, const nn::Conv2dOptions& opts = {}) {
+        const Var<T> y = conv2d(x, w, opts);
+        if (bias.tape() != x.tape()) throw std::runtime_error("autograd: operands are recorded on different tapes.");
+        if (bias.value().data.size() != y.shape()[1]) throw std::runtime_error("conv2d: bias must have one entry per output channel.");
+        // Adds bias over [N, O, OH, OW]; its gradient is the per-channel sum.
+        Tensor<T> out = y.value();
+        const std::size_t O = y.shape()[1], P = y.shape()[2] * y.shape()[3];
+        for (std::size_t i = 0; i < out.data.size(); ++i) out.data[i] += bias.value().data[(i / P) % O];
+        return x.tape()->record(std::move(out), {y, bias},
+            [y, bias, O, P](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+                if (tp.requires_grad(y.id())) {
+                    Tensor<T>& dy = tp.grad_buffer(y.id());
+                    for (std::size_t i = 0; i < g.data.size(); ++i) dy.data[i] += g.data[i];
+                }
+                if (tp.requires_grad(bias.id())) {
+                    Tensor<T>& db = tp.grad_buffer(bias.id());
+                    for (std::size_t i = 0; i < g.data.size(); ++i) db.data[(i / P) % O] += g.data[i];
+                }
+            });
+    }
+
+} // namespace autograd
+} // namespace tl
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include "../autograd/tape.hpp"
+#include "../random/random.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// Inverted dropout driven by the counter-based generator in tl/random.
+//
+// Element i is kept when its Philox word clears the drop threshold, and kept
+// elements are scaled by 1 / (1 - p).  The mask is never stored.  Since it is a
+// pure function of (seed, counter, i), the autograd backward regenerates it
+// from the two integers recorded in the forward pass.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace nn {
+
+    namespace detail {
+
+        // dst[i] (+)= src[i] * mask_i * scale for the mask stream at (seed, first).
+        template <typename T>
+        void dropout_apply(const T* src, T* dst, std::size_t n, double p, std::uint64_t seed, std::uint64_t first,
+                           bool accumulate) {
+            const std::uint64_t threshold = static_cast<std::uint64_t>(p * 4294967296.0);
+            const T scale = static_cast<T>(1.0 / (1.0 - p));
+            random::detail::for_each_block(seed, first, (n + 3) / 4, n, [&](std::size_t blk, const random::detail::Block& b) {
+                const std::size_t base = blk * 4;
+                const std::size_t m = std::min<std::size_t>(4, n - base);
+                for (std::size_t k = 0; k < m; ++k) {
+                    const T v = static_cast<std::uint64_t>(b.w[k]) >= threshold ? src[base + k] * scale : static_cast<T>(0);
+                    if (accumulate) dst[base + k] += v;
+                    else dst[base + k] = v;
+                }
+            });
+        }
+
+        inline void check_dropout(double p) {
+            if (!(p >= 0.0 && p < 1.0)) throw std::runtime_error("dropout: p must lie in [0, 1).");
+        }
+
+    } // namespace detail
+
+    // Zeroes each element with probability p and rescales the rest; identity when !training.
+    template <typename T>
+    Tensor<T> dropout(const Tensor<T>& x, double p, random::Generator& gen = random::default_generator(), bool training = true) {
+        detail::check_dropout(p);
+        if (!training || p == 0.0) return x;
+        Tensor<T> y(x.shape);
+        const std::size_t n = x.data.size();
+        const std::uint64_t first = gen.advance((n + 3) / 4);
+        detail::dropout_apply(x.data.data(), y.data.data(), n, p, gen.seed(), first, false);
+        return y;
+    }
+
+} // namespace nn
+
+
+namespace autograd {
+
+    template <typename T>
+    Var<T> dropout(const Var<T>& x, double p, random::Generator& gen = random::default_generator(), bool training = true) {
+        nn::detail::check_dropout(p);
+        if (!training || p == 0.0) {
+            return x.tape()->record(x.value(), {x}, [x](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+                Tensor<T>& dx = tp.grad_buffer(x.id());
+                for (std::size_t i = 0; i < g.data.size(); ++i) dx.data[i] += g.data[i];
+            });
+        }
+        const std::size_t n = x.value().data.size();
+        const std::uint64_t seed = gen.seed(), first = gen.advance((n + 3) / 4);
+        Tensor<T> y(x.value().shape);
+        nn::detail::dropout_apply(x.value().data.data(), y.data.data(), n, p, seed, first, false);
+        return x.tape()->record(std::move(y), {x}, [x, p, seed, first](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+            Tensor<T>& dx = tp.grad_buffer(x.id());
+            nn::detail::dropout_apply(g.data.data(), dx.data.data(), g.data.size(), p, seed, first, true);
+        });
+    }
+
+} // namespace autograd
+} // namespace tl
@@ -0,0 +1,11 @@
+#pragma once
+
+// Memory layout of 4D image tensors: channels second (NCHW) or last (NHWC).
+
+namespace tl {
+namespace nn {
+
+    enum class Layout { NCHW, NHWC };
+
+} // namespace nn
+} // namespace tl
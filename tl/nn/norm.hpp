@@ -0,0 +1,334 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include "../autograd/tape.hpp"
+#include "layout.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+// Fused normalisation layers.
+//
+//   layer_norm(x, gamma, beta)   : per-row (x - mean) / sqrt(var + eps) * gamma + beta,
+//                                  rows being the trailing dims covered by gamma
+//   rms_norm(x, gamma)           : x / sqrt(mean(x^2) + eps) * gamma
+//   batch_norm_inference(x, bn)  : x * scale[c] + shift[c] with running statistics
+//                                  folded once by fold_batch_norm
+//
+// The row statistics come from one Welford pass that runs in independent lanes,
+// merged with Chan's formula.  A second sweep applies the normalisation and the
+// affine transform together, so no intermediate tensor is allocated.  Rows are
+// split across threads.  layer_norm and rms_norm have tl::autograd overloads.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace nn {
+
+    // Inference-mode batch norm reduced to one multiply-add per element.
+    template <typename T>
+    struct BatchNormFold {
+        std::vector<T> scale;   // gamma / sqrt(running_var + eps)
+        std::vector<T> shift;   // beta - running_mean * scale
+    };
+
+
+    namespace detail {
+
+        constexpr std::size_t norm_parallel_threshold = 1 << 15;
+        constexpr std::size_t norm_lanes = 8;
+
+        // Splits x into [rows, cols] where cols covers the trailing dims given by `param`.
+        template <typename T>
+        std::size_t norm_columns(const Tensor<T>& x, const Tensor<T>& param, const char* op) {
+            const std::size_t k = param.shape.size();
+            if (k == 0 || k > x.shape.size() ||
+                !std::equal(param.shape.begin(), param.shape.end(), x.shape.end() - static_cast<std::ptrdiff_t>(k))) {
+                throw std::runtime_error(std::string(op) + ": parameter shape must match the trailing dimensions of the input.");
+            }
+            return param.data.size();
+        }
+
+        // One-pass mean and biased variance of a contiguous row.
+        template <typename T>
+        void welford(const T* x, std::size_t n, T& mean_out, T& var_out) {
+            constexpr std::size_t L = norm_lanes;
+            T mean[L] = {}, m2[L] = {};
+            const std::size_t blocks = n / L;
+            for (std::size_t b = 0; b < blocks; ++b) {
+                const T inv = static_cast<T>(1) / static_cast<T>(b + 1);
+                const T* v = x + b * L;
+                #pragma omp simd
+                for (std::size_t l = 0; l < L; ++l) {
+                    const T d = v[l] - mean[l];
+                    mean[l] += d * inv;
+                    m2[l] += d * (v[l] - mean[l]);
+                }
+            }
+            // Merge lanes (each holding `blocks` samples), then the tail one at a time.
+            T count = static_cast<T>(0), mu = static_cast<T>(0), M2 = static_cast<T>(0);
+            if (blocks > 0) {
+                const T nb = static_cast<T>(blocks);
+                for (std::size_t l = 0; l < L; ++l) {
+                    const T total = count + nb;
+                    const T d = mean[l] - mu;
+                    mu += d * nb / total;
+                    M2 += m2[l] + d * d * count * nb / total;
+                    count = total;
+                }
+            }
+            for (std::size_t i = blocks * L; i < n; ++i) {
+                count += static_cast<T>(1);
+                const T d = x[i] - mu;
+                mu += d / count;
+                M2 += d * (x[i] - mu);
+            }
+            mean_out = mu;
+            var_out = M2 / static_cast<T>(n);
+        }
+
+        template <typename T>
+        T mean_square(const T* x, std::size_t n) {
+            T acc = static_cast<T>(0);
+            #pragma omp simd reduction(+:acc)
+            for (std::size_t i = 0; i < n; ++i) acc += x[i] * x[i];
+            return acc / static_cast<T>(n);
+        }
+
+        // Forward layer norm; mean / rstd (one per row) are written when non-null.
+        template <typename T>
+        Tensor<T> layer_norm_forward(const Tensor<T>& x, const Tensor<T>& gamma, const Tensor<T>& beta, T eps,
+                                     T* mean_out, T* rstd_out) {
+            const std::size_t cols = norm_columns(x, gamma, "layer_norm");
+            if (beta.shape != gamma.shape) throw std::runtime_error("layer_norm: gamma and beta shapes differ.");
+            Tensor<T> y(x.shape);
+            if (cols == 0) return y;
+            const std::ptrdiff_t rows = static_cast<std::ptrdiff_t>(x.data.size() / cols);
+            const T* g = gamma.data.data();
+            const T* b = beta.data.data();
+
+            #pragma omp parallel for schedule(static) if(x.data.size() > norm_parallel_threshold)
+            for (std::ptrdiff_t r = 0; r < rows; ++r) {
+                const T* row = x.data.data() + static_cast<std::size_t>(r) * cols;
+                T* out = y.data.data() + static_cast<std::size_t>(r) * cols;
+                T mean, var;
+                welford(row, cols, mean, var);
+                const T rstd = static_cast<T>(1) / std::sqrt(var + eps);
+                #pragma omp simd
+                for (std::size_t j = 0; j < cols; ++j) out[j] = (row[j] - mean) * rstd * g[j] + b[j];
+                if (mean_out) mean_out[r] = mean;
+                if (rstd_out) rstd_out[r] = rstd;
+            }
+            return y;
+        }
+
+        template <typename T>
+        Tensor<T> rms_norm_forward(const Tensor<T>& x, const Tensor<T>& gamma, T eps, T* rstd_out) {
+            const std::size_t cols = norm_columns(x, gamma, "rms_norm");
+            Tensor<T> y(x.shape);
+            if (cols == 0) return y;
+            const std::ptrdiff_t rows = static_cast<std::ptrdiff_t>(x.data.size() / cols);
+            const T* g = gamma.data.data();
+
+            #pragma omp parallel for schedule(static) if(x.data.size() > norm_parallel_threshold)
+            for (std::ptrdiff_t r = 0; r < rows; ++r) {
+                const T* row = x.data.data() + static_cast<std::size_t>(r) * cols;
+                T* out = y.data.data() + static_cast<std::size_t>(r) * cols;
+                const T rstd = static_cast<T>(1) / std::sqrt(mean_square(row, cols) + eps);
+                #pragma omp simd
+                for (std::size_t j = 0; j < cols; ++j) out[j] = row[j] * rstd * g[j];
+                if (rstd_out) rstd_out[r] = rstd;
+            }
+            return y;
+        }
+
+    } // namespace detail
+
+
+    // --- Layer / RMS norm ---
+
+    template <typename T>
+    Tensor<T> layer_norm(const Tensor<T>& x, const Tensor<T>& gamma, const Tensor<T>& beta, T eps = static_cast<T>(1e-5)) {
+        return detail::layer_norm_forward(x, gamma, beta, eps, static_cast<T*>(nullptr), static_cast<T*>(nullptr));
+    }
+
+    template <typename T>
+    Tensor<T> rms_norm(const Tensor<T>& x, const Tensor<T>& gamma, T eps = static_cast<T>(1e-6)) {
+        return detail::rms_norm_forward(x, gamma, eps, static_cast<T*>(nullptr));
+    }
+
+    // --- Inference batch norm ---
+
+    template <typename T>
+    BatchNormFold<T> fold_batch_norm(const Tensor<T>& running_mean, const Tensor<T>& running_var,
+                                     const Tensor<T>& gamma, const Tensor<T>& beta, T eps = static_cast<T>(1e-5)) {
+        const std::size_t C = gamma.data.size();
+        if (beta.data.size() != C || running_mean.data.size() != C || running_var.data.size() != C) {
+            throw std::runtime_error("fold_batch_norm: mean, var, gamma and beta need one entry per channel.");
+        }
+        BatchNormFold<T> f{std::vector<T>(C), std::vector<T>(C)};
+        for (std::size_t c = 0; c < C; ++c) {
+            f.scale[c] = gamma.data[c] / std::sqrt(running_var.data[c] + eps);
+            f.shift[c] = beta.data[c] - running_mean.data[c] * f.scale[c];
+        }
+        return f;
+    }
+
+    // x is [N, C, ...] for NCHW or [..., C] for NHWC (any rank >= 2).
+    template <typename T>
+    Tensor<T> batch_norm_inference(const Tensor<T>& x, const BatchNormFold<T>& bn, Layout layout = Layout::NCHW) {
+        if (x.shape.size() < 2) throw std::runtime_error("batch_norm_inference expects a tensor of rank >= 2.");
+        const std::size_t C = bn.scale.size();
+        const std::size_t axis = layout == Layout::NCHW ? 1 : x.shape.size() - 1;
+        if (x.shape[axis] != C) {
+            throw std::runtime_error("batch_norm_inference: input has " + std::to_string(x.shape[axis]) +
+                                     " channels, statistics have " + std::to_string(C) + ".");
+        }
+        Tensor<T> y(x.shape);
+        const T* sc = bn.scale.data();
+        const T* sh = bn.shift.data();
+        const T* xs = x.data.data();
+        T* ys = y.data.data();
+
+        if (layout == Layout::NHWC) {
+            const std::ptrdiff_t rows = static_cast<std::ptrdiff_t>(C ? x.data.size() / C : 0);
+            #pragma omp parallel for schedule(static) if(x.data.size() > detail::norm_parallel_threshold)
+            for (std::ptrdiff_t r = 0; r < rows; ++r) {
+                const std::size_t off = static_cast<std::size_t>(r) * C;
+                #pragma omp simd
+                for (std::size_t c = 0; c < C; ++c) ys[off + c] = xs[off + c] * sc[c] + sh[c];
+            }
+            return y;
+        }
+
+        const std::size_t inner = x.strides[1];
+        const std::ptrdiff_t planes = static_cast<std::ptrdiff_t>(x.shape[0] * C);
+        #pragma omp parallel for schedule(static) if(x.data.size() > detail::norm_parallel_threshold)
+        for (std::ptrdiff_t p = 0; p < planes; ++p) {
+            const std::size_t c = static_cast<std::size_t>(p) % C, off = static_cast<std::size_t>(p) * inner;
+            const T s = sc[c], t = sh[c];
+            #pragma omp simd
+            for (std::size_t i = 0; i < inner; ++i) ys[off + i] = xs[off + i] * s + t;
+        }
+        return y;
+    }
+
+    template <typename T>
+    Tensor<T> batch_norm_inference(const Tensor<T>& x, const Tensor<T>& running_mean, const Tensor<T>& running_var,
+                                   const Tensor<T>& gamma, const Tensor<T>& beta, T eps = static_cast<T>(1e-5),
+                                   Layout layout = Layout::NCHW) {
+        return batch_norm_inference(x, fold_batch_norm(running_mean, running_var, gamma, beta, eps), layout);
+    }
+
+} // namespace nn
+
+
+namespace autograd {
+
+    namespace detail {
+
+        // Adds per-thread partial sums of gamma / beta gradients into their buffers.
+        template <typename T>
+        void merge_partials(const std::vector<T>& part, T* dst) {
+            if (!dst) return;
+            #pragma omp critical
+            for (std::size_t j = 0; j < part.size(); ++j) dst[j] += part[j];
+        }
+
+    } // namespace detail
+
+    template <typename T>
+    Var<T> layer_norm(const Var<T>& x, const Var<T>& gamma, const Var<T>& beta, T eps = static_cast<T>(1e-5)) {
+        Tape<T>& tape = *x.tape();
+        if (gamma.tape() != &tape || beta.tape() != &tape) throw std::runtime_error("autograd: operands are recorded on different tapes.");
+        const std::size_t cols = gamma.value().data.size();
+        const std::size_t rows = cols ? x.value().data.size() / cols : 0;
+        std::vector<T> mean(rows), rstd(rows);
+        Tensor<T> y = nn::detail::layer_norm_forward(x.value(), gamma.value(), beta.value(), eps, mean.data(), rstd.data());
+        return tape.record(std::move(y), {x, gamma, beta},
+            [x, gamma, beta, cols, rows, mean = std::move(mean), rstd = std::move(rstd)](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+                const T* X = x.value().data.data();
+                const T* G = gamma.value().data.data();
+                T* dX = tp.requires_grad(x.id()) ? tp.grad_buffer(x.id()).data.data() : nullptr;
+                T* dG = tp.requires_grad(gamma.id()) ? tp.grad_buffer(gamma.id()).data.data() : nullptr;
+                T* dB = tp.requires_grad(beta.id()) ? tp.grad_buffer(beta.id()).data.data() : nullptr;
+                const T inv_n = T(1) / static_cast<T>(cols);
+                const std::ptrdiff_t R = static_cast<std::ptrdiff_t>(rows);
+
+                #pragma omp parallel if(g.data.size() > detail::autograd_parallel_threshold)
+                {
+                    std::vector<T> dg(dG ? cols : 0, T(0)), db(dB ? cols : 0, T(0));
+                    #pragma omp for schedule(static)
+                    for (std::ptrdiff_t rr = 0; rr < R; ++rr) {
+                        const std::size_t r = static_cast<std::size_t>(rr), off = r * cols;
+                        const T mu = mean[r], rs = rstd[r];
+                        T sum_g = T(0), sum_gx = T(0);
+                        for (std::size_t j = 0; j < cols; ++j) {
+                            const T xhat = (X[off + j] - mu) * rs;
+                            const T gj = g.data[off + j];
+                            if (dG) dg[j] += gj * xhat;
+                            if (dB) db[j] += gj;
+                            sum_g += gj * G[j];
+                            sum_gx += gj * G[j] * xhat;
+                        }
+                        if (dX) {
+                            // dx = rstd * (g*gamma - mean(g*gamma) - xhat * mean(g*gamma*xhat))
+                            for (std::size_t j = 0; j < cols; ++j) {
+                                const T xhat = (X[off + j] - mu) * rs;
+                                dX[off + j] += rs * (g.data[off + j] * G[j] - inv_n * sum_g - xhat * inv_n * sum_gx);
+                            }
+                        }
+                    }
+                    detail::merge_partials(dg, dG);
+                    detail::merge_partials(db, dB);
+                }
+            });
+    }
+
+    template <typename T>
+    Var<T> rms_norm(const Var<T>& x, const Var<T>& gamma, T eps = static_cast<T>(1e-6)) {
+        Tape<T>& tape = *x.tape();
+        if (gamma.tape() != &tape) throw std::runtime_error("autograd: operands are recorded on different tapes.");
+        const std::size_t cols = gamma.value().data.size();
+        const std::size_t rows = cols ? x.value().data.size() / cols : 0;
+        std::vector<T> rstd(rows);
+        Tensor<T> y = nn::detail::rms_norm_forward(x.value(), gamma.value(), eps, rstd.data());
+        return tape.record(std::move(y), {x, gamma},
+            [x, gamma, cols, rows, rstd = std::move(rstd)](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+                const T* X = x.value().data.data();
+                const T* G = gamma.value().data.data();
+                T* dX = tp.requires_grad(x.id()) ? tp.grad_buffer(x.id()).data.data() : nullptr;
+                T* dG = tp.requires_grad(gamma.id()) ? tp.grad_buffer(gamma.id()).data.data() : nullptr;
+                const T inv_n = T(1) / static_cast<T>(cols);
+                const std::ptrdiff_t R = static_cast<std::ptrdiff_t>(rows);
+
+                #pragma omp parallel if(g.data.size() > detail::autograd_parallel_threshold)
+                {
+                    std::vector<T> dg(dG ? cols : 0, T(0));
+                    #pragma omp for schedule(static)
+                    for (std::ptrdiff_t rr = 0; rr < R; ++rr) {
+                        const std::size_t r = static_cast<std::size_t>(rr), off = r * cols;
+                        const T rs = rstd[r];
+                        T dot = T(0);
+                        for (std::size_t j = 0; j < cols; ++j) {
+                            const T gj = g.data[off + j];
+                            if (dG) dg[j] += gj * X[off + j] * rs;
+                            dot += gj * G[j] * X[off + j];
+                        }
+                        if (dX) {
+                            // dx = rstd * g*gamma - x * rstd^3 * mean(g*gamma*x)
+                            const T k = rs * rs * rs * dot * inv_n;
+                            for (std::size_t j = 0; j < cols; ++j) dX[off + j] += rs * g.data[off + j] * G[j] - X[off + j] * k;
+                        }
+                    }
+                    detail::merge_partials(dg, dG);
+                }
+            });
+    }
+
+} // namespace autograd
+} // namespace tl
@@ -0,0 +1,562 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include "../autograd/tape.hpp"
+#include "layout.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+// Pooling and upsampling over 4D image tensors in NCHW or NHWC layout.
+//
+//   max_pool2d / avg_pool2d        : windowed reductions (max_pool2d_with_indices also
+//                                    returns the argmax for the backward pass)
+//   global_avg_pool2d              : mean over H and W, keeping singleton spatial dims
+//   upsample_nearest2d / _bilinear : resize to an explicit output size
+//
+// Kernels address the tensors through their strides directly.  For NCHW the
+// parallel loop runs over (image, channel) planes.  For NHWC it runs over output
+// rows, and the innermost loop walks the contiguous channel vector.  Every forward
+// op has a matching *_backward, and tl::autograd wrappers record them on a tape.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace nn {
+
+    struct Pool2dOptions {
+        std::array<std::size_t, 2> kernel{2, 2};
+        std::array<std::size_t, 2> stride{0, 0};     // 0 = same as the kernel
+        std::array<std::size_t, 2> padding{0, 0};
+        Layout layout = Layout::NCHW;
+        bool count_include_pad = true;                // avg_pool2d divisor
+    };
+
+    template <typename T>
+    struct MaxPoolResult {
+        Tensor<T> output;
+        Tensor<std::size_t> indices;                  // argmax as h * W + w within the input plane
+    };
+
+
+    namespace detail {
+
+        constexpr std::size_t pool_parallel_threshold = 1 << 15;
+
+        // Logical N, C, H, W extents and the matching element strides of a tensor.
+        struct Dims4 {
+            std::size_t N, C, H, W;
+            std::size_t sn, sc, sh, sw;
+        };
+
+        template <typename T>
+        Dims4 dims4(const Tensor<T>& t, Layout layout, const char* op) {
+            if (t.shape.size() != 4) {
+                throw std::runtime_error(std::string(op) + " expects a 4D tensor, got rank " + std::to_string(t.shape.size()) + ".");
+            }
+            const auto& s = t.shape;
+            const auto& st = t.strides;
+            if (layout == Layout::NCHW) return {s[0], s[1], s[2], s[3], st[0], st[1], st[2], st[3]};
+            return {s[0], s[3], s[1], s[2], st[0], st[3], st[1], st[2]};
+        }
+
+        inline std::vector<std::size_t> shape4(std::size_t N, std::size_t C, std::size_t H, std::size_t W, Layout layout) {
+            return layout == Layout::NCHW ? std::vector<std::size_t>{N, C, H, W} : std::vector<std::size_t>{N, H, W, C};
+        }
+
+        struct PoolGeometry {
+            std::size_t KH, KW, SH, SW, PH, PW, OH, OW;
+        };
+
+        inline PoolGeometry pool_geometry(const Dims4& d, const Pool2dOptions& o) {
+            PoolGeometry g{o.kernel[0], o.kernel[1], o.stride[0] ? o.stride[0] : o.kernel[0],
+                           o.stride[1] ? o.stride[1] : o.kernel[1], o.padding[0], o.padding[1], 0, 0};
+            if (g.KH == 0 || g.KW == 0) throw std::runtime_error("pool2d: kernel size must be positive.");
+            if (2 * g.PH > g.KH || 2 * g.PW > g.KW) throw std::runtime_error("pool2d: padding must be at most half the kernel size.");
+            if (d.H + 2 * g.PH < g.KH || d.W + 2 * g.PW < g.KW) throw std::runtime_error("pool2d: kernel larger than the padded input.");
+            g.OH = (d.H + 2 * g.PH - g.KH) / g.SH + 1;
+            g.OW = (d.W + 2 * g.PW - g.KW) / g.SW + 1;
+            return g;
+        }
+
+        // Clipped window [begin, end) of output position o along one axis.
+        inline void window(std::size_t o, std::size_t stride, std::size_t pad, std::size_t k, std::size_t extent,
+                           std::size_t& begin, std::size_t& end) {
+            const std::size_t lo = o * stride;                        // in padded coordinates
+            begin = lo < pad ? 0 : lo - pad;
+            end = std::min(lo + k - pad, extent);
+        }
+
+        template <typename T>
+        constexpr T lowest() {
+            return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity() : std::numeric_limits<T>::lowest();
+        }
+
+        // Source taps of one output coordinate: value = (1 - l) * in[i0] + l * in[i1].
+        template <typename T>
+        struct Tap { std::size_t i0, i1; T l; };
+
+        template <typename T>
+        std::vector<Tap<T>> nearest_taps(std::size_t in, std::size_t out) {
+            std::vector<Tap<T>> taps(out);
+            for (std::size_t o = 0; o < out; ++o) {
+                const std::size_t i = std::min(o * in / out, in - 1);
+                taps[o] = {i, i, static_cast<T>(0)};
+            }
+            return taps;
+        }
+
+        template <typename T>
+        std::vector<Tap<T>> bilinear_taps(std::size_t in, std::size_t out, bool align_corners) {
+            std::vector<Tap<T>> taps(out);
+            for (std::size_t o = 0; o < out; ++o) {
+                T src;
+                if (align_corners) {
+                    src = out > 1 ? static_cast<T>(o) * static_cast<T>(in - 1) / static_cast<T>(out - 1) : static_cast<T>(0);
+                } else {
+                    src = (static_cast<T>(o) + static_cast<T>(0.5)) * static_cast<T>(in) / static_cast<T>(out) - static_cast<T>(0.5);
+                    src = std::max(src, static_cast<T>(0));
+                }
+                const std::size_t i0 = std::min(static_cast<std::size_t>(src), in - 1);
+                const std::size_t i1 = std::min(i0 + 1, in - 1);
+                taps[o] = {i0, i1, src - static_cast<T>(i0)};
+            }
+            return taps;
+        }
+
+        // out = separable interpolation of x with the given row / column taps.
+        template <typename T>
+        void resample(const Tensor<T>& x, Layout layout, const std::vector<Tap<T>>& rows,
+                      const std::vector<Tap<T>>& cols, Tensor<T>& y) {
+            const Dims4 d = dims4(x, layout, "upsample");
+            const Dims4 e = dims4(y, layout, "upsample");
+            const T one = static_cast<T>(1);
+            const T* xs = x.data.data();
+            T* ys = y.data.data();
+
+            if (layout == Layout::NHWC) {
+                const std::ptrdiff_t jobs = static_cast<std::ptrdiff_t>(e.N * e.H);
+                #pragma omp parallel for schedule(static) if(y.data.size() > pool_parallel_threshold)
+                for (std::ptrdiff_t job = 0; job < jobs; ++job) {
+                    const std::size_t n = static_cast<std::size_t>(job) / e.H, oh = static_cast<std::size_t>(job) % e.H;
+                    const Tap<T> r = rows[oh];
+                    const T* x0 = xs + n * d.sn + r.i0 * d.sh;
+                    const T* x1 = xs + n * d.sn + r.i1 * d.sh;
+                    for (std::size_t ow = 0; ow < e.W; ++ow) {
+                        const Tap<T> c = cols[ow];
+                        const T w00 = (one - r.l) * (one - c.l), w01 = (one - r.l) * c.l;
+                        const T w10 = r.l * (one - c.l), w11 = r.l * c.l;
+                        const T* a = x0 + c.i0 * d.sw; const T* b = x0 + c.i1 * d.sw;
+                        const T* p = x1 + c.i0 * d.sw; const T* q = x1 + c.i1 * d.sw;
+                        T* out = ys + n * e.sn + oh * e.sh + ow * e.sw;
+                        #pragma omp simd
+                        for (std::size_t ch = 0; ch < e.C; ++ch) {
+                            const std::size_t k = ch * d.sc;
+                            out[ch * e.sc] = w00 * a[k] + w01 * b[k] + w10 * p[k] + w11 * q[k];
+                        }
+                    }
+                }
+                return;
+            }
+
+            const std::ptrdiff_t planes = static_cast<std::ptrdiff_t>(e.N * e.C);
+            #pragma omp parallel for schedule(static) if(y.data.size() > pool_parallel_threshold)
+            for (std::ptrdiff_t pl = 0; pl < planes; ++pl) {
+                const std::size_t n = static_cast<std::size_t>(pl) / e.C, ch = static_cast<std::size_t>(pl) % e.C;
+                const T* src = xs + n * d.sn + ch * d.sc;
+                T* dst = ys + n * e.sn + ch * e.sc;
+                for (std::size_t oh = 0; oh < e.H; ++oh) {
+                    const Tap<T> r = rows[oh];
+                    const T* x0 = src + r.i0 * d.sh;
+                    const T* x1 = src + r.i1 * d.sh;
+                    T* out = dst + oh * e.sh;
+                    #pragma omp simd
+                    for (std::size_t ow = 0; ow < e.W; ++ow) {
+                        const Tap<T> c = cols[ow];
+                        const T top = (one - c.l) * x0[c.i0 * d.sw] + c.l * x0[c.i1 * d.sw];
+                        const T bot = (one - c.l) * x1[c.i0 * d.sw] + c.l * x1[c.i1 * d.sw];
+                        out[ow * e.sw] = (one - r.l) * top + r.l * bot;
+                    }
+                }
+            }
+        }
+
+        // Adjoint of resample: accumulates gy into dx (shape of the original input).
+        template <typename T>
+        void resample_backward(const Tensor<T>& gy, Layout layout, const std::vector<Tap<T>>& rows,
+                               const std::vector<Tap<T>>& cols, Tensor<T>& dx) {
+            const Dims4 d = dims4(dx, layout, "upsample");
+            const Dims4 e = dims4(gy, layout, "upsample");
+            const T one = static_cast<T>(1);
+            const std::ptrdiff_t planes = static_cast<std::ptrdiff_t>(e.N * e.C);
+            #pragma omp parallel for schedule(static) if(gy.data.size() > pool_parallel_threshold)
+            for (std::ptrdiff_t pl = 0; pl < planes; ++pl) {
+                const std::size_t n = static_cast<std::size_t>(pl) / e.C, ch = static_cast<std::size_t>(pl) % e.C;
+                T* dst = dx.data.data() + n * d.sn + ch * d.sc;
+                const T* src = gy.data.data() + n * e.sn + ch * e.sc;
+                for (std::size_t oh = 0; oh < e.H; ++oh) {
+                    const Tap<T> r = rows[oh];
+                    T* x0 = dst + r.i0 * d.sh;
+                    T* x1 = dst + r.i1 * d.sh;
+                    for (std::size_t ow = 0; ow < e.W; ++ow) {
+                        const Tap<T> c = cols[ow];
+                        const T g = src[oh * e.sh + ow * e.sw];
+                        x0[c.i0 * d.sw] += (one - r.l) * (one - c.l) * g;
+                        x0[c.i1 * d.sw] += (one - r.l) * c.l * g;
+                        x1[c.i0 * d.sw] += r.l * (one - c.l) * g;
+                        x1[c.i1 * d.sw] += r.l * c.l * g;
+                    }
+                }
+            }
+        }
+
+        template <typename T>
+        void max_pool_backward_accumulate(const Tensor<T>& gy, const Tensor<std::size_t>& indices, Layout layout, Tensor<T>& dx) {
+            const Dims4 d = dims4(dx, layout, "max_pool2d_backward");
+            const Dims4 e = dims4(gy, layout, "max_pool2d_backward");
+            if (indices.shape != gy.shape) throw std::runtime_error("max_pool2d_backward: indices and gradient shapes differ.");
+            const std::ptrdiff_t planes = static_cast<std::ptrdiff_t>(e.N * e.C);
+            #pragma omp parallel for schedule(static) if(gy.data.size() > pool_parallel_threshold)
+            for (std::ptrdiff_t pl = 0; pl < planes; ++pl) {
+                const std::size_t n = static_cast<std::size_t>(pl) / e.C, ch = static_cast<std::size_t>(pl) % e.C;
+                T* dst = dx.data.data() + n * d.sn + ch * d.sc;
+                const std::size_t base = n * e.sn + ch * e.sc;
+                for (std::size_t oh = 0; oh < e.H; ++oh)
+                    for (std::size_t ow = 0; ow < e.W; ++ow) {
+                        const std::size_t off = base + oh * e.sh + ow * e.sw;
+                        const std::size_t idx = indices.data[off];
+                        dst[(idx / d.W) * d.sh + (idx % d.W) * d.sw] += gy.data[off];
+                    }
+            }
+        }
+
+        template <typename T>
+        void avg_pool_backward_accumulate(const Tensor<T>& gy, const Pool2dOptions& opts, Tensor<T>& dx) {
+            const Dims4 d = dims4(dx, opts.layout, "avg_pool2d_backward");
+            const Dims4 e = dims4(gy, opts.layout, "avg_pool2d_backward");
+            const PoolGeometry g = pool_geometry(d, opts);
+            if (e.H != g.OH || e.W != g.OW) throw std::runtime_error("avg_pool2d_backward: gradient shape does not match the pooling geometry.");
+            const std::ptrdiff_t planes = static_cast<std::ptrdiff_t>(e.N * e.C);
+            #pragma omp parallel for schedule(static) if(gy.data.size() > pool_parallel_threshold)
+            for (std::ptrdiff_t pl = 0; pl < planes; ++pl) {
+                const std::size_t n = static_cast<std::size_t>(pl) / e.C, ch = static_cast<std::size_t>(pl) % e.C;
+                T* dst = dx.data.data() + n * d.sn + ch * d.sc;
+                const T* src = gy.data.data() + n * e.sn + ch * e.sc;
+                for (std::size_t oh = 0; oh < g.OH; ++oh) {
+                    std::size_t h0, h1;
+                    window(oh, g.SH, g.PH, g.KH, d.H, h0, h1);
+                    for (std::size_t ow = 0; ow < g.OW; ++ow) {
+                        std::size_t w0, w1;
+                        window(ow, g.SW, g.PW, g.KW, d.W, w0, w1);
+                        const std::size_t count = opts.count_include_pad ? g.KH * g.KW : (h1 - h0) * (w1 - w0);
+                        const T v = src[oh * e.sh + ow * e.sw] / static_cast<T>(count);
+                        for (std::size_t h = h0; h < h1; ++h)
+                            for (std::size_t w = w0; w < w1; ++w) dst[h * d.sh + w * d.sw] += v;
+                    }
+                }
+            }
+        }
+
+    } // namespace detail
+
+
+    // --- Pooling ---
+
+    template <typename T>
+    MaxPoolResult<T> max_pool2d_with_indices(const Tensor<T>& x, const Pool2dOptions& opts = {}) {
+        const detail::Dims4 d = detail::dims4(x, opts.layout, "max_pool2d");
+        const detail::PoolGeometry g = detail::pool_geometry(d, opts);
+        const auto out_shape = detail::shape4(d.N, d.C, g.OH, g.OW, opts.layout);
+        MaxPoolResult<T> r{Tensor<T>(out_shape), Tensor<std::size_t>(out_shape)};
+        const detail::Dims4 e = detail::dims4(r.output, opts.layout, "max_pool2d");
+        const T* xs = x.data.data();
+        T* ys = r.output.data.data();
+        std::size_t* is = r.indices.data.data();
+
+        if (opts.layout == Layout::NHWC) {
+            const std::ptrdiff_t jobs = static_cast<std::ptrdiff_t>(d.N * g.OH);
+            #pragma omp parallel for schedule(static) if(r.output.data.size() > detail::pool_parallel_threshold)
+            for (std::ptrdiff_t job = 0; job < jobs; ++job) {
+                const std::size_t n = static_cast<std::size_t>(job) / g.OH, oh = static_cast<std::size_t>(job) % g.OH;
+                std::size_t h0, h1;
+                detail::window(oh, g.SH, g.PH, g.KH, d.H, h0, h1);
+                for (std::size_t ow = 0; ow < g.OW; ++ow) {
+                    std::size_t w0, w1;
+                    detail::window(ow, g.SW, g.PW, g.KW, d.W, w0, w1);
+                    T* out = ys + n * e.sn + oh * e.sh + ow * e.sw;
+                    std::size_t* idx = is + n * e.sn + oh * e.sh + ow * e.sw;
+                    for (std::size_t c = 0; c < d.C; ++c) { out[c * e.sc] = detail::lowest<T>(); idx[c * e.sc] = h0 * d.W + w0; }
+                    for (std::size_t h = h0; h < h1; ++h)
+                        for (std::size_t w = w0; w < w1; ++w) {
+                            const T* src = xs + n * d.sn + h * d.sh + w * d.sw;
+                            const std::size_t flat = h * d.W + w;
+                            #pragma omp simd
+                            for (std::size_t c = 0; c < d.C; ++c) {
+                                const T v = src[c * d.sc];
+                                const bool better = v > out[c * e.sc];
+                                out[c * e.sc] = better ? v : out[c * e.sc];
+                                idx[c * e.sc] = better ? flat : idx[c * e.sc];
+                            }
+                        }
+                }
+            }
+            return r;
+        }
+
+        const std::ptrdiff_t planes = static_cast<std::ptrdiff_t>(d.N * d.C);
+        #pragma omp parallel for schedule(static) if(r.output.data.size() > detail::pool_parallel_threshold)
+        for (std::ptrdiff_t pl = 0; pl < planes; ++pl) {
+            const std::size_t n = static_cast<std::size_t>(pl) / d.C, c = static_cast<std::size_t>(pl) % d.C;
+            const T* src = xs + n * d.sn + c * d.sc;
+            const std::size_t base = n * e.sn + c * e.sc;
+            for (std::size_t oh = 0; oh < g.OH; ++oh) {
+                std::size_t h0, h1;
+                detail::window(oh, g.SH, g.PH, g.KH, d.H, h0, h1);
+                for (std::size_t ow = 0; ow < g.OW; ++ow) {
+                    std::size_t w0, w1;
+                    detail::window(ow, g.SW, g.PW, g.KW, d.W, w0, w1);
+                    T best = detail::lowest<T>();
+                    std::size_t arg = h0 * d.W + w0;
+                    for (std::size_t h = h0; h < h1; ++h)
+                        for (std::size_t w = w0; w < w1; ++w) {
+                            const T v = src[h * d.sh + w * d.sw];
+                            if (v > best) { best = v; arg = h * d.W + w; }
+                        }
+                    ys[base + oh * e.sh + ow * e.sw] = best;
+                    is[base + oh * e.sh + ow * e.sw] = arg;
+                }
+            }
+        }
+        return r;
+    }
+
+    template <typename T>
+    Tensor<T> max_pool2d(const Tensor<T>& x, const Pool2dOptions& opts = {}) {
+        return max_pool2d_with_indices(x, opts).output;
+    }
+
+    // Routes each output gradient to the input position recorded in indices.
+    template <typename T>
+    Tensor<T> max_pool2d_backward(const Tensor<T>& grad_out, const Tensor<std::size_t>& indices,
+                                  const std::vector<std::size_t>& input_shape, Layout layout = Layout::NCHW) {
+        Tensor<T> dx(input_shape);
+        detail::max_pool_backward_accumulate(grad_out, indices, layout, dx);
+        return dx;
+    }
+
+    template <typename T>
+    Tensor<T> avg_pool2d(const Tensor<T>& x, const Pool2dOptions& opts = {}) {
+        const detail::Dims4 d = detail::dims4(x, opts.layout, "avg_pool2d");
+        const detail::PoolGeometry g = detail::pool_geometry(d, opts);
+        Tensor<T> y(detail::shape4(d.N, d.C, g.OH, g.OW, opts.layout));
+        const detail::Dims4 e = detail::dims4(y, opts.layout, "avg_pool2d");
+        const T* xs = x.data.data();
+        T* ys = y.data.data();
+
+        if (opts.layout == Layout::NHWC) {
+            const std::ptrdiff_t jobs = static_cast<std::ptrdiff_t>(d.N * g.OH);
+            #pragma omp parallel for schedule(static) if(y.data.size() > detail::pool_parallel_threshold)
+            for (std::ptrdiff_t job = 0; job < jobs; ++job) {
+                const std::size_t n = static_cast<std::size_t>(job) / g.OH, oh = static_cast<std::size_t>(job) % g.OH;
+                std::size_t h0, h1;
+                detail::window(oh, g.SH, g.PH, g.KH, d.H, h0, h1);
+                for (std::size_t ow = 0; ow < g.OW; ++ow) {
+                    std::size_t w0, w1;
+                    detail::window(ow, g.SW, g.PW, g.KW, d.W, w0, w1);
+                    const std::size_t count = opts.count_include_pad ? g.KH * g.KW : (h1 - h0) * (w1 - w0);
+                    const T inv = static_cast<T>(1) / static_cast<T>(count);
+                    T* out = ys + n * e.sn + oh * e.sh + ow * e.sw;
+                    for (std::size_t h = h0; h < h1; ++h)
+                        for (std::size_t w = w0; w < w1; ++w) {
+                            const T* src = xs + n * d.sn + h * d.sh + w * d.sw;
+                            #pragma omp simd
+                            for (std::size_t c = 0; c < d.C; ++c) out[c * e.sc] += src[c * d.sc];
+                        }
+                    #pragma omp simd
+                    for (std::size_t c = 0; c < d.C; ++c) out[c * e.sc] *= inv;
+                }
+            }
+            return y;
+        }
+
+        const std::ptrdiff_t planes = static_cast<std::ptrdiff_t>(d.N * d.C);
+        #pragma omp parallel for schedule(static) if(y.data.size() > detail::pool_parallel_threshold)
+        for (std::ptrdiff_t pl = 0; pl < planes; ++pl) {
+            const std::size_t n = static_cast<std::size_t>(pl) / d.C, c = static_cast<std::size_t>(pl) % d.C;
+            const T* src = xs + n * d.sn + c * d.sc;
+            T* dst = ys + n * e.sn + c * e.sc;
+            for (std::size_t oh = 0; oh < g.OH; ++oh) {
+                std::size_t h0, h1;
+                detail::window(oh, g.SH, g.PH, g.KH, d.H, h0, h1);
+                for (std::size_t ow = 0; ow < g.OW; ++ow) {
+                    std::size_t w0, w1;
+                    detail::window(ow, g.SW, g.PW, g.KW, d.W, w0, w1);
+                    T acc = static_cast<T>(0);
+                    for (std::size_t h = h0; h < h1; ++h) {
+                        const T* row = src + h * d.sh;
+                        #pragma omp simd reduction(+:acc)
+                        for (std::size_t w = w0; w < w1; ++w) acc += row[w * d.sw];
+                    }
+                    const std::size_t count = opts.count_include_pad ? g.KH * g.KW : (h1 - h0) * (w1 - w0);
+                    dst[oh * e.sh + ow * e.sw] = acc / static_cast<T>(count);
+                }
+            }
+        }
+        return y;
+    }
+
+    template <typename T>
+    Tensor<T> avg_pool2d_backward(const Tensor<T>& grad_out, const std::vector<std::size_t>& input_shape,
+                                  const Pool2dOptions& opts = {}) {
+        Tensor<T> dx(input_shape);
+        detail::avg_pool_backward_accumulate(grad_out, opts, dx);
+        return dx;
+    }
+
+    // Mean over H and W: [N, C, 1, 1] (NCHW) or [N, 1, 1, C] (NHWC).
+    template <typename T>
+    Tensor<T> global_avg_pool2d(const Tensor<T>& x, Layout layout = Layout::NCHW) {
+        const detail::Dims4 d = detail::dims4(x, layout, "global_avg_pool2d");
+        if (d.H * d.W == 0) throw std::runtime_error("global_avg_pool2d: empty spatial extent.");
+        Tensor<T> y(detail::shape4(d.N, d.C, 1, 1, layout));
+        const T inv = static_cast<T>(1) / static_cast<T>(d.H * d.W);
+        const T* xs = x.data.data();
+
+        if (layout == Layout::NHWC) {
+            const std::ptrdiff_t N = static_cast<std::ptrdiff_t>(d.N);
+            #pragma omp parallel for schedule(static) if(x.data.size() > detail::pool_parallel_threshold)
+            for (std::ptrdiff_t nn_ = 0; nn_ < N; ++nn_) {
+                const std::size_t n = static_cast<std::size_t>(nn_);
+                T* out = y.data.data() + n * d.C;
+                for (std::size_t h = 0; h < d.H; ++h)
+                    for (std::size_t w = 0; w < d.W; ++w) {
+                        const T* src = xs + n * d.sn + h * d.sh + w * d.sw;
+                        #pragma omp simd
+                        for (std::size_t c = 0; c < d.C; ++c) out[c] += src[c * d.sc];
+                    }
+                for (std::size_t c = 0; c < d.C; ++c) out[c] *= inv;
+            }
+            return y;
+        }
+
+        const std::ptrdiff_t planes = static_cast<std::ptrdiff_t>(d.N * d.C);
+        #pragma omp parallel for schedule(static) if(x.data.size() > detail::pool_parallel_threshold)
+        for (std::ptrdiff_t pl = 0; pl < planes; ++pl) {
+            const std::size_t n = static_cast<std::size_t>(pl) / d.C, c = static_cast<std::size_t>(pl) % d.C;
+            const T* src = xs + n * d.sn + c * d.sc;
+            T acc = static_cast<T>(0);
+            for (std::size_t h = 0; h < d.H; ++h) {
+                const T* row = src + h * d.sh;
+                #pragma omp simd reduction(+:acc)
+                for (std::size_t w = 0; w < d.W; ++w) acc += row[w * d.sw];
+            }
+            y.data[static_cast<std::size_t>(pl)] = acc * inv;
+        }
+        return y;
+    }
+
+    template <typename T>
+    Tensor<T> global_avg_pool2d_backward(const Tensor<T>& grad_out, const std::vector<std::size_t>& input_shape,
+                                         Layout layout = Layout::NCHW) {
+        Tensor<T> dx(input_shape);
+        const detail::Dims4 d = detail::dims4(dx, layout, "global_avg_pool2d_backward");
+        if (grad_out.data.size() != d.N * d.C) throw std::runtime_error("global_avg_pool2d_backward: gradient shape mismatch.");
+        Pool2dOptions opts;
+        opts.kernel = {d.H, d.W};
+        opts.layout = layout;
+        detail::avg_pool_backward_accumulate(grad_out, opts, dx);
+        return dx;
+    }
+
+    // --- Upsampling ---
+
+    // Nearest neighbour: output (h, w) reads input (h * H / OH, w * W / OW).
+    template <typename T>
+    Tensor<T> upsample_nearest2d(const Tensor<T>& x, std::array<std::size_t, 2> size, Layout layout = Layout::NCHW) {
+        const detail::Dims4 d = detail::dims4(x, layout, "upsample_nearest2d");
+        if (size[0] == 0 || size[1] == 0 || d.H == 0 || d.W == 0) throw std::runtime_error("upsample_nearest2d: empty size.");
+        Tensor<T> y(detail::shape4(d.N, d.C, size[0], size[1], layout));
+        detail::resample(x, layout, detail::nearest_taps<T>(d.H, size[0]), detail::nearest_taps<T>(d.W, size[1]), y);
+        return y;
+    }
+
+    // Bilinear with half-pixel centres, or corner-aligned sampling when align_corners is set.
+    template <typename T>
+    Tensor<T> upsample_bilinear2d(const Tensor<T>& x, std::array<std::size_t, 2> size, bool align_corners = false,
+                                  Layout layout = Layout::NCHW) {
+        const detail::Dims4 d = detail::dims4(x, layout, "upsample_bilinear2d");
+        if (size[0] == 0 || size[1] == 0 || d.H == 0 || d.W == 0) throw std::runtime_error("upsample_bilinear2d: empty size.");
+        Tensor<T> y(detail::shape4(d.N, d.C, size[0], size[1], layout));
+        detail::resample(x, layout, detail::bilinear_taps<T>(d.H, size[0], align_corners),
+                         detail::bilinear_taps<T>(d.W, size[1], align_corners), y);
+        return y;
+    }
+
+} // namespace nn
+
+
+namespace autograd {
+
+    template <typename T>
+    Var<T> max_pool2d(const Var<T>& x, const nn::Pool2dOptions& opts = {}) {
+        auto r = nn::max_pool2d_with_indices(x.value(), opts);
+        return x.tape()->record(std::move(r.output), {x},
+            [x, idx = std::move(r.indices), layout = opts.layout](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+                nn::detail::max_pool_backward_accumulate(g, idx, layout, tp.grad_buffer(x.id()));
+            });
+    }
+
+    template <typename T>
+    Var<T> avg_pool2d(const Var<T>& x, const nn::Pool2dOptions& opts = {}) {
+        return x.tape()->record(nn::avg_pool2d(x.value(), opts), {x},
+            [x, opts](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+                nn::detail::avg_pool_backward_accumulate(g, opts, tp.grad_buffer(x.id()));
+            });
+    }
+
+    template <typename T>
+    Var<T> global_avg_pool2d(const Var<T>& x, nn::Layout layout = nn::Layout::NCHW) {
+        return x.tape()->record(nn::global_avg_pool2d(x.value(), layout), {x},
+            [x, layout](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+                Tensor<T>& dx = tp.grad_buffer(x.id());
+                const nn::detail::Dims4 d = nn::detail::dims4(dx, layout, "global_avg_pool2d");
+                nn::Pool2dOptions opts;
+                opts.kernel = {d.H, d.W};
+                opts.layout = layout;
+                nn::detail::avg_pool_backward_accumulate(g, opts, dx);
+            });
+    }
+
+    template <typename T>
+    Var<T> upsample_nearest2d(const Var<T>& x, std::array<std::size_t, 2> size, nn::Layout layout = nn::Layout::NCHW) {
+        return x.tape()->record(nn::upsample_nearest2d(x.value(), size, layout), {x},
+            [x, layout](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+                Tensor<T>& dx = tp.grad_buffer(x.id());
+                const nn::detail::Dims4 d = nn::detail::dims4(dx, layout, "upsample_nearest2d");
+                const nn::detail::Dims4 e = nn::detail::dims4(g, layout, "upsample_nearest2d");
+                nn::detail::resample_backward(g, layout, nn::detail::nearest_taps<T>(d.H, e.H),
+                                              nn::detail::nearest_taps<T>(d.W, e.W), dx);
+            });
+    }
+
+    template <typename T>
+    Var<T> upsample_bilinear2d(const Var<T>& x, std::array<std::size_t, 2> size, bool align_corners = false,
+                               nn::Layout layout = nn::Layout::NCHW) {
+        return x.tape()->record(nn::upsample_bilinear2d(x.value(), size, align_corners, layout), {x},
+            [x, align_corners, layout](Tape<T>& tp, const Tensor<T>&, const Tensor<T>& g) {
+                Tensor<T>& dx = tp.grad_buffer(x.id());
+                const nn::detail::Dims4 d = nn::detail::dims4(dx, layout, "upsample_bilinear2d");
+                const nn::detail::Dims4 e = nn::detail::dims4(g, layout, "upsample_bilinear2d");
+                nn::detail::resample_backward(g, layout, nn::detail::bilinear_taps<T>(d.H, e.H, align_corners),
+                                              nn::detail::bilinear_taps<T>(d.W, e.W, align_corners), dx);
+            });
+    }
+
+} // namespace autograd
+} // namespace tl
@@ -0,0 +1,489 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <functional>
+#include <limits>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Explicit Runge-Kutta integrators for y' = f(t, y) with Tensor<T> state.
+//
+// The right-hand side is any callable
+//     void f(T t, const Tensor<T>& y, Tensor<T>& dydt)
+// writing into a preallocated dydt of the same shape as y.
+//
+//   RK4             : classic fixed-step fourth-order method
+//   DormandPrince45 : adaptive 5(4) pair with FSAL and 4th-order dense output
+//   rk4_batch / solve_ivp_batch : many independent systems stored as the rows
+//                     of a [B, ...] tensor, integrated in parallel.  For the
+//                     batched forms f may also take the system index first:
+//                     void f(std::size_t b, T t, const Tensor<T>& y, Tensor<T>& dydt).
+//
+// Integrators own their stage buffers, which are allocated once and reused for
+// every step; stage combinations ("y + h * sum a_j k_j") and the error norm are
+// computed in single fused passes rather than chains of Tensor temporaries.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace ode {
+
+    template <typename T>
+    struct ODEOptions {
+        T rtol = static_cast<T>(1e-6);
+        T atol = static_cast<T>(1e-9);
+        T first_step = static_cast<T>(0);                        // 0 = choose automatically
+        T max_step = std::numeric_limits<T>::infinity();
+        T min_step = static_cast<T>(0);
+        std::size_t max_steps = 100000;
+        bool dense_output = false;                               // keep a continuous solution
+        std::function<void(T, const Tensor<T>&)> observer;       // called after every accepted step
+    };
+
+
+    // Piecewise-quartic continuous solution recorded by DormandPrince45.
+    template <typename T>
+    class DenseSolution {
+    public:
+        bool empty() const { return t_.empty(); }
+        std::size_t segments() const { return h_.size(); }
+        T t_begin() const { return t_.empty() ? static_cast<T>(0) : t_.front(); }
+        T t_end() const { return t_.empty() ? static_cast<T>(0) : t_.back(); }
+
+        // Evaluates y(t) into out (resized to the state shape if needed).
+        void eval(T t, Tensor<T>& out) const {
+            if (empty()) throw std::runtime_error("DenseSolution is empty.");
+            const T lo = std::min(t_begin(), t_end()), hi = std::max(t_begin(), t_end());
+            if (t < lo || t > hi) {
+                throw std::out_of_range("DenseSolution: t = " + std::to_string(t) + " outside the integrated interval.");
+            }
+            // Segments are ordered along the direction of integration.
+            const bool forward = t_end() >= t_begin();
+            std::size_t s = 0;
+            if (forward) s = std::upper_bound(t_.begin(), t_.end(), t) - t_.begin();
+            else         s = std::upper_bound(t_.begin(), t_.end(), t, std::greater<T>()) - t_.begin();
+            s = std::min(std::max<std::size_t>(s, 1), h_.size()) - 1;
+
+            if (out.shape != shape_) out = Tensor<T>(shape_);
+            const T theta = (t - t_[s]) / h_[s];
+            const T theta1 = static_cast<T>(1) - theta;
+            const std::size_t n = out.data.size();
+            const T* r = coeffs_.data() + s * 5 * n;
+            T* o = out.data.data();
+            #pragma omp simd
+            for (std::size_t i = 0; i < n; ++i)
+                o[i] = r[i] + theta * (r[n + i] + theta1 * (r[2 * n + i] + theta * (r[3 * n + i] + theta1 * r[4 * n + i])));
+        }
+
+        Tensor<T> operator()(T t) const {
+            Tensor<T> out(shape_);
+            eval(t, out);
+            return out;
+        }
+
+    private:
+        template <typename> friend class DormandPrince45;
+
+        std::vector<std::size_t> shape_;
+        std::vector<T> t_;        // segment start times, plus the final time
+        std::vector<T> h_;        // signed step of each segment
+        std::vector<T> coeffs_;   // 5 * n coefficients per segment
+    };
+
+
+    template <typename T>
+    struct ODEResult {
+        bool success = false;
+        T t = static_cast<T>(0);          // time reached
+        std::size_t steps = 0;            // accepted steps
+        std::size_t rejected = 0;
+        std::size_t fevals = 0;
+        std::string message;
+        DenseSolution<T> dense;           // filled when ODEOptions::dense_output is set
+    };
+
+
+    namespace detail {
+
+        constexpr std::size_t ode_parallel_threshold = 1 << 15;
+
+        // out = y + h * sum_j a[j] * k[j], one pass over memory.  out may be y itself
+        // (RK4's final stage), so neither is restrict; each i reads y[i] before writing out[i].
+        template <typename T, std::size_t S>
+        inline void combine(T* out, const T* y, T h,
+                            const std::array<T, S>& a, const std::array<const T*, S>& k, std::size_t n) {
+            std::array<T, S> ha;
+            for (std::size_t j = 0; j < S; ++j) ha[j] = h * a[j];
+            #pragma omp parallel for simd if(n > ode_parallel_threshold)
+            for (std::size_t i = 0; i < n; ++i) {
+                T acc = y[i];
+                for (std::size_t j = 0; j < S; ++j) acc += ha[j] * k[j][i];
+                out[i] = acc;
+            }
+        }
+
+        template <typename T>
+        inline void resize_like(Tensor<T>& buf, const std::vector<std::size_t>& shape) {
+            if (buf.shape != shape) buf = Tensor<T>(shape);
+        }
+
+        // Scaled RMS norm used for step-size control.
+        template <typename T>
+        T rms_scaled(const T* v, const T* y, T atol, T rtol, std::size_t n) {
+            T acc = static_cast<T>(0);
+            #pragma omp parallel for simd reduction(+:acc) if(n > ode_parallel_threshold)
+            for (std::size_t i = 0; i < n; ++i) {
+                const T sc = atol + rtol * std::abs(y[i]);
+                const T e = v[i] / sc;
+                acc += e * e;
+            }
+            return n ? std::sqrt(acc / static_cast<T>(n)) : static_cast<T>(0);
+        }
+
+        // Hairer & Wanner's starting step heuristic for a method of the given order.
+        // f0 = f(t, y); y1 and f1 are scratch buffers of the state shape.
+        template <typename T, typename F>
+        T select_initial_step(F& f, T t, const Tensor<T>& y, const Tensor<T>& f0, T dir, int order,
+                              const ODEOptions<T>& opts, Tensor<T>& y1, Tensor<T>& f1, std::size_t& fevals) {
+            const std::size_t n = y.data.size();
+            const T d0 = rms_scaled(y.data.data(), y.data.data(), opts.atol, opts.rtol, n);
+            const T d1 = rms_scaled(f0.data.data(), y.data.data(), opts.atol, opts.rtol, n);
+            T h0 = (d0 < T(1e-5) || d1 < T(1e-5)) ? T(1e-6) : T(0.01) * d0 / d1;
+            h0 = std::min(h0, opts.max_step);
+
+            combine<T, 1>(y1.data.data(), y.data.data(), dir * h0, {1}, {f0.data.data()}, n);
+            f(t + dir * h0, y1, f1);
+            ++fevals;
+            T* diff = y1.data.data();
+            for (std::size_t i = 0; i < n; ++i) diff[i] = f1.data[i] - f0.data[i];
+            const T d2 = rms_scaled(diff, y.data.data(), opts.atol, opts.rtol, n) / h0;
+
+            const T dmax = std::max(d1, d2);
+            const T h1 = dmax <= T(1e-15) ? std::max(T(1e-6), h0 * T(1e-3))
+                                          : std::pow(T(0.01) / dmax, static_cast<T>(1) / static_cast<T>(order + 1));
+            return std::min({T(100) * h0, h1, opts.max_step});
+        }
+
+        // Calls a batched right-hand side, forwarding the system index if it accepts one.
+        template <typename T, typename F>
+        inline void call_batched(F& f, std::size_t b, T t, const Tensor<T>& y, Tensor<T>& dy) {
+            if constexpr (std::is_invocable_v<F&, std::size_t, T, const Tensor<T>&, Tensor<T>&>) f(b, t, y, dy);
+            else f(t, y, dy);
+        }
+
+        template <typename T>
+        void check_batch(const Tensor<T>& Y) {
+            if (Y.shape.size() < 2) {
+                throw std::runtime_error("Batched integration expects a [B, ...] tensor with one system per row.");
+            }
+        }
+
+        // Shared by the serial integrators and the batched drivers, which must check before
+        // their parallel regions: an exception cannot leave an OpenMP region.
+        inline void check_steps(std::size_t steps) {
+            if (steps == 0) throw std::runtime_error("RK4::integrate requires at least one step.");
+        }
+
+        template <typename T>
+        void check_tolerances(const ODEOptions<T>& opts) {
+            if (opts.rtol <= static_cast<T>(0) && opts.atol <= static_cast<T>(0)) {
+                throw std::runtime_error("DormandPrince45: rtol and atol cannot both be zero.");
+            }
+        }
+
+    } // namespace detail
+
+
+    // --- Classic RK4 ---
+
+    template <typename T>
+    class RK4 {
+    public:
+        RK4() = default;
+        explicit RK4(const std::vector<std::size_t>& shape) { allocate(shape); }
+
+        // Advances y from t to t + h in place.
+        template <typename F>
+        void step(F& f, T t, Tensor<T>& y, T h) {
+            allocate(y.shape);
+            const std::size_t n = y.data.size();
+            const T* yp = y.data.data();
+            const T half = h / static_cast<T>(2);
+
+            f(t, y, k1_);
+            detail::combine<T, 1>(tmp_.data.data(), yp, half, {1}, {k1_.data.data()}, n);
+            f(t + half, tmp_, k2_);
+            detail::combine<T, 1>(tmp_.data.data(), yp, half, {1}, {k2_.data.data()}, n);
+            f(t + half, tmp_, k3_);
+            detail::combine<T, 1>(tmp_.data.data(), yp, h, {1}, {k3_.data.data()}, n);
+            f(t + h, tmp_, k4_);
+
+            const T sixth = static_cast<T>(1) / static_cast<T>(6);
+            const T third = static_cast<T>(1) / static_cast<T>(3);
+            detail::combine<T, 4>(y.data.data(), yp, h, {sixth, third, third, sixth},
+                                  {k1_.data.data(), k2_.data.data(), k3_.data.data(), k4_.data.data()}, n);
+        }
+
+        // Integrates from t0 to t1 in `steps` equal steps.
+        template <typename F>
+        ODEResult<T> integrate(F f, T t0, T t1, Tensor<T>& y, std::size_t steps,
+                               const std::function<void(T, const Tensor<T>&)>& observer = {}) {
+            detail::check_steps(steps);
+            ODEResult<T> res;
+            const T h = (t1 - t0) / static_cast<T>(steps);
+            for (std::size_t s = 0; s < steps; ++s) {
+                const T t = t0 + static_cast<T>(s) * h;
+                step(f, t, y, h);
+                if (observer) observer(t + h, y);
+            }
+            res.success = true;
+            res.t = t1;
+            res.steps = steps;
+            res.fevals = 4 * steps;
+            return res;
+        }
+
+    private:
+        Tensor<T> k1_{std::vector<std::size_t>{0}}, k2_{std::vector<std::size_t>{0}},
+                  k3_{std::vector<std::size_t>{0}}, k4_{std::vector<std::size_t>{0}},
+                  tmp_{std::vector<std::size_t>{0}};
+
+        void allocate(const std::vector<std::size_t>& shape) {
+            for (Tensor<T>* b : {&k1_, &k2_, &k3_, &k4_, &tmp_}) detail::resize_like(*b, shape);
+        }
+    };
+
+
+    // --- Dormand-Prince 5(4) ---
+
+    template <typename T>
+    class DormandPrince45 {
+    public:
+        DormandPrince45() = default;
+        explicit DormandPrince45(const std::vector<std::size_t>& shape) { allocate(shape); }
+
+        template <typename F>
+        ODEResult<T> integrate(F f, T t0, T t1, Tensor<T>& y, const ODEOptions<T>& opts = {}) {
+            allocate(y.shape);
+            ODEResult<T> res;
+            res.t = t0;
+            const T dir = t1 >= t0 ? static_cast<T>(1) : static_cast<T>(-1);
+            detail::check_tolerances(opts);
+            if (opts.dense_output) {
+                res.dense.shape_ = y.shape;
+                res.dense.t_.push_back(t0);
+            }
+            if (t0 == t1) { res.success = true; return res; }
+
+            T t = t0;
+            f(t, y, k_[0]);
+            ++res.fevals;
+            T h = opts.first_step > static_cast<T>(0)
+                ? opts.first_step
+                : detail::select_initial_step(f, t, y, k_[0], dir, 4, opts, y_stage_, k_[1], res.fevals);
+            bool last_rejected = false;
+
+            while (dir * (t1 - t) > static_cast<T>(0)) {
+                if (res.steps + res.rejected >= opts.max_steps) {
+                    res.message = "maximum number of steps reached";
+                    break;
+                }
+                h = std::min({h, opts.max_step, std::abs(t1 - t)});
+                const T hs = dir * h;
+                const T err = attempt(f, t, y, hs, opts, res);
+
+                if (err <= static_cast<T>(1)) {
+                    if (opts.dense_output) record_dense(res.dense, y, hs);
+                    t = (std::abs(t1 - (t + hs)) <= std::abs(hs) * static_cast<T>(1e-12)) ? t1 : t + hs;
+                    y.data.swap(y_new_.data);
+                    k_[0].data.swap(k_[6].data);   // FSAL: f(t + h, y_new) is the next k1
+                    ++res.steps;
+                    if (opts.dense_output) res.dense.t_.push_back(t);
+                    if (opts.observer) opts.observer(t, y);
+
+                    T fac = err == static_cast<T>(0) ? static_cast<T>(10)
+                                                     : static_cast<T>(0.9) * std::pow(err, static_cast<T>(-0.2));
+                    fac = std::min(std::max(fac, static_cast<T>(0.2)), static_cast<T>(10));
+                    if (last_rejected) fac = std::min(fac, static_cast<T>(1));
+                    h *= fac;
+                    last_rejected = false;
+                } else {
+                    ++res.rejected;
+                    h *= std::max(static_cast<T>(0.2), static_cast<T>(0.9) * std::pow(err, static_cast<T>(-0.2)));
+                    last_rejected = true;
+                    if (h < opts.min_step || h <= std::abs(t) * std::numeric_limits<T>::epsilon()) {
+                        res.message = "step size fell below the minimum";
+                        break;
+                    }
+                }
+            }
+            res.t = t;
+            res.success = (t == t1);
+            return res;
+        }
+
+    private:
+        std::array<Tensor<T>, 7> k_{Tensor<T>(std::vector<std::size_t>{0}), Tensor<T>(std::vector<std::size_t>{0}),
+                                    Tensor<T>(std::vector<std::size_t>{0}), Tensor<T>(std::vector<std::size_t>{0}),
+                                    Tensor<T>(std::vector<std::size_t>{0}), Tensor<T>(std::vector<std::size_t>{0}),
+                                    Tensor<T>(std::vector<std::size_t>{0})};
+        Tensor<T> y_stage_{std::vector<std::size_t>{0}}, y_new_{std::vector<std::size_t>{0}};
+
+        void allocate(const std::vector<std::size_t>& shape) {
+            for (auto& k : k_) detail::resize_like(k, shape);
+            detail::resize_like(y_stage_, shape);
+            detail::resize_like(y_new_, shape);
+        }
+
+        const T* k(std::size_t i) const { return k_[i].data.data(); }
+
+        // One trial step of size h from (t, y); k_[0] must hold f(t, y).
+        // Leaves the 5th-order solution in y_new_, f(t + h, y_new_) in k_[6], and
+        // returns the scaled error norm.
+        template <typename F>
+        T attempt(F& f, T t, const Tensor<T>& y, T h, const ODEOptions<T>& opts, ODEResult<T>& res) {
+            const std::size_t n = y.data.size();
+            const T* yp = y.data.data();
+            T* ys = y_stage_.data.data();
+
+            detail::combine<T, 1>(ys, yp, h, {T(1) / 5}, {k(0)}, n);
+            f(t + h * T(1) / 5, y_stage_, k_[1]);
+            detail::combine<T, 2>(ys, yp, h, {T(3) / 40, T(9) / 40}, {k(0), k(1)}, n);
+            f(t + h * T(3) / 10, y_stage_, k_[2]);
+            detail::combine<T, 3>(ys, yp, h, {T(44) / 45, T(-56) / 15, T(32) / 9}, {k(0), k(1), k(2)}, n);
+            f(t + h * T(4) / 5, y_stage_, k_[3]);
+            detail::combine<T, 4>(ys, yp, h, {T(19372) / 6561, T(-25360) / 2187, T(64448) / 6561, T(-212) / 729},
+                                  {k(0), k(1), k(2), k(3)}, n);
+            f(t + h * T(8) / 9, y_stage_, k_[4]);
+            detail::combine<T, 5>(ys, yp, h, {T(9017) / 3168, T(-355) / 33, T(46732) / 5247, T(49) / 176, T(-5103) / 18656},
+                                  {k(0), k(1), k(2), k(3), k(4)}, n);
+            f(t + h, y_stage_, k_[5]);
+            detail::combine<T, 5>(y_new_.data.data(), yp, h, {T(35) / 384, T(500) / 1113, T(125) / 192, T(-2187) / 6784, T(11) / 84},
+                                  {k(0), k(2), k(3), k(4), k(5)}, n);
+            f(t + h, y_new_, k_[6]);
+            res.fevals += 6;
+
+            // Embedded error estimate and its scaled RMS norm in one pass.
+            const T e1 = T(71) / 57600, e3 = T(-71) / 16695, e4 = T(71) / 1920,
+                    e5 = T(-17253) / 339200, e6 = T(22) / 525, e7 = T(-1) / 40;
+            const T* k1 = k(0); const T* k3 = k(2); const T* k4 = k(3);
+            const T* k5 = k(4); const T* k6 = k(5); const T* k7 = k(6);
+            const T* yn = y_new_.data.data();
+            const T atol = opts.atol, rtol = opts.rtol;
+            T acc = static_cast<T>(0);
+            #pragma omp parallel for simd reduction(+:acc) if(n > detail::ode_parallel_threshold)
+            for (std::size_t i = 0; i < n; ++i) {
+                const T e = h * (e1 * k1[i] + e3 * k3[i] + e4 * k4[i] + e5 * k5[i] + e6 * k6[i] + e7 * k7[i]);
+                const T sc = atol + rtol * std::max(std::abs(yp[i]), std::abs(yn[i]));
+                acc += (e / sc) * (e / sc);
+            }
+            return n ? std::sqrt(acc / static_cast<T>(n)) : static_cast<T>(0);
+        }
+
+        // Appends the continuous-extension coefficients for the step (y -> y_new_).
+        void record_dense(DenseSolution<T>& d, const Tensor<T>& y, T h) {
+            const std::size_t n = y.data.size();
+            const std::size_t base = d.coeffs_.size();
+            d.coeffs_.resize(base + 5 * n);
+            d.h_.push_back(h);
+            T* r = d.coeffs_.data() + base;
+            const T d1 = T(-12715105075.0) / T(11282082432.0), d3 = T(87487479700.0) / T(32700410799.0),
+                    d4 = T(-10690763975.0) / T(1880347072.0),  d5 = T(701980252875.0) / T(199316789632.0),
+                    d6 = T(-1453857185.0) / T(822651844.0),    d7 = T(69997945.0) / T(29380423.0);
+            const T* yp = y.data.data();
+            const T* yn = y_new_.data.data();
+            const T* k1 = k(0); const T* k3 = k(2); const T* k4 = k(3);
+            const T* k5 = k(4); const T* k6 = k(5); const T* k7 = k(6);
+            #pragma omp simd
+            for (std::size_t i = 0; i < n; ++i) {
+                const T ydiff = yn[i] - yp[i];
+                const T bspl = h * k1[i] - ydiff;
+                r[i] = yp[i];
+                r[n + i] = ydiff;
+                r[2 * n + i] = bspl;
+                r[3 * n + i] = ydiff - h * k7[i] - bspl;
+                r[4 * n + i] = h * (d1 * k1[i] + d3 * k3[i] + d4 * k4[i] + d5 * k5[i] + d6 * k6[i] + d7 * k7[i]);
+            }
+        }
+    };
+
+
+    // --- Convenience front-ends ---
+
+    template <typename T, typename F>
+    ODEResult<T> solve_ivp(F f, T t0, T t1, Tensor<T>& y, const ODEOptions<T>& opts = {}) {
+        DormandPrince45<T> integrator(y.shape);
+        return integrator.integrate(f, t0, t1, y, opts);
+    }
+
+    template <typename T, typename F>
+    ODEResult<T> rk4(F f, T t0, T t1, Tensor<T>& y, std::size_t steps) {
+        RK4<T> integrator(y.shape);
+        return integrator.integrate(f, t0, t1, y, steps);
+    }
+
+
+    // --- Batched integration: row b of Y is an independent system ---
+
+    // Fixed-step RK4 on every system.  When f can evaluate the whole batch at once,
+    // calling rk4(f, t0, t1, Y, steps) on the full [B, ...] tensor is usually faster.
+    template <typename T, typename F>
+    void rk4_batch(F f, T t0, T t1, Tensor<T>& Y, std::size_t steps) {
+        detail::check_batch(Y);
+        detail::check_steps(steps);
+        const std::size_t B = Y.shape[0];
+        const std::vector<std::size_t> sys_shape(Y.shape.begin() + 1, Y.shape.end());
+        const std::size_t n = Y.strides[0];
+
+        #pragma omp parallel
+        {
+            RK4<T> integrator(sys_shape);
+            Tensor<T> y(sys_shape);
+            #pragma omp for schedule(static)
+            for (std::ptrdiff_t b = 0; b < static_cast<std::ptrdiff_t>(B); ++b) {
+                const std::size_t bi = static_cast<std::size_t>(b);
+                std::copy(Y.data.begin() + bi * n, Y.data.begin() + (bi + 1) * n, y.data.begin());
+                auto rhs = [&f, bi](T t, const Tensor<T>& yy, Tensor<T>& dy) { detail::call_batched(f, bi, t, yy, dy); };
+                integrator.integrate(rhs, t0, t1, y, steps);
+                std::copy(y.data.begin(), y.data.end(), Y.data.begin() + bi * n);
+            }
+        }
+    }
+
+    // Adaptive Dormand-Prince on every system, each with its own step-size history.
+    template <typename T, typename F>
+    std::vector<ODEResult<T>> solve_ivp_batch(F f, T t0, T t1, Tensor<T>& Y, const ODEOptions<T>& opts = {}) {
+        detail::check_batch(Y);
+        detail::check_tolerances(opts);
+        const std::size_t B = Y.shape[0];
+        const std::vector<std::size_t> sys_shape(Y.shape.begin() + 1, Y.shape.end());
+        const std::size_t n = Y.strides[0];
+        std::vector<ODEResult<T>> results(B);
+        ODEOptions<T> local_opts = opts;
+        local_opts.observer = nullptr;   // per-step callbacks are not meaningful across threads
+
+        #pragma omp parallel
+        {
+            DormandPrince45<T> integrator(sys_shape);
+            Tensor<T> y(sys_shape);
+            #pragma omp for schedule(dynamic, 16)
+            for (std::ptrdiff_t b = 0; b < static_cast<std::ptrdiff_t>(B); ++b) {
+                const std::size_t bi = static_cast<std::size_t>(b);
+                std::copy(Y.data.begin() + bi * n, Y.data.begin() + (bi + 1) * n, y.data.begin());
+                auto rhs = [&f, bi](T t, const Tensor<T>& yy, Tensor<T>& dy) { detail::call_batched(f, bi, t, yy, dy); };
+                results[bi] = integrator.integrate(rhs, t0, t1, y, local_opts);
+                std::copy(y.data.begin(), y.data.end(), Y.data.begin() + bi * n);
+            }
+        }
+        return results;
+    }
+
+} // namespace ode
+} // namespace tl
@@ -0,0 +1,591 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include "../linalg/lu.hpp"
+#include "runge_kutta.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Implicit integrators for stiff systems y' = f(t, y).
+//
+//   BDF          : variable-order (1-5), quasi-constant step backward differentiation
+//                  formulas with a simplified Newton iteration (Shampine & Reichelt)
+//   Rosenbrock23 : L-stable Rosenbrock W-method of order 2 with a 3rd-order error
+//                  estimate (the ode23s pair); exact only up to the W-matrix, so the
+//                  Jacobian can be safely reused across steps
+//
+// Both keep the Jacobian J and the LU factors of the iteration matrix W = I - c J
+// between steps.  W is refactored only when the step size (or BDF order) moves c
+// by more than StiffOptions::refactor_threshold, or when the iteration degrades:
+// a Newton failure (BDF) or a rejected step (Rosenbrock) first refactors with the
+// current c, then re-evaluates J, and only then shrinks the step.
+//
+// The Jacobian is either supplied analytically,
+//     void jac(T t, const Tensor<T>& y, Tensor<T>& J)      // J is [n, n], row-major
+// or approximated by forward differences with columns evaluated in parallel, in
+// which case f must be safe to call concurrently from several threads.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace ode {
+
+    template <typename T>
+    struct StiffOptions : ODEOptions<T> {
+        std::size_t max_newton_iter = 4;
+        T refactor_threshold = static_cast<T>(0.3);   // relative change in c that forces a new LU
+        bool autonomous = false;                      // skip the df/dt term (Rosenbrock)
+    };
+
+    template <typename T>
+    struct StiffResult : ODEResult<T> {
+        std::size_t jac_evals = 0;
+        std::size_t lu_decompositions = 0;
+        std::size_t newton_iterations = 0;
+    };
+
+
+    namespace detail {
+
+        // Forward-difference Jacobian J[i, j] = (f_i(y + d_j e_j) - f0_i) / d_j.
+        template <typename T, typename F>
+        void fd_jacobian(F& f, T t, const Tensor<T>& y, const Tensor<T>& f0, Tensor<T>& J,
+                         T threshold, std::size_t& fevals) {
+            const std::size_t n = y.data.size();
+            const T sqrt_eps = std::sqrt(std::numeric_limits<T>::epsilon());
+            T* Jp = J.data.data();
+
+            #pragma omp parallel if(n > 8)
+            {
+                Tensor<T> yp = y;
+                Tensor<T> fp(y.shape);
+                #pragma omp for schedule(static)
+                for (std::ptrdiff_t jj = 0; jj < static_cast<std::ptrdiff_t>(n); ++jj) {
+                    const std::size_t j = static_cast<std::size_t>(jj);
+                    const T yj = y.data[j];
+                    const T sgn = yj < static_cast<T>(0) ? static_cast<T>(-1) : static_cast<T>(1);
+                    volatile T probe = yj + sgn * sqrt_eps * std::max(std::abs(yj), threshold);
+                    const T d = probe - yj;   // exactly representable increment
+                    yp.data[j] = probe;
+                    f(t, yp, fp);
+                    yp.data[j] = yj;
+                    const T inv = static_cast<T>(1) / d;
+                    for (std::size_t i = 0; i < n; ++i) Jp[i * n + j] = (fp.data[i] - f0.data[i]) * inv;
+                }
+            }
+            fevals += n;
+        }
+
+        // Shared Jacobian / iteration-matrix cache.
+        template <typename T>
+        struct IterationMatrix {
+            Tensor<T> J{std::vector<std::size_t>{0}};
+            Tensor<T> W{std::vector<std::size_t>{0}};
+            linalg::LUDecomposition<T> lu;
+            T c = static_cast<T>(0);        // W = I - c J
+            bool factored = false;
+            bool jac_current = false;       // J was evaluated at the current step
+
+            void allocate(std::size_t n) {
+                if (J.shape != std::vector<std::size_t>{n, n}) {
+                    J = Tensor<T>({n, n});
+                    W = Tensor<T>({n, n});
+                }
+                factored = false;
+                jac_current = false;
+            }
+
+            bool needs_refactor(T c_new, T threshold) const {
+                return !factored || std::abs(c_new - c) > threshold * std::abs(c);
+            }
+
+            // Returns false if W is singular.
+            bool refactor(T c_new, StiffResult<T>& res) {
+                const std::size_t n = J.shape[0];
+                const T* Jp = J.data.data();
+                T* Wp = W.data.data();
+                #pragma omp simd
+                for (std::size_t k = 0; k < n * n; ++k) Wp[k] = -c_new * Jp[k];
+                for (std::size_t i = 0; i < n; ++i) Wp[i * n + i] += static_cast<T>(1);
+                c = c_new;
+                ++res.lu_decompositions;
+                factored = lu.try_factor(W);
+                return factored;
+            }
+
+            template <typename F, typename Jac>
+            void evaluate(F& f, Jac& jac, T t, const Tensor<T>& y, const Tensor<T>& fy,
+                          T threshold, StiffResult<T>& res) {
+                if constexpr (std::is_same_v<Jac, std::nullptr_t>) fd_jacobian(f, t, y, fy, J, threshold, res.fevals);
+                else jac(t, y, J);
+                ++res.jac_evals;
+                jac_current = true;
+                factored = false;
+            }
+        };
+
+        template <typename T>
+        T rms_weighted(const T* v, const T* scale, std::size_t n) {
+            T acc = static_cast<T>(0);
+            #pragma omp parallel for simd reduction(+:acc) if(n > ode_parallel_threshold)
+            for (std::size_t i = 0; i < n; ++i) {
+                const T e = v[i] / scale[i];
+                acc += e * e;
+            }
+            return n ? std::sqrt(acc / static_cast<T>(n)) : static_cast<T>(0);
+        }
+
+        template <typename T>
+        void check_stiff(const Tensor<T>& y, const StiffOptions<T>& opts) {
+            if (opts.dense_output) {
+                throw std::runtime_error("Stiff integrators do not provide dense output; use an observer instead.");
+            }
+            if (opts.rtol <= static_cast<T>(0) && opts.atol <= static_cast<T>(0)) {
+                throw std::runtime_error("Stiff integrator: rtol and atol cannot both be zero.");
+            }
+            if (y.data.empty()) throw std::runtime_error("Stiff integrator: empty state.");
+        }
+
+    } // namespace detail
+
+
+    // --- Variable-order BDF ---
+
+    template <typename T>
+    class BDF {
+    public:
+        static constexpr std::size_t max_order = 5;
+
+        template <typename F, typename Jac = std::nullptr_t>
+        StiffResult<T> integrate(F f, T t0, T t1, Tensor<T>& y, const StiffOptions<T>& opts = {}, Jac jac = nullptr) {
+            detail::check_stiff(y, opts);
+            StiffResult<T> res;
+            res.t = t0;
+            if (t0 == t1) { res.success = true; return res; }
+
+            n_ = y.data.size();
+            allocate(y.shape);
+            const T dir = t1 >= t0 ? static_cast<T>(1) : static_cast<T>(-1);
+            const T eps = std::numeric_limits<T>::epsilon();
+            const T rtol = std::max(opts.rtol, T(100) * eps);
+            const T atol = opts.atol;
+            const T jac_threshold = atol / std::max(rtol, eps);
+            const T newton_tol = std::max(T(10) * eps / rtol, std::min(T(0.03), std::sqrt(rtol)));
+            const std::size_t maxit = std::max<std::size_t>(opts.max_newton_iter, 1);
+
+            // Method coefficients (NDF-style kappa correction).
+            const std::array<T, max_order + 1> kappa{T(0), T(-0.1850), T(-1) / 9, T(-0.0823), T(-0.0415), T(0)};
+            std::array<T, max_order + 2> gamma{}, alpha{}, error_const{};
+            for (std::size_t k = 1; k <= max_order; ++k) gamma[k] = gamma[k - 1] + static_cast<T>(1) / static_cast<T>(k);
+            for (std::size_t k = 0; k <= max_order; ++k) {
+                alpha[k] = (static_cast<T>(1) - kappa[k]) * gamma[k];
+                error_const[k] = kappa[k] * gamma[k] + static_cast<T>(1) / static_cast<T>(k + 1);
+            }
+
+            T t = t0;
+            f(t, y, f_);
+            ++res.fevals;
+            ODEOptions<T> start = opts;
+            start.rtol = rtol;
+            T h_abs = opts.first_step > T(0)
+                ? opts.first_step
+                : detail::select_initial_step(f, t, y, f_, dir, 1, start, y_pred_, work_, res.fevals);
+
+            std::fill(D_.begin(), D_.end(), T(0));
+            for (std::size_t i = 0; i < n_; ++i) {
+                D_[i] = y.data[i];
+                D_[n_ + i] = f_.data[i] * h_abs * dir;
+            }
+            iter_.evaluate(f, jac, t, y, f_, jac_threshold, res);
+
+            std::size_t order = 1, n_equal_steps = 0;
+
+            while (dir * (t1 - t) > T(0)) {
+                if (res.steps + res.rejected >= opts.max_steps) {
+                    res.message = "maximum number of steps reached";
+                    break;
+                }
+                const T min_step = std::max(opts.min_step,
+                    T(10) * std::abs(std::nextafter(t, dir * std::numeric_limits<T>::infinity()) - t));
+                if (h_abs > opts.max_step) {
+                    change_D(order, opts.max_step / h_abs);
+                    h_abs = opts.max_step;
+                    n_equal_steps = 0;
+                } else if (h_abs < min_step) {
+                    change_D(order, min_step / h_abs);
+                    h_abs = min_step;
+                    n_equal_steps = 0;
+                }
+
+                bool accepted = false;
+                std::size_t n_iter = 0;
+                T error_norm = T(0), t_new = t;
+                while (!accepted) {
+                    if (h_abs < min_step) break;
+                    T h = h_abs * dir;
+                    t_new = t + h;
+                    if (dir * (t_new - t1) > T(0)) {
+                        t_new = t1;
+                        change_D(order, std::abs(t_new - t) / h_abs);
+                        n_equal_steps = 0;
+                    }
+                    h = t_new - t;
+                    h_abs = std::abs(h);
+
+                    predict(order, gamma, alpha, atol, rtol);
+                    const T c = h / alpha[order];
+
+                    bool converged = false;
+                    for (;;) {
+                        if (iter_.needs_refactor(c, opts.refactor_threshold) && !iter_.refactor(c, res)) break;
+                        converged = newton(f, t_new, c, maxit, newton_tol, n_iter, res);
+                        if (converged) break;
+                        if (iter_.c != c) { iter_.factored = false; continue; }   // stale c: refactor first
+                        if (iter_.jac_current) break;
+                        f(t_new, y_pred_, work_);
+                        ++res.fevals;
+                        iter_.evaluate(f, jac, t_new, y_pred_, work_, jac_threshold, res);
+                    }
+
+                    if (!converged) {
+                        ++res.rejected;
+                        h_abs *= T(0.5);
+                        change_D(order, T(0.5));
+                        n_equal_steps = 0;
+                        continue;
+                    }
+
+                    const T safety = T(0.9) * static_cast<T>(2 * maxit + 1) / static_cast<T>(2 * maxit + n_iter);
+                    for (std::size_t i = 0; i < n_; ++i) {
+                        scale_[i] = atol + rtol * std::abs(y_new_.data[i]);
+                        work_.data[i] = error_const[order] * d_[i];
+                    }
+                    error_norm = detail::rms_weighted(work_.data.data(), scale_.data(), n_);
+                    if (error_norm > T(1)) {
+                        ++res.rejected;
+                        const T factor = std::max(T(0.2), safety * std::pow(error_norm, T(-1) / static_cast<T>(order + 1)));
+                        h_abs *= factor;
+                        change_D(order, factor);
+                        n_equal_steps = 0;
+                    } else {
+                        accepted = true;
+                        ++n_equal_steps;
+                        // Differences update: D[order+2] = d - D[order+1], D[order+1] = d, then cumulate.
+                        T* D = D_.data();
+                        for (std::size_t i = 0; i < n_; ++i) {
+                            D[(order + 2) * n_ + i] = d_[i] - D[(order + 1) * n_ + i];
+                            D[(order + 1) * n_ + i] = d_[i];
+                        }
+                        for (std::size_t k = order + 1; k-- > 0;)
+                            for (std::size_t i = 0; i < n_; ++i) D[k * n_ + i] += D[(k + 1) * n_ + i];
+
+                        if (n_equal_steps >= order + 1) {
+                            // Order selection among order - 1, order, order + 1.
+                            const T inf = std::numeric_limits<T>::infinity();
+                            T err_m = inf, err_p = inf;
+                            if (order > 1) {
+                                for (std::size_t i = 0; i < n_; ++i) work_.data[i] = error_const[order - 1] * D[order * n_ + i];
+                                err_m = detail::rms_weighted(work_.data.data(), scale_.data(), n_);
+                            }
+                            if (order < max_order) {
+                                for (std::size_t i = 0; i < n_; ++i) work_.data[i] = error_const[order + 1] * D[(order + 2) * n_ + i];
+                                err_p = detail::rms_weighted(work_.data.data(), scale_.data(), n_);
+                            }
+                            const T norms[3] = {err_m, error_norm, err_p};
+                            T best = T(0);
+                            std::size_t pick = 1;
+                            for (std::size_t k = 0; k < 3; ++k) {
+                                const T fac = norms[k] == T(0) ? inf
+                                    : std::pow(norms[k], T(-1) / static_cast<T>(order + k));
+                                if (fac > best) { best = fac; pick = k; }
+                            }
+                            order = order + pick - 1;
+                            const T factor = std::min(T(10), safety * best);
+                            h_abs *= factor;
+                            change_D(order, factor);
+                            n_equal_steps = 0;
+                        }
+                    }
+                }
+                if (!accepted) {
+                    res.message = "step size fell below the minimum";
+                    break;
+                }
+
+                t = t_new;
+                y.data.swap(y_new_.data);
+                ++res.steps;
+                iter_.jac_current = false;
+                if (opts.observer) opts.observer(t, y);
+            }
+            res.t = t;
+            res.success = (t == t1);
+            return res;
+        }
+
+    private:
+        std::size_t n_ = 0;
+        std::vector<T> D_;        // (max_order + 3) rows of backward differences
+        std::vector<T> d_;        // accumulated Newton correction
+        std::vector<T> psi_;
+        std::vector<T> scale_;
+        Tensor<T> f_{std::vector<std::size_t>{0}}, work_{std::vector<std::size_t>{0}},
+                  y_pred_{std::vector<std::size_t>{0}}, y_new_{std::vector<std::size_t>{0}};
+        detail::IterationMatrix<T> iter_;
+
+        void allocate(const std::vector<std::size_t>& shape) {
+            D_.assign((max_order + 3) * n_, T(0));
+            d_.assign(n_, T(0));
+            psi_.assign(n_, T(0));
+            scale_.assign(n_, T(0));
+            for (Tensor<T>* b : {&f_, &work_, &y_pred_, &y_new_}) detail::resize_like(*b, shape);
+            iter_.allocate(n_);
+        }
+
+        // R(order, factor) from Shampine & Reichelt, row-major (order+1)^2.
+        static void compute_R(std::size_t order, T factor, T* R) {
+            const std::size_t m = order + 1;
+            for (std::size_t j = 0; j < m; ++j) R[j] = T(1);
+            for (std::size_t i = 1; i < m; ++i) {
+                R[i * m] = T(0);
+                for (std::size_t j = 1; j < m; ++j) {
+                    const T mij = (static_cast<T>(i) - T(1) - factor * static_cast<T>(j)) / static_cast<T>(i);
+                    R[i * m + j] = R[(i - 1) * m + j] * mij;
+                }
+            }
+        }
+
+        // Rescales the difference array for a step-size change h -> factor * h.
+        void change_D(std::size_t order, T factor) {
+            const std::size_t m = order + 1;
+            T R[(max_order + 1) * (max_order + 1)], U[(max_order + 1) * (max_order + 1)], RU[(max_order + 1) * (max_order + 1)];
+            compute_R(order, factor, R);
+            compute_R(order, T(1), U);
+            for (std::size_t i = 0; i < m; ++i)
+                for (std::size_t j = 0; j < m; ++j) {
+                    T acc = T(0);
+                    for (std::size_t k = 0; k < m; ++k) acc += R[i * m + k] * U[k * m + j];
+                    RU[i * m + j] = acc;
+                }
+            // D[0..order] = RU^T D[0..order]
+            for (std::size_t i = 0; i < n_; ++i) {
+                T col[max_order + 1];
+                for (std::size_t k = 0; k < m; ++k) col[k] = D_[k * n_ + i];
+                for (std::size_t r = 0; r < m; ++r) {
+                    T acc = T(0);
+                    for (std::size_t k = 0; k < m; ++k) acc += RU[k * m + r] * col[k];
+                    D_[r * n_ + i] = acc;
+                }
+            }
+        }
+
+        // Predictor y_pred = sum D[0..order], error scale and psi.
+        void predict(std::size_t order, const std::array<T, max_order + 2>& gamma,
+                     const std::array<T, max_order + 2>& alpha, T atol, T rtol) {
+            const T inv_alpha = T(1) / alpha[order];
+            for (std::size_t i = 0; i < n_; ++i) {
+                T yp = D_[i], ps = T(0);
+                for (std::size_t k = 1; k <= order; ++k) {
+                    yp += D_[k * n_ + i];
+                    ps += D_[k * n_ + i] * gamma[k];
+                }
+                y_pred_.data[i] = yp;
+                scale_[i] = atol + rtol * std::abs(yp);
+                psi_[i] = ps * inv_alpha;
+            }
+        }
+
+        // Simplified Newton iteration for d = c f(t_new, y_pred + d) - psi.
+        template <typename F>
+        bool newton(F& f, T t_new, T c, std::size_t maxit, T tol, std::size_t& n_iter, StiffResult<T>& res) {
+            std::fill(d_.begin(), d_.end(), T(0));
+            y_new_.data = y_pred_.data;
+            T dy_norm_old = T(-1);
+            bool converged = false;
+            n_iter = 0;
+            for (std::size_t k = 0; k < maxit; ++k) {
+                f(t_new, y_new_, f_);
+                ++res.fevals;
+                ++res.newton_iterations;
+                n_iter = k + 1;
+                bool finite = true;
+                for (std::size_t i = 0; i < n_; ++i) {
+                    work_.data[i] = c * f_.data[i] - psi_[i] - d_[i];
+                    finite = finite && std::isfinite(work_.data[i]);
+                }
+                if (!finite) break;
+                iter_.lu.solve_in_place(work_.data.data());
+                const T dy_norm = detail::rms_weighted(work_.data.data(), scale_.data(), n_);
+                const T rate = dy_norm_old > T(0) ? dy_norm / dy_norm_old : T(-1);
+                if (rate >= T(0) && (rate >= T(1) ||
+                    std::pow(rate, static_cast<T>(maxit - k)) / (T(1) - rate) * dy_norm > tol)) break;
+                for (std::size_t i = 0; i < n_; ++i) {
+                    y_new_.data[i] += work_.data[i];
+                    d_[i] += work_.data[i];
+                }
+                if (dy_norm == T(0) || (rate >= T(0) && rate / (T(1) - rate) * dy_norm < tol)) {
+                    converged = true;
+                    break;
+                }
+                dy_norm_old = dy_norm;
+            }
+            return converged;
+        }
+    };
+
+
+    // --- Rosenbrock 2(3) W-method ---
+
+    template <typename T>
+    class Rosenbrock23 {
+    public:
+        template <typename F, typename Jac = std::nullptr_t>
+        StiffResult<T> integrate(F f, T t0, T t1, Tensor<T>& y, const StiffOptions<T>& opts = {}, Jac jac = nullptr) {
+            detail::check_stiff(y, opts);
+            StiffResult<T> res;
+            res.t = t0;
+            if (t0 == t1) { res.success = true; return res; }
+
+            const std::size_t n = y.data.size();
+            for (Tensor<T>* b : {&f0_, &f1_, &f2_, &k1_, &k2_, &k3_, &dfdt_, &y_new_})
+                detail::resize_like(*b, y.shape);
+            iter_.allocate(n);
+
+            const T dir = t1 >= t0 ? T(1) : T(-1);
+            const T eps = std::numeric_limits<T>::epsilon();
+            const T rtol = std::max(opts.rtol, T(100) * eps), atol = opts.atol;
+            const T jac_threshold = atol / std::max(rtol, eps);
+            const T d = T(1) / (T(2) + std::sqrt(T(2)));
+            const T e32 = T(6) + std::sqrt(T(2));
+
+            T t = t0;
+            f(t, y, f0_);
+            ++res.fevals;
+            ODEOptions<T> start = opts;
+            start.rtol = rtol;
+            T h_abs = opts.first_step > T(0)
+                ? opts.first_step
+                : detail::select_initial_step(f, t, y, f0_, dir, 2, start, y_new_, f1_, res.fevals);
+            iter_.evaluate(f, jac, t, y, f0_, jac_threshold, res);
+
+            while (dir * (t1 - t) > T(0)) {
+                if (res.steps + res.rejected >= opts.max_steps) {
+                    res.message = "maximum number of steps reached";
+                    break;
+                }
+                const T min_step = std::max(opts.min_step,
+                    T(10) * std::abs(std::nextafter(t, dir * std::numeric_limits<T>::infinity()) - t));
+                h_abs = std::min(h_abs, opts.max_step);
+                if (h_abs < min_step) {
+                    res.message = "step size fell below the minimum";
+                    break;
+                }
+                const bool last = h_abs >= std::abs(t1 - t);
+                const T h = last ? t1 - t : dir * h_abs;
+                const T t_new = last ? t1 : t + h;
+
+                // Keep W = I - h d J when h is close to the factored step.
+                if (iter_.needs_refactor(h * d, opts.refactor_threshold) && !iter_.refactor(h * d, res)) {
+                    ++res.rejected;
+                    h_abs *= T(0.5);
+                    continue;
+                }
+                const T hd = h * d;
+
+                // df/dt by a forward difference in t.
+                if (opts.autonomous) {
+                    std::fill(dfdt_.data.begin(), dfdt_.data.end(), T(0));
+                } else {
+                    const T dt = std::sqrt(eps) * std::max(std::abs(t), std::abs(h));
+                    f(t + dt, y, dfdt_);
+                    ++res.fevals;
+                    const T inv = T(1) / dt;
+                    for (std::size_t i = 0; i < n; ++i) dfdt_.data[i] = (dfdt_.data[i] - f0_.data[i]) * inv;
+                }
+
+                T* k1 = k1_.data.data(); T* k2 = k2_.data.data(); T* k3 = k3_.data.data();
+                const T* F0 = f0_.data.data(); const T* Ft = dfdt_.data.data();
+                for (std::size_t i = 0; i < n; ++i) k1[i] = F0[i] + hd * Ft[i];
+                iter_.lu.solve_in_place(k1);
+
+                for (std::size_t i = 0; i < n; ++i) y_new_.data[i] = y.data[i] + T(0.5) * h * k1[i];
+                f(t + T(0.5) * h, y_new_, f1_);
+                const T* F1 = f1_.data.data();
+                for (std::size_t i = 0; i < n; ++i) k2[i] = F1[i] - k1[i];
+                iter_.lu.solve_in_place(k2);
+                for (std::size_t i = 0; i < n; ++i) {
+                    k2[i] += k1[i];
+                    y_new_.data[i] = y.data[i] + h * k2[i];
+                }
+                f(t_new, y_new_, f2_);
+                res.fevals += 2;
+                const T* F2 = f2_.data.data();
+                for (std::size_t i = 0; i < n; ++i)
+                    k3[i] = F2[i] - e32 * (k2[i] - F1[i]) - T(2) * (k1[i] - F0[i]) + hd * Ft[i];
+                iter_.lu.solve_in_place(k3);
+
+                // Error estimate h/6 (k1 - 2 k2 + k3), fused with its scaled norm.
+                T acc = T(0);
+                for (std::size_t i = 0; i < n; ++i) {
+                    const T e = h / T(6) * (k1[i] - T(2) * k2[i] + k3[i]);
+                    const T sc = atol + rtol * std::max(std::abs(y.data[i]), std::abs(y_new_.data[i]));
+                    acc += (e / sc) * (e / sc);
+                }
+                const T err = std::sqrt(acc / static_cast<T>(n));
+                const bool finite = std::isfinite(err);
+
+                if (finite && err <= T(1)) {
+                    t = t_new;
+                    y.data.swap(y_new_.data);
+                    f0_.data.swap(f2_.data);          // FSAL
+                    ++res.steps;
+                    iter_.jac_current = false;
+                    if (opts.observer) opts.observer(t, y);
+                    const T fac = err == T(0) ? T(5) : std::min(T(5), T(0.8) * std::pow(err, T(-1) / T(3)));
+                    // Small increases keep the factored W.
+                    if (!(fac >= T(1) && fac <= T(1) + opts.refactor_threshold)) h_abs *= fac;
+                } else {
+                    ++res.rejected;
+                    h_abs *= finite ? std::max(T(0.2), T(0.8) * std::pow(err, T(-1) / T(3))) : T(0.25);
+                    // A rejected step signals a poor W: refresh J once per step.
+                    if (!iter_.jac_current) iter_.evaluate(f, jac, t, y, f0_, jac_threshold, res);
+                    iter_.factored = false;
+                }
+            }
+            res.t = t;
+            res.success = (t == t1);
+            return res;
+        }
+
+    private:
+        Tensor<T> f0_{std::vector<std::size_t>{0}}, f1_{std::vector<std::size_t>{0}}, f2_{std::vector<std::size_t>{0}},
+                  k1_{std::vector<std::size_t>{0}}, k2_{std::vector<std::size_t>{0}}, k3_{std::vector<std::size_t>{0}},
+                  dfdt_{std::vector<std::size_t>{0}}, y_new_{std::vector<std::size_t>{0}};
+        detail::IterationMatrix<T> iter_;
+    };
+
+
+    // --- Convenience front-ends ---
+
+    template <typename T, typename F, typename Jac = std::nullptr_t>
+    StiffResult<T> bdf(F f, T t0, T t1, Tensor<T>& y, const StiffOptions<T>& opts = {}, Jac jac = nullptr) {
+        BDF<T> integrator;
+        return integrator.integrate(f, t0, t1, y, opts, jac);
+    }
+
+    template <typename T, typename F, typename Jac = std::nullptr_t>
+    StiffResult<T> rosenbrock23(F f, T t0, T t1, Tensor<T>& y, const StiffOptions<T>& opts = {}, Jac jac = nullptr) {
+        Rosenbrock23<T> integrator;
+        return integrator.integrate(f, t0, t1, y, opts, jac);
+    }
+
+} // namespace ode
+} // namespace tl
@@ -0,0 +1,293 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include "../autograd/tape.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+// First-order optimizers over autograd::Parameter<T>.
+//
+//   SGD<T>    : momentum (optionally Nesterov) with L2 weight decay
+//   Adam<T>   : Adam with L2 weight decay folded into the gradient
+//   AdamW<T>  : Adam with decoupled weight decay
+//
+// step() updates parameter, moment buffers and weight decay in one pass per element.
+// All optimizer state sits in a single buffer allocated at construction (SGD's momentum
+// buffer on the first step with momentum, so options() may switch it on later).
+// options() may be changed between steps; step() re-validates them.
+//
+// With multi_tensor = false, each parameter tensor gets its own (thresholded)
+// parallel loop.  With multi_tensor = true, every parameter is cut into fixed-size
+// chunks up front, and one parallel loop covers all chunks of all tensors.  This
+// keeps models with many small tensors (biases, norm scales) from paying one
+// fork/join per tensor.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace optim {
+
+    using autograd::Parameter;
+
+    template <typename T>
+    struct SGDOptions {
+        T lr = static_cast<T>(0.01);
+        T momentum = static_cast<T>(0);
+        T dampening = static_cast<T>(0);
+        T weight_decay = static_cast<T>(0);
+        bool nesterov = false;
+        bool multi_tensor = false;
+    };
+
+    template <typename T>
+    struct AdamOptions {
+        T lr = static_cast<T>(1e-3);
+        T beta1 = static_cast<T>(0.9);
+        T beta2 = static_cast<T>(0.999);
+        T eps = static_cast<T>(1e-8);
+        T weight_decay = static_cast<T>(0);
+        bool multi_tensor = false;
+    };
+
+
+    namespace detail {
+
+        constexpr std::size_t optim_parallel_threshold = 1 << 15;
+        constexpr std::size_t optim_chunk = 1 << 12;
+
+        // Parameters plus `buffers` state slots per element, stored contiguously.
+        template <typename T>
+        class ParamState {
+        public:
+            ParamState(std::vector<Parameter<T>*> params, std::size_t buffers, bool multi_tensor)
+                : params_(std::move(params)), buffers_(buffers), multi_tensor_(multi_tensor) {
+                offsets_.reserve(params_.size());
+                for (std::size_t i = 0; i < params_.size(); ++i) {
+                    if (!params_[i]) throw std::runtime_error("optimizer: null parameter.");
+                    const std::size_t n = params_[i]->value.data.size();
+                    offsets_.push_back(total_);
+                    for (std::size_t b = 0; b < n; b += optim_chunk) chunks_.push_back({i, b, std::min(b + optim_chunk, n)});
+                    total_ += n;
+                }
+                state_.assign(total_ * buffers_, static_cast<T>(0));
+            }
+
+            std::size_t size() const { return params_.size(); }
+            std::size_t numel() const { return total_; }
+            std::size_t buffers() const { return buffers_; }
+
+            // Grows the state to `buffers` zero-filled slots per element.
+            void ensure_buffers(std::size_t buffers) {
+                if (buffers <= buffers_) return;
+                state_.resize(total_ * buffers, static_cast<T>(0));
+                buffers_ = buffers;
+            }
+            Parameter<T>& param(std::size_t i) { return *params_[i]; }
+
+            // State buffer k of parameter i (numel(i) entries).
+            T* state(std::size_t k, std::size_t i) { return state_.data() + k * total_ + offsets_[i]; }
+            const T* state(std::size_t k, std::size_t i) const { return state_.data() + k * total_ + offsets_[i]; }
+
+            // Calls fn(p, g, s0, s1, n) on contiguous slices covering every parameter.
+            template <typename Fn>
+            void for_each(Fn fn) {
+                for (std::size_t i = 0; i < params_.size(); ++i) {
+                    const Parameter<T>& p = *params_[i];
+                    const std::size_t n = (i + 1 < offsets_.size() ? offsets_[i + 1] : total_) - offsets_[i];
+                    if (p.value.data.size() != n || p.grad.data.size() != n) {
+                        throw std::runtime_error("optimizer: parameter " + std::to_string(i) +
+                                                 " changed size or has no gradient buffer of matching size.");
+                    }
+                }
+                if (multi_tensor_) {
+                    const std::ptrdiff_t C = static_cast<std::ptrdiff_t>(chunks_.size());
+                    #pragma omp parallel for schedule(static) if(total_ > optim_parallel_threshold)
+                    for (std::ptrdiff_t c = 0; c < C; ++c) run(chunks_[static_cast<std::size_t>(c)], fn);
+                    return;
+                }
+                std::size_t first = 0;
+                while (first < chunks_.size()) {
+                    std::size_t last = first;
+                    while (last < chunks_.size() && chunks_[last].param == chunks_[first].param) ++last;
+                    const std::size_t n = params_[chunks_[first].param]->value.data.size();
+                    const std::ptrdiff_t lo = static_cast<std::ptrdiff_t>(first), hi = static_cast<std::ptrdiff_t>(last);
+                    #pragma omp parallel for schedule(static) if(n > optim_parallel_threshold)
+                    for (std::ptrdiff_t c = lo; c < hi; ++c) run(chunks_[static_cast<std::size_t>(c)], fn);
+                    first = last;
+                }
+            }
+
+        private:
+            struct Chunk { std::size_t param, begin, end; };
+
+            std::vector<Parameter<T>*> params_;
+            std::vector<std::size_t> offsets_;
+            std::vector<Chunk> chunks_;
+            std::vector<T> state_;
+            std::size_t total_ = 0;
+            std::size_t buffers_;
+            bool multi_tensor_;
+
+            template <typename Fn>
+            void run(const Chunk& c, Fn& fn) {
+                Parameter<T>& p = *params_[c.param];
+                T* s0 = buffers_ > 0 ? state(0, c.param) + c.begin : nullptr;
+                T* s1 = buffers_ > 1 ? state(1, c.param) + c.begin : nullptr;
+                fn(p.value.data.data() + c.begin, p.grad.data.data() + c.begin, s0, s1, c.end - c.begin);
+            }
+        };
+
+        template <typename T>
+        void check_sgd(const SGDOptions<T>& o) {
+            if (o.nesterov && (o.momentum <= T(0) || o.dampening != T(0))) {
+                throw std::runtime_error("SGD: Nesterov momentum requires momentum > 0 and zero dampening.");
+            }
+        }
+
+        template <typename T>
+        void check_adam(const AdamOptions<T>& o) {
+            if (!(o.lr >= T(0)) || !(o.beta1 >= T(0) && o.beta1 < T(1)) || !(o.beta2 >= T(0) && o.beta2 < T(1)) || !(o.eps >= T(0))) {
+                throw std::runtime_error("Adam: invalid hyper-parameters (need lr >= 0, 0 <= beta < 1, eps >= 0).");
+            }
+        }
+
+        // Shared Adam / AdamW update; decoupled selects AdamW's weight decay.
+        template <typename T>
+        void adam_step(ParamState<T>& st, const AdamOptions<T>& o, std::size_t t, bool decoupled) {
+            const T b1 = o.beta1, b2 = o.beta2, eps = o.eps, wd = o.weight_decay;
+            const T step_size = o.lr / (T(1) - std::pow(b1, static_cast<T>(t)));
+            const T inv_sqrt_bc2 = T(1) / std::sqrt(T(1) - std::pow(b2, static_cast<T>(t)));
+            const T decay = decoupled ? T(1) - o.lr * wd : T(1);
+            const T l2 = decoupled ? T(0) : wd;
+            st.for_each([=](T* __restrict p, const T* __restrict g, T* __restrict m, T* __restrict v, std::size_t n) {
+                #pragma omp simd
+                for (std::size_t i = 0; i < n; ++i) {
+                    const T gi = g[i] + l2 * p[i];
+                    m[i] = b1 * m[i] + (T(1) - b1) * gi;
+                    v[i] = b2 * v[i] + (T(1) - b2) * gi * gi;
+                    p[i] = p[i] * decay - step_size * m[i] / (std::sqrt(v[i]) * inv_sqrt_bc2 + eps);
+                }
+            });
+        }
+
+    } // namespace detail
+
+
+    // --- SGD ---
+
+    template <typename T>
+    class SGD {
+    public:
+        SGD(std::vector<Parameter<T>*> params, SGDOptions<T> opts = {})
+            : opts_(opts), state_(std::move(params), opts.momentum != T(0) ? 1 : 0, opts.multi_tensor) {
+            detail::check_sgd(opts_);
+        }
+
+        void step() {
+            detail::check_sgd(opts_);
+            ++steps_;
+            const T lr = opts_.lr, mu = opts_.momentum, damp = T(1) - opts_.dampening, wd = opts_.weight_decay;
+            const bool nesterov = opts_.nesterov;
+            if (mu == T(0)) {
+                state_.for_each([=](T* __restrict p, const T* __restrict g, T*, T*, std::size_t n) {
+                    #pragma omp simd
+                    for (std::size_t i = 0; i < n; ++i) p[i] -= lr * (g[i] + wd * p[i]);
+                });
+                seeded_ = false;   // momentum switched back on later starts from a fresh buffer
+                return;
+            }
+            // The first step with momentum seeds the buffer with the gradient itself.
+            state_.ensure_buffers(1);
+            const bool seed = !seeded_;
+            seeded_ = true;
+            const T keep = seed ? T(0) : mu;
+            const T take = seed ? T(1) : damp;
+            state_.for_each([=](T* __restrict p, const T* __restrict g, T* __restrict buf, T*, std::size_t n) {
+                #pragma omp simd
+                for (std::size_t i = 0; i < n; ++i) {
+                    const T gi = g[i] + wd * p[i];
+                    buf[i] = keep * buf[i] + take * gi;
+                    p[i] -= lr * (nesterov ? gi + mu * buf[i] : buf[i]);
+                }
+            });
+        }
+
+        void zero_grad() { for (std::size_t i = 0; i < state_.size(); ++i) state_.param(i).zero_grad(); }
+
+        // Momentum buffer of parameter i (null without momentum).
+        const T* momentum_buffer(std::size_t i) const { return state_.buffers() > 0 ? state_.state(0, i) : nullptr; }
+
+        SGDOptions<T>& options() { return opts_; }
+        std::size_t steps() const { return steps_; }
+
+    private:
+        SGDOptions<T> opts_;
+        detail::ParamState<T> state_;
+        std::size_t steps_ = 0;
+        bool seeded_ = false;
+    };
+
+    // --- Adam / AdamW ---
+
+    template <typename T>
+    class Adam {
+    public:
+        Adam(std::vector<Parameter<T>*> params, AdamOptions<T> opts = {})
+            : opts_(opts), state_(std::move(params), 2, opts.multi_tensor) { detail::check_adam(opts_); }
+
+        void step() {
+            detail::check_adam(opts_);
+            detail::adam_step(state_, opts_, ++steps_, false);
+        }
+        void zero_grad() { for (std::size_t i = 0; i < state_.size(); ++i) state_.param(i).zero_grad(); }
+
+        const T* exp_avg(std::size_t i) const { return state_.state(0, i); }
+        const T* exp_avg_sq(std::size_t i) const { return state_.state(1, i); }
+
+        AdamOptions<T>& options() { return opts_; }
+        std::size_t steps() const { return steps_; }
+
+    private:
+        AdamOptions<T> opts_;
+        detail::ParamState<T> state_;
+        std::size_t steps_ = 0;
+    };
+
+    // Decoupled weight decay: p *= 1 - lr * weight_decay before the Adam update.
+    template <typename T>
+    class AdamW {
+    public:
+        static AdamOptions<T> default_options() {
+            AdamOptions<T> o;
+            o.weight_decay = static_cast<T>(1e-2);
+            return o;
+        }
+
+        AdamW(std::vector<Parameter<T>*> params, AdamOptions<T> opts = default_options())
+            : opts_(opts), state_(std::move(params), 2, opts.multi_tensor) { detail::check_adam(opts_); }
+
+        void step() {
+            detail::check_adam(opts_);
+            detail::adam_step(state_, opts_, ++steps_, true);
+        }
+        void zero_grad() { for (std::size_t i = 0; i < state_.size(); ++i) state_.param(i).zero_grad(); }
+
+        const T* exp_avg(std::size_t i) const { return state_.state(0, i); }
+        const T* exp_avg_sq(std::size_t i) const { return state_.state(1, i); }
+
+        AdamOptions<T>& options() { return opts_; }
+        std::size_t steps() const { return steps_; }
+
+    private:
+        AdamOptions<T> opts_;
+        detail::ParamState<T> state_;
+        std::size_t steps_ = 0;
+    };
+
+} // namespace optim
+} // namespace tl
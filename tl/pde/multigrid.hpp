@@ -0,0 +1,323 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include "../linalg/iterative.hpp"
+#include "stencil.hpp"
+#include "solvers.hpp"
+#include <array>
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+// Geometric multigrid for -lap(u) = f on 1D / 2D / 3D structured grids.
+//
+// Every level coarsens all axes by two; the rule depends on the axis' boundary:
+//   Dirichlet : n = 2^k - 1 interior points,  n_c = (n - 1) / 2, coarse i <-> fine 2i + 1
+//   Periodic  : n even,                       n_c = n / 2,       coarse i <-> fine 2i
+//   Neumann   : n = 2^k + 1 points,           n_c = (n + 1) / 2, coarse i <-> fine 2i
+// Restriction is full weighting, prolongation is (bi/tri)linear interpolation and
+// the smoother is red-black Gauss-Seidel (post-smoothing and the second half of
+// the coarsest-level sweeps run the colours in reverse, so a cycle is a symmetric
+// operator and can precondition CG).
+//
+// Multigrid::solve() iterates V- or W-cycles to a tolerance; Multigrid::apply()
+// runs one cycle from a zero guess with homogeneous boundaries, which is the
+// Preconditioner interface expected by tl::linalg::cg / bicgstab / gmres.
+// PoissonOperator provides the matching matrix-free operator and right-hand side.
+
+namespace tl {
+namespace pde {
+
+    enum class CycleType { V, W };
+
+    struct MultigridOptions {
+        CycleType cycle = CycleType::V;
+        std::size_t pre_smooth = 2;
+        std::size_t post_smooth = 2;
+        std::size_t coarse_sweeps = 50;   // red-black sweeps on the coarsest level (half forward, half reversed)
+        std::size_t max_levels = 32;
+        double omega = 1.0;               // relaxation factor of the smoother
+    };
+
+
+    namespace detail {
+
+        template <typename T>
+        Boundaries<T> homogeneous(const Boundaries<T>& bc) {
+            Boundaries<T> h = bc;
+            for (auto& pair : h.faces)
+                for (auto& f : pair) f.value = static_cast<T>(0);
+            return h;
+        }
+
+        // Coarse extent along an axis, or 0 if the axis cannot be coarsened further.
+        template <typename T>
+        std::size_t coarse_extent(std::size_t n, const std::array<BoundaryCondition<T>, 2>& faces) {
+            if (faces[0].type != faces[1].type) {
+                throw std::runtime_error("Multigrid requires both faces of an axis to share a boundary type.");
+            }
+            switch (faces[0].type) {
+                case BoundaryType::Dirichlet: return (n >= 3 && n % 2 == 1) ? (n - 1) / 2 : 0;
+                case BoundaryType::Periodic:  return (n >= 4 && n % 2 == 0) ? n / 2 : 0;
+                case BoundaryType::Neumann:   return (n >= 3 && n % 2 == 1) ? (n + 1) / 2 : 0;
+            }
+            return 0;
+        }
+
+        // (padded index, weight) pairs for one grid-transfer direction along one axis.
+        using TransferTaps = std::vector<std::vector<std::pair<std::size_t, double>>>;
+
+    } // namespace detail
+
+
+    template <typename T>
+    class Multigrid {
+    public:
+        Multigrid(std::vector<std::size_t> shape, T h, const Boundaries<T>& bc, MultigridOptions opts = {})
+            : opts_(opts), bc_(bc), homogeneous_bc_(detail::homogeneous(bc)) {
+            if (shape.empty() || shape.size() > 3) throw std::runtime_error("Multigrid supports 1D, 2D and 3D grids.");
+            if (bc.faces.size() != shape.size()) throw std::runtime_error("Boundaries must provide one face pair per axis.");
+            if (opts_.pre_smooth + opts_.post_smooth == 0) throw std::runtime_error("Multigrid needs at least one smoothing sweep.");
+
+            levels_.emplace_back();
+            levels_.back().shape = shape;
+            levels_.back().h = h;
+            while (levels_.size() < opts_.max_levels) {
+                std::vector<std::size_t> coarse(shape.size());
+                bool ok = true;
+                for (std::size_t a = 0; a < shape.size(); ++a) {
+                    coarse[a] = detail::coarse_extent(levels_.back().shape[a], bc.faces[a]);
+                    if (coarse[a] == 0) ok = false;
+                }
+                if (!ok) break;
+                const T hc = levels_.back().h * static_cast<T>(2);
+                levels_.emplace_back();
+                levels_.back().shape = coarse;
+                levels_.back().h = hc;
+            }
+            if (levels_.size() < 2) {
+                throw std::runtime_error(
+                    "Multigrid: grid cannot be coarsened (use 2^k - 1 points for Dirichlet, "
+                    "an even count for periodic and 2^k + 1 for Neumann axes).");
+            }
+
+            for (std::size_t l = 0; l < levels_.size(); ++l) {
+                Level& L = levels_[l];
+                L.u = detail::PaddedGrid<T>(L.shape, homogeneous_bc_);
+                L.rpad = detail::PaddedGrid<T>(L.shape, homogeneous_bc_);
+                L.f.assign(L.u.size(), static_cast<T>(0));
+                L.r.assign(L.u.size(), static_cast<T>(0));
+                if (l + 1 < levels_.size()) build_transfer(L, levels_[l + 1].shape);
+            }
+        }
+
+        std::size_t levels() const { return levels_.size(); }
+        const std::vector<std::size_t>& level_shape(std::size_t l) const { return levels_.at(l).shape; }
+
+        // Cycles until ||f + lap(u)||_2 <= max(rtol * ||r_0||_2, atol); u is updated in place.
+        linalg::SolverResult<T> solve(Tensor<T>& u, const Tensor<T>* f,
+                                      const linalg::SolverOptions<T>& opts = {}) const {
+            check(u, "solution");
+            if (f) check(*f, "right-hand side");
+            Level& L = levels_[0];
+            L.u.faces = faces_of(bc_);
+            L.u.load(u.data.data());
+            if (f) std::copy(f->data.begin(), f->data.end(), L.f.begin());
+            else std::fill(L.f.begin(), L.f.end(), static_cast<T>(0));
+
+            linalg::SolverResult<T> res;
+            T rnorm = detail::padded_residual(L.u, L.f.data(), L.h, L.r.data());
+            res.initial_residual = rnorm;
+            const T threshold = std::max(opts.rtol * rnorm, opts.atol);
+            if (!linalg::detail::record(res, opts, rnorm, threshold)) {
+                while (res.iterations < opts.max_iter) {
+                    cycle(0);
+                    ++res.iterations;
+                    rnorm = detail::padded_residual(L.u, L.f.data(), L.h, L.r.data());
+                    if (linalg::detail::record(res, opts, rnorm, threshold)) { res.converged = true; break; }
+                }
+            } else {
+                res.converged = true;
+            }
+            L.u.store(u.data.data());
+            return res;
+        }
+
+        // Preconditioner: z ~= (-lap)^{-1} r with homogeneous boundaries (one cycle).
+        void apply(const Tensor<T>& r, Tensor<T>& z) const {
+            Level& L = levels_[0];
+            if (r.data.size() != L.f.size() || z.data.size() != L.f.size()) {
+                throw std::runtime_error("Multigrid::apply: vector size does not match the grid.");
+            }
+            L.u.faces = faces_of(homogeneous_bc_);
+            L.u.zero();
+            std::copy(r.data.begin(), r.data.end(), L.f.begin());
+            cycle(0);
+            L.u.store(z.data.data());
+        }
+
+    private:
+        struct Level {
+            std::vector<std::size_t> shape;
+            T h = static_cast<T>(1);
+            detail::PaddedGrid<T> u;      // iterate (error on coarse levels)
+            detail::PaddedGrid<T> rpad;   // residual with ghosts, for restriction
+            std::vector<T> f, r;
+            std::array<detail::TransferTaps, 3> restrict_taps;   // per coarse index
+            std::array<detail::TransferTaps, 3> prolong_taps;    // per fine index
+        };
+
+        MultigridOptions opts_;
+        Boundaries<T> bc_, homogeneous_bc_;
+        mutable std::vector<Level> levels_;
+
+        void check(const Tensor<T>& t, const char* what) const {
+            if (t.shape != levels_[0].shape) {
+                throw std::runtime_error(std::string("Multigrid: ") + what + " shape does not match the grid.");
+            }
+        }
+
+        std::array<std::array<BoundaryCondition<T>, 2>, 3> faces_of(const Boundaries<T>& bc) const {
+            std::array<std::array<BoundaryCondition<T>, 2>, 3> f{};
+            const std::size_t shift = 3 - bc.faces.size();
+            for (std::size_t a = 0; a < bc.faces.size(); ++a) f[shift + a] = bc.faces[a];
+            return f;
+        }
+
+        void build_transfer(Level& L, const std::vector<std::size_t>& coarse) {
+            const std::size_t d = L.shape.size(), shift = 3 - d;
+            for (std::size_t a = 0; a < 3; ++a) {
+                auto& R = L.restrict_taps[a];
+                auto& P = L.prolong_taps[a];
+                if (a < shift) {   // inactive axis: extent 1, no ghosts
+                    R = {{{0, 1.0}}};
+                    P = {{{0, 1.0}}};
+                    continue;
+                }
+                const std::size_t ax = a - shift;
+                const std::size_t off = bc_.faces[ax][0].type == BoundaryType::Dirichlet ? 1 : 0;
+                R.assign(coarse[ax], {});
+                for (std::size_t i = 0; i < coarse[ax]; ++i) {
+                    const std::size_t fc = 2 * i + off + 1;   // padded fine index
+                    R[i] = {{fc - 1, 0.25}, {fc, 0.5}, {fc + 1, 0.25}};
+                }
+                P.assign(L.shape[ax], {});
+                for (std::size_t fi = 0; fi < L.shape[ax]; ++fi) {
+                    const std::ptrdiff_t s = static_cast<std::ptrdiff_t>(fi) - static_cast<std::ptrdiff_t>(off);
+                    if (s % 2 == 0) {
+                        P[fi] = {{static_cast<std::size_t>(s / 2 + 1), 1.0}};
+                    } else {
+                        const std::ptrdiff_t c0 = (s - 1) / 2;   // s = -1 gives the low ghost
+                        P[fi] = {{static_cast<std::size_t>(c0 + 1), 0.5}, {static_cast<std::size_t>(c0 + 2), 0.5}};
+                    }
+                }
+            }
+        }
+
+        void smooth(Level& L, std::size_t sweeps, bool reverse) const {
+            const T omega = static_cast<T>(opts_.omega);
+            for (std::size_t s = 0; s < sweeps; ++s) {
+                detail::rb_half_sweep(L.u, L.f.data(), L.h, omega, reverse ? 1 : 0);
+                detail::rb_half_sweep(L.u, L.f.data(), L.h, omega, reverse ? 0 : 1);
+            }
+        }
+
+        void restrict_residual(Level& F, Level& C) const {
+            detail::fill_padded(F.r.data(), F.rpad.P.data(), F.rpad.G, F.rpad.faces, F.rpad.spacing, true);
+            const auto& G = F.rpad.G;
+            const std::size_t cz = C.u.G.n[0], cy = C.u.G.n[1], cx = C.u.G.n[2];
+            const T* src = F.rpad.P.data();
+            #pragma omp parallel for schedule(static)
+            for (std::ptrdiff_t zy = 0; zy < static_cast<std::ptrdiff_t>(cz * cy); ++zy) {
+                const std::size_t z = static_cast<std::size_t>(zy) / cy, y = static_cast<std::size_t>(zy) % cy;
+                T* out = C.f.data() + (z * cy + y) * cx;
+                for (std::size_t x = 0; x < cx; ++x) {
+                    double acc = 0.0;
+                    for (const auto& [iz, wz] : F.restrict_taps[0][z])
+                        for (const auto& [iy, wy] : F.restrict_taps[1][y]) {
+                            const T* row = src + (iz * G.p[1] + iy) * G.p[2];
+                            for (const auto& [ix, wx] : F.restrict_taps[2][x])
+                                acc += wz * wy * wx * static_cast<double>(row[ix]);
+                        }
+                    out[x] = static_cast<T>(acc);
+                }
+            }
+        }
+
+        void prolongate_add(Level& F, Level& C) const {
+            C.u.refresh();   // coarse ghosts (homogeneous) feed the edge interpolation
+            const auto& CG = C.u.G;
+            const std::size_t nz = F.u.G.n[0], ny = F.u.G.n[1], nx = F.u.G.n[2];
+            const T* src = C.u.P.data();
+            #pragma omp parallel for schedule(static)
+            for (std::ptrdiff_t zy = 0; zy < static_cast<std::ptrdiff_t>(nz * ny); ++zy) {
+                const std::size_t z = static_cast<std::size_t>(zy) / ny, y = static_cast<std::size_t>(zy) % ny;
+                T* out = F.u.row(static_cast<std::size_t>(zy));
+                for (std::size_t x = 0; x < nx; ++x) {
+                    double acc = 0.0;
+                    for (const auto& [iz, wz] : F.prolong_taps[0][z])
+                        for (const auto& [iy, wy] : F.prolong_taps[1][y]) {
+                            const T* row = src + (iz * CG.p[1] + iy) * CG.p[2];
+                            for (const auto& [ix, wx] : F.prolong_taps[2][x])
+                                acc += wz * wy * wx * static_cast<double>(row[ix]);
+                        }
+                    out[x] += static_cast<T>(acc);
+                }
+            }
+        }
+
+        void cycle(std::size_t l) const {
+            Level& L = levels_[l];
+            if (l + 1 == levels_.size()) {
+                const std::size_t half = (opts_.coarse_sweeps + 1) / 2;
+                smooth(L, half, false);
+                smooth(L, half, true);
+                return;
+            }
+            smooth(L, opts_.pre_smooth, false);
+            detail::padded_residual(L.u, L.f.data(), L.h, L.r.data());
+            Level& C = levels_[l + 1];
+            restrict_residual(L, C);
+            C.u.zero();
+            const std::size_t gamma = (opts_.cycle == CycleType::W && l + 2 < levels_.size()) ? 2 : 1;
+            for (std::size_t g = 0; g < gamma; ++g) cycle(l + 1);
+            prolongate_add(L, C);
+            smooth(L, opts_.post_smooth, true);
+        }
+    };
+
+
+    // Matrix-free y = -lap(x) with homogeneous boundaries, in the operator form
+    // used by tl::linalg solvers.  rhs() folds the (possibly inhomogeneous)
+    // boundary values into the right-hand side: -lap_0(u) = f + lap_bc(0).
+    template <typename T>
+    class PoissonOperator {
+    public:
+        PoissonOperator(std::vector<std::size_t> shape, T h, const Boundaries<T>& bc)
+            : shape_(std::move(shape)), h_(h), bc_(bc),
+              grid_(shape_, detail::homogeneous(bc)), zero_(grid_.size(), static_cast<T>(0)) {}
+
+        void operator()(const Tensor<T>& x, Tensor<T>& y) const {
+            grid_.load(x.data.data());
+            detail::padded_residual(grid_, zero_.data(), h_, y.data.data());   // y = lap(x)
+            for (auto& v : y.data) v = -v;
+        }
+
+        Tensor<T> rhs(const Tensor<T>* f) const {
+            detail::PaddedGrid<T> g(shape_, bc_);   // zero interior, real boundary values
+            Tensor<T> b(shape_);
+            detail::padded_residual(g, f ? f->data.data() : zero_.data(), h_, b.data.data());
+            return b;
+        }
+
+    private:
+        std::vector<std::size_t> shape_;
+        T h_;
+        Boundaries<T> bc_;
+        mutable detail::PaddedGrid<T> grid_;
+        std::vector<T> zero_;
+    };
+
+} // namespace pde
+} // namespace tl
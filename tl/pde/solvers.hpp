@@ -0,0 +1,273 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include "../linalg/iterative.hpp"
+#include "stencil.hpp"
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+
+// Finite-difference solvers built on the stencil engine.
+//
+//   heat_explicit        : forward-Euler time stepping of u_t = alpha * lap(u)
+//   poisson_jacobi       : Jacobi iteration for -lap(u) = f
+//   poisson_gauss_seidel : red-black Gauss-Seidel / SOR for -lap(u) = f
+//
+// Grids are 1D / 2D / 3D tensors with uniform spacing h; boundary conditions
+// follow tl::pde::Boundaries (ghost cells just outside the tensor).  The
+// Poisson solvers report convergence through linalg::SolverResult and stop when
+// ||f + lap(u)||_2 <= max(rtol * ||r_0||_2, atol).  For Laplace's equation pass
+// an all-zero f (or nullptr).
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace pde {
+
+    // --- Heat equation ---
+
+    // Advances u by `steps` explicit Euler steps of size dt.
+    // Throws if the step violates the stability bound alpha * dt / h^2 <= 1 / (2 d).
+    template <typename T>
+    void heat_explicit(Tensor<T>& u, T alpha, T dt, T h, std::size_t steps,
+                       const Boundaries<T>& bc, TilingOptions tiling = {}) {
+        const std::size_t d = u.shape.size();
+        const T r = alpha * dt / (h * h);
+        if (r > static_cast<T>(1) / static_cast<T>(2 * d)) {
+            throw std::runtime_error("heat_explicit: unstable step, alpha*dt/h^2 = " + std::to_string(r) +
+                                     " exceeds 1/(2*" + std::to_string(d) + ")");
+        }
+        // u_{n+1} = (I + alpha dt lap) u_n is itself a constant-coefficient stencil.
+        const auto step = Stencil<T>::identity(d) + Stencil<T>::laplacian(d, h) * (alpha * dt);
+        StencilOperator<T> op(step, u.shape, bc, tiling);
+        op.iterate(u, steps);
+    }
+
+
+    namespace detail {
+
+        template <typename T>
+        T residual_norm(StencilOperator<T>& lap, const Tensor<T>& u, const Tensor<T>& f, Tensor<T>& r) {
+            lap.apply(u, r, &f, static_cast<T>(1));   // r = lap(u) + f
+            T acc = static_cast<T>(0);
+            const T* rp = r.data.data();
+            const std::size_t n = r.data.size();
+            #pragma omp parallel for simd reduction(+:acc) if(n > linalg::detail::krylov_parallel_threshold)
+            for (std::size_t i = 0; i < n; ++i) acc += rp[i] * rp[i];
+            return std::sqrt(acc);
+        }
+
+        template <typename T>
+        void check_poisson(const Tensor<T>& u, const Tensor<T>* f) {
+            if (u.shape.empty() || u.shape.size() > 3) {
+                throw std::runtime_error("Poisson solvers support 1D, 2D and 3D grids.");
+            }
+            if (f && f->shape != u.shape) {
+                throw std::runtime_error("Poisson solvers: right-hand side shape does not match the grid.");
+            }
+        }
+
+    } // namespace detail
+
+
+    // --- Jacobi ---
+
+    // The residual is evaluated every tiling.time_block sweeps; the sweeps in
+    // between run as one temporally blocked stencil pass.
+    template <typename T>
+    linalg::SolverResult<T> poisson_jacobi(Tensor<T>& u, const Tensor<T>* f, T h, const Boundaries<T>& bc,
+                                           const linalg::SolverOptions<T>& opts = {}, TilingOptions tiling = {}) {
+        detail::check_poisson(u, f);
+        const std::size_t d = u.shape.size();
+        const Tensor<T> zero_rhs = f ? Tensor<T>(std::vector<std::size_t>{0}) : Tensor<T>(u.shape);
+        const Tensor<T>& rhs = f ? *f : zero_rhs;
+
+        // u_new = (sum of neighbours + h^2 f) / (2d)  ==  u + h^2/(2d) (lap(u) + f)
+        const T w = h * h / static_cast<T>(2 * d);
+        const auto sweep = Stencil<T>::identity(d) + Stencil<T>::laplacian(d, h) * w;
+        StencilOperator<T> jac(sweep, u.shape, bc, tiling);
+        StencilOperator<T> lap(Stencil<T>::laplacian(d, h), u.shape, bc, tiling);
+        Tensor<T> r(u.shape);
+
+        linalg::SolverResult<T> res;
+        T rnorm = detail::residual_norm(lap, u, rhs, r);
+        res.initial_residual = rnorm;
+        const T threshold = std::max(opts.rtol * rnorm, opts.atol);
+        if (linalg::detail::record(res, opts, rnorm, threshold)) { res.converged = true; return res; }
+
+        const std::size_t check = std::max<std::size_t>(1, tiling.time_block);
+        while (res.iterations < opts.max_iter) {
+            const std::size_t n = std::min(check, opts.max_iter - res.iterations);
+            jac.iterate(u, n, &rhs, w);
+            res.iterations += n;
+            res.matvecs += n;
+            rnorm = detail::residual_norm(lap, u, rhs, r);
+            if (linalg::detail::record(res, opts, rnorm, threshold)) { res.converged = true; break; }
+        }
+        return res;
+    }
+
+
+    namespace detail {
+
+        // A grid with one ghost layer on every active axis, stored in the stencil
+        // engine's internal (z, y, x) layout and relaxed in place.
+        template <typename T>
+        struct PaddedGrid {
+            Geometry G;
+            std::array<std::array<BoundaryCondition<T>, 2>, 3> faces;
+            T spacing = static_cast<T>(1);
+            std::size_t dims = 0;
+            std::vector<T> P;
+
+            PaddedGrid() = default;
+            PaddedGrid(const std::vector<std::size_t>& shape, const Boundaries<T>& bc) {
+                dims = shape.size();
+                if (bc.faces.size() != dims) {
+                    throw std::runtime_error("Boundaries must provide one face pair per axis.");
+                }
+                const std::size_t shift = 3 - dims;
+                std::array<std::size_t, 3> ghost{0, 0, 0};
+                for (std::size_t a = 0; a < dims; ++a) {
+                    G.n[shift + a] = shape[a];
+                    faces[shift + a] = bc.faces[a];
+                    ghost[shift + a] = 1;
+                }
+                spacing = bc.spacing;
+                G.set_ghost(ghost);
+                P.assign(G.padded_size(), static_cast<T>(0));
+            }
+
+            std::size_t size() const { return G.n[0] * G.n[1] * G.n[2]; }
+            std::size_t rows() const { return G.n[0] * G.n[1]; }
+
+            // Interior row r (= z * ny + y), first interior element.
+            T* row(std::size_t r) {
+                const std::size_t z = r / G.n[1], y = r % G.n[1];
+                return P.data() + ((z + G.g[0]) * G.p[1] + y + G.g[1]) * G.p[2] + G.g[2];
+            }
+
+            void load(const T* src) { fill_padded(src, P.data(), G, faces, spacing, false); }
+            void refresh() { fill_ghosts(P.data(), G, faces, spacing, false); }
+            void store(T* dst) {
+                for (std::size_t r = 0; r < rows(); ++r) {
+                    const T* src = row(r);
+                    std::copy(src, src + G.n[2], dst + r * G.n[2]);
+                }
+            }
+            void zero() { std::fill(P.begin(), P.end(), static_cast<T>(0)); }
+        };
+
+        // One colour of red-black relaxation for -lap(u) = f: all points with
+        // (z + y + x + colour) even are updated.
+        template <typename T>
+        void rb_half_sweep(PaddedGrid<T>& g, const T* f, T h, T omega, std::size_t colour) {
+            g.refresh();   // ghosts must reflect the current interior
+            const std::ptrdiff_t sy = static_cast<std::ptrdiff_t>(g.G.p[2]);
+            const std::ptrdiff_t sz = static_cast<std::ptrdiff_t>(g.G.p[2] * g.G.p[1]);
+            const std::size_t d = g.dims, nx = g.G.n[2], ny = g.G.n[1];
+            const T h2 = h * h;
+            const T inv_diag = static_cast<T>(1) / static_cast<T>(2 * d);
+            const std::ptrdiff_t rows = static_cast<std::ptrdiff_t>(g.rows());
+
+            #pragma omp parallel for schedule(static)
+            for (std::ptrdiff_t r = 0; r < rows; ++r) {
+                T* row = g.row(static_cast<std::size_t>(r));
+                const T* frow = f + static_cast<std::size_t>(r) * nx;
+                const std::size_t z = static_cast<std::size_t>(r) / ny, y = static_cast<std::size_t>(r) % ny;
+                const std::size_t x0 = (z + y + colour) & 1;
+                #pragma omp simd
+                for (std::size_t x = x0; x < nx; x += 2) {
+                    T* c = row + x;
+                    T nb = c[-1] + c[1];
+                    if (d >= 2) nb += c[-sy] + c[sy];
+                    if (d >= 3) nb += c[-sz] + c[sz];
+                    const T gs = (nb + h2 * frow[x]) * inv_diag;
+                    *c += omega * (gs - *c);
+                }
+            }
+        }
+
+        // res = f + lap(u); returns ||res||_2.
+        template <typename T>
+        T padded_residual(PaddedGrid<T>& g, const T* f, T h, T* res) {
+            g.refresh();
+            const std::ptrdiff_t sy = static_cast<std::ptrdiff_t>(g.G.p[2]);
+            const std::ptrdiff_t sz = static_cast<std::ptrdiff_t>(g.G.p[2] * g.G.p[1]);
+            const std::size_t d = g.dims, nx = g.G.n[2];
+            const T inv_h2 = static_cast<T>(1) / (h * h);
+            const T centre = static_cast<T>(2 * d);
+            const std::ptrdiff_t rows = static_cast<std::ptrdiff_t>(g.rows());
+            T acc = static_cast<T>(0);
+
+            #pragma omp parallel for reduction(+:acc) schedule(static)
+            for (std::ptrdiff_t r = 0; r < rows; ++r) {
+                const T* row = g.row(static_cast<std::size_t>(r));
+                const T* frow = f + static_cast<std::size_t>(r) * nx;
+                T* rrow = res + static_cast<std::size_t>(r) * nx;
+                #pragma omp simd reduction(+:acc)
+                for (std::size_t x = 0; x < nx; ++x) {
+                    const T* c = row + x;
+                    T nb = c[-1] + c[1];
+                    if (d >= 2) nb += c[-sy] + c[sy];
+                    if (d >= 3) nb += c[-sz] + c[sz];
+                    const T v = frow[x] + (nb - centre * c[0]) * inv_h2;
+                    rrow[x] = v;
+                    acc += v * v;
+                }
+            }
+            return std::sqrt(acc);
+        }
+
+    } // namespace detail
+
+
+    // --- Red-black Gauss-Seidel / SOR ---
+
+    // In-place sweeps over the (2d + 1)-point Laplacian: all "red" points
+    // (i + j + k even) are relaxed first, then all "black" points, so each
+    // half-sweep is a parallel, unit-stride-2 loop.  omega = 1 gives Gauss-Seidel,
+    // 1 < omega < 2 over-relaxation.
+    template <typename T>
+    linalg::SolverResult<T> poisson_gauss_seidel(Tensor<T>& u, const Tensor<T>* f, T h, const Boundaries<T>& bc,
+                                                 T omega = static_cast<T>(1),
+                                                 const linalg::SolverOptions<T>& opts = {},
+                                                 std::size_t check_interval = 4) {
+        detail::check_poisson(u, f);
+        if (!(omega > static_cast<T>(0) && omega < static_cast<T>(2))) {
+            throw std::runtime_error("poisson_gauss_seidel: omega must lie in (0, 2).");
+        }
+        const Tensor<T> zero_rhs = f ? Tensor<T>(std::vector<std::size_t>{0}) : Tensor<T>(u.shape);
+        const Tensor<T>& rhs = f ? *f : zero_rhs;
+
+        detail::PaddedGrid<T> grid(u.shape, bc);
+        Tensor<T> r(u.shape);
+        grid.load(u.data.data());
+
+        linalg::SolverResult<T> res;
+        T rnorm = detail::padded_residual(grid, rhs.data.data(), h, r.data.data());
+        res.initial_residual = rnorm;
+        const T threshold = std::max(opts.rtol * rnorm, opts.atol);
+        if (linalg::detail::record(res, opts, rnorm, threshold)) { res.converged = true; return res; }
+
+        const std::size_t check = std::max<std::size_t>(1, check_interval);
+        while (res.iterations < opts.max_iter) {
+            const std::size_t n = std::min(check, opts.max_iter - res.iterations);
+            for (std::size_t it = 0; it < n; ++it) {
+                detail::rb_half_sweep(grid, rhs.data.data(), h, omega, 0);
+                detail::rb_half_sweep(grid, rhs.data.data(), h, omega, 1);
+            }
+            res.iterations += n;
+            res.matvecs += n;
+            rnorm = detail::padded_residual(grid, rhs.data.data(), h, r.data.data());
+            if (linalg::detail::record(res, opts, rnorm, threshold)) { res.converged = true; break; }
+        }
+        grid.store(u.data.data());
+        return res;
+    }
+
+} // namespace pde
+} // namespace tl
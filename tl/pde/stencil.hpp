@@ -0,0 +1,550 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <string>
+#include <stdexcept>
+#include <vector>
+
+// Constant-coefficient stencil engine for 1D / 2D / 3D grids stored as Tensor<T>
+// of shape [nx], [ny, nx] or [nz, ny, nx].
+//
+// Boundary conditions are imposed through ghost cells that sit just outside the
+// tensor on every face:
+//   Dirichlet : ghost = value
+//   Neumann   : ghost at distance k = mirrored interior point + 2 k h value,
+//               i.e. value is the outward normal derivative and h = spacing
+//   Periodic  : ghost wraps around to the opposite face
+//
+// StencilOperator sweeps the grid in cache-sized tiles (parallel across tiles).
+// iterate() additionally blocks in time: each tile is loaded once with a halo of
+// time_block * radius cells and advanced time_block steps before it is written
+// back, so repeated sweeps (explicit time stepping, Jacobi) stay in cache.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace pde {
+
+    // --- Stencil description ---
+
+    template <typename T>
+    struct StencilPoint {
+        std::array<std::ptrdiff_t, 3> offset{};   // per tensor axis; unused trailing entries are 0
+        T coeff = static_cast<T>(0);
+    };
+
+    template <typename T>
+    struct Stencil {
+        std::size_t dims = 0;
+        std::vector<StencilPoint<T>> points;
+
+        Stencil() = default;
+        explicit Stencil(std::size_t d) : dims(d) {
+            if (d < 1 || d > 3) throw std::runtime_error("Stencil supports 1, 2 or 3 dimensions.");
+        }
+
+        // Adds coeff at the given offset (one entry per axis); repeated offsets accumulate.
+        Stencil& add(const std::vector<std::ptrdiff_t>& offset, T coeff) {
+            if (offset.size() != dims) {
+                throw std::runtime_error("Stencil offset has " + std::to_string(offset.size()) +
+                                         " entries, expected " + std::to_string(dims));
+            }
+            std::array<std::ptrdiff_t, 3> o{};
+            std::copy(offset.begin(), offset.end(), o.begin());
+            for (auto& p : points) {
+                if (p.offset == o) { p.coeff += coeff; return *this; }
+            }
+            points.push_back({o, coeff});
+            return *this;
+        }
+
+        // Largest |offset| along axis a.
+        std::size_t radius(std::size_t a) const {
+            std::ptrdiff_t r = 0;
+            for (const auto& p : points) r = std::max(r, p.offset[a] < 0 ? -p.offset[a] : p.offset[a]);
+            return static_cast<std::size_t>(r);
+        }
+
+        // True if every point has a partner mirrored along axis a with the same coefficient.
+        bool symmetric(std::size_t a) const {
+            for (const auto& p : points) {
+                auto m = p.offset;
+                m[a] = -m[a];
+                bool found = false;
+                for (const auto& q : points)
+                    if (q.offset == m && q.coeff == p.coeff) { found = true; break; }
+                if (!found) return false;
+            }
+            return true;
+        }
+
+        Stencil operator*(T s) const {
+            Stencil r = *this;
+            for (auto& p : r.points) p.coeff *= s;
+            return r;
+        }
+
+        Stencil operator+(const Stencil& other) const {
+            if (dims != other.dims) throw std::runtime_error("Cannot add stencils of different dimensionality.");
+            Stencil r = *this;
+            for (const auto& p : other.points)
+                r.add(std::vector<std::ptrdiff_t>(p.offset.begin(), p.offset.begin() + dims), p.coeff);
+            // Drop points that cancelled out (e.g. the centre of a Jacobi sweep).
+            r.points.erase(std::remove_if(r.points.begin(), r.points.end(),
+                                          [](const StencilPoint<T>& q) { return q.coeff == static_cast<T>(0); }),
+                           r.points.end());
+            return r;
+        }
+
+        static Stencil identity(std::size_t d) {
+            Stencil s(d);
+            s.add(std::vector<std::ptrdiff_t>(d, 0), static_cast<T>(1));
+            return s;
+        }
+
+        // Standard (2d + 1)-point second-order Laplacian with grid spacing h.
+        static Stencil laplacian(std::size_t d, T h = static_cast<T>(1)) {
+            Stencil s(d);
+            const T inv_h2 = static_cast<T>(1) / (h * h);
+            s.add(std::vector<std::ptrdiff_t>(d, 0), static_cast<T>(-2) * static_cast<T>(d) * inv_h2);
+            for (std::size_t a = 0; a < d; ++a) {
+                std::vector<std::ptrdiff_t> o(d, 0);
+                o[a] = -1; s.add(o, inv_h2);
+                o[a] = +1; s.add(o, inv_h2);
+            }
+            return s;
+        }
+    };
+
+
+    // --- Boundary conditions ---
+
+    enum class BoundaryType { Dirichlet, Neumann, Periodic };
+
+    template <typename T>
+    struct BoundaryCondition {
+        BoundaryType type = BoundaryType::Dirichlet;
+        T value = static_cast<T>(0);
+    };
+
+    // One {low, high} pair per tensor axis.
+    template <typename T>
+    struct Boundaries {
+        std::vector<std::array<BoundaryCondition<T>, 2>> faces;
+        T spacing = static_cast<T>(1);   // grid spacing h used by Neumann ghosts
+
+        static Boundaries uniform(std::size_t dims, BoundaryCondition<T> bc, T h = static_cast<T>(1)) {
+            Boundaries b;
+            b.faces.assign(dims, {bc, bc});
+            b.spacing = h;
+            return b;
+        }
+
+        static Boundaries dirichlet(std::size_t dims, T value = static_cast<T>(0)) {
+            return uniform(dims, {BoundaryType::Dirichlet, value});
+        }
+
+        static Boundaries neumann(std::size_t dims, T flux = static_cast<T>(0), T h = static_cast<T>(1)) {
+            return uniform(dims, {BoundaryType::Neumann, flux}, h);
+        }
+
+        static Boundaries periodic(std::size_t dims) {
+            return uniform(dims, {BoundaryType::Periodic, static_cast<T>(0)});
+        }
+    };
+
+
+    struct TilingOptions {
+        std::size_t tile_x = 1024;
+        std::size_t tile_y = 32;
+        std::size_t tile_z = 8;
+        std::size_t time_block = 4;   // steps fused per tile load in iterate()
+    };
+
+
+    namespace detail {
+
+        // Index of the interior point that ghost cell `g` (may be < 0 or >= n) reads.
+        inline std::size_t wrap_index(std::ptrdiff_t g, std::size_t n) {
+            const std::ptrdiff_t m = static_cast<std::ptrdiff_t>(n);
+            return static_cast<std::size_t>(((g % m) + m) % m);
+        }
+
+        inline std::size_t reflect_index(std::ptrdiff_t g, std::size_t n) {
+            if (n == 1) return 0;
+            const std::ptrdiff_t period = 2 * (static_cast<std::ptrdiff_t>(n) - 1);
+            std::ptrdiff_t i = ((g % period) + period) % period;
+            if (i >= static_cast<std::ptrdiff_t>(n)) i = period - i;
+            return static_cast<std::size_t>(i);
+        }
+
+        // Grid geometry in internal (z, y, x) order; lower-rank grids use extent 1.
+        struct Geometry {
+            std::array<std::size_t, 3> n{1, 1, 1};   // interior extents
+            std::array<std::size_t, 3> g{0, 0, 0};   // ghost widths
+            std::array<std::size_t, 3> p{1, 1, 1};   // padded extents
+
+            void set_ghost(const std::array<std::size_t, 3>& ghost) {
+                g = ghost;
+                for (int a = 0; a < 3; ++a) p[a] = n[a] + 2 * g[a];
+            }
+            std::size_t padded_size() const { return p[0] * p[1] * p[2]; }
+        };
+
+        // Fills the ghost layers of a padded buffer whose interior is already set.
+        // Axes are filled x, then y, then z, each over the full padded extent of the
+        // already-filled axes, so edges and corners are covered.
+        // With as_source = true, ghosts only need to replicate data for periodic and
+        // Neumann faces (no flux term); Dirichlet ghosts are zeroed.
+        template <typename T>
+        void fill_ghosts(T* P, const Geometry& G,
+                         const std::array<std::array<BoundaryCondition<T>, 2>, 3>& bc,
+                         T spacing, bool as_source) {
+            const std::size_t PX = G.p[2], PY = G.p[1];
+            auto at = [&](std::size_t z, std::size_t y, std::size_t x) -> T& {
+                return P[(z * PY + y) * PX + x];
+            };
+
+            // Value of ghost cell at interior coordinate c (outside [0, n)) on axis a,
+            // given an accessor for interior coordinate -> value.
+            auto ghost_value = [&](std::size_t a, std::ptrdiff_t c, auto&& interior) -> T {
+                const std::size_t n = G.n[a];
+                const int face = c < 0 ? 0 : 1;
+                const auto& b = bc[a][face];
+                switch (b.type) {
+                    case BoundaryType::Dirichlet:
+                        return as_source ? static_cast<T>(0) : b.value;
+                    case BoundaryType::Periodic:
+                        return interior(wrap_index(c, n));
+                    case BoundaryType::Neumann: {
+                        const std::ptrdiff_t k = face == 0 ? -c : c - static_cast<std::ptrdiff_t>(n) + 1;
+                        const T v = interior(reflect_index(c, n));
+                        return as_source ? v : v + static_cast<T>(2 * k) * spacing * b.value;
+                    }
+                }
+                return static_cast<T>(0);
+            };
+
+            // x ghosts on interior rows
+            if (G.g[2] > 0) {
+                for (std::size_t z = G.g[0]; z < G.g[0] + G.n[0]; ++z)
+                    for (std::size_t y = G.g[1]; y < G.g[1] + G.n[1]; ++y) {
+                        T* row = &at(z, y, 0);
+                        auto interior = [&](std::size_t i) { return row[G.g[2] + i]; };
+                        for (std::size_t k = 1; k <= G.g[2]; ++k) {
+                            row[G.g[2] - k] = ghost_value(2, -static_cast<std::ptrdiff_t>(k), interior);
+                            row[G.g[2] + G.n[2] - 1 + k] =
+                                ghost_value(2, static_cast<std::ptrdiff_t>(G.n[2] - 1 + k), interior);
+                        }
+                    }
+            }
+            // y ghost rows (full padded width)
+            if (G.g[1] > 0) {
+                for (std::size_t z = G.g[0]; z < G.g[0] + G.n[0]; ++z)
+                    for (std::size_t x = 0; x < PX; ++x) {
+                        auto interior = [&](std::size_t i) { return at(z, G.g[1] + i, x); };
+                        for (std::size_t k = 1; k <= G.g[1]; ++k) {
+                            at(z, G.g[1] - k, x) = ghost_value(1, -static_cast<std::ptrdiff_t>(k), interior);
+                            at(z, G.g[1] + G.n[1] - 1 + k, x) =
+                                ghost_value(1, static_cast<std::ptrdiff_t>(G.n[1] - 1 + k), interior);
+                        }
+                    }
+            }
+            // z ghost planes (full padded plane)
+            if (G.g[0] > 0) {
+                for (std::size_t y = 0; y < PY; ++y)
+                    for (std::size_t x = 0; x < PX; ++x) {
+                        auto interior = [&](std::size_t i) { return at(G.g[0] + i, y, x); };
+                        for (std::size_t k = 1; k <= G.g[0]; ++k) {
+                            at(G.g[0] - k, y, x) = ghost_value(0, -static_cast<std::ptrdiff_t>(k), interior);
+                            at(G.g[0] + G.n[0] - 1 + k, y, x) =
+                                ghost_value(0, static_cast<std::ptrdiff_t>(G.n[0] - 1 + k), interior);
+                        }
+                    }
+            }
+        }
+
+        // Copies src into the interior of the padded buffer, then fills its ghosts.
+        template <typename T>
+        void fill_padded(const T* src, T* P, const Geometry& G,
+                         const std::array<std::array<BoundaryCondition<T>, 2>, 3>& bc,
+                         T spacing, bool as_source) {
+            for (std::size_t z = 0; z < G.n[0]; ++z)
+                for (std::size_t y = 0; y < G.n[1]; ++y)
+                    std::copy(src + (z * G.n[1] + y) * G.n[2], src + (z * G.n[1] + y + 1) * G.n[2],
+                              P + ((z + G.g[0]) * G.p[1] + y + G.g[1]) * G.p[2] + G.g[2]);
+            fill_ghosts(P, G, bc, spacing, as_source);
+        }
+
+        // out[i] = sum_p coeff[p] * in[i + off[p]]  (+ src_coeff * src[i])
+        // The point loop is outermost so each pass is a unit-stride, vectorisable FMA.
+        template <typename T>
+        inline void stencil_row(T* __restrict out, const T* __restrict in, std::size_t n,
+                                const std::ptrdiff_t* off, const T* coeff, std::size_t np,
+                                const T* __restrict src, T src_coeff) {
+            {
+                const T c = coeff[0];
+                const T* ip = in + off[0];
+                #pragma omp simd
+                for (std::size_t i = 0; i < n; ++i) out[i] = c * ip[i];
+            }
+            for (std::size_t p = 1; p < np; ++p) {
+                const T c = coeff[p];
+                const T* ip = in + off[p];
+                #pragma omp simd
+                for (std::size_t i = 0; i < n; ++i) out[i] += c * ip[i];
+            }
+            if (src) {
+                #pragma omp simd
+                for (std::size_t i = 0; i < n; ++i) out[i] += src_coeff * src[i];
+            }
+        }
+
+    } // namespace detail
+
+
+    // --- Stencil operator ---
+
+    template <typename T>
+    class StencilOperator {
+    public:
+        StencilOperator(Stencil<T> stencil, std::vector<std::size_t> shape,
+                        Boundaries<T> bc, TilingOptions tiling = {})
+            : stencil_(std::move(stencil)), shape_(std::move(shape)), tiling_(tiling) {
+            const std::size_t d = shape_.size();
+            if (d != stencil_.dims) {
+                throw std::runtime_error("Stencil dimensionality (" + std::to_string(stencil_.dims) +
+                                         ") does not match grid rank (" + std::to_string(d) + ")");
+            }
+            if (stencil_.points.empty()) throw std::runtime_error("Stencil has no points.");
+            if (bc.faces.size() != d) throw std::runtime_error("Boundaries must provide one face pair per axis.");
+            for (std::size_t a = 0; a < d; ++a) {
+                if (shape_[a] == 0) throw std::runtime_error("Stencil grid extents must be non-zero.");
+                const bool lo = bc.faces[a][0].type == BoundaryType::Periodic;
+                const bool hi = bc.faces[a][1].type == BoundaryType::Periodic;
+                if (lo != hi) throw std::runtime_error("Periodic boundaries must be set on both faces of an axis.");
+            }
+            if (tiling_.tile_x == 0 || tiling_.tile_y == 0 || tiling_.tile_z == 0) {
+                throw std::runtime_error("Tile sizes must be non-zero.");
+            }
+
+            // Map tensor axes onto internal (z, y, x).
+            const std::size_t shift = 3 - d;
+            spacing_ = bc.spacing;
+            for (int a = 0; a < 3; ++a) bc_[a] = {BoundaryCondition<T>{}, BoundaryCondition<T>{}};
+            for (std::size_t a = 0; a < d; ++a) {
+                geom_.n[shift + a] = shape_[a];
+                bc_[shift + a] = bc.faces[a];
+                radius_[shift + a] = stencil_.radius(a);
+            }
+            for (const auto& p : stencil_.points) {
+                std::array<std::ptrdiff_t, 3> o{0, 0, 0};
+                for (std::size_t a = 0; a < d; ++a) o[shift + a] = p.offset[a];
+                offsets_.push_back(o);
+                coeffs_.push_back(p.coeff);
+            }
+
+            // Temporal blocking keeps the halo consistent only if ghost cells evolve
+            // like the interior: true for periodic and homogeneous-Neumann faces with
+            // a stencil symmetric across that axis; Dirichlet ghosts are held fixed.
+            can_time_block_ = true;
+            for (std::size_t a = 0; a < d; ++a)
+                for (int f = 0; f < 2; ++f)
+                    if (bc.faces[a][f].type == BoundaryType::Neumann &&
+                        (bc.faces[a][f].value != static_cast<T>(0) || !stencil_.symmetric(a)))
+                        can_time_block_ = false;
+        }
+
+        const std::vector<std::size_t>& shape() const { return shape_; }
+
+        // out = S in (+ source_coeff * source). `in` and `out` may be the same tensor.
+        void apply(const Tensor<T>& in, Tensor<T>& out,
+                   const Tensor<T>* source = nullptr, T source_coeff = static_cast<T>(1)) {
+            check(in, "input");
+            if (out.shape != shape_) out = Tensor<T>(shape_);
+            if (source) check(*source, "source");
+            run(in.data.data(), out.data.data(), 1, source ? source->data.data() : nullptr, source_coeff);
+        }
+
+        // u <- S^steps u (each step adds source_coeff * source), with temporal blocking.
+        void iterate(Tensor<T>& u, std::size_t steps,
+                     const Tensor<T>* source = nullptr, T source_coeff = static_cast<T>(1)) {
+            check(u, "state");
+            if (source) check(*source, "source");
+            const std::size_t block = can_time_block_ ? std::max<std::size_t>(1, tiling_.time_block) : 1;
+            if (scratch_.data.size() != u.data.size()) scratch_ = Tensor<T>(shape_);
+            while (steps > 0) {
+                const std::size_t t = std::min(block, steps);
+                run(u.data.data(), scratch_.data.data(), t,
+                    source ? source->data.data() : nullptr, source_coeff);
+                std::swap(u.data, scratch_.data);
+                steps -= t;
+            }
+        }
+
+    private:
+        Stencil<T> stencil_;
+        std::vector<std::size_t> shape_;
+        TilingOptions tiling_;
+        T spacing_ = static_cast<T>(1);
+        std::array<std::array<BoundaryCondition<T>, 2>, 3> bc_;
+        std::array<std::size_t, 3> radius_{0, 0, 0};
+        std::vector<std::array<std::ptrdiff_t, 3>> offsets_;
+        std::vector<T> coeffs_;
+        bool can_time_block_ = true;
+
+        detail::Geometry geom_;
+        std::vector<T> padded_, padded_src_;   // reused across calls
+        Tensor<T> scratch_{std::vector<std::size_t>{0}};
+
+        void check(const Tensor<T>& t, const char* what) const {
+            if (t.shape != shape_) {
+                throw std::runtime_error(std::string("StencilOperator: ") + what +
+                                         " shape does not match the operator grid.");
+            }
+        }
+
+        // Advances `steps` applications of the stencil from src to dst.
+        void run(const T* src, T* dst, std::size_t steps, const T* source, T source_coeff) {
+            std::array<std::size_t, 3> ghost;
+            for (int a = 0; a < 3; ++a) ghost[a] = radius_[a] * steps;
+            geom_.set_ghost(ghost);
+            padded_.resize(geom_.padded_size());
+            detail::fill_padded(src, padded_.data(), geom_, bc_, spacing_, false);
+            if (source) {
+                padded_src_.resize(geom_.padded_size());
+                detail::fill_padded(source, padded_src_.data(), geom_, bc_, spacing_, true);
+            }
+            // From here on only the padded copies are read, so dst may alias src.
+
+            const std::array<std::size_t, 3> tile{
+                std::min(tiling_.tile_z, geom_.n[0]),
+                std::min(tiling_.tile_y, geom_.n[1]),
+                std::min(tiling_.tile_x, geom_.n[2])};
+            const std::array<std::size_t, 3> ntiles{
+                (geom_.n[0] + tile[0] - 1) / tile[0],
+                (geom_.n[1] + tile[1] - 1) / tile[1],
+                (geom_.n[2] + tile[2] - 1) / tile[2]};
+            const std::ptrdiff_t total = static_cast<std::ptrdiff_t>(ntiles[0] * ntiles[1] * ntiles[2]);
+
+            if (steps == 1) {
+                // Single sweep: read the padded grid directly, no tile copies needed.
+                const auto off = linear_offsets(geom_.p);
+                const std::size_t np = off.size();
+                #pragma omp parallel for schedule(dynamic)
+                for (std::ptrdiff_t t = 0; t < total; ++t) {
+                    const auto o = tile_origin(static_cast<std::size_t>(t), ntiles, tile);
+                    for (std::size_t z = o[0]; z < std::min(o[0] + tile[0], geom_.n[0]); ++z)
+                        for (std::size_t y = o[1]; y < std::min(o[1] + tile[1], geom_.n[1]); ++y) {
+                            const std::size_t x0 = o[2];
+                            const std::size_t nx = std::min(o[2] + tile[2], geom_.n[2]) - x0;
+                            const std::size_t pidx = ((z + geom_.g[0]) * geom_.p[1] + y + geom_.g[1]) * geom_.p[2]
+                                                     + x0 + geom_.g[2];
+                            detail::stencil_row(dst + (z * geom_.n[1] + y) * geom_.n[2] + x0,
+                                                padded_.data() + pidx, nx, off.data(), coeffs_.data(), np,
+                                                source ? padded_src_.data() + pidx : nullptr, source_coeff);
+                        }
+                }
+                return;
+            }
+
+            // Temporal blocking: copy tile + halo into thread-local ping-pong buffers,
+            // advance `steps` times on a shrinking region, write back the core.
+            const std::array<std::size_t, 3> local{
+                tile[0] + 2 * geom_.g[0], tile[1] + 2 * geom_.g[1], tile[2] + 2 * geom_.g[2]};
+            const auto off = linear_offsets(local);
+            const std::size_t np = off.size();
+
+            #pragma omp parallel
+            {
+                std::vector<T> A(local[0] * local[1] * local[2]);
+                std::vector<T> B(A.size());
+                std::vector<T> S(source ? A.size() : 0);
+
+                #pragma omp for schedule(dynamic)
+                for (std::ptrdiff_t t = 0; t < total; ++t) {
+                    const auto o = tile_origin(static_cast<std::size_t>(t), ntiles, tile);
+                    std::array<std::size_t, 3> core, ext;
+                    for (int a = 0; a < 3; ++a) {
+                        core[a] = std::min(o[a] + tile[a], geom_.n[a]) - o[a];
+                        ext[a] = core[a] + 2 * geom_.g[a];
+                    }
+                    // Local (0,0,0) corresponds to padded index o (global o - ghost).
+                    for (std::size_t z = 0; z < ext[0]; ++z)
+                        for (std::size_t y = 0; y < ext[1]; ++y) {
+                            const std::size_t pidx = ((o[0] + z) * geom_.p[1] + o[1] + y) * geom_.p[2] + o[2];
+                            const std::size_t lidx = (z * local[1] + y) * local[2];
+                            std::copy(padded_.data() + pidx, padded_.data() + pidx + ext[2], A.data() + lidx);
+                            std::copy(padded_.data() + pidx, padded_.data() + pidx + ext[2], B.data() + lidx);
+                            if (source)
+                                std::copy(padded_src_.data() + pidx, padded_src_.data() + pidx + ext[2], S.data() + lidx);
+                        }
+
+                    T* cur = A.data();
+                    T* nxt = B.data();
+                    for (std::size_t s = 1; s <= steps; ++s) {
+                        std::array<std::size_t, 3> lo, hi;
+                        for (int a = 0; a < 3; ++a) {
+                            const std::size_t e = radius_[a] * (steps - s);
+                            lo[a] = geom_.g[a] - e;
+                            hi[a] = geom_.g[a] + core[a] + e;
+                            // Dirichlet ghosts are fixed: never update outside the domain.
+                            const std::size_t dom_lo = geom_.g[a] > o[a] ? geom_.g[a] - o[a] : 0;
+                            const std::size_t dom_hi = geom_.g[a] + geom_.n[a] - o[a];
+                            if (bc_[a][0].type == BoundaryType::Dirichlet) lo[a] = std::max(lo[a], dom_lo);
+                            if (bc_[a][1].type == BoundaryType::Dirichlet) hi[a] = std::min(hi[a], dom_hi);
+                        }
+                        for (std::size_t z = lo[0]; z < hi[0]; ++z)
+                            for (std::size_t y = lo[1]; y < hi[1]; ++y) {
+                                const std::size_t lidx = (z * local[1] + y) * local[2] + lo[2];
+                                detail::stencil_row(nxt + lidx, cur + lidx, hi[2] - lo[2], off.data(),
+                                                    coeffs_.data(), np,
+                                                    source ? S.data() + lidx : nullptr, source_coeff);
+                            }
+                        std::swap(cur, nxt);
+                    }
+
+                    for (std::size_t z = 0; z < core[0]; ++z)
+                        for (std::size_t y = 0; y < core[1]; ++y) {
+                            const std::size_t lidx = ((z + geom_.g[0]) * local[1] + y + geom_.g[1]) * local[2] + geom_.g[2];
+                            std::copy(cur + lidx, cur + lidx + core[2],
+                                      dst + ((o[0] + z) * geom_.n[1] + o[1] + y) * geom_.n[2] + o[2]);
+                        }
+                }
+            }
+        }
+
+        std::vector<std::ptrdiff_t> linear_offsets(const std::array<std::size_t, 3>& ext) const {
+            std::vector<std::ptrdiff_t> off;
+            off.reserve(offsets_.size());
+            const std::ptrdiff_t sy = static_cast<std::ptrdiff_t>(ext[2]);
+            const std::ptrdiff_t sz = static_cast<std::ptrdiff_t>(ext[1] * ext[2]);
+            for (const auto& o : offsets_) off.push_back(o[0] * sz + o[1] * sy + o[2]);
+            return off;
+        }
+
+        static std::array<std::size_t, 3> tile_origin(std::size_t t, const std::array<std::size_t, 3>& ntiles,
+                                                      const std::array<std::size_t, 3>& tile) {
+            const std::size_t tx = t % ntiles[2];
+            const std::size_t ty = (t / ntiles[2]) % ntiles[1];
+            const std::size_t tz = t / (ntiles[2] * ntiles[1]);
+            return {tz * tile[0], ty * tile[1], tx * tile[2]};
+        }
+    };
+
+
+    // One-shot convenience: returns S u with the given boundary conditions.
+    template <typename T>
+    Tensor<T> apply_stencil(const Stencil<T>& stencil, const Tensor<T>& u, const Boundaries<T>& bc) {
+        StencilOperator<T> op(stencil, u.shape, bc);
+        Tensor<T> out(u.shape);
+        op.apply(u, out);
+        return out;
+    }
+
+} // namespace pde
+} // namespace tl
@@ -0,0 +1,329 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Tensor memory accounting.
+//
+// Every Tensor storage buffer is registered when a constructor or copy allocates it
+// and released when the tensor is destroyed or assigned over.  Buffers are keyed by
+// their data pointer, so swapping or moving storage between tensors keeps the books
+// straight.  The tracker answers:
+//
+//   memory_stats()             current / peak bytes, live tensors, allocation count
+//   largest_live_tensors(k)    the k biggest live buffers with shapes and the scope
+//                              that allocated them
+//   MemoryScope s("encoder")   per-scope bytes allocated, peak above the bytes live
+//                              at entry, net retained bytes and largest allocations
+//   dump_memory()              all of the above as a readable report
+//
+// Accounting is compiled in together with the profiler (TL_PROFILE).  Without it the
+// hooks in Tensor are no-ops and every query reports zero.  Storage resized directly
+// through the public data vector is not seen until it is released.
+//
+// Scopes nest and are per thread: allocations made on OpenMP worker threads count in
+// the global totals but not in the scopes of the thread that launched the region.
+
+namespace tl {
+namespace profile {
+
+    struct AllocationRecord {
+        std::size_t bytes = 0;
+        std::vector<std::size_t> shape;
+        std::string scope;                  // innermost MemoryScope on the allocating thread
+        std::uint64_t id = 0;               // allocation sequence number
+    };
+
+    struct MemoryStats {
+        std::size_t current_bytes = 0;
+        std::size_t peak_bytes = 0;
+        std::size_t live_tensors = 0;
+        std::uint64_t allocations = 0;
+        std::uint64_t frees = 0;
+        std::size_t total_allocated_bytes = 0;
+    };
+
+    struct MemoryScopeStats {
+        std::string name;
+        std::size_t allocated_bytes = 0;    // everything allocated inside the scope
+        std::size_t peak_bytes = 0;         // peak of the live total above its value at entry
+        std::ptrdiff_t net_bytes = 0;       // live total at exit (or now) minus at entry
+        std::uint64_t allocations = 0;
+        std::vector<AllocationRecord> largest;
+    };
+
+    class MemoryScope;
+
+    namespace detail {
+
+        constexpr std::size_t scope_largest_kept = 8;
+
+        struct LiveBuffer {
+            std::size_t bytes;
+            std::vector<std::size_t> shape;
+            std::string scope;
+            std::uint64_t id;
+        };
+
+        struct MemoryState {
+            std::mutex mutex;
+            MemoryStats stats;
+            std::unordered_map<const void*, LiveBuffer> live;
+            std::vector<MemoryScopeStats> finished_scopes;
+        };
+
+        inline MemoryState& memory_state() {
+            static MemoryState s;
+            return s;
+        }
+
+        // Tensor bytes allocated on this thread since start-up (read by profile::ScopedOp).
+        inline std::size_t& thread_allocated_bytes() {
+            thread_local std::size_t bytes = 0;
+            return bytes;
+        }
+
+        inline MemoryScope*& current_memory_scope() {
+            thread_local MemoryScope* scope = nullptr;
+            return scope;
+        }
+
+        // Keeps `list` sorted by size (largest first) and at most scope_largest_kept long.
+        inline void keep_largest(std::vector<AllocationRecord>& list, const AllocationRecord& r) {
+            if (list.size() == scope_largest_kept && list.back().bytes >= r.bytes) return;
+            auto pos = std::upper_bound(list.begin(), list.end(), r,
+                                        [](const AllocationRecord& a, const AllocationRecord& b) { return a.bytes > b.bytes; });
+            list.insert(pos, r);
+            if (list.size() > scope_largest_kept) list.pop_back();
+        }
+
+        inline void release_locked(MemoryState& s, std::unordered_map<const void*, LiveBuffer>::iterator it) {
+            s.stats.current_bytes -= it->second.bytes;
+            ++s.stats.frees;
+            s.live.erase(it);
+        }
+
+        inline void track_alloc(const void* ptr, std::size_t bytes, const std::vector<std::size_t>& shape);
+
+        inline void track_free(const void* ptr) {
+            if (!ptr) return;
+            auto& s = memory_state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            auto it = s.live.find(ptr);
+            if (it != s.live.end()) release_locked(s, it);
+        }
+
+    } // namespace detail
+
+
+    // --- Scopes ---
+
+    class MemoryScope {
+    public:
+        explicit MemoryScope(const char* name) : parent_(detail::current_memory_scope()) {
+            stats_.name = name;
+            auto& s = detail::memory_state();
+            {
+                std::lock_guard<std::mutex> lock(s.mutex);
+                baseline_ = s.stats.current_bytes;
+            }
+            detail::current_memory_scope() = this;
+        }
+
+        ~MemoryScope() {
+            detail::current_memory_scope() = parent_;
+            auto& s = detail::memory_state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            stats_.net_bytes = static_cast<std::ptrdiff_t>(s.stats.current_bytes) - static_cast<std::ptrdiff_t>(baseline_);
+            s.finished_scopes.push_back(std::move(stats_));
+        }
+
+        MemoryScope(const MemoryScope&) = delete;
+        MemoryScope& operator=(const MemoryScope&) = delete;
+
+        // Snapshot so far; net_bytes is measured against the current live total.
+        MemoryScopeStats stats() const {
+            auto& s = detail::memory_state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            MemoryScopeStats out = stats_;
+            out.net_bytes = static_cast<std::ptrdiff_t>(s.stats.current_bytes) - static_cast<std::ptrdiff_t>(baseline_);
+            return out;
+        }
+
+        const char* name() const { return stats_.name.c_str(); }
+
+    private:
+        friend void detail::track_alloc(const void*, std::size_t, const std::vector<std::size_t>&);
+
+        // Called with the tracker mutex held.
+        void note(const AllocationRecord& r, std::size_t current) {
+            stats_.allocated_bytes += r.bytes;
+            ++stats_.allocations;
+            if (current > baseline_) stats_.peak_bytes = std::max(stats_.peak_bytes, current - baseline_);
+            detail::keep_largest(stats_.largest, r);
+        }
+
+        MemoryScope* parent_;
+        std::size_t baseline_ = 0;
+        MemoryScopeStats stats_;
+    };
+
+    namespace detail {
+
+        inline void track_alloc(const void* ptr, std::size_t bytes, const std::vector<std::size_t>& shape) {
+            thread_allocated_bytes() += bytes;
+            if (!ptr || bytes == 0) return;
+            MemoryScope* scope = current_memory_scope();
+            auto& s = memory_state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+
+            // A buffer freed behind the tracker's back may come back at the same address.
+            auto stale = s.live.find(ptr);
+            if (stale != s.live.end()) release_locked(s, stale);
+
+            const std::uint64_t id = ++s.stats.allocations;
+            s.stats.current_bytes += bytes;
+            s.stats.total_allocated_bytes += bytes;
+            s.stats.peak_bytes = std::max(s.stats.peak_bytes, s.stats.current_bytes);
+            s.live.emplace(ptr, LiveBuffer{bytes, shape, scope ? scope->name() : "", id});
+
+            if (scope) {
+                const AllocationRecord r{bytes, shape, scope->name(), id};
+                for (MemoryScope* sc = scope; sc; sc = sc->parent_) sc->note(r, s.stats.current_bytes);
+            }
+        }
+
+    } // namespace detail
+
+
+    // --- Queries ---
+
+    inline MemoryStats memory_stats() {
+        auto& s = detail::memory_state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        MemoryStats out = s.stats;
+        out.live_tensors = s.live.size();
+        return out;
+    }
+
+    // Restarts peak tracking from the bytes live now.
+    inline void reset_peak_memory() {
+        auto& s = detail::memory_state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.stats.peak_bytes = s.stats.current_bytes;
+    }
+
+    inline std::vector<AllocationRecord> largest_live_tensors(std::size_t k = 10) {
+        std::vector<AllocationRecord> out;
+        {
+            auto& s = detail::memory_state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            out.reserve(s.live.size());
+            for (const auto& kv : s.live) out.push_back({kv.second.bytes, kv.second.shape, kv.second.scope, kv.second.id});
+        }
+        const auto by_size = [](const AllocationRecord& a, const AllocationRecord& b) {
+            return a.bytes != b.bytes ? a.bytes > b.bytes : a.id < b.id;
+        };
+        if (out.size() > k) {
+            std::partial_sort(out.begin(), out.begin() + static_cast<std::ptrdiff_t>(k), out.end(), by_size);
+            out.resize(k);
+        } else {
+            std::sort(out.begin(), out.end(), by_size);
+        }
+        return out;
+    }
+
+    // Scopes that have ended, in the order they ended.
+    inline std::vector<MemoryScopeStats> memory_scopes() {
+        auto& s = detail::memory_state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        return s.finished_scopes;
+    }
+
+    inline void clear_memory_scopes() {
+        auto& s = detail::memory_state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.finished_scopes.clear();
+    }
+
+    // --- Report ---
+
+    namespace detail {
+
+        inline std::string format_bytes(double bytes) {
+            char buf[32];
+            if (bytes >= 1024.0 * 1024.0 * 1024.0) std::snprintf(buf, sizeof(buf), "%.2f GB", bytes / (1024.0 * 1024.0 * 1024.0));
+            else if (bytes >= 1024.0 * 1024.0) std::snprintf(buf, sizeof(buf), "%.2f MB", bytes / (1024.0 * 1024.0));
+            else if (bytes >= 1024.0) std::snprintf(buf, sizeof(buf), "%.2f KB", bytes / 1024.0);
+            else std::snprintf(buf, sizeof(buf), "%.0f B", bytes);
+            return buf;
+        }
+
+        inline std::string format_shape(const std::vector<std::size_t>& shape) {
+            std::string s = "[";
+            for (std::size_t i = 0; i < shape.size(); ++i) s += (i ? "," : "") + std::to_string(shape[i]);
+            return s + "]";
+        }
+
+    } // namespace detail
+
+    // Global counters, the `top` largest live tensors and every finished scope.
+    inline void dump_memory(std::ostream& os = std::cout, std::size_t top = 10) {
+        const MemoryStats st = memory_stats();
+        os << "tensor memory: current " << detail::format_bytes(double(st.current_bytes))
+           << ", peak " << detail::format_bytes(double(st.peak_bytes))
+           << ", live tensors " << st.live_tensors
+           << ", allocations " << st.allocations << " (" << detail::format_bytes(double(st.total_allocated_bytes)) << ")"
+           << ", frees " << st.frees << "\n";
+
+        const auto live = largest_live_tensors(top);
+        if (!live.empty()) os << "largest live tensors:\n";
+        char line[256];
+        for (const auto& r : live) {
+            std::snprintf(line, sizeof(line), "  #%-8llu %12s  %-24s %s\n", static_cast<unsigned long long>(r.id),
+                          detail::format_bytes(double(r.bytes)).c_str(), detail::format_shape(r.shape).c_str(), r.scope.c_str());
+            os << line;
+        }
+
+        const auto scopes = memory_scopes();
+        if (!scopes.empty()) {
+            std::snprintf(line, sizeof(line), "%-24s %12s %12s %12s %8s  %s\n", "scope", "allocated", "peak", "net", "allocs", "largest");
+            os << line;
+        }
+        for (const auto& sc : scopes) {
+            const std::string net = (sc.net_bytes < 0 ? "-" : "") + detail::format_bytes(double(sc.net_bytes < 0 ? -sc.net_bytes : sc.net_bytes));
+            std::snprintf(line, sizeof(line), "%-24s %12s %12s %12s %8llu  %s\n", sc.name.c_str(),
+                          detail::format_bytes(double(sc.allocated_bytes)).c_str(), detail::format_bytes(double(sc.peak_bytes)).c_str(),
+                          net.c_str(), static_cast<unsigned long long>(sc.allocations),
+                          sc.largest.empty() ? "" : detail::format_shape(sc.largest.front().shape).c_str());
+            os << line;
+        }
+    }
+
+} // namespace profile
+} // namespace tl
+
+
+// --- Storage hooks (used by Tensor) ---
+
+#ifndef TL_PROFILE_CONCAT
+    #define TL_PROFILE_CONCAT_(a, b) a##b
+    #define TL_PROFILE_CONCAT(a, b) TL_PROFILE_CONCAT_(a, b)
+#endif
+
+#ifdef TL_PROFILE
+    #define TL_PROFILE_ALLOC(ptr, bytes, shape) ::tl::profile::detail::track_alloc(ptr, bytes, shape)
+    #define TL_PROFILE_FREE(ptr) ::tl::profile::detail::track_free(ptr)
+    #define TL_MEMORY_SCOPE(name) ::tl::profile::MemoryScope TL_PROFILE_CONCAT(tl_memory_scope_, __LINE__)(name)
+#else
+    #define TL_PROFILE_ALLOC(ptr, bytes, shape) ((void)0)
+    #define TL_PROFILE_FREE(ptr) ((void)0)
+    #define TL_MEMORY_SCOPE(name) ((void)0)
+#endif
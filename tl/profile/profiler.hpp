@@ -0,0 +1,312 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <functional>
+#include <initializer_list>
+#include <iostream>
+#include <map>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include "memory.hpp"
+
+// Op-level profiler.
+//
+// Instrumented kernels (the tensor operators, matmul / transpose, the reductions and
+// the functional:: kernels) open a ScopedOp through TL_PROFILE_OP.  While recording
+// is enabled each call produces an Event with its wall time, input shapes, FLOP count
+// and the tensor bytes allocated inside it:
+//
+//   profile::enable();
+//   auto y = functional::relu(linalg::matmul(x, w) + b);
+//   profile::disable();
+//   profile::print_summary();                       // per-op table, sorted by self time
+//   profile::write_chrome_trace("trace.json");      // chrome://tracing or ui.perfetto.dev
+//
+// Instrumentation is compiled in only when TL_PROFILE is defined (CMake: -DTL_PROFILE=ON).
+// Without it TL_PROFILE_OP and TL_PROFILE_SCOPE expand to no-ops and their arguments
+// are never evaluated.  With it, a call made while recording is disabled costs one
+// relaxed atomic load.
+//
+// Ops nest: matmul inside a user scope (TL_PROFILE_SCOPE) or inside another op is
+// recorded as a child.  Events carry both inclusive time and self time (children
+// excluded); the summary aggregates self time and self allocations so nested ops are
+// not counted twice.
+
+namespace tl {
+namespace profile {
+
+    struct Event {
+        std::string name;
+        std::string shapes;                 // e.g. "[64,128] [128,32]"
+        double flops = 0.0;
+        std::size_t bytes_allocated = 0;    // inclusive of nested ops
+        std::size_t self_bytes_allocated = 0;
+        std::int64_t start_ns = 0;          // since the profiler's time origin
+        std::int64_t duration_ns = 0;       // inclusive of nested ops
+        std::int64_t self_ns = 0;
+        int thread = 0;
+        int depth = 0;
+    };
+
+    struct OpSummary {
+        std::string name;
+        std::size_t calls = 0;
+        double self_ms = 0.0;
+        double total_ms = 0.0;              // inclusive; nested calls of the same op count twice
+        double min_ms = 0.0;
+        double max_ms = 0.0;
+        double flops = 0.0;
+        std::size_t bytes_allocated = 0;    // self
+
+        double gflops() const { return total_ms > 0.0 ? flops / (total_ms * 1e6) : 0.0; }
+    };
+
+
+    namespace detail {
+
+        using clock = std::chrono::steady_clock;
+
+        struct State {
+            std::atomic<bool> enabled{false};
+            std::atomic<int> next_thread{0};
+            std::mutex mutex;
+            std::vector<Event> events;
+            clock::time_point origin = clock::now();
+        };
+
+        inline State& state() {
+            static State s;
+            return s;
+        }
+
+        inline int thread_index() {
+            thread_local const int id = state().next_thread.fetch_add(1, std::memory_order_relaxed);
+            return id;
+        }
+
+        inline std::string format_shapes(std::initializer_list<std::reference_wrapper<const std::vector<std::size_t>>> shapes) {
+            std::string s;
+            for (const auto& ref : shapes) {
+                if (!s.empty()) s += ' ';
+                s += '[';
+                const auto& shape = ref.get();
+                for (std::size_t i = 0; i < shape.size(); ++i) {
+                    if (i) s += ',';
+                    s += std::to_string(shape[i]);
+                }
+                s += ']';
+            }
+            return s;
+        }
+
+        inline std::string json_escape(const std::string& s) {
+            std::string out;
+            for (char ch : s) {
+                if (ch == '"' || ch == '\\') out += '\\';
+                out += ch;
+            }
+            return out;
+        }
+
+    } // namespace detail
+
+
+    // --- Recording control ---
+
+    inline void enable() { detail::state().enabled.store(true, std::memory_order_relaxed); }
+    inline void disable() { detail::state().enabled.store(false, std::memory_order_relaxed); }
+    inline bool enabled() { return detail::state().enabled.load(std::memory_order_relaxed); }
+
+    // Drops all recorded events and restarts the trace clock.
+    inline void clear() {
+        auto& s = detail::state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        s.events.clear();
+        s.origin = detail::clock::now();
+    }
+
+    inline std::vector<Event> events() {
+        auto& s = detail::state();
+        std::lock_guard<std::mutex> lock(s.mutex);
+        return s.events;
+    }
+
+    // Enables recording for its lifetime, restoring the previous state afterwards.
+    class Session {
+    public:
+        explicit Session(bool clear_events = true) : was_enabled_(enabled()) {
+            if (clear_events) clear();
+            enable();
+        }
+        ~Session() { if (!was_enabled_) disable(); }
+        Session(const Session&) = delete;
+        Session& operator=(const Session&) = delete;
+
+    private:
+        bool was_enabled_;
+    };
+
+
+    // --- Scoped op ---
+
+    class ScopedOp {
+    public:
+        using Shapes = std::initializer_list<std::reference_wrapper<const std::vector<std::size_t>>>;
+
+        explicit ScopedOp(const char* name, double flops = 0.0, Shapes shapes = {}) {
+            if (!enabled()) return;
+            active_ = true;
+            name_ = name;
+            flops_ = flops;
+            shapes_ = detail::format_shapes(shapes);
+            parent_ = current();
+            depth_ = parent_ ? parent_->depth_ + 1 : 0;
+            current() = this;
+            alloc_start_ = detail::thread_allocated_bytes();
+            start_ = detail::clock::now();
+        }
+
+        ~ScopedOp() {
+            if (!active_) return;
+            const auto end = detail::clock::now();
+            current() = parent_;
+
+            Event e;
+            e.name = name_;
+            e.shapes = std::move(shapes_);
+            e.flops = flops_;
+            e.bytes_allocated = detail::thread_allocated_bytes() - alloc_start_;
+            e.self_bytes_allocated = e.bytes_allocated - child_bytes_;
+            e.duration_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start_).count();
+            e.self_ns = e.duration_ns - child_ns_;
+            e.thread = detail::thread_index();
+            e.depth = depth_;
+            if (parent_) {
+                parent_->child_ns_ += e.duration_ns;
+                parent_->child_bytes_ += e.bytes_allocated;
+            }
+
+            auto& s = detail::state();
+            std::lock_guard<std::mutex> lock(s.mutex);
+            e.start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(start_ - s.origin).count();
+            s.events.push_back(std::move(e));
+        }
+
+        ScopedOp(const ScopedOp&) = delete;
+        ScopedOp& operator=(const ScopedOp&) = delete;
+
+    private:
+        static ScopedOp*& current() {
+            thread_local ScopedOp* op = nullptr;
+            return op;
+        }
+
+        bool active_ = false;
+        const char* name_ = nullptr;
+        double flops_ = 0.0;
+        std::string shapes_;
+        ScopedOp* parent_ = nullptr;
+        int depth_ = 0;
+        std::size_t alloc_start_ = 0;
+        std::size_t child_bytes_ = 0;
+        std::int64_t child_ns_ = 0;
+        detail::clock::time_point start_;
+    };
+
+
+    // --- Reports ---
+
+    // Per-op aggregates, sorted by self time (descending).
+    inline std::vector<OpSummary> summary() {
+        std::map<std::string, OpSummary> by_name;
+        for (const auto& e : events()) {
+            auto& s = by_name[e.name];
+            const double ms = static_cast<double>(e.duration_ns) * 1e-6;
+            if (s.calls == 0) {
+                s.name = e.name;
+                s.min_ms = s.max_ms = ms;
+            }
+            ++s.calls;
+            s.self_ms += static_cast<double>(e.self_ns) * 1e-6;
+            s.total_ms += ms;
+            s.min_ms = std::min(s.min_ms, ms);
+            s.max_ms = std::max(s.max_ms, ms);
+            s.flops += e.flops;
+            s.bytes_allocated += e.self_bytes_allocated;
+        }
+        std::vector<OpSummary> out;
+        out.reserve(by_name.size());
+        for (auto& kv : by_name) out.push_back(std::move(kv.second));
+        std::stable_sort(out.begin(), out.end(), [](const OpSummary& a, const OpSummary& b) { return a.self_ms > b.self_ms; });
+        return out;
+    }
+
+    // Prints the summary as a table; `top` limits the number of rows (0 = all).
+    inline void print_summary(std::ostream& os = std::cout, std::size_t top = 0) {
+        const auto rows = summary();
+        double total_self = 0.0;
+        for (const auto& r : rows) total_self += r.self_ms;
+
+        char line[256];
+        std::snprintf(line, sizeof(line), "%-28s %8s %11s %7s %11s %10s %10s %9s %12s\n",
+                      "op", "calls", "self ms", "self%", "total ms", "mean ms", "max ms", "GFLOP/s", "alloc MB");
+        os << line;
+        const std::size_t n = top ? std::min(top, rows.size()) : rows.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            const auto& r = rows[i];
+            std::snprintf(line, sizeof(line), "%-28s %8zu %11.3f %6.1f%% %11.3f %10.4f %10.4f %9.2f %12.3f\n",
+                          r.name.c_str(), r.calls, r.self_ms, total_self > 0.0 ? 100.0 * r.self_ms / total_self : 0.0,
+                          r.total_ms, r.total_ms / static_cast<double>(r.calls), r.max_ms, r.gflops(),
+                          static_cast<double>(r.bytes_allocated) / (1024.0 * 1024.0));
+            os << line;
+        }
+    }
+
+    // Chrome trace-event JSON ("X" complete events, microsecond timestamps).
+    inline std::string chrome_trace() {
+        std::ostringstream out;
+        out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+        const auto evs = events();
+        for (std::size_t i = 0; i < evs.size(); ++i) {
+            const auto& e = evs[i];
+            out << (i ? ",\n" : "\n") << "  {\"name\": \"" << detail::json_escape(e.name) << "\", \"cat\": \"tl\", \"ph\": \"X\""
+                << ", \"ts\": " << static_cast<double>(e.start_ns) * 1e-3
+                << ", \"dur\": " << static_cast<double>(e.duration_ns) * 1e-3
+                << ", \"pid\": 1, \"tid\": " << e.thread
+                << ", \"args\": {\"shapes\": \"" << e.shapes << "\", \"flops\": " << e.flops
+                << ", \"bytes_allocated\": " << e.bytes_allocated << "}}";
+        }
+        out << "\n]}\n";
+        return out.str();
+    }
+
+    inline void write_chrome_trace(const std::string& path) {
+        std::ofstream f(path);
+        if (!f) throw std::runtime_error("Cannot open trace file: " + path);
+        f << chrome_trace();
+    }
+
+} // namespace profile
+} // namespace tl
+
+
+// --- Instrumentation macros ---
+
+#ifdef TL_PROFILE
+    // TL_PROFILE_OP("name", flops, shape, shape, ...): times the rest of the enclosing scope.
+    #define TL_PROFILE_OP(name, flops, ...) \
+        ::tl::profile::ScopedOp TL_PROFILE_CONCAT(tl_profile_op_, __LINE__)(name, static_cast<double>(flops), {__VA_ARGS__})
+    #define TL_PROFILE_SCOPE(name) ::tl::profile::ScopedOp TL_PROFILE_CONCAT(tl_profile_op_, __LINE__)(name)
+#else
+    #define TL_PROFILE_OP(name, flops, ...) ((void)sizeof(name))
+    #define TL_PROFILE_SCOPE(name) ((void)0)
+#endif
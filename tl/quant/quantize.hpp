@@ -0,0 +1,457 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#if defined(__AVX512VNNI__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+// Affine int8 / uint8 quantisation and a quantised GEMM.
+//
+//   real = scale * (q - zero_point)
+//
+// QParams holds one (scale, zero_point) pair for the whole tensor, or one pair per
+// index along `axis` (per-channel).
+//
+//   auto xq = quant::quantize<std::uint8_t>(x);                           // per tensor
+//   auto wq = quant::quantize<std::int8_t>(W, quant::choose_qparams<std::int8_t>(W, 1, true));
+//   quant::PackedWeights wp(wq);                                          // pack once
+//   auto y  = quant::qlinear(xq, wp, bias, true);                         // float out, fused ReLU
+//   auto yq = quant::qlinear(xq, wp, bias, out_params, true);             // requantised uint8
+//
+// qgemm multiplies uint8 activations [M, K] by int8 weights [K, N] into int32.
+// Weights are packed into 16-column panels with K interleaved in small groups.
+// The inner loop is one broadcast of activation bytes and one weight load per
+// group.  It uses AVX-512 VNNI (vpdpbusd, four products per lane) when available,
+// AVX2 otherwise (bytes widened to int16, then vpmaddwd), and a portable scalar
+// loop without either.  All three produce the same int32 sums.  qlinear's
+// epilogue removes the zero-point cross terms, rescales, adds the bias, applies
+// ReLU and optionally requantises, while each output tile is still in registers.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace quant {
+
+    struct QParams {
+        std::vector<float> scale;
+        std::vector<std::int32_t> zero_point;
+        int axis = -1;                          // -1: per tensor; otherwise the channel axis
+
+        bool per_channel() const { return axis >= 0; }
+    };
+
+    template <typename Q>
+    struct QTensor {
+        Tensor<Q> values;
+        QParams params;
+    };
+
+
+    namespace detail {
+
+        constexpr std::size_t quant_parallel_threshold = 1 << 15;
+        constexpr std::size_t qgemm_nr = 16;    // columns per packed panel
+        constexpr std::size_t qgemm_mr = 4;     // activation rows per register tile
+#if defined(__AVX512VNNI__)
+        constexpr std::size_t qgemm_group = 4;  // consecutive K values stored together per column
+#else
+        constexpr std::size_t qgemm_group = 2;
+#endif
+
+        template <typename Q>
+        constexpr void check_qtype() {
+            static_assert(std::is_same_v<Q, std::int8_t> || std::is_same_v<Q, std::uint8_t>,
+                          "quantisation supports int8_t and uint8_t");
+        }
+
+        // Scale and zero point covering [lo, hi], widened to contain 0 so zero is exact.
+        // Symmetric ranges centre the zero point (0 for int8, 128 for uint8).
+        template <typename Q>
+        void affine_params(float lo, float hi, bool symmetric, float& scale, std::int32_t& zp) {
+            constexpr std::int32_t qmin = std::numeric_limits<Q>::min(), qmax = std::numeric_limits<Q>::max();
+            if (!std::isfinite(lo) || !std::isfinite(hi)) throw std::runtime_error("quantize: input contains non-finite values.");
+            lo = std::min(lo, 0.0f);
+            hi = std::max(hi, 0.0f);
+            if (symmetric) {
+                zp = (qmin + qmax + 1) / 2;
+                scale = std::max(-lo, hi) / static_cast<float>(qmax - zp);
+            } else {
+                scale = (hi - lo) / static_cast<float>(qmax - qmin);
+            }
+            if (scale == 0.0f) scale = 1.0f;
+            if (!symmetric) {
+                zp = std::clamp(qmin - static_cast<std::int32_t>(std::nearbyint(lo / scale)), qmin, qmax);
+            }
+        }
+
+        // x viewed as [outer, channels, inner] around `axis`.
+        struct ChannelSplit { std::size_t outer, channels, inner; };
+
+        inline ChannelSplit channel_split(const std::vector<std::size_t>& shape, int axis, const char* op) {
+            if (axis < 0 || static_cast<std::size_t>(axis) >= shape.size()) {
+                throw std::runtime_error(std::string(op) + ": channel axis " + std::to_string(axis) +
+                                         " out of range for rank " + std::to_string(shape.size()) + ".");
+            }
+            ChannelSplit s{1, shape[static_cast<std::size_t>(axis)], 1};
+            for (std::size_t d = 0; d < static_cast<std::size_t>(axis); ++d) s.outer *= shape[d];
+            for (std::size_t d = static_cast<std::size_t>(axis) + 1; d < shape.size(); ++d) s.inner *= shape[d];
+            return s;
+        }
+
+        inline void check_params(const QParams& p, const std::vector<std::size_t>& shape, const char* op) {
+            const std::size_t want = p.per_channel() ? channel_split(shape, p.axis, op).channels : 1;
+            if (p.scale.size() != want || p.zero_point.size() != want) {
+                throw std::runtime_error(std::string(op) + ": expected " + std::to_string(want) +
+                                         " scale / zero-point pairs, got " + std::to_string(p.scale.size()) + ".");
+            }
+            for (float s : p.scale)
+                if (!(s > 0.0f) || !std::isfinite(s)) throw std::runtime_error(std::string(op) + ": scales must be positive and finite.");
+        }
+
+        // Calls fn(first, count, channel) for each contiguous run sharing one channel.
+        template <typename Fn>
+        void for_each_channel_run(const std::vector<std::size_t>& shape, const QParams& p, std::size_t n, Fn fn) {
+            if (!p.per_channel()) { fn(std::size_t(0), n, std::size_t(0)); return; }
+            const ChannelSplit s = channel_split(shape, p.axis, "quantize");
+            const std::ptrdiff_t runs = static_cast<std::ptrdiff_t>(s.outer * s.channels);
+            #pragma omp parallel for schedule(static) if(n > quant_parallel_threshold)
+            for (std::ptrdiff_t r = 0; r < runs; ++r) {
+                const std::size_t run = static_cast<std::size_t>(r);
+                fn(run * s.inner, s.inner, run % s.channels);
+            }
+        }
+
+        template <typename Q, typename T>
+        void quantize_span(const T* x, Q* q, std::size_t n, float scale, std::int32_t zp) {
+            constexpr float qmin = std::numeric_limits<Q>::min(), qmax = std::numeric_limits<Q>::max();
+            const float inv = 1.0f / scale, z = static_cast<float>(zp);
+            #pragma omp simd
+            for (std::size_t i = 0; i < n; ++i) {
+                const float v = std::nearbyint(static_cast<float>(x[i]) * inv) + z;
+                q[i] = static_cast<Q>(std::min(std::max(v, qmin), qmax));
+            }
+        }
+
+        inline std::uint32_t load_u32(const std::uint8_t* p) { std::uint32_t v; std::memcpy(&v, p, 4); return v; }
+        inline std::uint32_t load_u16_pair(const std::uint8_t* p) { return static_cast<std::uint32_t>(p[0]) | static_cast<std::uint32_t>(p[1]) << 16; }
+
+    } // namespace detail
+
+
+    // --- Parameter selection ---
+
+    // One (scale, zero point) for the whole tensor from its min / max.
+    template <typename Q, typename T>
+    QParams choose_qparams(const Tensor<T>& x, bool symmetric = false) {
+        detail::check_qtype<Q>();
+        if (x.data.empty()) throw std::runtime_error("choose_qparams: empty tensor.");
+        const auto [lo, hi] = std::minmax_element(x.data.begin(), x.data.end());
+        QParams p;
+        p.scale.resize(1);
+        p.zero_point.resize(1);
+        detail::affine_params<Q>(static_cast<float>(*lo), static_cast<float>(*hi), symmetric, p.scale[0], p.zero_point[0]);
+        return p;
+    }
+
+    // One (scale, zero point) per index of `axis`.
+    template <typename Q, typename T>
+    QParams choose_qparams(const Tensor<T>& x, int axis, bool symmetric) {
+        detail::check_qtype<Q>();
+        const detail::ChannelSplit s = detail::channel_split(x.shape, axis, "choose_qparams");
+        if (x.data.empty()) throw std::runtime_error("choose_qparams: empty tensor.");
+        std::vector<float> lo(s.channels, std::numeric_limits<float>::infinity());
+        std::vector<float> hi(s.channels, -std::numeric_limits<float>::infinity());
+        for (std::size_t o = 0; o < s.outer; ++o)
+            for (std::size_t c = 0; c < s.channels; ++c) {
+                const T* run = x.data.data() + (o * s.channels + c) * s.inner;
+                for (std::size_t i = 0; i < s.inner; ++i) {
+                    lo[c] = std::min(lo[c], static_cast<float>(run[i]));
+                    hi[c] = std::max(hi[c], static_cast<float>(run[i]));
+                }
+            }
+        QParams p;
+        p.axis = axis;
+        p.scale.resize(s.channels);
+        p.zero_point.resize(s.channels);
+        for (std::size_t c = 0; c < s.channels; ++c) detail::affine_params<Q>(lo[c], hi[c], symmetric, p.scale[c], p.zero_point[c]);
+        return p;
+    }
+
+    // --- Quantize / dequantize ---
+
+    // q = clamp(round(x / scale) + zero_point), rounding half to even.
+    template <typename Q, typename T>
+    QTensor<Q> quantize(const Tensor<T>& x, const QParams& p) {
+        detail::check_qtype<Q>();
+        detail::check_params(p, x.shape, "quantize");
+        QTensor<Q> q{Tensor<Q>(x.shape), p};
+        const T* src = x.data.data();
+        Q* dst = q.values.data.data();
+        detail::for_each_channel_run(x.shape, p, x.data.size(), [&](std::size_t first, std::size_t count, std::size_t c) {
+            detail::quantize_span(src + first, dst + first, count, p.scale[c], p.zero_point[c]);
+        });
+        return q;
+    }
+
+    // Per-tensor quantisation with parameters from choose_qparams.
+    template <typename Q, typename T>
+    QTensor<Q> quantize(const Tensor<T>& x, bool symmetric = false) {
+        return quantize<Q>(x, choose_qparams<Q>(x, symmetric));
+    }
+
+    template <typename T = float, typename Q>
+    Tensor<T> dequantize(const QTensor<Q>& q) {
+        detail::check_params(q.params, q.values.shape, "dequantize");
+        Tensor<T> x(q.values.shape);
+        const Q* src = q.values.data.data();
+        T* dst = x.data.data();
+        detail::for_each_channel_run(q.values.shape, q.params, x.data.size(), [&](std::size_t first, std::size_t count, std::size_t c) {
+            const float s = q.params.scale[c];
+            const std::int32_t z = q.params.zero_point[c];
+            #pragma omp simd
+            for (std::size_t i = first; i < first + count; ++i)
+                dst[i] = static_cast<T>(s * static_cast<float>(static_cast<std::int32_t>(src[i]) - z));
+        });
+        return x;
+    }
+
+
+    // --- Packed weights ---
+
+    // int8 weights [K, N] (per tensor, or per output channel with axis 1) in the
+    // qgemm panel layout: panel nb holds columns [16 nb, 16 nb + 16), and within it
+    // group g holds K rows [G g, G g + G) for every column, column-major.
+    // Padding rows and columns are zero.
+    class PackedWeights {
+    public:
+        explicit PackedWeights(const QTensor<std::int8_t>& w) {
+            using namespace detail;
+            if (w.values.shape.size() != 2) throw std::runtime_error("PackedWeights: weights must be 2-D [in, out].");
+            check_params(w.params, w.values.shape, "PackedWeights");
+            if (w.params.per_channel() && w.params.axis != 1) {
+                throw std::runtime_error("PackedWeights: per-channel weights must be quantised along axis 1 (output features).");
+            }
+            K_ = w.values.shape[0];
+            N_ = w.values.shape[1];
+            groups_ = (K_ + qgemm_group - 1) / qgemm_group;
+            const std::size_t panels = (N_ + qgemm_nr - 1) / qgemm_nr;
+            data_.assign(panels * groups_ * qgemm_nr * qgemm_group, 0);
+            col_sum_.assign(N_, 0);
+            scale_.resize(N_);
+            zero_point_.resize(N_);
+            for (std::size_t k = 0; k < K_; ++k)
+                for (std::size_t n = 0; n < N_; ++n) {
+                    const std::int8_t v = w.values.data[k * N_ + n];
+                    data_[((n / qgemm_nr * groups_ + k / qgemm_group) * qgemm_nr + n % qgemm_nr) * qgemm_group + k % qgemm_group] = v;
+                    col_sum_[n] += v;
+                }
+            for (std::size_t n = 0; n < N_; ++n) {
+                const std::size_t c = w.params.per_channel() ? n : 0;
+                scale_[n] = w.params.scale[c];
+                zero_point_[n] = w.params.zero_point[c];
+                has_zero_point_ = has_zero_point_ || zero_point_[n] != 0;
+            }
+        }
+
+        std::size_t rows() const { return K_; }
+        std::size_t cols() const { return N_; }
+        std::size_t panels() const { return (N_ + detail::qgemm_nr - 1) / detail::qgemm_nr; }
+        std::size_t groups() const { return groups_; }
+        const std::int8_t* panel(std::size_t nb) const { return data_.data() + nb * groups_ * detail::qgemm_nr * detail::qgemm_group; }
+
+        const std::vector<std::int32_t>& col_sum() const { return col_sum_; }
+        const std::vector<float>& scale() const { return scale_; }
+        const std::vector<std::int32_t>& zero_point() const { return zero_point_; }
+        bool has_zero_point() const { return has_zero_point_; }
+
+    private:
+        std::size_t K_ = 0, N_ = 0, groups_ = 0;
+        std::vector<std::int8_t> data_;
+        std::vector<std::int32_t> col_sum_;
+        std::vector<float> scale_;
+        std::vector<std::int32_t> zero_point_;
+        bool has_zero_point_ = false;
+    };
+
+
+    namespace detail {
+
+        // acc[r * NR + c] = sum_k a[r][k] * B[k][c] over one packed panel, for the
+        // MR rows in `rows` (rows past the matrix end repeat a valid row).
+        inline void qgemm_tile(const std::uint8_t* const* rows, std::size_t K, const std::int8_t* panel, std::int32_t* acc) {
+            constexpr std::size_t MR = qgemm_mr, NR = qgemm_nr, G = qgemm_group;
+            const std::size_t full = K / G;
+            // The last partial group is read from a zero-padded copy of each row's tail.
+            alignas(16) std::uint8_t tail[MR][G] = {};
+            if (K % G) {
+                for (std::size_t r = 0; r < MR; ++r) std::memcpy(tail[r], rows[r] + full * G, K % G);
+            }
+            const std::size_t groups = full + (K % G ? 1 : 0);
+            auto a_at = [&](std::size_t r, std::size_t g) { return g < full ? rows[r] + g * G : tail[r]; };
+
+#if defined(__AVX512VNNI__)
+            __m512i c[MR];
+            for (std::size_t r = 0; r < MR; ++r) c[r] = _mm512_setzero_si512();
+            for (std::size_t g = 0; g < groups; ++g) {
+                const __m512i b = _mm512_loadu_si512(panel + g * NR * G);
+                for (std::size_t r = 0; r < MR; ++r)
+                    c[r] = _mm512_dpbusd_epi32(c[r], _mm512_set1_epi32(static_cast<int>(load_u32(a_at(r, g)))), b);
+            }
+            for (std::size_t r = 0; r < MR; ++r) _mm512_storeu_si512(acc + r * NR, c[r]);
+#elif defined(__AVX2__)
+            // vpmaddubsw would saturate its int16 pair sums for large activations, so
+            // bytes are widened to int16 first and multiplied exactly with vpmaddwd.
+            __m256i c[MR][2];
+            for (std::size_t r = 0; r < MR; ++r) c[r][0] = c[r][1] = _mm256_setzero_si256();
+            for (std::size_t g = 0; g < groups; ++g) {
+                const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(panel + g * NR * G));
+                const __m256i b_lo = _mm256_cvtepi8_epi16(_mm256_castsi256_si128(b));
+                const __m256i b_hi = _mm256_cvtepi8_epi16(_mm256_extracti128_si256(b, 1));
+                for (std::size_t r = 0; r < MR; ++r) {
+                    const __m256i a = _mm256_set1_epi32(static_cast<int>(load_u16_pair(a_at(r, g))));
+                    c[r][0] = _mm256_add_epi32(c[r][0], _mm256_madd_epi16(a, b_lo));
+                    c[r][1] = _mm256_add_epi32(c[r][1], _mm256_madd_epi16(a, b_hi));
+                }
+            }
+            for (std::size_t r = 0; r < MR; ++r) {
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + r * NR), c[r][0]);
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(acc + r * NR + 8), c[r][1]);
+            }
+#else
+            std::fill(acc, acc + MR * NR, 0);
+            for (std::size_t g = 0; g < groups; ++g) {
+                const std::int8_t* b = panel + g * NR * G;
+                for (std::size_t r = 0; r < MR; ++r) {
+                    const std::uint8_t* a = a_at(r, g);
+                    for (std::size_t col = 0; col < NR; ++col)
+                        for (std::size_t j = 0; j < G; ++j)
+                            acc[r * NR + col] += static_cast<std::int32_t>(a[j]) * b[col * G + j];
+                }
+            }
+#endif
+        }
+
+        // Runs every (MR x NR) tile of a[M, K] * W and hands it to
+        // emit(row0, rows, col0, cols, acc) with acc laid out [MR][NR].
+        template <typename Emit>
+        void qgemm_run(const std::uint8_t* a, std::size_t M, std::size_t K, const PackedWeights& w, Emit emit) {
+            constexpr std::size_t MR = qgemm_mr, NR = qgemm_nr;
+            const std::size_t N = w.cols(), panels = w.panels();
+            const std::ptrdiff_t tiles = static_cast<std::ptrdiff_t>((M + MR - 1) / MR * panels);
+            #pragma omp parallel for schedule(static) if(M * K * N > quant_parallel_threshold)
+            for (std::ptrdiff_t t = 0; t < tiles; ++t) {
+                const std::size_t i0 = static_cast<std::size_t>(t) / panels * MR, nb = static_cast<std::size_t>(t) % panels;
+                const std::size_t mr = std::min(MR, M - i0);
+                const std::uint8_t* rows[MR];
+                for (std::size_t r = 0; r < MR; ++r) rows[r] = a + (i0 + std::min(r, mr - 1)) * K;
+                alignas(64) std::int32_t acc[MR * NR];
+                qgemm_tile(rows, K, w.panel(nb), acc);
+                emit(i0, mr, nb * NR, std::min(NR, N - nb * NR), static_cast<const std::int32_t*>(acc));
+            }
+        }
+
+        inline void check_qgemm(const std::vector<std::size_t>& a_shape, const PackedWeights& w, const char* op) {
+            if (a_shape.size() != 2) throw std::runtime_error(std::string(op) + ": activations must be 2-D [batch, in].");
+            if (a_shape[1] != w.rows()) {
+                throw std::runtime_error(std::string(op) + ": inner dimensions differ (" + std::to_string(a_shape[1]) +
+                                         " vs " + std::to_string(w.rows()) + ").");
+            }
+        }
+
+        // Shared qlinear epilogue: real(i, n) = sa * sw[n] * (acc - za * colsum[n] - zw[n] * rowsum[i]
+        // + K * za * zw[n]) + bias[n], optionally clamped at 0, handed to store(i, n, real).
+        template <typename Store>
+        void qlinear_run(const QTensor<std::uint8_t>& x, const PackedWeights& w, const Tensor<float>& bias, bool relu,
+                         const char* op, Store store) {
+            check_qgemm(x.values.shape, w, op);
+            if (x.params.per_channel()) throw std::runtime_error(std::string(op) + ": activations must be quantised per tensor.");
+            check_params(x.params, x.values.shape, op);
+            const std::size_t M = x.values.shape[0], K = w.rows(), N = w.cols();
+            if (bias.data.size() != N) throw std::runtime_error(std::string(op) + ": bias must have one entry per output feature.");
+
+            const float sa = x.params.scale[0];
+            const std::int32_t za = x.params.zero_point[0];
+            std::vector<float> mult(N);
+            std::vector<std::int32_t> offset(N);
+            for (std::size_t n = 0; n < N; ++n) {
+                mult[n] = sa * w.scale()[n];
+                offset[n] = static_cast<std::int32_t>(K) * za * w.zero_point()[n] - za * w.col_sum()[n];
+            }
+            std::vector<std::int32_t> row_sum;
+            if (w.has_zero_point()) {
+                row_sum.assign(M, 0);
+                for (std::size_t i = 0; i < M; ++i)
+                    for (std::size_t k = 0; k < K; ++k) row_sum[i] += x.values.data[i * K + k];
+            }
+            const float* b = bias.data.data();
+            qgemm_run(x.values.data.data(), M, K, w, [&](std::size_t i0, std::size_t mr, std::size_t n0, std::size_t nc,
+                                                          const std::int32_t* acc) {
+                for (std::size_t r = 0; r < mr; ++r) {
+                    const std::int32_t rs = row_sum.empty() ? 0 : row_sum[i0 + r];
+                    for (std::size_t c = 0; c < nc; ++c) {
+                        const std::size_t n = n0 + c;
+                        const std::int32_t v = acc[r * qgemm_nr + c] + offset[n] - w.zero_point()[n] * rs;
+                        float y = mult[n] * static_cast<float>(v) + b[n];
+                        if (relu) y = std::max(y, 0.0f);
+                        store(i0 + r, n, y);
+                    }
+                }
+            });
+        }
+
+    } // namespace detail
+
+
+    // --- Quantised GEMM ---
+
+    // Raw int32 products a[M, K] * W[K, N] of the stored integers (no zero-point correction).
+    inline Tensor<std::int32_t> qgemm(const Tensor<std::uint8_t>& a, const PackedWeights& w) {
+        detail::check_qgemm(a.shape, w, "qgemm");
+        const std::size_t M = a.shape[0], N = w.cols();
+        Tensor<std::int32_t> c({M, N});
+        detail::qgemm_run(a.data.data(), M, a.shape[1], w, [&](std::size_t i0, std::size_t mr, std::size_t n0, std::size_t nc,
+                                                               const std::int32_t* acc) {
+            for (std::size_t r = 0; r < mr; ++r)
+                std::copy(acc + r * detail::qgemm_nr, acc + r * detail::qgemm_nr + nc, c.data.data() + (i0 + r) * N + n0);
+        });
+        return c;
+    }
+
+    // x @ W + bias with float output (dequantised in the epilogue).
+    inline Tensor<float> qlinear(const QTensor<std::uint8_t>& x, const PackedWeights& w, const Tensor<float>& bias,
+                                 bool relu = false) {
+        Tensor<float> y({x.values.shape.empty() ? 0 : x.values.shape[0], w.cols()});
+        float* out = y.data.data();
+        const std::size_t N = w.cols();
+        detail::qlinear_run(x, w, bias, relu, "qlinear", [=](std::size_t i, std::size_t n, float v) { out[i * N + n] = v; });
+        return y;
+    }
+
+    // x @ W + bias requantised to uint8 with the (per-tensor) output parameters `out`.
+    inline QTensor<std::uint8_t> qlinear(const QTensor<std::uint8_t>& x, const PackedWeights& w, const Tensor<float>& bias,
+                                         const QParams& out, bool relu = false) {
+        QTensor<std::uint8_t> y{Tensor<std::uint8_t>({x.values.shape.empty() ? 0 : x.values.shape[0], w.cols()}), out};
+        if (out.per_channel()) throw std::runtime_error("qlinear: output parameters must be per tensor.");
+        detail::check_params(out, y.values.shape, "qlinear");
+        const float inv = 1.0f / out.scale[0], z = static_cast<float>(out.zero_point[0]);
+        std::uint8_t* q = y.values.data.data();
+        const std::size_t N = w.cols();
+        detail::qlinear_run(x, w, bias, relu, "qlinear", [=](std::size_t i, std::size_t n, float v) {
+            q[i * N + n] = static_cast<std::uint8_t>(std::min(std::max(std::nearbyint(v * inv) + z, 0.0f), 255.0f));
+        });
+        return y;
+    }
+
+} // namespace quant
+} // namespace tl
@@ -0,0 +1,249 @@
+#pragma once
+
+#include "../tensor_core/tensor.hpp"
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+// Counter-based random tensors (Philox4x32-10).
+//
+// Element i of a fill is a pure function of (seed, stream offset, i): block i / E
+// of the call is encrypted with the seed as key, and each 128-bit output block
+// feeds E consecutive elements.  E is 4 for 32-bit draws and 2 for doubles.
+// Results are therefore bit-identical for any thread count or schedule.  Each
+// call advances the Generator's offset past the blocks it used, so consecutive
+// calls draw fresh numbers.
+//
+//   Generator gen(seed);
+//   auto W = tl::random::normal<float>({784, 64}, 0.0f, 0.05f, gen);
+//   tl::random::fill_uniform(b, -0.1f, 0.1f, gen);
+//
+// Factories: uniform, normal, bernoulli, randint; fill_* variants write in place.
+// Calls without a generator use default_generator() (seed 0), which is not
+// synchronised: share it across threads only between parallel regions.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+namespace random {
+
+    class Generator {
+    public:
+        explicit Generator(std::uint64_t seed = 0) : seed_(seed) {}
+
+        std::uint64_t seed() const { return seed_; }
+        std::uint64_t offset() const { return offset_; }
+
+        void manual_seed(std::uint64_t seed) { seed_ = seed; offset_ = 0; }
+        void set_offset(std::uint64_t offset) { offset_ = offset; }
+
+        // Reserves `blocks` counter values and returns the first one.
+        std::uint64_t advance(std::uint64_t blocks) {
+            const std::uint64_t first = offset_;
+            offset_ += blocks;
+            return first;
+        }
+
+    private:
+        std::uint64_t seed_;
+        std::uint64_t offset_ = 0;
+    };
+
+    inline Generator& default_generator() {
+        static Generator gen;
+        return gen;
+    }
+
+
+    namespace detail {
+
+        constexpr std::size_t random_parallel_threshold = 1 << 15;
+        constexpr std::size_t philox_batch = 8;
+
+        struct Block { std::uint32_t w[4]; };
+
+        // Philox4x32 with 10 rounds on counter (c0..c3) and key (k0, k1).
+        inline Block philox4x32(std::uint32_t c0, std::uint32_t c1, std::uint32_t c2, std::uint32_t c3,
+                                std::uint32_t k0, std::uint32_t k1) {
+            for (int r = 0; r < 10; ++r) {
+                const std::uint64_t p0 = static_cast<std::uint64_t>(0xD2511F53u) * c0;
+                const std::uint64_t p1 = static_cast<std::uint64_t>(0xCD9E8D57u) * c2;
+                const std::uint32_t n0 = static_cast<std::uint32_t>(p1 >> 32) ^ c1 ^ k0;
+                const std::uint32_t n2 = static_cast<std::uint32_t>(p0 >> 32) ^ c3 ^ k1;
+                c0 = n0;
+                c1 = static_cast<std::uint32_t>(p1);
+                c2 = n2;
+                c3 = static_cast<std::uint32_t>(p0);
+                k0 += 0x9E3779B9u;
+                k1 += 0xBB67AE85u;
+            }
+            return {{c0, c1, c2, c3}};
+        }
+
+        // Calls emit(block_index, Block) for blocks [0, blocks) of the stream starting at
+        // counter `first`.  Blocks are generated in SIMD batches and split across threads.
+        template <typename Emit>
+        void for_each_block(std::uint64_t seed, std::uint64_t first, std::size_t blocks, std::size_t elements, Emit emit) {
+            const std::uint32_t k0 = static_cast<std::uint32_t>(seed), k1 = static_cast<std::uint32_t>(seed >> 32);
+            const std::ptrdiff_t batches = static_cast<std::ptrdiff_t>((blocks + philox_batch - 1) / philox_batch);
+            #pragma omp parallel for schedule(static) if(elements > random_parallel_threshold)
+            for (std::ptrdiff_t b = 0; b < batches; ++b) {
+                const std::size_t begin = static_cast<std::size_t>(b) * philox_batch;
+                Block out[philox_batch]{};
+                #pragma omp simd
+                for (std::size_t j = 0; j < philox_batch; ++j) {
+                    const std::uint64_t ctr = first + begin + j;
+                    out[j] = philox4x32(static_cast<std::uint32_t>(ctr), static_cast<std::uint32_t>(ctr >> 32), 0u, 0u, k0, k1);
+                }
+                const std::size_t end = std::min(begin + philox_batch, blocks);
+                for (std::size_t j = begin; j < end; ++j) emit(j, out[j - begin]);
+            }
+        }
+
+        // Draws one 32-bit word per element: fn(i, word) for i in [0, n).
+        template <typename Fn>
+        void for_each_word(Generator& gen, std::size_t n, Fn fn) {
+            const std::size_t blocks = (n + 3) / 4;
+            const std::uint64_t first = gen.advance(blocks);
+            for_each_block(gen.seed(), first, blocks, n, [&](std::size_t blk, const Block& b) {
+                const std::size_t base = blk * 4;
+                const std::size_t m = std::min<std::size_t>(4, n - base);
+                for (std::size_t k = 0; k < m; ++k) fn(base + k, b.w[k]);
+            });
+        }
+
+        // Uniform [0, 1) from 24 (float) or 53 (double) random bits.
+        inline float unit_float(std::uint32_t w) { return static_cast<float>(w >> 8) * (1.0f / 16777216.0f); }
+        inline double unit_double(std::uint32_t hi, std::uint32_t lo) {
+            const std::uint64_t bits = (static_cast<std::uint64_t>(hi) << 32 | lo) >> 11;
+            return static_cast<double>(bits) * (1.0 / 9007199254740992.0);
+        }
+
+        // Fills n uniforms in [0, 1) as U, E per block: fn(i, u).
+        template <typename U, typename Fn>
+        void for_each_unit(Generator& gen, std::size_t n, Fn fn) {
+            constexpr std::size_t E = std::is_same_v<U, double> ? 2 : 4;
+            const std::size_t blocks = (n + E - 1) / E;
+            const std::uint64_t first = gen.advance(blocks);
+            for_each_block(gen.seed(), first, blocks, n, [&](std::size_t blk, const Block& b) {
+                const std::size_t base = blk * E;
+                U u[E] = {};
+                if constexpr (E == 2) {
+                    u[0] = unit_double(b.w[0], b.w[1]);
+                    u[1] = unit_double(b.w[2], b.w[3]);
+                } else {
+                    for (std::size_t k = 0; k < 4; ++k) u[k] = static_cast<U>(unit_float(b.w[k]));
+                }
+                // A constant count for full blocks lets the callee's loop unroll over u[0..E);
+                // with a runtime bound GCC vectorises it wider than E and warns about u.
+                if (n - base >= E) fn(base, u, E);
+                else fn(base, u, n - base);
+            });
+        }
+
+        template <typename T>
+        using unit_t = std::conditional_t<std::is_same_v<T, double> || std::is_same_v<T, long double>, double, float>;
+
+        inline std::size_t volume(const std::vector<std::size_t>& shape) {
+            std::size_t n = 1;
+            for (auto d : shape) n *= d;
+            return n;
+        }
+
+    } // namespace detail
+
+
+    // --- In-place fills ---
+
+    template <typename T>
+    void fill_uniform(Tensor<T>& t, T low = static_cast<T>(0), T high = static_cast<T>(1), Generator& gen = default_generator()) {
+        static_assert(std::is_floating_point_v<T>, "fill_uniform requires a floating-point tensor; use fill_randint for integers.");
+        if (!(low <= high)) throw std::runtime_error("uniform: low must not exceed high.");
+        T* d = t.data.data();
+        const T span = high - low;
+        detail::for_each_unit<detail::unit_t<T>>(gen, t.data.size(), [=](std::size_t i, const auto* u, std::size_t m) {
+            for (std::size_t k = 0; k < m; ++k) d[i + k] = low + span * static_cast<T>(u[k]);
+        });
+    }
+
+    // Box-Muller on consecutive pairs of uniforms.
+    template <typename T>
+    void fill_normal(Tensor<T>& t, T mean = static_cast<T>(0), T stddev = static_cast<T>(1), Generator& gen = default_generator()) {
+        static_assert(std::is_floating_point_v<T>, "fill_normal requires a floating-point tensor.");
+        if (!(stddev >= static_cast<T>(0))) throw std::runtime_error("normal: stddev must be non-negative.");
+        using U = detail::unit_t<T>;
+        T* d = t.data.data();
+        const std::size_t n = t.data.size();
+        detail::for_each_unit<U>(gen, n, [=](std::size_t i, const U* u, std::size_t m) {
+            for (std::size_t k = 0; k < m; k += 2) {
+                const U r = std::sqrt(static_cast<U>(-2) * std::log(static_cast<U>(1) - u[k]));
+                const U theta = static_cast<U>(6.283185307179586476925) * u[k + 1];
+                d[i + k] = mean + stddev * static_cast<T>(r * std::cos(theta));
+                if (k + 1 < m) d[i + k + 1] = mean + stddev * static_cast<T>(r * std::sin(theta));
+            }
+        });
+    }
+
+    // 1 with probability p, else 0.
+    template <typename T>
+    void fill_bernoulli(Tensor<T>& t, double p = 0.5, Generator& gen = default_generator()) {
+        if (!(p >= 0.0 && p <= 1.0)) throw std::runtime_error("bernoulli: p must lie in [0, 1].");
+        T* d = t.data.data();
+        const std::uint64_t threshold = static_cast<std::uint64_t>(p * 4294967296.0);
+        detail::for_each_word(gen, t.data.size(), [=](std::size_t i, std::uint32_t w) {
+            d[i] = static_cast<std::uint64_t>(w) < threshold ? static_cast<T>(1) : static_cast<T>(0);
+        });
+    }
+
+    // Integers in [low, high), by multiply-shift on a 32-bit word (range at most 2^32).
+    template <typename T>
+    void fill_randint(Tensor<T>& t, std::int64_t low, std::int64_t high, Generator& gen = default_generator()) {
+        if (high <= low) throw std::runtime_error("randint: high must exceed low.");
+        const std::uint64_t range = static_cast<std::uint64_t>(high - low);
+        if (range > (std::uint64_t(1) << 32)) throw std::runtime_error("randint: range wider than 2^32.");
+        T* d = t.data.data();
+        detail::for_each_word(gen, t.data.size(), [=](std::size_t i, std::uint32_t w) {
+            d[i] = static_cast<T>(low + static_cast<std::int64_t>((static_cast<std::uint64_t>(w) * range) >> 32));
+        });
+    }
+
+    // --- Factories ---
+
+    template <typename T>
+    Tensor<T> uniform(const std::vector<std::size_t>& shape, T low = static_cast<T>(0), T high = static_cast<T>(1),
+                      Generator& gen = default_generator()) {
+        Tensor<T> t(shape);
+        fill_uniform(t, low, high, gen);
+        return t;
+    }
+
+    template <typename T>
+    Tensor<T> normal(const std::vector<std::size_t>& shape, T mean = static_cast<T>(0), T stddev = static_cast<T>(1),
+                     Generator& gen = default_generator()) {
+        Tensor<T> t(shape);
+        fill_normal(t, mean, stddev, gen);
+        return t;
+    }
+
+    template <typename T>
+    Tensor<T> bernoulli(const std::vector<std::size_t>& shape, double p = 0.5, Generator& gen = default_generator()) {
+        Tensor<T> t(shape);
+        fill_bernoulli(t, p, gen);
+        return t;
+    }
+
+    template <typename T>
+    Tensor<T> randint(const std::vector<std::size_t>& shape, std::int64_t low, std::int64_t high,
+                      Generator& gen = default_generator()) {
+        Tensor<T> t(shape);
+        fill_randint(t, low, high, gen);
+        return t;
+    }
+
+} // namespace random
+} // namespace tl
@@ -0,0 +1,590 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "tensor.hpp"
+#include "broadcasting.hpp"
+#include "promotion.hpp"
+#include "indexing.hpp"
+#if defined(__AVX__)
+#include <immintrin.h>
+#endif
+
+// Element-wise comparisons, logical ops and boolean masks.
+//
+//   a == b, a != b, a < b, a <= b, a > b, a >= b     Tensor<mask_t> (1 / 0), broadcasting;
+//                                                    mixed tensors compare in promote_t; a scalar
+//                                                    on either side is weak, as in arithmetic
+//   logical_and / logical_or / logical_xor / logical_not   non-zero is true
+//   any, all, count_nonzero                          whole-tensor reductions
+//   nonzero(t)                                       [count, rank] coordinates of the non-zeros
+//
+// Masks are Tensor<std::uint8_t> (one byte per element; std::vector<bool> has no
+// contiguous storage to hand to kernels).  For large filtering steps BitMask stores
+// one bit per element, 8x smaller than a byte mask and 32x smaller than a float one:
+//
+//   BitMask keep = compare_bits(scores, Cmp::Gt, 0.5f);   // packed straight from the compare
+//   auto kept = masked_select(values, keep);               // walks the set bits
+//   BitMask both = keep & BitMask::pack(valid);            // word-wise logic
+//
+// compare_bits on float / double uses AVX compare + movemask (8 or 4 lanes per
+// instruction) when the target has AVX, and a portable bit-assembly loop otherwise.
+// Comparisons follow C++ semantics: NaN compares unequal to everything.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+
+using mask_t = std::uint8_t;
+
+enum class Cmp { Eq, Ne, Lt, Le, Gt, Ge };
+
+namespace detail {
+
+    constexpr std::size_t compare_parallel_threshold = 1 << 15;
+    constexpr std::size_t any_chunk = 1 << 12;            // elements tested between early-exit checks
+
+    template <typename T>
+    inline bool truthy(const T& v) { return v != T(0); }
+
+    template <typename C>
+    inline bool compare(Cmp op, const C& x, const C& y) {
+        if constexpr (is_complex_v<C>) {
+            return op == Cmp::Eq ? x == y : x != y;           // ordering rejected by check_orderable
+        } else {
+            switch (op) {
+                case Cmp::Eq: return x == y;
+                case Cmp::Ne: return x != y;
+                case Cmp::Lt: return x < y;
+                case Cmp::Le: return x <= y;
+                case Cmp::Gt: return x > y;
+                case Cmp::Ge: return x >= y;
+            }
+            return false;
+        }
+    }
+
+    // Called before any kernel: an exception must not escape an OpenMP region.
+    template <typename C>
+    void check_orderable(Cmp op) {
+        if (is_complex_v<C> && op != Cmp::Eq && op != Cmp::Ne)
+            throw std::runtime_error("complex values support only == and !=.");
+    }
+
+    // Compute type for comparing an A with a B.
+    template <typename A, typename B>
+    using compare_t = accum_t<promote_t<A, B>>;
+
+    // out[i] = f(a[i], b[i]) over the broadcast shape.
+    template <typename A, typename B, typename F>
+    Tensor<mask_t> mask_binary(const Tensor<A>& a, const Tensor<B>& b, F f, const char* name) {
+        if (a.shape == b.shape) {
+            TL_PROFILE_OP(name, a.data.size(), a.shape, b.shape);
+            Tensor<mask_t> out(a.shape);
+            const A* pa = a.data.data();
+            const B* pb = b.data.data();
+            mask_t* r = out.data.data();
+            const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(out.data.size());
+            #pragma omp parallel for simd schedule(static) if(out.data.size() > compare_parallel_threshold)
+            for (std::ptrdiff_t i = 0; i < n; ++i) r[i] = f(pa[i], pb[i]) ? 1 : 0;
+            return out;
+        }
+
+        const std::vector<std::size_t> shape = compute_broadcast_shape(a.shape, b.shape);
+        const auto sa = broadcast_strides_for(a.shape, shape), sb = broadcast_strides_for(b.shape, shape);
+        Tensor<mask_t> out(shape);
+        TL_PROFILE_OP(name, out.data.size(), a.shape, b.shape);
+        if (out.data.empty()) return out;
+        // Rows of the last dimension with fixed strides (rank >= 1: 0-d shapes always match).
+        const std::size_t rank = shape.size(), last = shape.back(), la = sa.back(), lb = sb.back();
+        const std::ptrdiff_t rows = static_cast<std::ptrdiff_t>(out.data.size() / last);
+        #pragma omp parallel for schedule(static) if(out.data.size() > compare_parallel_threshold)
+        for (std::ptrdiff_t r = 0; r < rows; ++r) {
+            std::size_t oa = 0, ob = 0, rem = static_cast<std::size_t>(r);
+            for (std::size_t d = rank - 1; d-- > 0; ) {
+                const std::size_t c = rem % shape[d];
+                rem /= shape[d];
+                oa += c * sa[d]; ob += c * sb[d];
+            }
+            mask_t* dst = out.data.data() + static_cast<std::size_t>(r) * last;
+            for (std::size_t j = 0; j < last; ++j) dst[j] = f(a.data[oa + j * la], b.data[ob + j * lb]) ? 1 : 0;
+        }
+        return out;
+    }
+
+    template <typename T, typename F>
+    Tensor<mask_t> mask_unary(const Tensor<T>& t, F f, const char* name) {
+        TL_PROFILE_OP(name, t.data.size(), t.shape);
+        Tensor<mask_t> out(t.shape);
+        const T* p = t.data.data();
+        mask_t* r = out.data.data();
+        const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(out.data.size());
+        #pragma omp parallel for simd schedule(static) if(out.data.size() > compare_parallel_threshold)
+        for (std::ptrdiff_t i = 0; i < n; ++i) r[i] = f(p[i]) ? 1 : 0;
+        return out;
+    }
+
+    template <typename A, typename B>
+    Tensor<mask_t> compare_tensors(const Tensor<A>& a, const Tensor<B>& b, Cmp op, const char* name) {
+        using C = compare_t<A, B>;
+        check_orderable<C>(op);
+        return mask_binary(a, b, [op](const A& x, const B& y) { return compare(op, static_cast<C>(x), static_cast<C>(y)); }, name);
+    }
+
+    // Scalars are weak, as in the arithmetic operators: t > 0.5 compares a float tensor in float,
+    // and a float16 tensor against the scalar rounded to float16 (then widened to compare).
+    template <typename T, typename S>
+    using scalar_compare_t = accum_t<scalar_promote_t<T, S>>;
+
+    template <typename T, typename S>
+    inline scalar_compare_t<T, S> weak_scalar(S s) {
+        return static_cast<scalar_compare_t<T, S>>(static_cast<scalar_promote_t<T, S>>(s));
+    }
+
+    // An integer scalar outside an integer tensor's range would wrap when made weak, so
+    // u8 < 300 is decided up front instead: +1 above T's range, -1 below, 0 inside.
+    template <typename T, typename S>
+    inline int scalar_out_of_range(S s) {
+        if constexpr (std::is_integral_v<T> && std::is_integral_v<S> && !std::is_same_v<T, bool> &&
+                      std::is_same_v<scalar_promote_t<T, S>, T>) {
+            if constexpr (std::is_signed_v<S>) {
+                if (s < 0) {
+                    if constexpr (std::is_unsigned_v<T>) return -1;
+                    else return static_cast<std::intmax_t>(s) < static_cast<std::intmax_t>(std::numeric_limits<T>::min()) ? -1 : 0;
+                }
+            }
+            if (static_cast<std::uintmax_t>(s) > static_cast<std::uintmax_t>(std::numeric_limits<T>::max())) return 1;
+        }
+        return 0;
+    }
+
+    // What every element satisfies against a scalar on the given side of its range.
+    inline bool out_of_range_result(Cmp op, int side) {
+        switch (op) {
+            case Cmp::Eq: return false;
+            case Cmp::Ne: return true;
+            case Cmp::Lt: case Cmp::Le: return side > 0;
+            case Cmp::Gt: case Cmp::Ge: return side < 0;
+        }
+        return false;
+    }
+
+    template <typename T, typename S>
+    Tensor<mask_t> compare_scalar(const Tensor<T>& t, S s, Cmp op, const char* name) {
+        using C = scalar_compare_t<T, S>;
+        check_orderable<C>(op);
+        if (const int side = scalar_out_of_range<T>(s)) {
+            Tensor<mask_t> out(t.shape);
+            std::fill(out.data.begin(), out.data.end(), static_cast<mask_t>(out_of_range_result(op, side)));
+            return out;
+        }
+        const C c = weak_scalar<T>(s);
+        return mask_unary(t, [op, c](const T& x) { return compare(op, static_cast<C>(x), c); }, name);
+    }
+
+    // s op t == t (mirrored op) s.
+    inline Cmp mirrored(Cmp op) {
+        switch (op) {
+            case Cmp::Lt: return Cmp::Gt;
+            case Cmp::Le: return Cmp::Ge;
+            case Cmp::Gt: return Cmp::Lt;
+            case Cmp::Ge: return Cmp::Le;
+            default: return op;
+        }
+    }
+
+    template <typename A, typename B>
+    using enable_compare_t = std::enable_if_t<(dtype_kind<A>() >= 0) && (dtype_kind<B>() >= 0)>;
+
+    inline std::size_t popcount64(std::uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_popcountll(w));
+#else
+        std::size_t c = 0;
+        for (; w; w &= w - 1) ++c;
+        return c;
+#endif
+    }
+
+    inline unsigned lowest_bit(std::uint64_t w) {
+#if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(w));
+#else
+        unsigned i = 0;
+        while (!(w & 1)) { w >>= 1; ++i; }
+        return i;
+#endif
+    }
+
+} // namespace detail
+
+
+// --- Comparison operators ---
+
+#define TL_COMPARE_OPERATOR(sym, cmp, name)                                                                         \
+    template <typename A, typename B, typename = detail::enable_compare_t<A, B>>                                    \
+    Tensor<mask_t> operator sym(const Tensor<A>& a, const Tensor<B>& b) {                                           \
+        return detail::compare_tensors(a, b, cmp, name);                                                            \
+    }                                                                                                               \
+    template <typename T, typename S, typename = detail::enable_compare_t<T, S>>                                    \
+    Tensor<mask_t> operator sym(const Tensor<T>& t, S s) {                                                          \
+        return detail::compare_scalar(t, s, cmp, name);                                                             \
+    }                                                                                                               \
+    template <typename S, typename T, typename = detail::enable_compare_t<T, S>>                                    \
+    Tensor<mask_t> operator sym(S s, const Tensor<T>& t) {                                                          \
+        return detail::compare_scalar(t, s, detail::mirrored(cmp), name);                                           \
+    }
+
+TL_COMPARE_OPERATOR(==, Cmp::Eq, "eq")
+TL_COMPARE_OPERATOR(!=, Cmp::Ne, "ne")
+TL_COMPARE_OPERATOR(<,  Cmp::Lt, "lt")
+TL_COMPARE_OPERATOR(<=, Cmp::Le, "le")
+TL_COMPARE_OPERATOR(>,  Cmp::Gt, "gt")
+TL_COMPARE_OPERATOR(>=, Cmp::Ge, "ge")
+
+#undef TL_COMPARE_OPERATOR
+
+
+// --- Logical ops (non-zero is true) ---
+
+template <typename A, typename B>
+Tensor<mask_t> logical_and(const Tensor<A>& a, const Tensor<B>& b) {
+    return detail::mask_binary(a, b, [](const A& x, const B& y) { return detail::truthy(x) && detail::truthy(y); }, "logical_and");
+}
+
+template <typename A, typename B>
+Tensor<mask_t> logical_or(const Tensor<A>& a, const Tensor<B>& b) {
+    return detail::mask_binary(a, b, [](const A& x, const B& y) { return detail::truthy(x) || detail::truthy(y); }, "logical_or");
+}
+
+template <typename A, typename B>
+Tensor<mask_t> logical_xor(const Tensor<A>& a, const Tensor<B>& b) {
+    return detail::mask_binary(a, b, [](const A& x, const B& y) { return detail::truthy(x) != detail::truthy(y); }, "logical_xor");
+}
+
+template <typename T>
+Tensor<mask_t> logical_not(const Tensor<T>& t) {
+    return detail::mask_unary(t, [](const T& x) { return !detail::truthy(x); }, "logical_not");
+}
+
+
+// --- Reductions ---
+
+template <typename T>
+std::size_t count_nonzero(const Tensor<T>& t) {
+    TL_PROFILE_OP("count_nonzero", t.data.size(), t.shape);
+    const T* p = t.data.data();
+    const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(t.data.size());
+    std::size_t count = 0;
+    #pragma omp parallel for simd schedule(static) reduction(+:count) if(t.data.size() > detail::compare_parallel_threshold)
+    for (std::ptrdiff_t i = 0; i < n; ++i) count += detail::truthy(p[i]) ? 1 : 0;
+    return count;
+}
+
+// Stops at the first chunk holding a non-zero.
+template <typename T>
+bool any(const Tensor<T>& t) {
+    TL_PROFILE_OP("any", t.data.size(), t.shape);
+    const T* p = t.data.data();
+    const std::size_t n = t.data.size();
+    for (std::size_t i0 = 0; i0 < n; i0 += detail::any_chunk) {
+        const std::size_t i1 = std::min(n, i0 + detail::any_chunk);
+        std::size_t hits = 0;
+        #pragma omp simd reduction(+:hits)
+        for (std::size_t i = i0; i < i1; ++i) hits += detail::truthy(p[i]) ? 1 : 0;
+        if (hits) return true;
+    }
+    return false;
+}
+
+// True for an empty tensor, like NumPy.
+template <typename T>
+bool all(const Tensor<T>& t) {
+    TL_PROFILE_OP("all", t.data.size(), t.shape);
+    const T* p = t.data.data();
+    const std::size_t n = t.data.size();
+    for (std::size_t i0 = 0; i0 < n; i0 += detail::any_chunk) {
+        const std::size_t i1 = std::min(n, i0 + detail::any_chunk);
+        std::size_t misses = 0;
+        #pragma omp simd reduction(+:misses)
+        for (std::size_t i = i0; i < i1; ++i) misses += detail::truthy(p[i]) ? 0 : 1;
+        if (misses) return false;
+    }
+    return true;
+}
+
+// Coordinates of the non-zero elements in row-major order, as a [count, rank] tensor.
+template <typename T>
+Tensor<std::size_t> nonzero(const Tensor<T>& t) {
+    TL_PROFILE_OP("nonzero", t.data.size(), t.shape);
+    const std::size_t rank = t.shape.size(), n = t.data.size(), chunks = (n + detail::compact_chunk - 1) / detail::compact_chunk;
+    const T* p = t.data.data();
+    std::vector<std::size_t> start(chunks + 1, 0);
+    const std::ptrdiff_t nc = static_cast<std::ptrdiff_t>(chunks);
+    #pragma omp parallel for schedule(static) if(n > detail::compare_parallel_threshold)
+    for (std::ptrdiff_t c = 0; c < nc; ++c) {
+        const std::size_t e0 = static_cast<std::size_t>(c) * detail::compact_chunk, e1 = std::min(n, e0 + detail::compact_chunk);
+        std::size_t count = 0;
+        #pragma omp simd reduction(+:count)
+        for (std::size_t e = e0; e < e1; ++e) count += detail::truthy(p[e]) ? 1 : 0;
+        start[static_cast<std::size_t>(c) + 1] = count;
+    }
+    for (std::size_t c = 0; c < chunks; ++c) start[c + 1] += start[c];
+
+    Tensor<std::size_t> out({start[chunks], rank});
+    std::size_t* op = out.data.data();
+    #pragma omp parallel for schedule(static) if(n > detail::compare_parallel_threshold)
+    for (std::ptrdiff_t c = 0; c < nc; ++c) {
+        const std::size_t e0 = static_cast<std::size_t>(c) * detail::compact_chunk, e1 = std::min(n, e0 + detail::compact_chunk);
+        std::size_t k = start[static_cast<std::size_t>(c)];
+        for (std::size_t e = e0; e < e1; ++e) {
+            if (!detail::truthy(p[e])) continue;
+            std::size_t rem = e;
+            for (std::size_t d = rank; d-- > 0; ) {
+                op[k * rank + d] = rem % t.shape[d];
+                rem /= t.shape[d];
+            }
+            ++k;
+        }
+    }
+    return out;
+}
+
+
+// --- Packed masks ---
+
+// One bit per element, 64 to a word, element i at bit i % 64 of word i / 64.
+// Bits past size() in the last word are always zero.
+struct BitMask {
+    std::vector<std::uint64_t> words;
+    std::vector<std::size_t> shape;
+
+    BitMask() = default;
+    explicit BitMask(std::vector<std::size_t> s) : shape(std::move(s)) {
+        words.assign((size() + 63) / 64, 0);
+    }
+
+    std::size_t size() const {
+        std::size_t n = 1;
+        for (auto d : shape) n *= d;
+        return n;
+    }
+
+    bool test(std::size_t i) const { return (words[i / 64] >> (i % 64)) & 1u; }
+    void set(std::size_t i, bool v = true) {
+        const std::uint64_t bit = std::uint64_t(1) << (i % 64);
+        words[i / 64] = v ? (words[i / 64] | bit) : (words[i / 64] & ~bit);
+    }
+
+    std::size_t count() const {
+        std::size_t c = 0;
+        for (auto w : words) c += detail::popcount64(w);
+        return c;
+    }
+    bool any() const {
+        for (auto w : words) if (w) return true;
+        return false;
+    }
+    bool all() const { return count() == size(); }
+
+    // Byte mask with the same shape.
+    Tensor<mask_t> unpack() const {
+        Tensor<mask_t> out(shape);
+        const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(out.data.size());
+        #pragma omp parallel for simd schedule(static) if(out.data.size() > detail::compare_parallel_threshold)
+        for (std::ptrdiff_t i = 0; i < n; ++i) out.data[static_cast<std::size_t>(i)] = test(static_cast<std::size_t>(i)) ? 1 : 0;
+        return out;
+    }
+
+    // Packs any tensor (non-zero is set).
+    template <typename T>
+    static BitMask pack(const Tensor<T>& t) {
+        BitMask m(t.shape);
+        const T* p = t.data.data();
+        const std::size_t n = t.data.size();
+        const std::ptrdiff_t nw = static_cast<std::ptrdiff_t>(m.words.size());
+        #pragma omp parallel for schedule(static) if(n > detail::compare_parallel_threshold)
+        for (std::ptrdiff_t w = 0; w < nw; ++w) {
+            const std::size_t base = static_cast<std::size_t>(w) * 64, cnt = std::min<std::size_t>(64, n - base);
+            std::uint64_t bits = 0;
+            for (std::size_t j = 0; j < cnt; ++j) bits |= static_cast<std::uint64_t>(detail::truthy(p[base + j])) << j;
+            m.words[static_cast<std::size_t>(w)] = bits;
+        }
+        return m;
+    }
+
+    BitMask& operator&=(const BitMask& o) { check(o); for (std::size_t i = 0; i < words.size(); ++i) words[i] &= o.words[i]; return *this; }
+    BitMask& operator|=(const BitMask& o) { check(o); for (std::size_t i = 0; i < words.size(); ++i) words[i] |= o.words[i]; return *this; }
+    BitMask& operator^=(const BitMask& o) { check(o); for (std::size_t i = 0; i < words.size(); ++i) words[i] ^= o.words[i]; return *this; }
+
+    BitMask operator&(const BitMask& o) const { BitMask r = *this; return r &= o; }
+    BitMask operator|(const BitMask& o) const { BitMask r = *this; return r |= o; }
+    BitMask operator^(const BitMask& o) const { BitMask r = *this; return r ^= o; }
+    BitMask operator~() const {
+        BitMask r = *this;
+        for (auto& w : r.words) w = ~w;
+        if (const std::size_t tail = size() % 64) r.words.back() &= (std::uint64_t(1) << tail) - 1;
+        return r;
+    }
+
+private:
+    void check(const BitMask& o) const {
+        if (shape != o.shape) throw std::runtime_error("BitMask: shape mismatch.");
+    }
+};
+
+
+namespace detail {
+
+    // words[w] <- bits of pred(i) for i in [64 w, 64 w + 64).
+    template <typename Pred>
+    void assemble_bits(std::size_t n, std::uint64_t* words, Pred pred) {
+        const std::ptrdiff_t nw = static_cast<std::ptrdiff_t>((n + 63) / 64);
+        #pragma omp parallel for schedule(static) if(n > compare_parallel_threshold)
+        for (std::ptrdiff_t w = 0; w < nw; ++w) {
+            const std::size_t base = static_cast<std::size_t>(w) * 64, cnt = std::min<std::size_t>(64, n - base);
+            std::uint64_t bits = 0;
+            for (std::size_t j = 0; j < cnt; ++j) bits |= static_cast<std::uint64_t>(pred(base + j)) << j;
+            words[w] = bits;
+        }
+    }
+
+#if defined(__AVX__)
+    // Full 64-element words straight from vector compares; b_step = 0 broadcasts b[0].
+    template <int Imm>
+    void cmp_words_avx(const float* a, const float* b, std::size_t b_step, std::size_t full_words, std::uint64_t* words) {
+        const std::ptrdiff_t nw = static_cast<std::ptrdiff_t>(full_words);
+        #pragma omp parallel for schedule(static) if(full_words * 64 > compare_parallel_threshold)
+        for (std::ptrdiff_t w = 0; w < nw; ++w) {
+            const float* pa = a + w * 64;
+            const float* pb = b + w * 64 * static_cast<std::ptrdiff_t>(b_step);
+            std::uint64_t bits = 0;
+            for (int k = 0; k < 8; ++k) {
+                const __m256 y = b_step ? _mm256_loadu_ps(pb + 8 * k) : _mm256_broadcast_ss(b);
+                const int m = _mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(pa + 8 * k), y, Imm));
+                bits |= static_cast<std::uint64_t>(static_cast<unsigned>(m)) << (8 * k);
+            }
+            words[w] = bits;
+        }
+    }
+
+    template <int Imm>
+    void cmp_words_avx(const double* a, const double* b, std::size_t b_step, std::size_t full_words, std::uint64_t* words) {
+        const std::ptrdiff_t nw = static_cast<std::ptrdiff_t>(full_words);
+        #pragma omp parallel for schedule(static) if(full_words * 64 > compare_parallel_threshold)
+        for (std::ptrdiff_t w = 0; w < nw; ++w) {
+            const double* pa = a + w * 64;
+            const double* pb = b + w * 64 * static_cast<std::ptrdiff_t>(b_step);
+            std::uint64_t bits = 0;
+            for (int k = 0; k < 16; ++k) {
+                const __m256d y = b_step ? _mm256_loadu_pd(pb + 4 * k) : _mm256_broadcast_sd(b);
+                const int m = _mm256_movemask_pd(_mm256_cmp_pd(_mm256_loadu_pd(pa + 4 * k), y, Imm));
+                bits |= static_cast<std::uint64_t>(static_cast<unsigned>(m)) << (4 * k);
+            }
+            words[w] = bits;
+        }
+    }
+
+    template <typename T>
+    void cmp_words_avx(Cmp op, const T* a, const T* b, std::size_t b_step, std::size_t full_words, std::uint64_t* words) {
+        // Ordered predicates, except unordered not-equal: NaN != x is true, as in C++.
+        switch (op) {
+            case Cmp::Eq: cmp_words_avx<_CMP_EQ_OQ>(a, b, b_step, full_words, words); break;
+            case Cmp::Ne: cmp_words_avx<_CMP_NEQ_UQ>(a, b, b_step, full_words, words); break;
+            case Cmp::Lt: cmp_words_avx<_CMP_LT_OQ>(a, b, b_step, full_words, words); break;
+            case Cmp::Le: cmp_words_avx<_CMP_LE_OQ>(a, b, b_step, full_words, words); break;
+            case Cmp::Gt: cmp_words_avx<_CMP_GT_OQ>(a, b, b_step, full_words, words); break;
+            case Cmp::Ge: cmp_words_avx<_CMP_GE_OQ>(a, b, b_step, full_words, words); break;
+        }
+    }
+#endif
+
+    // Packed a[i] op b[i * b_step] (b_step 0: a scalar) for same-typed contiguous inputs.
+    template <typename T>
+    void compare_words(Cmp op, const T* a, const T* b, std::size_t b_step, std::size_t n, std::uint64_t* words) {
+        std::size_t done = 0;
+#if defined(__AVX__)
+        if constexpr (std::is_same_v<T, float> || std::is_same_v<T, double>) {
+            cmp_words_avx(op, a, b, b_step, n / 64, words);
+            done = n / 64 * 64;
+        }
+#endif
+        using C = accum_t<T>;
+        const std::size_t rest = n - done;
+        if (rest == 0) return;
+        switch (op) {
+            case Cmp::Eq: assemble_bits(rest, words + done / 64, [&](std::size_t i) { return C(a[done + i]) == C(b[(done + i) * b_step]); }); break;
+            case Cmp::Ne: assemble_bits(rest, words + done / 64, [&](std::size_t i) { return C(a[done + i]) != C(b[(done + i) * b_step]); }); break;
+            default:
+                assemble_bits(rest, words + done / 64, [&](std::size_t i) { return compare(op, C(a[done + i]), C(b[(done + i) * b_step])); });
+        }
+    }
+
+} // namespace detail
+
+
+// --- Compare straight to packed bits ---
+
+template <typename T, typename S, typename = detail::enable_compare_t<T, S>>
+BitMask compare_bits(const Tensor<T>& a, Cmp op, S scalar) {
+    TL_PROFILE_OP("compare_bits", a.data.size(), a.shape);
+    detail::check_orderable<detail::scalar_compare_t<T, S>>(op);
+    BitMask m(a.shape);
+    if (const int side = detail::scalar_out_of_range<T>(scalar)) return detail::out_of_range_result(op, side) ? ~m : m;
+    if constexpr (std::is_same_v<scalar_promote_t<T, S>, T>) {
+        const T s = static_cast<T>(scalar);
+        detail::compare_words(op, a.data.data(), &s, 0, a.data.size(), m.words.data());
+    } else {
+        using C = detail::scalar_compare_t<T, S>;
+        const C c = detail::weak_scalar<T>(scalar);
+        const T* p = a.data.data();
+        detail::assemble_bits(a.data.size(), m.words.data(), [&](std::size_t i) { return detail::compare(op, static_cast<C>(p[i]), c); });
+    }
+    return m;
+}
+
+template <typename A, typename B, typename = detail::enable_compare_t<A, B>>
+BitMask compare_bits(const Tensor<A>& a, Cmp op, const Tensor<B>& b) {
+    if (a.shape != b.shape) return BitMask::pack(detail::compare_tensors(a, b, op, "compare_bits"));
+    TL_PROFILE_OP("compare_bits", a.data.size(), a.shape, b.shape);
+    detail::check_orderable<detail::compare_t<A, B>>(op);
+    BitMask m(a.shape);
+    if constexpr (std::is_same_v<A, B>) {
+        detail::compare_words(op, a.data.data(), b.data.data(), 1, a.data.size(), m.words.data());
+    } else {
+        using C = detail::compare_t<A, B>;
+        const A* pa = a.data.data();
+        const B* pb = b.data.data();
+        detail::assemble_bits(a.data.size(), m.words.data(), [&](std::size_t i) { return detail::compare(op, static_cast<C>(pa[i]), static_cast<C>(pb[i])); });
+    }
+    return m;
+}
+
+// Elements of x at the set bits, in order; cost scales with the words plus the hits.
+template <typename T>
+Tensor<T> masked_select(const Tensor<T>& x, const BitMask& mask) {
+    if (mask.shape != x.shape) throw std::runtime_error("masked_select: BitMask shape must match the tensor.");
+    TL_PROFILE_OP("masked_select", 0, x.shape);
+    const std::size_t nw = mask.words.size();
+    std::vector<std::size_t> start(nw + 1, 0);
+    for (std::size_t w = 0; w < nw; ++w) start[w + 1] = start[w] + detail::popcount64(mask.words[w]);
+    Tensor<T> out({start[nw]});
+    const std::ptrdiff_t total = static_cast<std::ptrdiff_t>(nw);
+    #pragma omp parallel for schedule(static) if(x.data.size() > detail::compare_parallel_threshold)
+    for (std::ptrdiff_t w = 0; w < total; ++w) {
+        std::uint64_t bits = mask.words[static_cast<std::size_t>(w)];
+        std::size_t k = start[static_cast<std::size_t>(w)];
+        const T* base = x.data.data() + static_cast<std::size_t>(w) * 64;
+        for (; bits; bits &= bits - 1) out.data[k++] = base[detail::lowest_bit(bits)];
+    }
+    return out;
+}
+
+} // namespace tl
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include "tensor.hpp"
+
+// Complex element types.
+//
+// Tensor<std::complex<float>> and Tensor<std::complex<double>> use the ordinary
+// Tensor operators (+ - * / with broadcasting, scalar and in-place forms) and
+// reductions (sum, mean, dot without conjugation).  Mixing with real tensors goes
+// through promotion.hpp: complex is the highest kind, so Tensor<complex<float>> *
+// Tensor<double> is Tensor<complex<double>> and Tensor<float> * std::complex<float>
+// is Tensor<complex<float>>.
+//
+// This header adds the conversions between the two worlds:
+//
+//   make_complex(re, im), to_complex(x)     real -> complex
+//   real, imag, abs, angle                  complex -> real (per element)
+//   conj                                    complex -> complex
+
+namespace tl {
+
+template <typename T> struct is_complex : std::false_type {};
+template <typename T> struct is_complex<std::complex<T>> : std::true_type {};
+template <typename T> inline constexpr bool is_complex_v = is_complex<T>::value;
+
+// Component type of a complex type; T itself otherwise.
+template <typename T> struct real_type { using type = T; };
+template <typename T> struct real_type<std::complex<T>> { using type = T; };
+template <typename T> using real_t = typename real_type<T>::type;
+
+namespace detail {
+
+    template <typename R, typename T, typename Op>
+    Tensor<R> map_elements(const Tensor<T>& t, Op op, const char* name) {
+        TL_PROFILE_OP(name, t.data.size(), t.shape);
+        Tensor<R> res(t.shape);
+        R* r = res.data.data();
+        const T* p = t.data.data();
+        const std::size_t n = t.data.size();
+        for (std::size_t i = 0; i < n; ++i) r[i] = op(p[i]);
+        return res;
+    }
+
+} // namespace detail
+
+
+// --- Real -> complex ---
+
+template <typename T>
+Tensor<std::complex<T>> make_complex(const Tensor<T>& re, const Tensor<T>& im) {
+    static_assert(std::is_floating_point_v<T>, "make_complex requires float or double components.");
+    if (re.shape != im.shape) throw std::runtime_error("make_complex: real and imaginary parts must have the same shape.");
+    TL_PROFILE_OP("make_complex", 0, re.shape, im.shape);
+    Tensor<std::complex<T>> res(re.shape);
+    for (std::size_t i = 0; i < re.data.size(); ++i) res.data[i] = std::complex<T>(re.data[i], im.data[i]);
+    return res;
+}
+
+template <typename T>
+Tensor<std::complex<T>> to_complex(const Tensor<T>& re) {
+    static_assert(std::is_floating_point_v<T>, "to_complex requires float or double components.");
+    return detail::map_elements<std::complex<T>>(re, [](T x) { return std::complex<T>(x, T(0)); }, "to_complex");
+}
+
+
+// --- Complex -> real / complex ---
+
+template <typename T>
+Tensor<T> real(const Tensor<std::complex<T>>& z) {
+    return detail::map_elements<T>(z, [](const std::complex<T>& v) { return v.real(); }, "real");
+}
+
+template <typename T>
+Tensor<T> imag(const Tensor<std::complex<T>>& z) {
+    return detail::map_elements<T>(z, [](const std::complex<T>& v) { return v.imag(); }, "imag");
+}
+
+// Magnitude |z|, computed without intermediate overflow (std::hypot).
+template <typename T>
+Tensor<T> abs(const Tensor<std::complex<T>>& z) {
+    return detail::map_elements<T>(z, [](const std::complex<T>& v) { return std::hypot(v.real(), v.imag()); }, "abs");
+}
+
+// Phase in (-pi, pi].
+template <typename T>
+Tensor<T> angle(const Tensor<std::complex<T>>& z) {
+    return detail::map_elements<T>(z, [](const std::complex<T>& v) { return std::atan2(v.imag(), v.real()); }, "angle");
+}
+
+template <typename T>
+Tensor<std::complex<T>> conj(const Tensor<std::complex<T>>& z) {
+    return detail::map_elements<std::complex<T>>(z, [](const std::complex<T>& v) { return std::conj(v); }, "conj");
+}
+
+} // namespace tl
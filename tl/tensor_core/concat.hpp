@@ -0,0 +1,356 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include "tensor.hpp"
+#include "view.hpp"
+#include "indexing.hpp"
+
+// Joining, splitting and padding along any axis.
+//
+//   concatenate(parts, axis)        parts joined along an existing axis
+//   stack(parts, axis)              parts (all the same shape) joined along a new axis
+//   narrow(x, axis, start, length)  TensorSlice of x[..., start:start+length, ...], no copy
+//   split(x, size, axis)            slices of `size` along axis (the last may be shorter), no copy
+//   split(x, sizes, axis)           slices of the given sizes (summing to the axis length), no copy
+//   chunk(x, chunks, axis)          at most `chunks` equal slices, as torch.chunk, no copy
+//   pad(x, widths, value)           constant padding, widths[d] = {before, after} per dimension
+//   pad(x, axis, before, after, value)
+//
+// Every result is allocated once at its final size and filled with bulk copies of the
+// longest contiguous runs the layout allows: a run is everything from the axis inwards,
+// so joining along axis 0 is one memcpy per part.  The copies are split into
+// copy_block-element tasks across threads once the total is large.
+//
+// A TensorSlice points into its parent's buffer and keeps the parent's strides, so it
+// sees (and can write) the parent's data; it must not outlive the parent, and the
+// rvalue overloads are deleted so it cannot bind to a temporary.  Indexing works as on
+// a Tensor; to_tensor() materialises a contiguous copy.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+
+namespace detail {
+
+    constexpr std::size_t concat_parallel_threshold = 1 << 15;
+    constexpr std::size_t copy_block = 1 << 14;         // elements per copy task; longer runs are split
+
+    template <typename T>
+    inline void copy_run(T* dst, const T* src, std::size_t n) {
+        if constexpr (std::is_trivially_copyable_v<T>) {
+            if (n) std::memcpy(dst, src, n * sizeof(T));
+        } else {
+            std::copy_n(src, n, dst);
+        }
+    }
+
+    // One source of a strided copy: each of `outer` rows moves `run` elements from
+    // src + o * src_pitch to dst + o * dst_pitch + dst_off.
+    template <typename T>
+    struct RunPart { const T* src; std::size_t run, src_pitch, dst_off; };
+
+    // All parts of all rows as one task list of at most copy_block elements each.
+    template <typename T>
+    void copy_parts(T* dst, std::size_t dst_pitch, std::size_t outer, const std::vector<RunPart<T>>& parts) {
+        std::vector<std::size_t> first(parts.size() + 1, 0);   // blocks per row, prefix-summed over parts
+        std::size_t per_row_elems = 0;
+        for (std::size_t p = 0; p < parts.size(); ++p) {
+            first[p + 1] = first[p] + (parts[p].run + copy_block - 1) / copy_block;
+            per_row_elems += parts[p].run;
+        }
+        const std::size_t per_row = first.back();
+        const std::ptrdiff_t tasks = static_cast<std::ptrdiff_t>(outer * per_row);
+        #pragma omp parallel for schedule(static) if(outer * per_row_elems > concat_parallel_threshold)
+        for (std::ptrdiff_t t = 0; t < tasks; ++t) {
+            const std::size_t o = static_cast<std::size_t>(t) / per_row, b = static_cast<std::size_t>(t) % per_row;
+            const std::size_t p = static_cast<std::size_t>(std::upper_bound(first.begin() + 1, first.end(), b) - (first.begin() + 1));
+            const RunPart<T>& part = parts[p];
+            const std::size_t j0 = (b - first[p]) * copy_block;
+            copy_run(dst + o * dst_pitch + part.dst_off + j0, part.src + o * part.src_pitch + j0,
+                     std::min(copy_block, part.run - j0));
+        }
+    }
+
+    inline std::string dims_str(const std::vector<std::size_t>& shape) {
+        std::string s = "[";
+        for (std::size_t d = 0; d < shape.size(); ++d) s += (d ? ", " : "") + std::to_string(shape[d]);
+        return s + "]";
+    }
+
+} // namespace detail
+
+
+// --- Slices ---
+
+// A strided window into another tensor's buffer (see the header comment).
+template <typename T>
+struct TensorSlice {
+    T* data_ptr;
+    std::vector<std::size_t> shape;
+    std::vector<std::size_t> strides;   // the parent's strides
+
+    std::size_t size() const {
+        std::size_t n = 1;
+        for (auto d : shape) n *= d;
+        return n;
+    }
+
+    // True when the elements form one block, e.g. any slice along axis 0.
+    bool is_contiguous() const {
+        std::size_t expect = 1;
+        for (std::size_t d = shape.size(); d-- > 0; ) {
+            if (shape[d] != 1 && strides[d] != expect) return false;
+            expect *= shape[d];
+        }
+        return true;
+    }
+
+    View<T> operator[](std::size_t i) const {
+        if (shape.empty()) throw std::out_of_range("Cannot index a 0-dimensional slice (scalar)");
+        if (i >= shape[0]) {
+            throw std::out_of_range(
+                "Index " + std::to_string(i) +
+                " out of range for dimension of size " + std::to_string(shape[0]));
+        }
+        return View<T>{ data_ptr + i * strides[0], shape.data() + 1, strides.data() + 1, shape.size() - 1 };
+    }
+
+    // Contiguous copy.  Trailing dimensions that are contiguous in the parent form the
+    // run; the leading ones advance by a single pitch, as for every slice along one axis.
+    Tensor<std::remove_const_t<T>> to_tensor() const {
+        using E = std::remove_const_t<T>;
+        Tensor<E> out(shape);
+        TL_PROFILE_OP("slice_copy", 0, shape);
+        if (out.data.empty()) return out;
+        std::size_t run = 1, k = shape.size();
+        while (k > 0 && (shape[k - 1] == 1 || strides[k - 1] == run)) run *= shape[--k];
+        const std::size_t rows = out.data.size() / run, pitch = k > 0 ? strides[k - 1] : run;
+        detail::copy_parts<E>(out.data.data(), run, rows, {{data_ptr, run, pitch, 0}});
+        return out;
+    }
+};
+
+namespace detail {
+
+    template <typename E>
+    TensorSlice<E> narrow_impl(E* data, const std::vector<std::size_t>& shape, const std::vector<std::size_t>& strides,
+                               int axis, std::size_t start, std::size_t length, const char* op) {
+        const AxisSplit s = axis_split(shape, axis, op);
+        if (start > s.len || length > s.len - start) {
+            throw std::runtime_error(std::string(op) + ": range [" + std::to_string(start) + ", " +
+                                     std::to_string(start + length) + ") exceeds axis length " + std::to_string(s.len) + ".");
+        }
+        TensorSlice<E> slice{data + start * strides[s.axis], shape, strides};
+        slice.shape[s.axis] = length;
+        return slice;
+    }
+
+    template <typename E>
+    std::vector<TensorSlice<E>> split_impl(E* data, const std::vector<std::size_t>& shape, const std::vector<std::size_t>& strides,
+                                           const std::vector<std::size_t>& sizes, int axis) {
+        const AxisSplit s = axis_split(shape, axis, "split");
+        std::size_t total = 0;
+        for (auto n : sizes) total += n;
+        if (total != s.len) {
+            throw std::runtime_error("split: sizes sum to " + std::to_string(total) + " but the axis has length " +
+                                     std::to_string(s.len) + ".");
+        }
+        std::vector<TensorSlice<E>> out;
+        out.reserve(sizes.size());
+        std::size_t start = 0;
+        for (auto n : sizes) {
+            out.push_back(narrow_impl(data, shape, strides, static_cast<int>(s.axis), start, n, "split"));
+            start += n;
+        }
+        return out;
+    }
+
+    // Sizes of the pieces of `len` cut every `size` elements.
+    inline std::vector<std::size_t> even_sizes(std::size_t len, std::size_t size) {
+        if (size == 0) throw std::runtime_error("split: piece size must be positive.");
+        std::vector<std::size_t> sizes(len / size, size);
+        if (len % size) sizes.push_back(len % size);
+        return sizes;
+    }
+
+    inline std::vector<std::size_t> chunk_sizes(const std::vector<std::size_t>& shape, std::size_t chunks, int axis) {
+        if (chunks == 0) throw std::runtime_error("chunk: the number of chunks must be positive.");
+        const std::size_t len = axis_split(shape, axis, "chunk").len;
+        return even_sizes(len, std::max<std::size_t>(1, (len + chunks - 1) / chunks));
+    }
+
+} // namespace detail
+
+template <typename T>
+TensorSlice<T> narrow(Tensor<T>& x, int axis, std::size_t start, std::size_t length) {
+    return detail::narrow_impl(x.data.data(), x.shape, x.strides, axis, start, length, "narrow");
+}
+template <typename T>
+TensorSlice<const T> narrow(const Tensor<T>& x, int axis, std::size_t start, std::size_t length) {
+    return detail::narrow_impl(x.data.data(), x.shape, x.strides, axis, start, length, "narrow");
+}
+template <typename T>
+void narrow(Tensor<T>&&, int, std::size_t, std::size_t) = delete;
+
+template <typename T>
+std::vector<TensorSlice<T>> split(Tensor<T>& x, const std::vector<std::size_t>& sizes, int axis = 0) {
+    return detail::split_impl(x.data.data(), x.shape, x.strides, sizes, axis);
+}
+template <typename T>
+std::vector<TensorSlice<const T>> split(const Tensor<T>& x, const std::vector<std::size_t>& sizes, int axis = 0) {
+    return detail::split_impl(x.data.data(), x.shape, x.strides, sizes, axis);
+}
+template <typename T>
+void split(Tensor<T>&&, const std::vector<std::size_t>&, int = 0) = delete;
+
+template <typename T>
+std::vector<TensorSlice<T>> split(Tensor<T>& x, std::size_t size, int axis = 0) {
+    return split(x, detail::even_sizes(detail::axis_split(x.shape, axis, "split").len, size), axis);
+}
+template <typename T>
+std::vector<TensorSlice<const T>> split(const Tensor<T>& x, std::size_t size, int axis = 0) {
+    return split(x, detail::even_sizes(detail::axis_split(x.shape, axis, "split").len, size), axis);
+}
+template <typename T>
+void split(Tensor<T>&&, std::size_t, int = 0) = delete;
+
+template <typename T>
+std::vector<TensorSlice<T>> chunk(Tensor<T>& x, std::size_t chunks, int axis = 0) {
+    return split(x, detail::chunk_sizes(x.shape, chunks, axis), axis);
+}
+template <typename T>
+std::vector<TensorSlice<const T>> chunk(const Tensor<T>& x, std::size_t chunks, int axis = 0) {
+    return split(x, detail::chunk_sizes(x.shape, chunks, axis), axis);
+}
+template <typename T>
+void chunk(Tensor<T>&&, std::size_t, int = 0) = delete;
+
+
+// --- Joining ---
+
+template <typename T>
+Tensor<T> concatenate(const std::vector<Tensor<T>>& parts, int axis = 0) {
+    if (parts.empty()) throw std::runtime_error("concatenate: need at least one tensor.");
+    const detail::AxisSplit s = detail::axis_split(parts[0].shape, axis, "concatenate");
+    std::vector<std::size_t> shape = parts[0].shape;
+    shape[s.axis] = 0;
+    for (std::size_t i = 0; i < parts.size(); ++i) {
+        const auto& ps = parts[i].shape;
+        bool ok = ps.size() == shape.size();
+        for (std::size_t d = 0; ok && d < ps.size(); ++d) ok = d == s.axis || ps[d] == shape[d];
+        if (!ok) {
+            throw std::runtime_error("concatenate: part " + std::to_string(i) + " has shape " + detail::dims_str(ps) +
+                                     ", incompatible with " + detail::dims_str(parts[0].shape) + " along axis " +
+                                     std::to_string(s.axis) + ".");
+        }
+        shape[s.axis] += ps[s.axis];
+    }
+    Tensor<T> out(shape);
+    TL_PROFILE_OP("concatenate", 0, out.shape);
+    std::vector<detail::RunPart<T>> runs;
+    runs.reserve(parts.size());
+    std::size_t offset = 0;
+    for (const auto& p : parts) {
+        const std::size_t run = p.shape[s.axis] * s.inner;
+        runs.push_back({p.data.data(), run, run, offset});
+        offset += run;
+    }
+    detail::copy_parts(out.data.data(), offset, s.outer, runs);
+    return out;
+}
+
+template <typename T>
+Tensor<T> stack(const std::vector<Tensor<T>>& parts, int axis = 0) {
+    if (parts.empty()) throw std::runtime_error("stack: need at least one tensor.");
+    const auto& shape0 = parts[0].shape;
+    for (std::size_t i = 1; i < parts.size(); ++i) {
+        if (parts[i].shape != shape0) {
+            throw std::runtime_error("stack: part " + std::to_string(i) + " has shape " + detail::dims_str(parts[i].shape) +
+                                     " but part 0 has " + detail::dims_str(shape0) + ".");
+        }
+    }
+    // The new axis may sit anywhere in [0, rank].
+    const std::size_t a = detail::axis_split(std::vector<std::size_t>(shape0.size() + 1, 1), axis, "stack").axis;
+    std::vector<std::size_t> shape = shape0;
+    shape.insert(shape.begin() + static_cast<std::ptrdiff_t>(a), parts.size());
+    std::size_t outer = 1, inner = 1;
+    for (std::size_t d = 0; d < shape0.size(); ++d) (d < a ? outer : inner) *= shape0[d];
+
+    Tensor<T> out(shape);
+    TL_PROFILE_OP("stack", 0, out.shape);
+    std::vector<detail::RunPart<T>> runs;
+    runs.reserve(parts.size());
+    for (std::size_t i = 0; i < parts.size(); ++i) runs.push_back({parts[i].data.data(), inner, inner, i * inner});
+    detail::copy_parts(out.data.data(), parts.size() * inner, outer, runs);
+    return out;
+}
+
+
+// --- Padding ---
+
+template <typename T>
+Tensor<T> pad(const Tensor<T>& x, const std::vector<std::pair<std::size_t, std::size_t>>& widths,
+              typename Tensor<T>::value_type value = T(0)) {
+    const std::size_t rank = x.shape.size();
+    if (widths.size() != rank) {
+        throw std::runtime_error("pad: expected " + std::to_string(rank) + " (before, after) pairs, got " +
+                                 std::to_string(widths.size()) + ".");
+    }
+    std::vector<std::size_t> shape(rank);
+    std::size_t k = rank;                                  // last padded axis; the run starts there
+    for (std::size_t d = 0; d < rank; ++d) {
+        shape[d] = widths[d].first + x.shape[d] + widths[d].second;
+        if (widths[d].first || widths[d].second) k = d;
+    }
+    Tensor<T> out(shape);
+    TL_PROFILE_OP("pad", 0, x.shape, out.shape);
+    if (!(value == T(0))) {
+        T* o = out.data.data();
+        const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(out.data.size());
+        #pragma omp parallel for simd schedule(static) if(out.data.size() > detail::concat_parallel_threshold)
+        for (std::ptrdiff_t i = 0; i < n; ++i) o[i] = value;
+    }
+    if (k == rank) {                                       // nothing padded
+        detail::copy_parts<T>(out.data.data(), 0, 1, {{x.data.data(), x.data.size(), 0, 0}});
+        return out;
+    }
+    if (x.data.empty()) return out;
+
+    // Row r of x is its elements from axis k inwards; only its destination needs the
+    // per-axis offsets, so a row is located once and then copied in blocks.
+    std::size_t run = x.shape[k];
+    for (std::size_t d = k + 1; d < rank; ++d) run *= x.shape[d];
+    const std::size_t rows = x.data.size() / run, blocks = (run + detail::copy_block - 1) / detail::copy_block;
+    const std::size_t base = widths[k].first * out.strides[k];
+    const std::ptrdiff_t tasks = static_cast<std::ptrdiff_t>(rows * blocks);
+    #pragma omp parallel for schedule(static) if(x.data.size() > detail::concat_parallel_threshold)
+    for (std::ptrdiff_t t = 0; t < tasks; ++t) {
+        const std::size_t r = static_cast<std::size_t>(t) / blocks, j0 = (static_cast<std::size_t>(t) % blocks) * detail::copy_block;
+        std::size_t dst = base, rem = r;
+        for (std::size_t d = k; d-- > 0; ) {
+            dst += (rem % x.shape[d] + widths[d].first) * out.strides[d];
+            rem /= x.shape[d];
+        }
+        detail::copy_run(out.data.data() + dst + j0, x.data.data() + r * run + j0, std::min(detail::copy_block, run - j0));
+    }
+    return out;
+}
+
+template <typename T>
+Tensor<T> pad(const Tensor<T>& x, int axis, std::size_t before, std::size_t after,
+              typename Tensor<T>::value_type value = T(0)) {
+    const std::size_t a = detail::axis_split(x.shape, axis, "pad").axis;
+    std::vector<std::pair<std::size_t, std::size_t>> widths(x.shape.size(), {0, 0});
+    widths[a] = {before, after};
+    return pad(x, widths, value);
+}
+
+} // namespace tl
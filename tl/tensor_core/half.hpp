@@ -0,0 +1,243 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <type_traits>
+#if defined(__F16C__) || defined(__AVX512BF16__)
+#include <immintrin.h>
+#endif
+
+// 16-bit floating-point storage types.
+//
+//   float16  : IEEE 754 binary16 (1-5-10 bits), range +-65504, about 3 significant digits
+//   bfloat16 : the upper half of a float (1-8-7 bits), float's range, about 2 digits
+//
+// Both are storage formats.  Every arithmetic operator widens to float, computes,
+// and rounds the result back to nearest-even.  Kernels that reduce over many
+// elements (sum, mean, dot, matmul, softmax) accumulate in accum_t<T> = float and
+// round once at the end.  A Tensor<float16> therefore moves half the bytes of a
+// Tensor<float> without compounding rounding error.
+//
+// Conversions compile to F16C instructions when the target has them and to
+// portable bit manipulation otherwise; both give the same bits for every non-NaN
+// input.  Bulk float -> bfloat16 uses AVX-512 BF16 when available, which matches
+// the scalar rounding except that it flushes float denormals to zero.
+//
+//   Tensor<tl::float16> W({784, 64}, ...);
+//   auto y = tl::linalg::matmul(x, W);      // float16 in and out, float accumulators
+//
+// Bulk conversion: convert_to_float(src, dst, n) and convert_from_float(src, dst, n).
+
+namespace tl {
+namespace detail {
+
+    struct raw_bits_t {};
+
+    inline std::uint32_t float_bits(float f) { std::uint32_t u; std::memcpy(&u, &f, 4); return u; }
+    inline float bits_float(std::uint32_t u) { float f; std::memcpy(&f, &u, 4); return f; }
+
+    // float -> binary16, round to nearest even.
+    inline std::uint16_t half_from_float_portable(float f) {
+        std::uint32_t x = float_bits(f);
+        const std::uint32_t sign = (x >> 16) & 0x8000u;
+        x &= 0x7FFFFFFFu;
+        if (x >= 0x7F800000u) return static_cast<std::uint16_t>(sign | (x > 0x7F800000u ? 0x7E00u : 0x7C00u));
+        if (x >= 0x477FF000u) return static_cast<std::uint16_t>(sign | 0x7C00u);     // rounds past 65504
+        if (x < 0x38800000u) {
+            // Subnormal result: adding 0.5f lines the half mantissa up with the float's
+            // low bits and lets the FPU do the rounding.
+            return static_cast<std::uint16_t>(sign | (float_bits(bits_float(x) + 0.5f) - 0x3F000000u));
+        }
+        const std::uint32_t odd = (x >> 13) & 1u;
+        x += 0xC8000FFFu + odd;                                                       // rebias, round half to even
+        return static_cast<std::uint16_t>(sign | (x >> 13));
+    }
+
+    inline float float_from_half_portable(std::uint16_t h) {
+        const std::uint32_t sign = static_cast<std::uint32_t>(h & 0x8000u) << 16;
+        const std::uint32_t em = h & 0x7FFFu;
+        if (em >= 0x7C00u) return bits_float(sign | 0x7F800000u | ((em & 0x3FFu) << 13));
+        if (em >= 0x0400u) return bits_float(sign | ((em << 13) + 0x38000000u));
+        return bits_float(sign | float_bits(static_cast<float>(em) * 5.9604644775390625e-8f));   // em * 2^-24
+    }
+
+    // float -> bfloat16, round to nearest even; NaNs stay quiet NaNs.
+    inline std::uint16_t bfloat_from_float_portable(float f) {
+        const std::uint32_t x = float_bits(f);
+        if ((x & 0x7FFFFFFFu) > 0x7F800000u) return static_cast<std::uint16_t>((x >> 16) | 0x40u);
+        return static_cast<std::uint16_t>((x + 0x7FFFu + ((x >> 16) & 1u)) >> 16);
+    }
+
+    inline float float_from_bfloat(std::uint16_t b) { return bits_float(static_cast<std::uint32_t>(b) << 16); }
+
+    inline std::uint16_t half_from_float(float f) {
+#if defined(__F16C__)
+        return static_cast<std::uint16_t>(_cvtss_sh(f, _MM_FROUND_TO_NEAREST_INT));
+#else
+        return half_from_float_portable(f);
+#endif
+    }
+
+    inline float float_from_half(std::uint16_t h) {
+#if defined(__F16C__)
+        return _cvtsh_ss(h);
+#else
+        return float_from_half_portable(h);
+#endif
+    }
+
+    // Arithmetic shared by both types, found through ADL as hidden friends.  Each
+    // operation widens to float and rounds the result back once.
+    template <typename H>
+    struct half_arithmetic {
+        friend H operator+(H a, H b) { return H(static_cast<float>(a) + static_cast<float>(b)); }
+        friend H operator-(H a, H b) { return H(static_cast<float>(a) - static_cast<float>(b)); }
+        friend H operator*(H a, H b) { return H(static_cast<float>(a) * static_cast<float>(b)); }
+        friend H operator/(H a, H b) { return H(static_cast<float>(a) / static_cast<float>(b)); }
+        friend H operator-(H a) { return H::from_bits(static_cast<std::uint16_t>(a.bits ^ 0x8000u)); }
+        friend H operator+(H a) { return a; }
+
+        friend H& operator+=(H& a, H b) { return a = a + b; }
+        friend H& operator-=(H& a, H b) { return a = a - b; }
+        friend H& operator*=(H& a, H b) { return a = a * b; }
+        friend H& operator/=(H& a, H b) { return a = a / b; }
+
+        friend bool operator==(H a, H b) { return static_cast<float>(a) == static_cast<float>(b); }
+        friend bool operator!=(H a, H b) { return static_cast<float>(a) != static_cast<float>(b); }
+        friend bool operator<(H a, H b) { return static_cast<float>(a) < static_cast<float>(b); }
+        friend bool operator>(H a, H b) { return static_cast<float>(a) > static_cast<float>(b); }
+        friend bool operator<=(H a, H b) { return static_cast<float>(a) <= static_cast<float>(b); }
+        friend bool operator>=(H a, H b) { return static_cast<float>(a) >= static_cast<float>(b); }
+
+        friend std::ostream& operator<<(std::ostream& os, H h) { return os << static_cast<float>(h); }
+    };
+
+} // namespace detail
+
+
+// Implicit from float (so literals and float results store naturally); explicit to
+// float (so mixed expressions never silently drop to 16-bit arithmetic or vice versa).
+struct float16 : detail::half_arithmetic<float16> {
+    std::uint16_t bits;
+
+    float16() = default;
+    float16(float f) : bits(detail::half_from_float(f)) {}
+    constexpr float16(detail::raw_bits_t, std::uint16_t b) : bits(b) {}
+
+    static constexpr float16 from_bits(std::uint16_t b) { return float16(detail::raw_bits_t{}, b); }
+    explicit operator float() const { return detail::float_from_half(bits); }
+};
+
+struct bfloat16 : detail::half_arithmetic<bfloat16> {
+    std::uint16_t bits;
+
+    bfloat16() = default;
+    bfloat16(float f) : bits(detail::bfloat_from_float_portable(f)) {}
+    constexpr bfloat16(detail::raw_bits_t, std::uint16_t b) : bits(b) {}
+
+    static constexpr bfloat16 from_bits(std::uint16_t b) { return bfloat16(detail::raw_bits_t{}, b); }
+    explicit operator float() const { return detail::float_from_bfloat(bits); }
+};
+
+static_assert(sizeof(float16) == 2 && sizeof(bfloat16) == 2, "16-bit storage types must be two bytes");
+
+
+// --- Traits ---
+
+template <typename T> struct is_half : std::false_type {};
+template <> struct is_half<float16> : std::true_type {};
+template <> struct is_half<bfloat16> : std::true_type {};
+template <typename T> inline constexpr bool is_half_v = is_half<T>::value;
+
+// Type that loops over T should accumulate in: float for the 16-bit types, T otherwise.
+template <typename T> struct accumulate_type { using type = T; };
+template <> struct accumulate_type<float16> { using type = float; };
+template <> struct accumulate_type<bfloat16> { using type = float; };
+template <typename T> using accum_t = typename accumulate_type<T>::type;
+
+
+// --- Bulk conversion ---
+
+inline void convert_to_float(const float16* src, float* dst, std::size_t n) {
+    std::size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+    for (; i + 8 <= n; i += 8)
+        _mm256_storeu_ps(dst + i, _mm256_cvtph_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+#endif
+    for (; i < n; ++i) dst[i] = static_cast<float>(src[i]);
+}
+
+inline void convert_from_float(const float* src, float16* dst, std::size_t n) {
+    std::size_t i = 0;
+#if defined(__F16C__) && defined(__AVX__)
+    for (; i + 8 <= n; i += 8)
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm256_cvtps_ph(_mm256_loadu_ps(src + i), _MM_FROUND_TO_NEAREST_INT));
+#endif
+    for (; i < n; ++i) dst[i] = float16(src[i]);
+}
+
+inline void convert_to_float(const bfloat16* src, float* dst, std::size_t n) {
+    #pragma omp simd
+    for (std::size_t i = 0; i < n; ++i) dst[i] = detail::float_from_bfloat(src[i].bits);
+}
+
+inline void convert_from_float(const float* src, bfloat16* dst, std::size_t n) {
+    std::size_t i = 0;
+#if defined(__AVX512BF16__)
+    for (; i + 16 <= n; i += 16)
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i),
+                            reinterpret_cast<__m256i>(_mm512_cvtneps_pbh(_mm512_loadu_ps(src + i))));
+#endif
+    for (; i < n; ++i) dst[i] = bfloat16(src[i]);
+}
+
+} // namespace tl
+
+
+namespace std {
+
+template <>
+class numeric_limits<tl::float16> {
+public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = true;
+    static constexpr bool is_integer = false;
+    static constexpr bool is_exact = false;
+    static constexpr bool has_infinity = true;
+    static constexpr bool has_quiet_NaN = true;
+    static constexpr int digits = 11;
+    static constexpr int radix = 2;
+    static constexpr tl::float16 min() noexcept { return tl::float16::from_bits(0x0400); }
+    static constexpr tl::float16 max() noexcept { return tl::float16::from_bits(0x7BFF); }
+    static constexpr tl::float16 lowest() noexcept { return tl::float16::from_bits(0xFBFF); }
+    static constexpr tl::float16 epsilon() noexcept { return tl::float16::from_bits(0x1400); }
+    static constexpr tl::float16 infinity() noexcept { return tl::float16::from_bits(0x7C00); }
+    static constexpr tl::float16 quiet_NaN() noexcept { return tl::float16::from_bits(0x7E00); }
+    static constexpr tl::float16 denorm_min() noexcept { return tl::float16::from_bits(0x0001); }
+};
+
+template <>
+class numeric_limits<tl::bfloat16> {
+public:
+    static constexpr bool is_specialized = true;
+    static constexpr bool is_signed = true;
+    static constexpr bool is_integer = false;
+    static constexpr bool is_exact = false;
+    static constexpr bool has_infinity = true;
+    static constexpr bool has_quiet_NaN = true;
+    static constexpr int digits = 8;
+    static constexpr int radix = 2;
+    static constexpr tl::bfloat16 min() noexcept { return tl::bfloat16::from_bits(0x0080); }
+    static constexpr tl::bfloat16 max() noexcept { return tl::bfloat16::from_bits(0x7F7F); }
+    static constexpr tl::bfloat16 lowest() noexcept { return tl::bfloat16::from_bits(0xFF7F); }
+    static constexpr tl::bfloat16 epsilon() noexcept { return tl::bfloat16::from_bits(0x3C00); }
+    static constexpr tl::bfloat16 infinity() noexcept { return tl::bfloat16::from_bits(0x7F80); }
+    static constexpr tl::bfloat16 quiet_NaN() noexcept { return tl::bfloat16::from_bits(0x7FC0); }
+    static constexpr tl::bfloat16 denorm_min() noexcept { return tl::bfloat16::from_bits(0x0001); }
+};
+
+} // namespace std
@@ -0,0 +1,343 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+#include "tensor.hpp"
+#include "broadcasting.hpp"
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+// Index- and mask-driven selection (PyTorch semantics).
+//
+//   index_select(x, axis, idx)         slices idx[j] of x along axis; idx is 1-D
+//   gather(x, axis, idx)               out[..., j, ...] = x[..., idx[..., j, ...], ...]
+//   scatter(x, axis, idx, src)         copy of x with x[..., idx[..., j, ...], ...] = src[..., j, ...]
+//   scatter_add(x, axis, idx, src)     the same, accumulating (duplicates add up)
+//   masked_select(x, mask)             1-D tensor of the x elements where mask != 0
+//   where(cond, a, b)                  a where cond != 0, else b; all three broadcast
+//
+// Indices may be any integer type and are validated before any data moves
+// (std::runtime_error on a negative or out-of-range entry).  For gather / scatter,
+// idx (and src) must match x in every dimension except `axis`.  Masks and conditions
+// may be any element type; non-zero means selected.
+//
+// Large index sets run in parallel.  scatter / scatter_add partition the work by fibre
+// (the positions that differ only along `axis`), so each output element has a single
+// writer and the result is deterministic; only when there are fewer fibre blocks than
+// threads (e.g. a 1-D histogram) does scatter_add switch to atomic adds, for
+// arithmetic element types.
+//
+// Note: #pragma omp directives require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
+// Without that flag the pragmas are silently ignored; all loops remain correct.
+
+namespace tl {
+
+namespace detail {
+
+    constexpr std::size_t index_parallel_threshold = 1 << 15;
+    constexpr std::size_t scatter_block = 64;           // fibres per scatter work item...
+    constexpr std::size_t scatter_min_block = 16;       // ...narrowed to this to feed every thread
+    constexpr std::size_t compact_chunk = 1 << 14;      // elements per masked_select chunk
+
+    // Shape viewed as [outer, len, inner] around `axis` (negative counts from the back).
+    struct AxisSplit { std::size_t axis, outer, len, inner; };
+
+    inline AxisSplit axis_split(const std::vector<std::size_t>& shape, int axis, const char* op) {
+        const int rank = static_cast<int>(shape.size());
+        const int a = axis < 0 ? axis + rank : axis;
+        if (rank == 0 || a < 0 || a >= rank) {
+            throw std::runtime_error(std::string(op) + ": axis " + std::to_string(axis) +
+                                     " out of range for rank " + std::to_string(rank) + ".");
+        }
+        AxisSplit s{static_cast<std::size_t>(a), 1, shape[static_cast<std::size_t>(a)], 1};
+        for (std::size_t d = 0; d < s.axis; ++d) s.outer *= shape[d];
+        for (std::size_t d = s.axis + 1; d < shape.size(); ++d) s.inner *= shape[d];
+        return s;
+    }
+
+    inline int index_threads() {
+#ifdef _OPENMP
+        return omp_get_max_threads();
+#else
+        return 1;
+#endif
+    }
+
+    template <typename I>
+    inline bool index_in_range(I v, std::size_t limit) {
+        if constexpr (std::is_signed_v<I>) {
+            if (v < 0) return false;
+        }
+        return static_cast<std::size_t>(v) < limit;
+    }
+
+    template <typename I>
+    void check_indices(const Tensor<I>& idx, std::size_t limit, const char* op) {
+        static_assert(std::is_integral_v<I>, "index tensors must have an integer element type.");
+        const I* p = idx.data.data();
+        const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(idx.data.size());
+        std::size_t bad = 0;
+        #pragma omp parallel for schedule(static) reduction(+:bad) if(idx.data.size() > index_parallel_threshold)
+        for (std::ptrdiff_t i = 0; i < n; ++i) bad += index_in_range(p[i], limit) ? 0 : 1;
+        if (bad != 0) {
+            throw std::runtime_error(std::string(op) + ": " + std::to_string(bad) +
+                                     " index value(s) out of range for an axis of size " + std::to_string(limit) + ".");
+        }
+    }
+
+    // idx must have x's rank and extents everywhere but along `axis`.
+    inline void check_fibres(const std::vector<std::size_t>& x, const std::vector<std::size_t>& idx, std::size_t axis, const char* op) {
+        bool ok = x.size() == idx.size();
+        for (std::size_t d = 0; ok && d < x.size(); ++d) ok = d == axis || x[d] == idx[d];
+        if (!ok) throw std::runtime_error(std::string(op) + ": index shape must match the input except along the axis.");
+    }
+
+    template <typename I, typename T, bool Accumulate>
+    Tensor<T> scatter_impl(const Tensor<T>& x, int axis, const Tensor<I>& idx, const Tensor<T>& src, const char* op) {
+        const AxisSplit s = axis_split(x.shape, axis, op);
+        check_fibres(x.shape, idx.shape, s.axis, op);
+        if (src.shape != idx.shape) throw std::runtime_error(std::string(op) + ": source and index shapes must match.");
+        check_indices(idx, s.len, op);
+        TL_PROFILE_OP(op, Accumulate ? idx.data.size() : 0, x.shape, idx.shape);
+
+        Tensor<T> out = x;
+        const std::size_t m = idx.shape[s.axis], inner = s.inner, len = s.len;
+        const I* ip = idx.data.data();
+        const T* sp = src.data.data();
+        T* dst_p = out.data.data();
+        const bool parallel = idx.data.size() > index_parallel_threshold;
+        const std::size_t threads = parallel ? static_cast<std::size_t>(index_threads()) : 1;
+        std::size_t block = scatter_block;
+        while (block > scatter_min_block && s.outer * ((inner + block - 1) / block) < threads) block /= 2;
+        const std::size_t blocks = (inner + block - 1) / block, items = s.outer * blocks;
+
+        if constexpr (Accumulate && std::is_arithmetic_v<T>) {
+            if (items < threads) {
+                const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(idx.data.size());
+                #pragma omp parallel for schedule(static)
+                for (std::ptrdiff_t e = 0; e < n; ++e) {
+                    const std::size_t f = static_cast<std::size_t>(e), o = f / (m * inner), i = f % inner;
+                    T* dst = dst_p + (o * len + static_cast<std::size_t>(ip[f])) * inner + i;
+                    #pragma omp atomic
+                    *dst += sp[f];
+                }
+                return out;
+            }
+        }
+
+        // One work item per (outer, block of fibres): every write to a fibre comes from its item.
+        const std::ptrdiff_t total = static_cast<std::ptrdiff_t>(items);
+        #pragma omp parallel for schedule(static) if(parallel && items > 1)
+        for (std::ptrdiff_t w = 0; w < total; ++w) {
+            const std::size_t o = static_cast<std::size_t>(w) / blocks;
+            const std::size_t i0 = (static_cast<std::size_t>(w) % blocks) * block, i1 = std::min(inner, i0 + block);
+            for (std::size_t j = 0; j < m; ++j) {
+                const std::size_t row = (o * m + j) * inner;
+                for (std::size_t i = i0; i < i1; ++i) {
+                    T& dst = dst_p[(o * len + static_cast<std::size_t>(ip[row + i])) * inner + i];
+                    if constexpr (Accumulate) dst = static_cast<T>(static_cast<accum_t<T>>(dst) + static_cast<accum_t<T>>(sp[row + i]));
+                    else dst = sp[row + i];
+                }
+            }
+        }
+        return out;
+    }
+
+    // Element strides of a tensor of `shape` broadcast to `target`.
+    inline std::vector<std::size_t> broadcast_strides_for(const std::vector<std::size_t>& shape, const std::vector<std::size_t>& target) {
+        std::vector<std::size_t> strides(shape.size());
+        std::size_t stride = 1;
+        for (std::size_t d = shape.size(); d-- > 0; ) { strides[d] = stride; stride *= shape[d]; }
+        return get_broadcast_strides(shape, strides, target);
+    }
+
+    // t broadcast to `shape` and materialised.
+    template <typename U>
+    Tensor<U> expand_to(const Tensor<U>& t, const std::vector<std::size_t>& shape) {
+        Tensor<U> out(shape);
+        const auto st = broadcast_strides_for(t.shape, shape);
+        const std::size_t rank = shape.size();
+        const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(out.data.size());
+        #pragma omp parallel for schedule(static) if(out.data.size() > index_parallel_threshold)
+        for (std::ptrdiff_t e = 0; e < n; ++e) {
+            std::size_t off = 0, rem = static_cast<std::size_t>(e);
+            for (std::size_t d = rank; d-- > 0; ) {
+                off += (rem % shape[d]) * st[d];
+                rem /= shape[d];
+            }
+            out.data[static_cast<std::size_t>(e)] = t.data[off];
+        }
+        return out;
+    }
+
+} // namespace detail
+
+
+// --- Index selection ---
+
+template <typename T, typename I>
+Tensor<T> index_select(const Tensor<T>& x, int axis, const Tensor<I>& idx) {
+    if (idx.shape.size() != 1) throw std::runtime_error("index_select: indices must be 1-D.");
+    const detail::AxisSplit s = detail::axis_split(x.shape, axis, "index_select");
+    detail::check_indices(idx, s.len, "index_select");
+    TL_PROFILE_OP("index_select", 0, x.shape, idx.shape);
+
+    std::vector<std::size_t> shape = x.shape;
+    const std::size_t m = idx.data.size(), inner = s.inner, len = s.len;
+    shape[s.axis] = m;
+    Tensor<T> out(shape);
+    const I* ip = idx.data.data();
+    const T* xp = x.data.data();
+    T* dst = out.data.data();
+    const std::ptrdiff_t rows = static_cast<std::ptrdiff_t>(s.outer * m);
+    #pragma omp parallel for schedule(static) if(out.data.size() > detail::index_parallel_threshold)
+    for (std::ptrdiff_t r = 0; r < rows; ++r) {
+        const std::size_t o = static_cast<std::size_t>(r) / m, j = static_cast<std::size_t>(r) % m;
+        const T* from = xp + (o * len + static_cast<std::size_t>(ip[j])) * inner;
+        std::copy(from, from + inner, dst + static_cast<std::size_t>(r) * inner);
+    }
+    return out;
+}
+
+template <typename T, typename I>
+Tensor<T> gather(const Tensor<T>& x, int axis, const Tensor<I>& idx) {
+    const detail::AxisSplit s = detail::axis_split(x.shape, axis, "gather");
+    detail::check_fibres(x.shape, idx.shape, s.axis, "gather");
+    detail::check_indices(idx, s.len, "gather");
+    TL_PROFILE_OP("gather", 0, x.shape, idx.shape);
+
+    Tensor<T> out(idx.shape);
+    const std::size_t m = idx.shape[s.axis], inner = s.inner, len = s.len;
+    const I* ip = idx.data.data();
+    const T* xp = x.data.data();
+    T* dst = out.data.data();
+    const std::ptrdiff_t rows = static_cast<std::ptrdiff_t>(s.outer * m);
+    #pragma omp parallel for schedule(static) if(out.data.size() > detail::index_parallel_threshold)
+    for (std::ptrdiff_t r = 0; r < rows; ++r) {
+        const std::size_t o = static_cast<std::size_t>(r) / m, row = static_cast<std::size_t>(r) * inner;
+        const T* base = xp + o * len * inner;
+        #pragma omp simd
+        for (std::size_t i = 0; i < inner; ++i) dst[row + i] = base[static_cast<std::size_t>(ip[row + i]) * inner + i];
+    }
+    return out;
+}
+
+
+// --- Scatter ---
+
+template <typename T, typename I>
+Tensor<T> scatter(const Tensor<T>& x, int axis, const Tensor<I>& idx, const Tensor<T>& src) {
+    return detail::scatter_impl<I, T, false>(x, axis, idx, src, "scatter");
+}
+
+template <typename T, typename I>
+Tensor<T> scatter_add(const Tensor<T>& x, int axis, const Tensor<I>& idx, const Tensor<T>& src) {
+    return detail::scatter_impl<I, T, true>(x, axis, idx, src, "scatter_add");
+}
+
+
+// --- Masks ---
+
+template <typename T, typename M>
+Tensor<T> masked_select(const Tensor<T>& x, const Tensor<M>& mask) {
+    if (x.shape != mask.shape) {
+        const std::vector<std::size_t> shape = compute_broadcast_shape(x.shape, mask.shape);
+        return masked_select(detail::expand_to(x, shape), detail::expand_to(mask, shape));
+    }
+    TL_PROFILE_OP("masked_select", 0, x.shape, mask.shape);
+
+    // Count per chunk, prefix-sum the counts, then each chunk compacts into its own range.
+    const std::size_t n = x.data.size(), chunks = (n + detail::compact_chunk - 1) / detail::compact_chunk;
+    const T* xp = x.data.data();
+    const M* mp = mask.data.data();
+    std::vector<std::size_t> start(chunks + 1, 0);
+    const std::ptrdiff_t nc = static_cast<std::ptrdiff_t>(chunks);
+    #pragma omp parallel for schedule(static) if(n > detail::index_parallel_threshold)
+    for (std::ptrdiff_t c = 0; c < nc; ++c) {
+        const std::size_t e0 = static_cast<std::size_t>(c) * detail::compact_chunk, e1 = std::min(n, e0 + detail::compact_chunk);
+        std::size_t count = 0;
+        #pragma omp simd reduction(+:count)
+        for (std::size_t e = e0; e < e1; ++e) count += mp[e] != M(0) ? 1 : 0;
+        start[static_cast<std::size_t>(c) + 1] = count;
+    }
+    for (std::size_t c = 0; c < chunks; ++c) start[c + 1] += start[c];
+
+    Tensor<T> out({start[chunks]});
+    T* op = out.data.data();
+    #pragma omp parallel for schedule(static) if(n > detail::index_parallel_threshold)
+    for (std::ptrdiff_t c = 0; c < nc; ++c) {
+        const std::size_t e0 = static_cast<std::size_t>(c) * detail::compact_chunk, e1 = std::min(n, e0 + detail::compact_chunk);
+        T* dst = op + start[static_cast<std::size_t>(c)];
+        const std::size_t cap = start[static_cast<std::size_t>(c) + 1] - start[static_cast<std::size_t>(c)];
+        // Branch-free: every element is written at the cursor, which only advances past kept ones.
+        std::size_t k = 0;
+        for (std::size_t e = e0; e < e1; ++e) {
+            if (k < cap) dst[k] = xp[e];
+            k += mp[e] != M(0) ? 1 : 0;
+        }
+    }
+    return out;
+}
+
+template <typename M, typename T>
+Tensor<T> where(const Tensor<M>& cond, const Tensor<T>& a, const Tensor<T>& b) {
+    TL_PROFILE_OP("where", 0, cond.shape, a.shape, b.shape);
+    if (cond.shape == a.shape && a.shape == b.shape) {
+        Tensor<T> out(a.shape);
+        const M* c = cond.data.data();
+        const T* pa = a.data.data();
+        const T* pb = b.data.data();
+        T* r = out.data.data();
+        const std::ptrdiff_t n = static_cast<std::ptrdiff_t>(out.data.size());
+        #pragma omp parallel for simd schedule(static) if(out.data.size() > detail::index_parallel_threshold)
+        for (std::ptrdiff_t i = 0; i < n; ++i) r[i] = c[i] != M(0) ? pa[i] : pb[i];
+        return out;
+    }
+
+    const std::vector<std::size_t> shape = compute_broadcast_shape(compute_broadcast_shape(cond.shape, a.shape), b.shape);
+    const auto sc = detail::broadcast_strides_for(cond.shape, shape);
+    const auto sa = detail::broadcast_strides_for(a.shape, shape);
+    const auto sb = detail::broadcast_strides_for(b.shape, shape);
+    Tensor<T> out(shape);
+    if (out.data.empty()) return out;
+
+    // One row per position of the leading dimensions (rank >= 1 here: 0-d shapes all match);
+    // the last dimension runs with fixed strides.
+    const std::size_t rank = shape.size(), last = shape.back();
+    const std::size_t lc = sc.back(), la = sa.back(), lb = sb.back();
+    const std::ptrdiff_t rows = static_cast<std::ptrdiff_t>(out.data.size() / last);
+    #pragma omp parallel for schedule(static) if(out.data.size() > detail::index_parallel_threshold)
+    for (std::ptrdiff_t r = 0; r < rows; ++r) {
+        std::size_t oc = 0, oa = 0, ob = 0, rem = static_cast<std::size_t>(r);
+        for (std::size_t d = rank - 1; d-- > 0; ) {
+            const std::size_t c = rem % shape[d];
+            rem /= shape[d];
+            oc += c * sc[d]; oa += c * sa[d]; ob += c * sb[d];
+        }
+        T* dst = out.data.data() + static_cast<std::size_t>(r) * last;
+        for (std::size_t j = 0; j < last; ++j) dst[j] = cond.data[oc + j * lc] != M(0) ? a.data[oa + j * la] : b.data[ob + j * lb];
+    }
+    return out;
+}
+
+// Scalar branches broadcast like 0-d tensors.
+template <typename M, typename T>
+Tensor<T> where(const Tensor<M>& cond, const Tensor<T>& a, typename Tensor<T>::value_type b) {
+    Tensor<T> s(std::vector<std::size_t>{});
+    s.data[0] = b;
+    return where(cond, a, s);
+}
+
+template <typename M, typename T>
+Tensor<T> where(const Tensor<M>& cond, typename Tensor<T>::value_type a, const Tensor<T>& b) {
+    Tensor<T> s(std::vector<std::size_t>{});
+    s.data[0] = a;
+    return where(cond, s, b);
+}
+
+} // namespace tl
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+#include "half.hpp"
+#include "complex.hpp"
+#include "tensor.hpp"
+#include "broadcasting.hpp"
+
+// Mixed element types with NumPy-style promotion.
+//
+// Tensor<A> op Tensor<B> (A != B) returns Tensor<promote_t<A, B>>.  Each element is
+// converted inside the fused (broadcasting) loop, so no converted copy of either
+// operand is made.  The rules extend functional::math_result_t:
+//
+//   - kinds rank bool < integer < floating (float16 / bfloat16 count as floating);
+//     the operand of the higher kind decides, so Tensor<int> * Tensor<float> is float
+//   - two floating types give the wider one; float16 with bfloat16 gives float
+//   - two integers of the same signedness give the wider one; mixed signedness gives
+//     a signed type wide enough for both (uint32 with int32 is int64), and
+//     uint64 with any signed type is double
+//   - complex ranks above floating: the result is std::complex of the promoted
+//     component types (complex<float> with double is complex<double>)
+//
+// Scalars are weak, as in NumPy: a scalar only changes the result type when its kind
+// is higher than the tensor's.  So Tensor<int> * 2.5 is Tensor<double>, while
+// Tensor<float> * 2.0 stays Tensor<float> (the same-type member operators).
+//
+// In-place a op= b keeps a's type and converts b element by element.
+
+namespace tl {
+
+// --- Promotion rules ---
+
+namespace detail {
+
+    // 0 = bool, 1 = integer, 2 = floating, 3 = complex, -1 = not an arithmetic element type.
+    template <typename T>
+    constexpr int dtype_kind() {
+        if constexpr (std::is_same_v<T, bool>) return 0;
+        else if constexpr (std::is_integral_v<T>) return 1;
+        else if constexpr (std::is_floating_point_v<T> || is_half_v<T>) return 2;
+        else if constexpr (is_complex_v<T>) return 3;
+        else return -1;
+    }
+
+    template <std::size_t Bytes> struct signed_of_size;
+    template <> struct signed_of_size<1> { using type = std::int8_t; };
+    template <> struct signed_of_size<2> { using type = std::int16_t; };
+    template <> struct signed_of_size<4> { using type = std::int32_t; };
+    template <> struct signed_of_size<8> { using type = std::int64_t; };
+
+    template <typename A, typename B>
+    struct promote_integers {
+        using S = std::conditional_t<std::is_signed_v<A>, A, B>;
+        using U = std::conditional_t<std::is_signed_v<A>, B, A>;
+        using mixed = std::conditional_t<(sizeof(U) < sizeof(S)), S,
+                      std::conditional_t<(sizeof(U) < 8), typename signed_of_size<(sizeof(U) < 8 ? 2 * sizeof(U) : 8)>::type, double>>;
+        using type = std::conditional_t<std::is_signed_v<A> == std::is_signed_v<B>,
+                                        std::conditional_t<(sizeof(A) >= sizeof(B)), A, B>, mixed>;
+    };
+
+    template <typename A, typename B>
+    struct promote_floats {
+        using type = std::conditional_t<is_half_v<A> && is_half_v<B>, float,
+                     std::conditional_t<is_half_v<A>, B,
+                     std::conditional_t<is_half_v<B>, A,
+                     std::conditional_t<(sizeof(A) >= sizeof(B)), A, B>>>>;
+    };
+
+    template <typename A, typename B> struct promote_impl;
+
+    template <typename A, typename B>
+    struct promote_complex {
+        using type = std::complex<typename promote_impl<real_t<A>, real_t<B>>::type>;
+    };
+
+    template <typename A, typename B>
+    struct promote_impl {
+        static_assert(dtype_kind<A>() >= 0 && dtype_kind<B>() >= 0, "promote_t: unsupported element type");
+        static constexpr int ka = dtype_kind<A>(), kb = dtype_kind<B>();
+        using type = typename std::conditional_t<
+            std::is_same_v<A, B>, std::common_type<A>,
+            std::conditional_t<(ka == 3 || kb == 3), promote_complex<A, B>,
+            std::conditional_t<(ka > kb), std::common_type<A>,
+            std::conditional_t<(kb > ka), std::common_type<B>,
+            std::conditional_t<ka == 2, promote_floats<A, B>,
+            std::conditional_t<ka == 1, promote_integers<A, B>, std::common_type<bool>>>>>>>::type;
+    };
+
+} // namespace detail
+
+template <typename A, typename B>
+using promote_t = typename detail::promote_impl<std::remove_cv_t<A>, std::remove_cv_t<B>>::type;
+
+// Result of Tensor<T> op scalar S: S's type only when its kind outranks T's.
+template <typename T, typename S>
+using scalar_promote_t = std::conditional_t<(detail::dtype_kind<S>() > detail::dtype_kind<T>()), S, T>;
+
+
+// --- Cross-type broadcasting engine ---
+
+// out[i] = op(a[i], b[i]) over the broadcast shape, with both inputs converted to
+// accum_t<R> inside the loop and the result stored as R.  `name` labels the call
+// for the profiler.
+template <typename R, typename A, typename B, typename Op>
+Tensor<R> broadcast_apply(const Tensor<A>& a, const Tensor<B>& b, Op op, const char* name = "broadcast_apply") {
+    using C = accum_t<R>;
+    if (a.shape == b.shape) {
+        TL_PROFILE_OP(name, a.data.size(), a.shape, b.shape);
+        Tensor<R> res(a.shape);
+        R* r = res.data.data();
+        const A* pa = a.data.data();
+        const B* pb = b.data.data();
+        const std::size_t n = a.data.size();
+        for (std::size_t i = 0; i < n; ++i) r[i] = static_cast<R>(op(static_cast<C>(pa[i]), static_cast<C>(pb[i])));
+        return res;
+    }
+
+    std::vector<std::size_t> out_shape = compute_broadcast_shape(a.shape, b.shape);
+    std::vector<std::size_t> str_a = get_broadcast_strides(a.shape, a.strides, out_shape);
+    std::vector<std::size_t> str_b = get_broadcast_strides(b.shape, b.strides, out_shape);
+
+    std::size_t volume = 1;
+    for (auto d : out_shape) volume *= d;
+    TL_PROFILE_OP(name, volume, a.shape, b.shape);
+    Tensor<R> res(out_shape);
+    const std::size_t rank = out_shape.size();
+    const std::size_t total = res.data.size();
+
+    for (std::size_t flat = 0; flat < total; ++flat) {
+        std::size_t off_a = 0, off_b = 0;
+        std::size_t remaining = flat;
+        for (std::size_t d = rank; d-- > 0; ) {
+            std::size_t coord = remaining % out_shape[d];
+            remaining /= out_shape[d];
+            off_a += coord * str_a[d];
+            off_b += coord * str_b[d];
+        }
+        res.data[flat] = static_cast<R>(op(static_cast<C>(a.data[off_a]), static_cast<C>(b.data[off_b])));
+    }
+    return res;
+}
+
+namespace detail {
+
+    template <typename A, typename B>
+    using enable_mixed_t = std::enable_if_t<!std::is_same_v<A, B> && (dtype_kind<A>() >= 0) && (dtype_kind<B>() >= 0)>;
+
+    // Scalar operands that outrank the tensor's kind (the rest use the member operators).
+    template <typename T, typename S>
+    using enable_weak_scalar_t = std::enable_if_t<(dtype_kind<S>() > dtype_kind<T>()) && (dtype_kind<T>() >= 0)>;
+
+    // In-place a op= b over a's shape; b must match it exactly, as for the same-type operators.
+    template <typename A, typename B, typename Op>
+    Tensor<A>& apply_inplace(Tensor<A>& a, const Tensor<B>& b, Op op) {
+        if (a.shape != b.shape) throw std::runtime_error("Shape mismatch");
+        TL_PROFILE_OP("mixed_inplace", a.data.size(), a.shape, b.shape);
+        using C = accum_t<promote_t<A, B>>;
+        A* pa = a.data.data();
+        const B* pb = b.data.data();
+        const std::size_t n = a.data.size();
+        for (std::size_t i = 0; i < n; ++i) pa[i] = static_cast<A>(op(static_cast<C>(pa[i]), static_cast<C>(pb[i])));
+        return a;
+    }
+
+    template <typename R, typename T, typename Op>
+    Tensor<R> apply_scalar(const Tensor<T>& t, Op op) {
+        TL_PROFILE_OP("mixed_scalar", t.data.size(), t.shape);
+        using C = accum_t<R>;
+        Tensor<R> res(t.shape);
+        R* r = res.data.data();
+        const T* p = t.data.data();
+        const std::size_t n = t.data.size();
+        for (std::size_t i = 0; i < n; ++i) r[i] = static_cast<R>(op(static_cast<C>(p[i])));
+        return res;
+    }
+
+} // namespace detail
+
+
+// --- Tensor op Tensor (different element types) ---
+
+template <typename A, typename B, typename = detail::enable_mixed_t<A, B>>
+Tensor<promote_t<A, B>> operator+(const Tensor<A>& a, const Tensor<B>& b) {
+    return broadcast_apply<promote_t<A, B>>(a, b, [](auto x, auto y) { return x + y; }, "add");
+}
+
+template <typename A, typename B, typename = detail::enable_mixed_t<A, B>>
+Tensor<promote_t<A, B>> operator-(const Tensor<A>& a, const Tensor<B>& b) {
+    return broadcast_apply<promote_t<A, B>>(a, b, [](auto x, auto y) { return x - y; }, "sub");
+}
+
+template <typename A, typename B, typename = detail::enable_mixed_t<A, B>>
+Tensor<promote_t<A, B>> operator*(const Tensor<A>& a, const Tensor<B>& b) {
+    return broadcast_apply<promote_t<A, B>>(a, b, [](auto x, auto y) { return x * y; }, "mul");
+}
+
+template <typename A, typename B, typename = detail::enable_mixed_t<A, B>>
+Tensor<promote_t<A, B>> operator/(const Tensor<A>& a, const Tensor<B>& b) {
+    return broadcast_apply<promote_t<A, B>>(a, b, [](auto x, auto y) { return x / y; }, "div");
+}
+
+// --- In-place (result keeps the left-hand type) ---
+
+template <typename A, typename B, typename = detail::enable_mixed_t<A, B>>
+Tensor<A>& operator+=(Tensor<A>& a, const Tensor<B>& b) { return detail::apply_inplace(a, b, [](auto x, auto y) { return x + y; }); }
+
+template <typename A, typename B, typename = detail::enable_mixed_t<A, B>>
+Tensor<A>& operator-=(Tensor<A>& a, const Tensor<B>& b) { return detail::apply_inplace(a, b, [](auto x, auto y) { return x - y; }); }
+
+template <typename A, typename B, typename = detail::enable_mixed_t<A, B>>
+Tensor<A>& operator*=(Tensor<A>& a, const Tensor<B>& b) { return detail::apply_inplace(a, b, [](auto x, auto y) { return x * y; }); }
+
+template <typename A, typename B, typename = detail::enable_mixed_t<A, B>>
+Tensor<A>& operator/=(Tensor<A>& a, const Tensor<B>& b) { return detail::apply_inplace(a, b, [](auto x, auto y) { return x / y; }); }
+
+// --- Tensor op scalar / scalar op Tensor (weak scalars of a higher kind) ---
+
+template <typename T, typename S, typename = detail::enable_weak_scalar_t<T, S>>
+Tensor<S> operator+(const Tensor<T>& t, S s) { return detail::apply_scalar<S>(t, [c = static_cast<accum_t<S>>(s)](auto x) { return x + c; }); }
+
+template <typename T, typename S, typename = detail::enable_weak_scalar_t<T, S>>
+Tensor<S> operator-(const Tensor<T>& t, S s) { return detail::apply_scalar<S>(t, [c = static_cast<accum_t<S>>(s)](auto x) { return x - c; }); }
+
+template <typename T, typename S, typename = detail::enable_weak_scalar_t<T, S>>
+Tensor<S> operator*(const Tensor<T>& t, S s) { return detail::apply_scalar<S>(t, [c = static_cast<accum_t<S>>(s)](auto x) { return x * c; }); }
+
+template <typename T, typename S, typename = detail::enable_weak_scalar_t<T, S>>
+Tensor<S> operator/(const Tensor<T>& t, S s) { return detail::apply_scalar<S>(t, [c = static_cast<accum_t<S>>(s)](auto x) { return x / c; }); }
+
+template <typename S, typename T, typename = detail::enable_weak_scalar_t<T, S>>
+Tensor<S> operator+(S s, const Tensor<T>& t) { return detail::apply_scalar<S>(t, [c = static_cast<accum_t<S>>(s)](auto x) { return c + x; }); }
+
+template <typename S, typename T, typename = detail::enable_weak_scalar_t<T, S>>
+Tensor<S> operator-(S s, const Tensor<T>& t) { return detail::apply_scalar<S>(t, [c = static_cast<accum_t<S>>(s)](auto x) { return c - x; }); }
+
+template <typename S, typename T, typename = detail::enable_weak_scalar_t<T, S>>
+Tensor<S> operator*(S s, const Tensor<T>& t) { return detail::apply_scalar<S>(t, [c = static_cast<accum_t<S>>(s)](auto x) { return c * x; }); }
+
+template <typename S, typename T, typename = detail::enable_weak_scalar_t<T, S>>
+Tensor<S> operator/(S s, const Tensor<T>& t) { return detail::apply_scalar<S>(t, [c = static_cast<accum_t<S>>(s)](auto x) { return c / x; }); }
+
+} // namespace tl
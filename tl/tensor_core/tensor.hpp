@@ -4,8 +4,10 @@
 #include <stdexcept>
 #include <algorithm>
 #include <numeric>
+#include "half.hpp"
 #include "view.hpp"
 #include "broadcasting.hpp"
+#include "../profile/profiler.hpp"
 
 namespace tl {
 
@@ -23,6 +25,7 @@ public:
         std::size_t total_size = 1;
         for (auto dim : shape) total_size *= dim;
         data.resize(total_size);
+        TL_PROFILE_ALLOC(data.data(), total_size * sizeof(T), shape);
         recalculate_strides();
     }
 
@@ -36,6 +39,7 @@ public:
             if (row.size() != cols) throw std::runtime_error("Inconsistent row lengths");
             data.insert(data.end(), row.begin(), row.end());
         }
+        TL_PROFILE_ALLOC(data.data(), data.size() * sizeof(T), shape);
         recalculate_strides();
     }
 
@@ -50,6 +54,7 @@ public:
                 "Shape/data mismatch: shape implies " + std::to_string(expected) +
                 " elements, but " + std::to_string(data.size()) + " were provided.");
         }
+        TL_PROFILE_ALLOC(data.data(), data.size() * sizeof(T), shape);
         recalculate_strides();
     }
 
@@ -92,24 +97,25 @@ public:
     // Broadcast path: different shapes → stride-based multi-dimensional loop.
 
     Tensor operator+(const Tensor& other) const {
-        return broadcast_apply(other, [](T a, T b){ return a + b; });
+        return broadcast_apply(other, [](T a, T b){ return a + b; }, "add");
     }
 
     Tensor operator-(const Tensor& other) const {
-        return broadcast_apply(other, [](T a, T b){ return a - b; });
+        return broadcast_apply(other, [](T a, T b){ return a - b; }, "sub");
     }
 
     Tensor operator*(const Tensor& other) const {
-        return broadcast_apply(other, [](T a, T b){ return a * b; });
+        return broadcast_apply(other, [](T a, T b){ return a * b; }, "mul");
     }
 
     Tensor operator/(const Tensor& other) const {
-        return broadcast_apply(other, [](T a, T b){ return a / b; });
+        return broadcast_apply(other, [](T a, T b){ return a / b; }, "div");
     }
 
     // --- Element-wise scalar operators ---
 
     Tensor operator+(T scalar) const {
+        TL_PROFILE_OP("add_scalar", data.size(), shape);
         Tensor res(shape);
         T* r = res.data.data();
         const T* a = this->data.data();
@@ -119,6 +125,7 @@ public:
     }
 
     Tensor operator*(T scalar) const {
+        TL_PROFILE_OP("mul_scalar", data.size(), shape);
         Tensor res(shape);
         T* r = res.data.data();
         const T* a = this->data.data();
@@ -128,6 +135,7 @@ public:
     }
 
     Tensor operator-(T scalar) const {
+        TL_PROFILE_OP("sub_scalar", data.size(), shape);
         Tensor res(shape);
         T* r = res.data.data();
         const T* a = this->data.data();
@@ -137,6 +145,7 @@ public:
     }
 
     Tensor operator/(T scalar) const {
+        TL_PROFILE_OP("div_scalar", data.size(), shape);
         Tensor res(shape);
         T* r = res.data.data();
         const T* a = this->data.data();
@@ -148,6 +157,7 @@ public:
     // --- In-place tensor operators ---
 
     Tensor& operator+=(const Tensor& other) {
+        TL_PROFILE_OP("add_", data.size(), shape, other.shape);
         check_shape(other);
         T* a = this->data.data();
         const T* b = other.data.data();
@@ -157,6 +167,7 @@ public:
     }
 
     Tensor& operator-=(const Tensor& other) {
+        TL_PROFILE_OP("sub_", data.size(), shape, other.shape);
         check_shape(other);
         T* a = this->data.data();
         const T* b = other.data.data();
@@ -166,6 +177,7 @@ public:
     }
 
     Tensor& operator*=(const Tensor& other) {
+        TL_PROFILE_OP("mul_", data.size(), shape, other.shape);
         check_shape(other);
         T* a = this->data.data();
         const T* b = other.data.data();
@@ -175,6 +187,7 @@ public:
     }
 
     Tensor& operator/=(const Tensor& other) {
+        TL_PROFILE_OP("div_", data.size(), shape, other.shape);
         check_shape(other);
         T* a = this->data.data();
         const T* b = other.data.data();
@@ -188,6 +201,7 @@ public:
     // Without that flag the pragma is silently ignored; the loops are still correct.
 
     Tensor& operator+=(T scalar) {
+        TL_PROFILE_OP("add_scalar_", data.size(), shape);
         T* a = this->data.data();
         const std::size_t n = data.size();
         #pragma omp simd
@@ -196,6 +210,7 @@ public:
     }
 
     Tensor& operator-=(T scalar) {
+        TL_PROFILE_OP("sub_scalar_", data.size(), shape);
         T* a = this->data.data();
         const std::size_t n = data.size();
         #pragma omp simd
@@ -204,6 +219,7 @@ public:
     }
 
     Tensor& operator*=(T scalar) {
+        TL_PROFILE_OP("mul_scalar_", data.size(), shape);
         T* a = this->data.data();
         const std::size_t n = data.size();
         #pragma omp simd
@@ -212,6 +228,7 @@ public:
     }
 
     Tensor& operator/=(T scalar) {
+        TL_PROFILE_OP("div_scalar_", data.size(), shape);
         T* a = this->data.data();
         const std::size_t n = data.size();
         #pragma omp simd
@@ -220,13 +237,18 @@ public:
     }
 
     // --- Rule of Five ---
-    ~Tensor() = default;
-    Tensor(const Tensor& other) : data(other.data), shape(other.shape), strides(other.strides) {}
+    // Storage changes are reported to the memory tracker (tl/profile/memory.hpp).
+    ~Tensor() { TL_PROFILE_FREE(data.data()); }
+    Tensor(const Tensor& other) : data(other.data), shape(other.shape), strides(other.strides) {
+        TL_PROFILE_ALLOC(data.data(), data.size() * sizeof(T), shape);
+    }
     Tensor& operator=(const Tensor& other) {
         if (this != &other) {
+            TL_PROFILE_FREE(data.data());
             data = other.data;
             shape = other.shape;
             strides = other.strides;
+            TL_PROFILE_ALLOC(data.data(), data.size() * sizeof(T), shape);
         }
         return *this;
     }
@@ -235,6 +257,7 @@ public:
 
     Tensor& operator=(Tensor&& other) noexcept {
         if (this != &other) {
+            TL_PROFILE_FREE(data.data());
             data = std::move(other.data);
             shape = std::move(other.shape);
             strides = std::move(other.strides);
@@ -261,11 +284,12 @@ private:
     }
 
     // Core broadcasting engine.
-    // Op is a binary functor (T, T) -> T.
+    // Op is a binary functor (T, T) -> T; name labels the call for the profiler.
     template <typename Op>
-    Tensor broadcast_apply(const Tensor& other, Op op) const {
+    Tensor broadcast_apply(const Tensor& other, Op op, const char* name) const {
         // Fast path: identical shapes — original direct loop, zero overhead.
         if (shape == other.shape) {
+            TL_PROFILE_OP(name, data.size(), shape, other.shape);
             Tensor res(shape);
             T* r = res.data.data();
             const T* a = data.data();
@@ -280,12 +304,13 @@ private:
         std::vector<std::size_t> str_a = get_broadcast_strides(shape, strides, out_shape);
         std::vector<std::size_t> str_b = get_broadcast_strides(other.shape, other.strides, out_shape);
 
-        Tensor res(out_shape);
-        const std::size_t rank = out_shape.size();
-
         // Compute total output elements
         std::size_t total = 1;
         for (auto d : out_shape) total *= d;
+        TL_PROFILE_OP(name, total, shape, other.shape);
+
+        Tensor res(out_shape);
+        const std::size_t rank = out_shape.size();
 
         for (std::size_t flat = 0; flat < total; ++flat) {
             // Convert flat index to multi-dimensional coordinates, then
@@ -3,6 +3,7 @@
 #include <iostream>
 #include <string>
 #include "tensor.hpp"
+#include "complex.hpp"
 
 // Note: #pragma omp simd hints require compiling with -fopenmp (GCC/Clang) or /openmp (MSVC).
 // Without that flag the pragmas are silently ignored; all loops remain correct.
@@ -22,6 +23,7 @@ Tensor<T> operator*(T scalar, const Tensor<T>& t) { return t * scalar; }
 // scalar - tensor: result[i] = scalar - t[i]  (NOT t[i] - scalar)
 template <typename T>
 Tensor<T> operator-(T scalar, const Tensor<T>& t) {
+    TL_PROFILE_OP("rsub_scalar", t.data.size(), t.shape);
     Tensor<T> res(t.shape);
     T* r = res.data.data();
     const T* a = t.data.data();
@@ -33,6 +35,7 @@ Tensor<T> operator-(T scalar, const Tensor<T>& t) {
 // scalar / tensor: result[i] = scalar / t[i]  (NOT t[i] / scalar)
 template <typename T>
 Tensor<T> operator/(T scalar, const Tensor<T>& t) {
+    TL_PROFILE_OP("rdiv_scalar", t.data.size(), t.shape);
     Tensor<T> res(t.shape);
     T* r = res.data.data();
     const T* a = t.data.data();
@@ -94,42 +97,58 @@ T dot(const Tensor<T>& a, const Tensor<T>& b) {
     if (a.shape[0] != b.shape[0]) {
         throw std::runtime_error("Vectors must be the same length.");
     }
+    TL_PROFILE_OP("dot", 2 * a.data.size(), a.shape, b.shape);
 
-    T result = static_cast<T>(0);
+    using A = accum_t<T>;
+    A result = static_cast<A>(0);
     const T* ptr_a = a.data.data();
     const T* ptr_b = b.data.data();
     const std::size_t n = a.data.size();
 
     for (std::size_t i = 0; i < n; ++i) {
-        result += ptr_a[i] * ptr_b[i];
+        result += static_cast<A>(ptr_a[i]) * static_cast<A>(ptr_b[i]);
     }
-    return result;
+    return static_cast<T>(result);
 }
 
 
 // --- Reductions ---
 
-// FIX: sum returns T (was already correct, kept as-is).
+// Sum in the accumulator type (float for float16 / bfloat16, T otherwise).
 template <typename T>
-T sum(const Tensor<T>& t) {
-    T total = static_cast<T>(0);
+accum_t<T> sum_accumulate(const Tensor<T>& t) {
+    TL_PROFILE_OP("sum", t.data.size(), t.shape);
+    using A = accum_t<T>;
+    A total = static_cast<A>(0);
     const T* ptr = t.data.data();
     const std::size_t n = t.data.size();
 
-    #pragma omp simd reduction(+:total)
-    for (std::size_t i = 0; i < n; ++i) {
-        total += ptr[i];
+    if constexpr (is_complex_v<A>) {
+        // OpenMP has no built-in + reduction for std::complex.
+        for (std::size_t i = 0; i < n; ++i) total += ptr[i];
+    } else {
+        #pragma omp simd reduction(+:total)
+        for (std::size_t i = 0; i < n; ++i) {
+            total += static_cast<A>(ptr[i]);
+        }
     }
     return total;
 }
 
+// FIX: sum returns T (was already correct, kept as-is).
+template <typename T>
+T sum(const Tensor<T>& t) {
+    return static_cast<T>(sum_accumulate(t));
+}
+
 // FIX: mean now returns T instead of always float, preserving double precision.
 template <typename T>
 T mean(const Tensor<T>& t) {
     if (t.data.empty()) {
         throw std::runtime_error("Cannot compute mean of empty tensor");
     }
-    return sum(t) / static_cast<T>(t.data.size());
+    using A = accum_t<T>;
+    return static_cast<T>(sum_accumulate(t) / static_cast<A>(t.data.size()));
 }
 
 template <typename T>
@@ -137,6 +156,7 @@ T max(const Tensor<T>& t) {
     if (t.data.empty()) {
         throw std::runtime_error("Cannot compute max of empty tensor");
     }
+    TL_PROFILE_OP("max", t.data.size(), t.shape);
     return *std::max_element(t.data.begin(), t.data.end());
 }
 
@@ -145,6 +165,7 @@ T min(const Tensor<T>& t) {
     if (t.data.empty()) {
         throw std::runtime_error("Cannot compute min of empty tensor");
     }
+    TL_PROFILE_OP("min", t.data.size(), t.shape);
     return *std::min_element(t.data.begin(), t.data.end());
 }
 
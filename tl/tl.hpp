@@ -1,6 +1,9 @@
 // tl/tl.hpp
 #pragma once
 
+// 0. Op profiler (standalone; instrumentation compiled in with -DTL_PROFILE)
+#include "profile/profiler.hpp"
+
 // 1. View comes first (it's the most basic dependency)
 #include "tensor_core/view.hpp"
 
@@ -10,9 +13,57 @@
 // 3. Broadcasting utilities (depends on Tensor)
 #include "tensor_core/broadcasting.hpp"
 
-// 4. Utils comes last (depends on Tensor and View)
+// 4. Utils (depends on Tensor and View)
 #include "tensor_core/tensor_utils.hpp"
 
+// 5. Mixed element-type operators with promotion (depends on Tensor and broadcasting)
+#include "tensor_core/promotion.hpp"
+
+// 6. Complex tensors: parts, magnitude, conjugate (promotion ranks complex above floating)
+#include "tensor_core/complex.hpp"
+
+// 7. Index / mask selection: index_select, gather, scatter, masked_select, where
+#include "tensor_core/indexing.hpp"
+
+// 8. Comparisons, logical ops and masks (byte masks and packed BitMask)
+#include "tensor_core/compare.hpp"
+
+// 9. Joining and splitting: concatenate, stack, split / chunk slices, pad
+#include "tensor_core/concat.hpp"
+
 #include "linalg/linalg_utils.hpp"
+#include "linalg/einsum.hpp"
+#include "linalg/lu.hpp"
+#include "linalg/sparse.hpp"
+#include "linalg/iterative.hpp"
+
+#include "functional/functions.hpp"
+#include "functional/softmax.hpp"
+
+#include "random/random.hpp"
+
+#include "fft/plan.hpp"
+#include "fft/fft.hpp"
+#include "fft/convolve.hpp"
+
+#include "autograd/tape.hpp"
+#include "autograd/ops.hpp"
+
+#include "graph/graph.hpp"
+#include "graph/plan.hpp"
+
+#include "nn/conv.hpp"
+#include "nn/pooling.hpp"
+#include "nn/norm.hpp"
+#include "nn/dropout.hpp"
+
+#include "optim/optimizers.hpp"
+
+#include "quant/quantize.hpp"
+
+#include "pde/stencil.hpp"
+#include "pde/solvers.hpp"
+#include "pde/multigrid.hpp"
 
-#include "functional/functions.hpp"
\ No newline at end of file
+#include "ode/runge_kutta.hpp"
+#include "ode/stiff.hpp"
\ No newline at end of file